@@ -0,0 +1,142 @@
+/**
+ * @file bench_gates.cpp
+ * @brief Benchmarks for NeuronGate::process and NeuronGate::evaluate of every gate type.
+ */
+
+#include "benchmark.h"
+#include "../include/neuron_gate.h"
+#include "../include/synapse.h"
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Run one gate over range(0) inputs with strengths spread over [0.5, 0.9]
+ * @param state Benchmark state
+ * @param gate Gate under test
+ */
+void runGate(benchmark::State& state, NeuronGate& gate) {
+    size_t count = static_cast<size_t>(state.range(0));
+    std::vector<SynapsePtr> inputs;
+    for (size_t i = 0; i < count; ++i) {
+        float strength = 0.5f + 0.4f * static_cast<float>(i) / static_cast<float>(count);
+        inputs.push_back(Synapse::create("input", Synapse::SynapseType::EXCITATORY, strength));
+    }
+
+    for (auto _ : state) {
+        (void)_;
+        SynapsePtr output = gate.process(inputs);
+        benchmark::DoNotOptimize(output.get());
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+/**
+ * @brief Run a gate created by NeuronGateFactory
+ * @param state Benchmark state
+ * @param type Gate type
+ */
+void runFactoryGate(benchmark::State& state, NeuronGate::GateType type) {
+    std::shared_ptr<NeuronGate> gate = NeuronGateFactory::createGate(type, "bench_gate");
+    runGate(state, *gate);
+}
+
+/**
+ * @brief Evaluate one gate over a batch of range(0) independent signals
+ * @param state Benchmark state
+ * @param type Gate type
+ */
+void runBatch(benchmark::State& state, NeuronGate::GateType type) {
+    std::shared_ptr<NeuronGate> gate = NeuronGateFactory::createGate(type, "bench_gate");
+    size_t count = static_cast<size_t>(state.range(0));
+    std::vector<float> strengths(count);
+    std::vector<float> outputs(count);
+    std::vector<uint8_t> passed(count);
+    for (size_t i = 0; i < count; ++i) {
+        strengths[i] = 0.5f + 0.4f * static_cast<float>(i) / static_cast<float>(count);
+    }
+
+    for (auto _ : state) {
+        (void)_;
+        gate->evaluate(strengths.data(), count, outputs.data(), passed.data());
+        benchmark::DoNotOptimize(passed.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+} // namespace
+
+/**
+ * @brief AND gate over range(0) inputs
+ */
+static void BM_AndGate(benchmark::State& state) {
+    runFactoryGate(state, NeuronGate::GateType::AND);
+}
+BENCHMARK(BM_AndGate)->Arg(1)->Arg(4)->Arg(16)->ArgNames({"inputs"});
+
+/**
+ * @brief OR gate over range(0) inputs
+ */
+static void BM_OrGate(benchmark::State& state) {
+    runFactoryGate(state, NeuronGate::GateType::OR);
+}
+BENCHMARK(BM_OrGate)->Arg(1)->Arg(4)->Arg(16)->ArgNames({"inputs"});
+
+/**
+ * @brief NOT gate over range(0) inputs
+ */
+static void BM_NotGate(benchmark::State& state) {
+    runFactoryGate(state, NeuronGate::GateType::NOT);
+}
+BENCHMARK(BM_NotGate)->Arg(1)->Arg(4)->Arg(16)->ArgNames({"inputs"});
+
+/**
+ * @brief XOR gate over range(0) inputs
+ */
+static void BM_XorGate(benchmark::State& state) {
+    runFactoryGate(state, NeuronGate::GateType::XOR);
+}
+BENCHMARK(BM_XorGate)->Arg(1)->Arg(4)->Arg(16)->ArgNames({"inputs"});
+
+/**
+ * @brief THRESHOLD gate over range(0) inputs
+ */
+static void BM_ThresholdGate(benchmark::State& state) {
+    runFactoryGate(state, NeuronGate::GateType::THRESHOLD);
+}
+BENCHMARK(BM_ThresholdGate)->Arg(1)->Arg(4)->Arg(16)->ArgNames({"inputs"});
+
+/**
+ * @brief MODULATOR gate over range(0) inputs
+ */
+static void BM_ModulatorGate(benchmark::State& state) {
+    runFactoryGate(state, NeuronGate::GateType::MODULATOR);
+}
+BENCHMARK(BM_ModulatorGate)->Arg(1)->Arg(4)->Arg(16)->ArgNames({"inputs"});
+
+/**
+ * @brief CUSTOM gate over range(0) inputs
+ */
+static void BM_CustomGate(benchmark::State& state) {
+    runFactoryGate(state, NeuronGate::GateType::CUSTOM);
+}
+BENCHMARK(BM_CustomGate)->Arg(1)->Arg(4)->Arg(16)->ArgNames({"inputs"});
+
+/**
+ * @brief THRESHOLD gate evaluating a batch of range(0) signals
+ */
+static void BM_ThresholdGateBatch(benchmark::State& state) {
+    runBatch(state, NeuronGate::GateType::THRESHOLD);
+}
+BENCHMARK(BM_ThresholdGateBatch)->Arg(16)->Arg(256)->Arg(4096)->ArgNames({"signals"});
+
+/**
+ * @brief MODULATOR gate evaluating a batch of range(0) signals
+ */
+static void BM_ModulatorGateBatch(benchmark::State& state) {
+    runBatch(state, NeuronGate::GateType::MODULATOR);
+}
+BENCHMARK(BM_ModulatorGateBatch)->Arg(16)->Arg(256)->Arg(4096)->ArgNames({"signals"});
@@ -0,0 +1,97 @@
+/**
+ * @file bench_network.cpp
+ * @brief Benchmarks for Network::processSignals on random graphs.
+ */
+
+#include "benchmark.h"
+#include "../include/graph_generator.h"
+#include "../include/network.h"
+#include "../include/neuron.h"
+#include "../include/synapse.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+const double MEAN_DEGREE = 4.0;    // Mean out-degree of the random graphs
+const size_t INPUT_NEURONS = 16;   // Sensory neurons receiving a signal every tick
+const size_t OUTPUT_NEURONS = 16;  // Output neurons
+const uint64_t GRAPH_SEED = 42;    // Seed shared by all graph sizes
+const int EPISODE_TICKS = 10;      // Ticks simulated per timed iteration
+
+/**
+ * @brief Build an Erdős–Rényi graph
+ * @param network Network to populate
+ * @param count Number of neurons
+ * @return The input neurons
+ */
+std::vector<std::shared_ptr<Neuron>> buildRandomGraph(Network& network, size_t count) {
+    GraphGenerator::Config config;
+    config.topology = GraphGenerator::Topology::ERDOS_RENYI;
+    config.neuronCount = count;
+    config.meanDegree = MEAN_DEGREE;
+    config.inputCount = INPUT_NEURONS;
+    config.outputCount = OUTPUT_NEURONS;
+    config.seed = GRAPH_SEED;
+
+    GraphGenerator::Graph graph = GraphGenerator::generate(config);
+    std::vector<std::shared_ptr<Neuron>> neurons = GraphGenerator::build(graph, network);
+
+    std::vector<std::shared_ptr<Neuron>> inputs;
+    for (uint32_t input : graph.inputs) {
+        inputs.push_back(neurons[input]);
+    }
+    return inputs;
+}
+
+} // namespace
+
+/**
+ * @brief Run an episode of ticks on a random graph of range(0) neurons with range(1) workers,
+ *        scanning densely (range(2) == 0), event-driven (range(2) == 1) or levelized (range(2) == 2)
+ *
+ * Each iteration resets the network outside the timed region, then
+ * stimulates the input neurons on every tick of the episode, so every
+ * iteration replays the same spread of activity through the graph.
+ */
+static void BM_NetworkProcessSignals(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    Network network("bench_network");
+    std::vector<std::shared_ptr<Neuron>> inputs = buildRandomGraph(network, count);
+    network.setParallelism(static_cast<size_t>(state.range(1)));
+    network.setSchedulingMode(static_cast<Network::SchedulingMode>(state.range(2)));
+
+    size_t pending = 0;
+    for (auto _ : state) {
+        (void)_;
+        state.PauseTiming();
+        network.reset();
+        state.ResumeTiming();
+
+        for (int tick = 0; tick < EPISODE_TICKS; ++tick) {
+            for (const auto& input : inputs) {
+                SynapsePtr signal = Synapse::create("stimulus");
+                signal->setData("strength", 1.0f);
+                input->receiveSignal(signal);
+            }
+            network.processSignals();
+        }
+        pending = network.getPendingSignalCount();
+    }
+
+    state.SetItemsProcessed(state.iterations() * EPISODE_TICKS * static_cast<int64_t>(count));
+    state.SetLabel("pending=" + std::to_string(pending));
+}
+BENCHMARK(BM_NetworkProcessSignals)
+    ->ArgsProduct({{1000, 10000}, {1, 4}, {0, 1, 2}})
+    ->ArgNames({"neurons", "workers", "scheduling"})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+// Large graphs take seconds to build, so they run a fixed number of episodes
+BENCHMARK(BM_NetworkProcessSignals)
+    ->ArgsProduct({{100000, 1000000}, {1, 4}, {0, 1, 2}})
+    ->ArgNames({"neurons", "workers", "scheduling"})
+    ->Iterations(5)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
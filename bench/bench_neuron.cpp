@@ -0,0 +1,83 @@
+/**
+ * @file bench_neuron.cpp
+ * @brief Benchmarks for Neuron::fire fan-out and the integration kernel.
+ */
+
+#include "benchmark.h"
+#include "../include/integration_kernel.h"
+#include "../include/network.h"
+#include "../include/neuron.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+const int64_t DRAIN_INTERVAL = 64;  // Fires between untimed drains of the signal queue
+
+} // namespace
+
+/**
+ * @brief Fire one neuron connected to range(0) targets
+ */
+static void BM_NeuronFire(benchmark::State& state) {
+    Network network("fire_bench");
+    auto source = network.createNeuron("source", Neuron::NeuronType::PROCESSING);
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        auto target = network.createNeuron("target_" + std::to_string(i), Neuron::NeuronType::PROCESSING);
+        source->connectTo(target, 0.5f);
+    }
+
+    int64_t fired = 0;
+    for (auto _ : state) {
+        (void)_;
+        source->fire();
+
+        // Keep the delivery queue from growing without bound
+        if (++fired % DRAIN_INTERVAL == 0) {
+            state.PauseTiming();
+            network.reset();
+            state.ResumeTiming();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_NeuronFire)->RangeMultiplier(4)->Range(1, 1024)->ArgNames({"fanout"});
+
+/**
+ * @brief Integrate range(1) slots, all active, with the variant range(0)
+ */
+static void BM_IntegrationKernel(benchmark::State& state) {
+    IntegrationKernel::Isa previous = IntegrationKernel::getIsa();
+    IntegrationKernel::Isa isa = static_cast<IntegrationKernel::Isa>(state.range(0));
+    if (!IntegrationKernel::setIsa(isa)) {
+        state.SkipWithError(std::string("CPU lacks ") + IntegrationKernel::getIsaName(isa));
+        return;
+    }
+    state.SetLabel(IntegrationKernel::getIsaName(isa));
+
+    size_t count = static_cast<size_t>(state.range(1));
+    std::vector<float> potentials(count, 0.0f);
+    std::vector<float> thresholds(count, 0.75f);
+    std::vector<float> currents(count);
+    std::vector<uint8_t> active(count, 1);
+    std::vector<float> decays(count, 0.9f);
+    std::vector<uint64_t> fired((count + 63) / 64);
+    for (size_t i = 0; i < count; ++i) {
+        currents[i] = static_cast<float>(i % 7) * 0.05f;
+    }
+
+    for (auto _ : state) {
+        (void)_;
+        IntegrationKernel::integrate(potentials.data(), thresholds.data(), currents.data(),
+                                     active.data(), decays.data(), count, fired.data());
+        benchmark::DoNotOptimize(fired.data());
+    }
+
+    IntegrationKernel::setIsa(previous);
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK(BM_IntegrationKernel)
+    ->Args({0, 4096})->Args({1, 4096})->Args({2, 4096})->Args({3, 4096})
+    ->Args({0, 1 << 20})->Args({2, 1 << 20})->Args({3, 1 << 20})
+    ->ArgNames({"isa", "neurons"});
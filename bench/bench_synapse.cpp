@@ -0,0 +1,169 @@
+/**
+ * @file bench_synapse.cpp
+ * @brief Benchmarks for synapse creation, derivation and payload access.
+ */
+
+#include "benchmark.h"
+#include "../include/synapse.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+// Payload keys used by the setData/getData benchmarks
+std::vector<std::string> payloadKeys(size_t count) {
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < count; ++i) {
+        keys.push_back("key_" + std::to_string(i));
+    }
+    return keys;
+}
+
+} // namespace
+
+/**
+ * @brief Create a synapse under the ID policy given by range(0) (0 = counter, 1 = UUID)
+ */
+static void BM_SynapseCreate(benchmark::State& state) {
+    Synapse::IdPolicy previous = Synapse::getIdPolicy();
+    Synapse::setIdPolicy(state.range(0) ? Synapse::IdPolicy::UUID : Synapse::IdPolicy::COUNTER);
+
+    for (auto _ : state) {
+        (void)_;
+        SynapsePtr synapse = Synapse::create();
+        benchmark::DoNotOptimize(synapse.get());
+    }
+
+    Synapse::setIdPolicy(previous);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SynapseCreate)->Arg(0)->Arg(1)->ArgNames({"uuid"});
+
+/**
+ * @brief Derive from a synapse carrying range(0) tags
+ */
+static void BM_SynapseDerive(benchmark::State& state) {
+    SynapsePtr base = Synapse::create("base", Synapse::SynapseType::EXCITATORY, 0.8f);
+    base->setSourceId("source");
+    base->setTargetId("target");
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        base->addTag("tag_" + std::to_string(i));
+    }
+
+    for (auto _ : state) {
+        (void)_;
+        SynapsePtr derived = base->derive(0.5f);
+        benchmark::DoNotOptimize(derived.get());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SynapseDerive)->Arg(0)->Arg(4)->ArgNames({"tags"});
+
+/**
+ * @brief Write range(0) float values through the string-keyed API
+ */
+static void BM_SynapseSetData(benchmark::State& state) {
+    std::vector<std::string> keys = payloadKeys(static_cast<size_t>(state.range(0)));
+    SynapsePtr synapse = Synapse::create("payload");
+    float value = 0.0f;
+
+    for (auto _ : state) {
+        (void)_;
+        for (const auto& key : keys) {
+            synapse->setData(key, value);
+        }
+        value += 1.0f;
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SynapseSetData)->Arg(1)->Arg(4)->Arg(16)->ArgNames({"keys"});
+
+/**
+ * @brief Write range(0) float values under interned keys
+ */
+static void BM_SynapseSetDataSymbol(benchmark::State& state) {
+    std::vector<Symbol> keys;
+    for (const auto& key : payloadKeys(static_cast<size_t>(state.range(0)))) {
+        keys.push_back(SymbolTable::global().intern(key));
+    }
+    SynapsePtr synapse = Synapse::create("payload");
+    float value = 0.0f;
+
+    for (auto _ : state) {
+        (void)_;
+        for (Symbol key : keys) {
+            synapse->setData(key, value);
+        }
+        value += 1.0f;
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SynapseSetDataSymbol)->Arg(1)->Arg(4)->Arg(16)->ArgNames({"keys"});
+
+/**
+ * @brief Read range(0) float values through the string-keyed API
+ */
+static void BM_SynapseGetData(benchmark::State& state) {
+    std::vector<std::string> keys = payloadKeys(static_cast<size_t>(state.range(0)));
+    SynapsePtr synapse = Synapse::create("payload");
+    for (const auto& key : keys) {
+        synapse->setData(key, 0.5f);
+    }
+
+    for (auto _ : state) {
+        (void)_;
+        float sum = 0.0f;
+        for (const auto& key : keys) {
+            sum += synapse->getData<float>(key);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SynapseGetData)->Arg(1)->Arg(4)->Arg(16)->ArgNames({"keys"});
+
+/**
+ * @brief Read range(0) float values under interned keys
+ */
+static void BM_SynapseGetDataSymbol(benchmark::State& state) {
+    std::vector<Symbol> keys;
+    for (const auto& key : payloadKeys(static_cast<size_t>(state.range(0)))) {
+        keys.push_back(SymbolTable::global().intern(key));
+    }
+    SynapsePtr synapse = Synapse::create("payload");
+    for (Symbol key : keys) {
+        synapse->setData(key, 0.5f);
+    }
+
+    for (auto _ : state) {
+        (void)_;
+        float sum = 0.0f;
+        for (Symbol key : keys) {
+            sum += synapse->getData<float>(key);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SynapseGetDataSymbol)->Arg(1)->Arg(4)->Arg(16)->ArgNames({"keys"});
+
+/**
+ * @brief Read a value stored as text as a float, the legacy payload path
+ */
+static void BM_SynapseGetDataFromString(benchmark::State& state) {
+    SynapsePtr synapse = Synapse::create("payload");
+    synapse->setData("value", std::string("0.750000"));
+
+    for (auto _ : state) {
+        (void)_;
+        benchmark::DoNotOptimize(synapse->getData<float>("value"));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SynapseGetDataFromString);
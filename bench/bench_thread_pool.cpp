@@ -0,0 +1,111 @@
+/**
+ * @file bench_thread_pool.cpp
+ * @brief Benchmarks for ThreadPool task throughput.
+ */
+
+#include "benchmark.h"
+#include "../include/thread_pool.h"
+#include <atomic>
+#include <functional>
+#include <vector>
+
+namespace {
+
+const int64_t TASKS_PER_ITERATION = 1024;  // Tasks submitted per timed iteration
+const size_t PARALLEL_FOR_SIZE = 1 << 20;  // Indices covered by each parallelFor
+
+} // namespace
+
+/**
+ * @brief Submit tiny tasks one at a time to a pool of range(0) threads and wait
+ */
+static void BM_ThreadPoolSubmit(benchmark::State& state) {
+    ThreadPool pool(static_cast<size_t>(state.range(0)));
+    std::atomic<int64_t> counter(0);
+
+    for (auto _ : state) {
+        (void)_;
+        TaskGroup group;
+        for (int64_t i = 0; i < TASKS_PER_ITERATION; ++i) {
+            pool.submit(group, [&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+        }
+        pool.wait(group);
+    }
+
+    benchmark::DoNotOptimize(counter.load());
+    state.SetItemsProcessed(state.iterations() * TASKS_PER_ITERATION);
+}
+BENCHMARK(BM_ThreadPoolSubmit)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->ArgNames({"threads"})->UseRealTime();
+
+/**
+ * @brief Submit tiny tasks as one batch to a pool of range(0) threads and wait
+ */
+static void BM_ThreadPoolSubmitBatch(benchmark::State& state) {
+    ThreadPool pool(static_cast<size_t>(state.range(0)));
+    std::atomic<int64_t> counter(0);
+    std::vector<std::function<void()>> tasks;
+
+    for (auto _ : state) {
+        (void)_;
+        TaskGroup group;
+        tasks.clear();
+        for (int64_t i = 0; i < TASKS_PER_ITERATION; ++i) {
+            tasks.push_back([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+        }
+        pool.submitBatch(group, tasks);
+        pool.wait(group);
+    }
+
+    benchmark::DoNotOptimize(counter.load());
+    state.SetItemsProcessed(state.iterations() * TASKS_PER_ITERATION);
+}
+BENCHMARK(BM_ThreadPoolSubmitBatch)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->ArgNames({"threads"})->UseRealTime();
+
+/**
+ * @brief Enqueue fire-and-forget tasks and wait for the pool to drain
+ */
+static void BM_ThreadPoolEnqueue(benchmark::State& state) {
+    ThreadPool pool(static_cast<size_t>(state.range(0)));
+    std::atomic<int64_t> counter(0);
+
+    for (auto _ : state) {
+        (void)_;
+        for (int64_t i = 0; i < TASKS_PER_ITERATION; ++i) {
+            pool.enqueue([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+        }
+        pool.waitForCompletion();
+    }
+
+    benchmark::DoNotOptimize(counter.load());
+    state.SetItemsProcessed(state.iterations() * TASKS_PER_ITERATION);
+}
+BENCHMARK(BM_ThreadPoolEnqueue)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->ArgNames({"threads"})->UseRealTime();
+
+/**
+ * @brief Sum a large array with parallelFor on range(0) threads and grain range(1)
+ */
+static void BM_ThreadPoolParallelFor(benchmark::State& state) {
+    ThreadPool pool(static_cast<size_t>(state.range(0)));
+    size_t grain = static_cast<size_t>(state.range(1));
+    std::vector<float> values(PARALLEL_FOR_SIZE, 1.0f);
+    std::vector<double> partial(PARALLEL_FOR_SIZE / grain + 1, 0.0);
+
+    for (auto _ : state) {
+        (void)_;
+        pool.parallelFor(0, PARALLEL_FOR_SIZE, grain, [&](size_t first, size_t last) {
+            double sum = 0.0;
+            for (size_t i = first; i < last; ++i) {
+                sum += values[i];
+            }
+            partial[first / grain] = sum;
+        });
+        benchmark::DoNotOptimize(partial.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(PARALLEL_FOR_SIZE));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(PARALLEL_FOR_SIZE * sizeof(float)));
+}
+BENCHMARK(BM_ThreadPoolParallelFor)
+    ->ArgsProduct({{1, 4}, {1024, 16384}})
+    ->ArgNames({"threads", "grain"})
+    ->UseRealTime();
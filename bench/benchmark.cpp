@@ -0,0 +1,556 @@
+/**
+ * @file benchmark.cpp
+ * @brief Runner, reporters and entry point of the O3 benchmark suite.
+ */
+
+#include "benchmark.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <regex>
+#include <sstream>
+#include <thread>
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+namespace benchmark {
+
+namespace {
+
+const int64_t MAX_ITERATIONS = 1000000000;  // Upper bound for time based runs
+const double DEFAULT_MIN_TIME = 0.5;        // Seconds measured per instance
+
+/**
+ * @brief Options set by the --benchmark_* flags
+ */
+struct Options {
+    std::string filter;        // Regular expression selecting instances
+    double minTime;            // Seconds measured per instance
+    std::string format;        // Standard output format: console or json
+    std::string out;           // Report file
+    std::string outFormat;     // Report file format: console or json
+    bool listTests;            // Only print instance names
+    std::string executable;    // argv[0]
+
+    Options() : filter("."), minTime(DEFAULT_MIN_TIME), format("console"),
+                outFormat("json"), listTests(false) {}
+};
+
+/**
+ * @brief Measured result of one benchmark instance
+ */
+struct Result {
+    std::string name;          // Instance name
+    int64_t iterations;        // Iterations of the final run
+    double realTime;           // Wall time per iteration, in unit
+    double cpuTime;            // CPU time per iteration, in unit
+    TimeUnit unit;             // Reported time unit
+    double itemsPerSecond;     // 0 if not reported
+    double bytesPerSecond;     // 0 if not reported
+    std::string label;         // SetLabel text
+    bool failed;               // Whether SkipWithError was called
+    std::string error;         // SkipWithError message
+};
+
+Options& options() {
+    static Options instance;
+    return instance;
+}
+
+std::vector<std::unique_ptr<Benchmark>>& registry() {
+    static std::vector<std::unique_ptr<Benchmark>> benchmarks;
+    return benchmarks;
+}
+
+double unitMultiplier(TimeUnit unit) {
+    switch (unit) {
+        case kNanosecond: return 1e9;
+        case kMicrosecond: return 1e6;
+        case kMillisecond: return 1e3;
+        case kSecond: return 1.0;
+    }
+    return 1e9;
+}
+
+const char* unitName(TimeUnit unit) {
+    switch (unit) {
+        case kNanosecond: return "ns";
+        case kMicrosecond: return "us";
+        case kMillisecond: return "ms";
+        case kSecond: return "s";
+    }
+    return "ns";
+}
+
+std::string jsonEscape(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        switch (c) {
+            case '"': escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\t': escaped += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buffer[8];
+                    std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                    escaped += buffer;
+                } else {
+                    escaped += c;
+                }
+        }
+    }
+    return escaped;
+}
+
+std::string hostName() {
+#if defined(__unix__) || defined(__APPLE__)
+    char buffer[256] = {0};
+    if (gethostname(buffer, sizeof(buffer) - 1) == 0) {
+        return buffer;
+    }
+#endif
+    return "unknown";
+}
+
+std::string currentDate() {
+    std::time_t now = std::time(nullptr);
+    char buffer[64];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+    return buffer;
+}
+
+void writeJson(std::ostream& out, const std::vector<Result>& results) {
+    const Options& opts = options();
+
+    out << "{\n  \"context\": {\n"
+        << "    \"date\": \"" << jsonEscape(currentDate()) << "\",\n"
+        << "    \"host_name\": \"" << jsonEscape(hostName()) << "\",\n"
+        << "    \"executable\": \"" << jsonEscape(opts.executable) << "\",\n"
+        << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+#ifdef NDEBUG
+        << "    \"library_build_type\": \"release\"\n"
+#else
+        << "    \"library_build_type\": \"debug\"\n"
+#endif
+        << "  },\n  \"benchmarks\": [";
+
+    out << std::setprecision(10);
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& result = results[i];
+        out << (i ? ",\n" : "\n") << "    {\n"
+            << "      \"name\": \"" << jsonEscape(result.name) << "\",\n"
+            << "      \"run_name\": \"" << jsonEscape(result.name) << "\",\n"
+            << "      \"run_type\": \"iteration\",\n"
+            << "      \"repetitions\": 1,\n"
+            << "      \"repetition_index\": 0,\n"
+            << "      \"threads\": 1,\n";
+        if (result.failed) {
+            out << "      \"error_occurred\": true,\n"
+                << "      \"error_message\": \"" << jsonEscape(result.error) << "\"\n    }";
+            continue;
+        }
+        out << "      \"iterations\": " << result.iterations << ",\n"
+            << "      \"real_time\": " << result.realTime << ",\n"
+            << "      \"cpu_time\": " << result.cpuTime << ",\n"
+            << "      \"time_unit\": \"" << unitName(result.unit) << "\"";
+        if (result.itemsPerSecond > 0.0) {
+            out << ",\n      \"items_per_second\": " << result.itemsPerSecond;
+        }
+        if (result.bytesPerSecond > 0.0) {
+            out << ",\n      \"bytes_per_second\": " << result.bytesPerSecond;
+        }
+        if (!result.label.empty()) {
+            out << ",\n      \"label\": \"" << jsonEscape(result.label) << "\"";
+        }
+        out << "\n    }";
+    }
+    out << "\n  ]\n}\n";
+}
+
+std::string formatRate(double perSecond, const char* suffix) {
+    const char* prefixes[] = {"", "k", "M", "G", "T"};
+    size_t prefix = 0;
+    while (perSecond >= 1000.0 && prefix < 4) {
+        perSecond /= 1000.0;
+        ++prefix;
+    }
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(3) << perSecond << prefixes[prefix] << suffix;
+    return text.str();
+}
+
+void writeConsoleHeader(std::ostream& out, size_t nameWidth) {
+    out << std::left << std::setw(static_cast<int>(nameWidth)) << "Benchmark"
+        << std::right << std::setw(16) << "Time" << std::setw(16) << "CPU"
+        << std::setw(14) << "Iterations" << "  Counters\n"
+        << std::string(nameWidth + 46 + 10, '-') << "\n";
+}
+
+void writeConsoleResult(std::ostream& out, const Result& result, size_t nameWidth) {
+    out << std::left << std::setw(static_cast<int>(nameWidth)) << result.name << std::right;
+    if (result.failed) {
+        out << "  ERROR: " << result.error << "\n";
+        return;
+    }
+
+    std::ostringstream real;
+    std::ostringstream cpu;
+    real << std::fixed << std::setprecision(result.realTime < 10 ? 2 : 0)
+         << result.realTime << " " << unitName(result.unit);
+    cpu << std::fixed << std::setprecision(result.cpuTime < 10 ? 2 : 0)
+        << result.cpuTime << " " << unitName(result.unit);
+
+    out << std::setw(16) << real.str() << std::setw(16) << cpu.str()
+        << std::setw(14) << result.iterations;
+    if (result.itemsPerSecond > 0.0) {
+        out << "  items_per_second=" << formatRate(result.itemsPerSecond, "/s");
+    }
+    if (result.bytesPerSecond > 0.0) {
+        out << "  bytes_per_second=" << formatRate(result.bytesPerSecond, "B/s");
+    }
+    if (!result.label.empty()) {
+        out << "  " << result.label;
+    }
+    out << "\n";
+}
+
+bool parseFlag(const char* arg, const char* flag, std::string& value) {
+    size_t length = std::strlen(flag);
+    if (std::strncmp(arg, flag, length) != 0) {
+        return false;
+    }
+    if (arg[length] == '=') {
+        value = arg + length + 1;
+        return true;
+    }
+    if (arg[length] == '\0') {
+        value = "true";
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+// ============== State Implementation ==============
+
+State::State(int64_t maxIterations, const std::vector<int64_t>& args)
+    : maxIterations(maxIterations), remaining(maxIterations), args(args),
+      running(false), finished(false), failed(false),
+      itemsProcessed(0), bytesProcessed(0),
+      realSeconds(0.0), cpuSeconds(0.0), cpuStart(0) {
+}
+
+void State::PauseTiming() {
+    if (!running) return;
+
+    realSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - realStart).count();
+    cpuSeconds += static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    running = false;
+}
+
+void State::ResumeTiming() {
+    if (running || finished) return;
+
+    running = true;
+    cpuStart = std::clock();
+    realStart = std::chrono::steady_clock::now();
+}
+
+void State::SkipWithError(const std::string& message) {
+    failed = true;
+    error = message;
+    remaining = 0;
+}
+
+void State::StartKeepRunning() {
+    ResumeTiming();
+}
+
+void State::FinishKeepRunning() {
+    PauseTiming();
+    finished = true;
+}
+
+// ============== Benchmark Implementation ==============
+
+Benchmark::Benchmark(const std::string& name, Function function)
+    : name(name), function(function), rangeMultiplier(8), iterations(0),
+      minTime(0.0), unit(kNanosecond), useRealTime(false) {
+}
+
+Benchmark* Benchmark::Arg(int64_t value) {
+    instances.push_back(std::vector<int64_t>(1, value));
+    return this;
+}
+
+Benchmark* Benchmark::Args(const std::vector<int64_t>& values) {
+    instances.push_back(values);
+    return this;
+}
+
+Benchmark* Benchmark::Range(int64_t low, int64_t high) {
+    Arg(low);
+    for (int64_t value = 1; value < high; value *= rangeMultiplier) {
+        if (value > low) {
+            Arg(value);
+        }
+    }
+    if (high != low) {
+        Arg(high);
+    }
+    return this;
+}
+
+Benchmark* Benchmark::DenseRange(int64_t low, int64_t high, int64_t step) {
+    for (int64_t value = low; value <= high; value += step) {
+        Arg(value);
+    }
+    return this;
+}
+
+Benchmark* Benchmark::ArgsProduct(const std::vector<std::vector<int64_t>>& lists) {
+    std::vector<std::vector<int64_t>> product(1);
+    for (const auto& list : lists) {
+        std::vector<std::vector<int64_t>> extended;
+        for (const auto& prefix : product) {
+            for (int64_t value : list) {
+                extended.push_back(prefix);
+                extended.back().push_back(value);
+            }
+        }
+        product.swap(extended);
+    }
+    instances.insert(instances.end(), product.begin(), product.end());
+    return this;
+}
+
+Benchmark* Benchmark::RangeMultiplier(int multiplier) {
+    rangeMultiplier = std::max(2, multiplier);
+    return this;
+}
+
+Benchmark* Benchmark::ArgNames(const std::vector<std::string>& names) {
+    argNames = names;
+    return this;
+}
+
+Benchmark* Benchmark::Iterations(int64_t count) {
+    iterations = count;
+    return this;
+}
+
+Benchmark* Benchmark::MinTime(double seconds) {
+    minTime = seconds;
+    return this;
+}
+
+Benchmark* Benchmark::Unit(TimeUnit timeUnit) {
+    unit = timeUnit;
+    return this;
+}
+
+Benchmark* Benchmark::UseRealTime() {
+    useRealTime = true;
+    return this;
+}
+
+// ============== Runner Implementation ==============
+
+/**
+ * @brief Expands registered benchmarks into instances and measures them
+ */
+class Runner {
+public:
+    /**
+     * @brief Get the reported name of a benchmark instance
+     * @param benchmark The benchmark
+     * @param args Instance arguments
+     * @return Name such as "BM_Foo/neurons:1024/4"
+     */
+    static std::string instanceName(const Benchmark& benchmark, const std::vector<int64_t>& args) {
+        std::string name = benchmark.name;
+        for (size_t i = 0; i < args.size(); ++i) {
+            name += "/";
+            if (i < benchmark.argNames.size() && !benchmark.argNames[i].empty()) {
+                name += benchmark.argNames[i] + ":";
+            }
+            name += std::to_string(static_cast<long long>(args[i]));
+        }
+        return name;
+    }
+
+    /**
+     * @brief Get the argument sets of a benchmark
+     * @param benchmark The benchmark
+     * @return Its instances, or one empty set if it takes no arguments
+     */
+    static std::vector<std::vector<int64_t>> instancesOf(const Benchmark& benchmark) {
+        if (benchmark.instances.empty()) {
+            return std::vector<std::vector<int64_t>>(1);
+        }
+        return benchmark.instances;
+    }
+
+    /**
+     * @brief Measure one instance, growing the iteration count until the time target is met
+     * @param benchmark The benchmark
+     * @param args Instance arguments
+     * @return The result of the final run
+     */
+    static Result run(const Benchmark& benchmark, const std::vector<int64_t>& args) {
+        double minTime = benchmark.minTime > 0.0 ? benchmark.minTime : options().minTime;
+        int64_t iterations = benchmark.iterations > 0 ? benchmark.iterations : 1;
+
+        Result result;
+        result.name = instanceName(benchmark, args);
+        result.unit = benchmark.unit;
+
+        for (;;) {
+            State state(iterations, args);
+            benchmark.function(state);
+
+            double seconds = benchmark.useRealTime ? state.realSeconds : state.cpuSeconds;
+            bool done = state.failed || benchmark.iterations > 0 ||
+                        seconds >= minTime || iterations >= MAX_ITERATIONS;
+
+            if (done) {
+                double multiplier = unitMultiplier(benchmark.unit);
+                double rateSeconds = benchmark.useRealTime ? state.realSeconds : state.cpuSeconds;
+
+                result.iterations = iterations;
+                result.realTime = state.realSeconds * multiplier / static_cast<double>(iterations);
+                result.cpuTime = state.cpuSeconds * multiplier / static_cast<double>(iterations);
+                result.itemsPerSecond = rateSeconds > 0.0 ? state.itemsProcessed / rateSeconds : 0.0;
+                result.bytesPerSecond = rateSeconds > 0.0 ? state.bytesProcessed / rateSeconds : 0.0;
+                result.label = state.label;
+                result.failed = state.failed;
+                result.error = state.error;
+                return result;
+            }
+
+            // Aim past the target the way Google Benchmark does, growing at most tenfold
+            double scale = seconds > 0.0 ? minTime * 1.4 / seconds : 10.0;
+            if (seconds / minTime <= 0.1) {
+                scale = std::min(scale, 10.0);
+            }
+            int64_t next = static_cast<int64_t>(static_cast<double>(iterations) * scale + 0.5);
+            iterations = std::min(MAX_ITERATIONS, std::max(next, iterations + 1));
+        }
+    }
+};
+
+Benchmark* RegisterBenchmark(const char* name, Function function) {
+    registry().push_back(std::unique_ptr<Benchmark>(new Benchmark(name, function)));
+    return registry().back().get();
+}
+
+void Initialize(int* argc, char** argv) {
+    Options& opts = options();
+    opts.executable = *argc > 0 ? argv[0] : "";
+
+    int kept = 1;
+    for (int i = 1; i < *argc; ++i) {
+        std::string value;
+        if (parseFlag(argv[i], "--benchmark_filter", value)) {
+            opts.filter = value;
+        } else if (parseFlag(argv[i], "--benchmark_min_time", value)) {
+            // Accept both "0.5" and the newer "0.5s" spelling
+            opts.minTime = std::atof(value.c_str());
+        } else if (parseFlag(argv[i], "--benchmark_format", value)) {
+            opts.format = value;
+        } else if (parseFlag(argv[i], "--benchmark_out_format", value)) {
+            opts.outFormat = value;
+        } else if (parseFlag(argv[i], "--benchmark_out", value)) {
+            opts.out = value;
+        } else if (parseFlag(argv[i], "--benchmark_list_tests", value)) {
+            opts.listTests = value != "false" && value != "0";
+        } else {
+            argv[kept++] = argv[i];
+        }
+    }
+    *argc = kept;
+}
+
+size_t RunSpecifiedBenchmarks() {
+    const Options& opts = options();
+    std::regex filter(opts.filter);
+
+    // Expand all instances up front so the console columns line up
+    std::vector<std::pair<const Benchmark*, std::vector<int64_t>>> selected;
+    size_t nameWidth = 10;
+    for (const auto& benchmark : registry()) {
+        for (const auto& args : Runner::instancesOf(*benchmark)) {
+            std::string name = Runner::instanceName(*benchmark, args);
+            if (std::regex_search(name, filter)) {
+                selected.push_back(std::make_pair(benchmark.get(), args));
+                nameWidth = std::max(nameWidth, name.size() + 2);
+            }
+        }
+    }
+
+    if (opts.listTests) {
+        for (const auto& entry : selected) {
+            std::cout << Runner::instanceName(*entry.first, entry.second) << "\n";
+        }
+        return selected.size();
+    }
+
+    bool consoleOut = opts.format != "json";
+    if (consoleOut) {
+        writeConsoleHeader(std::cout, nameWidth);
+    }
+
+    std::vector<Result> results;
+    for (const auto& entry : selected) {
+        results.push_back(Runner::run(*entry.first, entry.second));
+        if (consoleOut) {
+            writeConsoleResult(std::cout, results.back(), nameWidth);
+            std::cout.flush();
+        }
+    }
+
+    if (!consoleOut) {
+        writeJson(std::cout, results);
+    }
+
+    if (!opts.out.empty()) {
+        std::ofstream file(opts.out.c_str());
+        if (!file) {
+            std::cerr << "Failed to open benchmark output file " << opts.out << std::endl;
+        } else if (opts.outFormat == "console") {
+            writeConsoleHeader(file, nameWidth);
+            for (const auto& result : results) {
+                writeConsoleResult(file, result, nameWidth);
+            }
+        } else {
+            writeJson(file, results);
+        }
+    }
+
+    return results.size();
+}
+
+} // namespace benchmark
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    if (argc > 1) {
+        std::cerr << "Unknown argument: " << argv[1] << "\n"
+                  << "Usage: " << argv[0] << " [--benchmark_filter=<regex>]"
+                  << " [--benchmark_min_time=<seconds>]"
+                  << " [--benchmark_format=console|json]"
+                  << " [--benchmark_out=<file>] [--benchmark_out_format=json|console]"
+                  << " [--benchmark_list_tests]" << std::endl;
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
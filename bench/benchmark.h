@@ -0,0 +1,327 @@
+/**
+ * @file benchmark.h
+ * @brief Minimal microbenchmark harness for the Ozone (O3) benchmarks.
+ *
+ * The API mirrors the subset of Google Benchmark used by the O3 suite
+ * (State, BENCHMARK, Arg/Args/Range, DoNotOptimize, the --benchmark_*
+ * flags and the JSON report format), so results can be compared with the
+ * usual Google Benchmark tooling and the suite can be moved onto the real
+ * library without touching the benchmarks themselves.
+ */
+
+#ifndef O3_BENCHMARK_H
+#define O3_BENCHMARK_H
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <vector>
+
+namespace benchmark {
+
+/**
+ * @brief Unit in which a benchmark reports its time
+ */
+enum TimeUnit {
+    kNanosecond,
+    kMicrosecond,
+    kMillisecond,
+    kSecond
+};
+
+/**
+ * @brief Running state handed to a benchmark function
+ *
+ * The function performs its setup, then loops with
+ * `for (auto _ : state)` or `while (state.KeepRunning())`; only the loop
+ * is timed.
+ */
+class State {
+public:
+    /**
+     * @brief Constructor for State
+     * @param maxIterations Number of loop iterations to run
+     * @param args Arguments of this benchmark instance
+     */
+    State(int64_t maxIterations, const std::vector<int64_t>& args);
+
+    /**
+     * @brief Advance the timed loop
+     * @return True while iterations remain
+     */
+    bool KeepRunning() {
+        if (remaining > 0) {
+            if (remaining == maxIterations) {
+                StartKeepRunning();
+            }
+            --remaining;
+            return true;
+        }
+        FinishKeepRunning();
+        return false;
+    }
+
+    /**
+     * @brief Get an argument of this benchmark instance
+     * @param index Argument position
+     * @return The argument value
+     */
+    int64_t range(size_t index = 0) const { return args[index]; }
+
+    /**
+     * @brief Stop the timers for untimed work inside the loop
+     */
+    void PauseTiming();
+
+    /**
+     * @brief Restart the timers after PauseTiming
+     */
+    void ResumeTiming();
+
+    /**
+     * @brief Report the number of items processed, for an items/s rate
+     * @param items Items processed over all iterations
+     */
+    void SetItemsProcessed(int64_t items) { itemsProcessed = items; }
+
+    /**
+     * @brief Report the number of bytes processed, for a bytes/s rate
+     * @param bytes Bytes processed over all iterations
+     */
+    void SetBytesProcessed(int64_t bytes) { bytesProcessed = bytes; }
+
+    /**
+     * @brief Attach a label to the result
+     * @param text The label
+     */
+    void SetLabel(const std::string& text) { label = text; }
+
+    /**
+     * @brief Abort the benchmark with an error
+     * @param message Reason reported in place of a result
+     */
+    void SkipWithError(const std::string& message);
+
+    /**
+     * @brief Get the number of iterations this run performs
+     * @return Iteration count
+     */
+    int64_t iterations() const { return maxIterations; }
+
+    /**
+     * @brief Iterator driving the range-based timed loop
+     */
+    class Iterator {
+    public:
+        explicit Iterator(State* state) : state(state) {}
+        bool operator!=(const Iterator&) { return state && state->KeepRunning(); }
+        Iterator& operator++() { return *this; }
+        int operator*() const { return 0; }
+
+    private:
+        State* state;  // Running state, or nullptr for the end iterator
+    };
+
+    Iterator begin() { return Iterator(this); }
+    Iterator end() { return Iterator(nullptr); }
+
+private:
+    friend class Runner;
+
+    /**
+     * @brief Start the timers when the loop begins
+     */
+    void StartKeepRunning();
+
+    /**
+     * @brief Stop the timers when the loop ends
+     */
+    void FinishKeepRunning();
+
+    int64_t maxIterations;            // Iterations requested
+    int64_t remaining;                // Iterations left
+    std::vector<int64_t> args;        // Instance arguments
+    bool running;                     // Whether the timers are running
+    bool finished;                    // Whether the loop has ended
+    bool failed;                      // Whether SkipWithError was called
+    std::string error;                // SkipWithError message
+    std::string label;                // Result label
+    int64_t itemsProcessed;           // Reported by SetItemsProcessed
+    int64_t bytesProcessed;           // Reported by SetBytesProcessed
+    double realSeconds;               // Accumulated wall time
+    double cpuSeconds;                // Accumulated process CPU time
+    std::chrono::steady_clock::time_point realStart;  // Wall time of the last start
+    std::clock_t cpuStart;                            // CPU time of the last start
+};
+
+typedef void (*Function)(State&);
+
+/**
+ * @brief A registered benchmark and its argument sets
+ */
+class Benchmark {
+public:
+    /**
+     * @brief Constructor for Benchmark
+     * @param name Benchmark name
+     * @param function Benchmark function
+     */
+    Benchmark(const std::string& name, Function function);
+
+    /**
+     * @brief Add an instance with one argument
+     * @param value The argument
+     * @return This benchmark
+     */
+    Benchmark* Arg(int64_t value);
+
+    /**
+     * @brief Add an instance with several arguments
+     * @param values The arguments
+     * @return This benchmark
+     */
+    Benchmark* Args(const std::vector<int64_t>& values);
+
+    /**
+     * @brief Add instances for powers of the range multiplier within [low, high]
+     * @param low First argument
+     * @param high Last argument
+     * @return This benchmark
+     */
+    Benchmark* Range(int64_t low, int64_t high);
+
+    /**
+     * @brief Add instances for every step within [low, high]
+     * @param low First argument
+     * @param high Last argument
+     * @param step Increment
+     * @return This benchmark
+     */
+    Benchmark* DenseRange(int64_t low, int64_t high, int64_t step = 1);
+
+    /**
+     * @brief Add instances for the cartesian product of argument lists
+     * @param lists One list of values per argument
+     * @return This benchmark
+     */
+    Benchmark* ArgsProduct(const std::vector<std::vector<int64_t>>& lists);
+
+    /**
+     * @brief Set the factor between arguments generated by Range
+     * @param multiplier The factor (default 8)
+     * @return This benchmark
+     */
+    Benchmark* RangeMultiplier(int multiplier);
+
+    /**
+     * @brief Name the arguments in reported instance names
+     * @param names One name per argument
+     * @return This benchmark
+     */
+    Benchmark* ArgNames(const std::vector<std::string>& names);
+
+    /**
+     * @brief Run a fixed number of iterations instead of a time target
+     * @param count Iterations per run
+     * @return This benchmark
+     */
+    Benchmark* Iterations(int64_t count);
+
+    /**
+     * @brief Set the minimum measured time per instance
+     * @param seconds Time target
+     * @return This benchmark
+     */
+    Benchmark* MinTime(double seconds);
+
+    /**
+     * @brief Set the reported time unit
+     * @param unit The unit
+     * @return This benchmark
+     */
+    Benchmark* Unit(TimeUnit unit);
+
+    /**
+     * @brief Use wall time rather than CPU time to size the runs
+     * @return This benchmark
+     */
+    Benchmark* UseRealTime();
+
+private:
+    friend class Runner;
+
+    std::string name;                          // Benchmark name
+    Function function;                         // Benchmark function
+    std::vector<std::vector<int64_t>> instances;  // Argument sets
+    std::vector<std::string> argNames;         // Argument names for reporting
+    int rangeMultiplier;                       // Factor used by Range
+    int64_t iterations;                        // Fixed iterations (0 = time based)
+    double minTime;                            // Time target (0 = command line default)
+    TimeUnit unit;                             // Reported time unit
+    bool useRealTime;                          // Size runs by wall time
+};
+
+/**
+ * @brief Register a benchmark function
+ * @param name Benchmark name
+ * @param function Benchmark function
+ * @return The registered benchmark, for chaining options
+ */
+Benchmark* RegisterBenchmark(const char* name, Function function);
+
+/**
+ * @brief Parse the --benchmark_* flags, removing them from argv
+ * @param argc Argument count (updated)
+ * @param argv Argument vector (updated)
+ */
+void Initialize(int* argc, char** argv);
+
+/**
+ * @brief Run every registered benchmark matching the filter
+ * @return Number of benchmark instances run
+ */
+size_t RunSpecifiedBenchmarks();
+
+/**
+ * @brief Keep the compiler from discarding a value
+ * @param value The value
+ */
+template<typename T>
+inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    const volatile T* sink = &value;
+    (void)sink;
+#endif
+}
+
+/**
+ * @brief Keep the compiler from reordering memory accesses across this point
+ */
+inline void ClobberMemory() {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : : "memory");
+#endif
+}
+
+} // namespace benchmark
+
+#if defined(__GNUC__) || defined(__clang__)
+#define BENCHMARK_UNUSED __attribute__((unused))
+#else
+#define BENCHMARK_UNUSED
+#endif
+
+#define BENCHMARK_CONCAT2(a, b) a##b
+#define BENCHMARK_CONCAT(a, b) BENCHMARK_CONCAT2(a, b)
+
+/**
+ * @brief Register a benchmark function at static initialization
+ */
+#define BENCHMARK(function)                                             \
+    static ::benchmark::Benchmark* BENCHMARK_CONCAT(benchmark_, __LINE__) \
+        BENCHMARK_UNUSED = ::benchmark::RegisterBenchmark(#function, function)
+
+#endif // O3_BENCHMARK_H
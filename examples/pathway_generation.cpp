@@ -112,7 +112,7 @@ int pathwayGenerationMain() {
             if (currentWeight > 0.0f) {
                 // Strengthen existing connection (Hebbian learning)
                 float newWeight = std::min(1.0f, currentWeight + 0.1f);
-                neuron->updateConnectionWeight(emotion, newWeight);
+                neuron->setConnectionWeight(emotion, newWeight);
                 
                 std::cout << "Strengthened connection from " << neuron->getId() 
                           << " to " << emotion->getId() 
@@ -153,7 +153,7 @@ int pathwayGenerationMain() {
             if (currentWeight > 0.0f) {
                 // Strengthen existing connection (Hebbian learning)
                 float newWeight = std::min(1.0f, currentWeight + 0.15f);  // Tones form stronger associations
-                neuron->updateConnectionWeight(emotion, newWeight);
+                neuron->setConnectionWeight(emotion, newWeight);
                 
                 std::cout << "Strengthened connection from " << neuron->getId() 
                           << " to " << emotion->getId() 
@@ -219,19 +219,21 @@ int pathwayGenerationMain() {
     std::cout << "Scenario 1: Visual input (light) + happiness" << std::endl;
     
     // Activate visual sensor with light stimulus
-    auto lightSignal = std::make_shared<Synapse>("light_signal");
+    auto lightSignal = Synapse::create("light_signal");
     lightSignal->setData("type", std::string("light"));
     lightSignal->setData("intensity", std::string("high"));
     lightSignal->setStrength(0.9f);
     visualSensor->receiveSignal(lightSignal);
     
     // Directly activate happy emotion (as if from some other input)
-    auto happySignal = std::make_shared<Synapse>("happy_signal");
+    auto happySignal = Synapse::create("happy_signal");
     happySignal->setStrength(0.8f);
     happyEmotion->receiveSignal(happySignal);
     
     // Process signals
-    network.processSignals();
+    for (int tick = 0; tick < 4; ++tick) {
+        network.processSignals();  // Signals advance one hop per tick
+    }
     std::this_thread::sleep_for(std::chrono::milliseconds(200));
     
     // Scenario 2: Auditory input (tone) + fear
@@ -243,19 +245,21 @@ int pathwayGenerationMain() {
     happyEmotion->setState(Neuron::NeuronState::RESTING);
     
     // Activate auditory sensor with tone stimulus
-    auto toneSignal = std::make_shared<Synapse>("tone_signal");
+    auto toneSignal = Synapse::create("tone_signal");
     toneSignal->setData("type", std::string("tone"));
     toneSignal->setData("frequency", std::string("high"));
     toneSignal->setStrength(0.85f);
     auditorySensor->receiveSignal(toneSignal);
     
     // Directly activate fear emotion
-    auto fearSignal = std::make_shared<Synapse>("fear_signal");
+    auto fearSignal = Synapse::create("fear_signal");
     fearSignal->setStrength(0.9f);
     fearEmotion->receiveSignal(fearSignal);
     
     // Process signals
-    network.processSignals();
+    for (int tick = 0; tick < 4; ++tick) {
+        network.processSignals();  // Signals advance one hop per tick
+    }
     std::this_thread::sleep_for(std::chrono::milliseconds(200));
     
     // Scenario 3: Visual + auditory + anger (multimodal association)
@@ -272,17 +276,19 @@ int pathwayGenerationMain() {
     auditorySensor->receiveSignal(toneSignal);
     
     // Activate anger emotion
-    auto angerSignal = std::make_shared<Synapse>("anger_signal");
+    auto angerSignal = Synapse::create("anger_signal");
     angerSignal->setStrength(0.75f);
     angryEmotion->receiveSignal(angerSignal);
     
     // Boost attention for multimodal learning
-    auto attentionSignal = std::make_shared<Synapse>("attention_signal");
+    auto attentionSignal = Synapse::create("attention_signal");
     attentionSignal->setStrength(0.8f);
     attentionRegulator->receiveSignal(attentionSignal);
     
     // Process signals
-    network.processSignals();
+    for (int tick = 0; tick < 4; ++tick) {
+        network.processSignals();  // Signals advance one hop per tick
+    }
     std::this_thread::sleep_for(std::chrono::milliseconds(200));
     
     // Show network after learning
@@ -302,7 +308,9 @@ int pathwayGenerationMain() {
     visualSensor->receiveSignal(lightSignal);
     
     // Process and observe results
-    network.processSignals();
+    for (int tick = 0; tick < 4; ++tick) {
+        network.processSignals();  // Signals advance one hop per tick
+    }
     std::this_thread::sleep_for(std::chrono::milliseconds(200));
     
     // Check if happy emotion activated
@@ -320,7 +328,9 @@ int pathwayGenerationMain() {
     auditorySensor->receiveSignal(toneSignal);
     
     // Process and observe results
-    network.processSignals();
+    for (int tick = 0; tick < 4; ++tick) {
+        network.processSignals();  // Signals advance one hop per tick
+    }
     std::this_thread::sleep_for(std::chrono::milliseconds(200));
     
     // Check if fear emotion activated
@@ -35,7 +35,7 @@ public:
      */
     void receiveInput(float inputValue) {
         // Create a synapse with the sensory data
-        auto signal = std::make_shared<Synapse>("sensor_signal");
+        auto signal = Synapse::create("sensor_signal");
         signal->setData("sensor_type", sensorType);
         signal->setData("value", std::to_string(inputValue));
         signal->setStrength(inputValue);
@@ -223,7 +223,9 @@ int simpleNetworkMain() {
     touchSensor.receiveInput(0.1f);
     
     // Process signals
-    network.processSignals();
+    for (int tick = 0; tick < 4; ++tick) {
+        network.processSignals();  // Signals advance one hop per tick
+    }
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
     
     std::cout << "Process results:" << std::endl;
@@ -237,7 +239,9 @@ int simpleNetworkMain() {
     touchSensor.receiveInput(0.9f);  // High touch should trigger reflex
     
     // Process signals
-    network.processSignals();
+    for (int tick = 0; tick < 4; ++tick) {
+        network.processSignals();  // Signals advance one hop per tick
+    }
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
     
     std::cout << "Process results:" << std::endl;
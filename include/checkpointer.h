@@ -0,0 +1,135 @@
+/**
+ * @file checkpointer.h
+ * @brief Periodic incremental checkpoints of a running network.
+ *
+ * Saving a full snapshot of a large network on every checkpoint costs time
+ * proportional to the whole network, even when a tick only moved a few
+ * potentials and weights. The checkpointer instead writes a full snapshot
+ * (the base) once and then deltas holding only the neuron state and edge
+ * rows that changed since the previous checkpoint, as tracked by the
+ * simulation core. A structural change (neurons, connections, tags,
+ * metadata, gates, layers or tier extras) starts a new base.
+ *
+ * Capturing happens on the thread that calls checkpoint(), or inside the
+ * tick that triggers an automatic checkpoint, under the network lock;
+ * writing the files happens on a background thread. A delta only copies
+ * the changed state, but a base copies the state of every neuron and
+ * every edge, so the tick that captures a base stalls for time
+ * proportional to the whole network. setBaseInterval() bounds how often
+ * that happens; structural changes force it sooner. A manifest in the
+ * directory lists the current base and its deltas; it is replaced
+ * atomically after every file, so a crash leaves either the old or the new
+ * chain, never a half-written one.
+ */
+
+#ifndef CHECKPOINTER_H
+#define CHECKPOINTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "network.h"
+
+/**
+ * @brief Writes base snapshots and deltas of a network into a directory
+ */
+class Checkpointer {
+public:
+    /**
+     * @brief Constructor for Checkpointer
+     *
+     * Numbering continues after the checkpoints already listed in the
+     * directory's manifest, whose files are replaced once the first base
+     * of this checkpointer is written.
+     *
+     * @param network The network to checkpoint; must outlive the checkpointer
+     * @param directory Existing directory for the checkpoint files
+     * @param interval Ticks between automatic checkpoints (0 to checkpoint only on request)
+     */
+    Checkpointer(Network& network, const std::string& directory, size_t interval = 0);
+
+    /**
+     * @brief Destructor for Checkpointer, finishing the pending write
+     *
+     * Stops automatic checkpoints; must not run during a tick of the network.
+     */
+    ~Checkpointer();
+
+    Checkpointer(const Checkpointer&) = delete;
+    Checkpointer& operator=(const Checkpointer&) = delete;
+
+    /**
+     * @brief Capture a checkpoint now and queue it for writing
+     *
+     * Waits for the previous checkpoint to be written first. Automatic
+     * checkpoints taken after a tick never wait: they are skipped while the
+     * writer is busy, and the changes stay tracked for the next one.
+     *
+     * @return True if a checkpoint was captured
+     */
+    bool checkpoint();
+
+    /**
+     * @brief Wait until the queued checkpoint is written
+     * @return True if every write so far succeeded
+     */
+    bool flush();
+
+    /**
+     * @brief Set the number of ticks between automatic checkpoints
+     * @param ticks Interval in ticks (0 to disable)
+     */
+    void setInterval(size_t ticks);
+
+    /**
+     * @brief Get the number of ticks between automatic checkpoints
+     * @return Interval in ticks
+     */
+    size_t getInterval() const;
+
+    /**
+     * @brief Set how many deltas may follow a base before a new base is written
+     *
+     * Each base stalls the capturing tick for a full copy of the network,
+     * so a larger interval trades restore time for fewer stalls.
+     *
+     * @param deltas Maximum chain length (0 to write only bases)
+     */
+    void setBaseInterval(size_t deltas);
+
+    /**
+     * @brief Get how many deltas may follow a base
+     * @return Maximum chain length
+     */
+    size_t getBaseInterval() const;
+
+    /**
+     * @brief Get the sequence number of the last captured checkpoint
+     * @return Sequence number (0 before the first checkpoint)
+     */
+    uint64_t getSequence() const;
+
+    /**
+     * @brief Get the reason the last failed write failed
+     * @return Error description, empty if no write failed
+     */
+    std::string getError() const;
+
+    /**
+     * @brief Restore the network recorded in a checkpoint directory
+     * @param directory Directory written by a checkpointer
+     * @param error Receives a description of the failure, if not null
+     * @return The network as of the last checkpoint, or null on failure
+     */
+    static std::shared_ptr<Network> restore(const std::string& directory, std::string* error = nullptr);
+
+private:
+    struct State;
+
+    Network& network;               // Network being checkpointed
+    std::shared_ptr<State> state;   // Shared with the writer thread and the tick callback
+    size_t callbackHandle;          // Tick callback registered on the network
+};
+
+#endif // CHECKPOINTER_H
@@ -0,0 +1,163 @@
+/**
+ * @file delivery_queue.h
+ * @brief Tick-based delivery queue for signals travelling between neurons.
+ *
+ * Signals fired during tick N are not handed to their targets right away.
+ * They are placed in a timing wheel and delivered at the start of tick
+ * N + delay, where the delay comes from the connection (one tick by
+ * default). Each delay slot is a ring buffer with a bounded capacity, so a
+ * runaway network cannot grow the queue without limit; signals that do not
+ * fit are dropped and counted.
+ */
+
+#ifndef DELIVERY_QUEUE_H
+#define DELIVERY_QUEUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "synapse.h"
+
+/**
+ * @brief Timing wheel of bounded ring buffers, one per delay slot
+ */
+class DeliveryQueue {
+public:
+    /**
+     * @brief A signal waiting to be delivered
+     */
+    struct Event {
+        uint32_t target;                  // Index of the receiving neuron
+        uint32_t generation;              // Slot generation the event was addressed to
+        SynapsePtr signal;  // The signal to deliver
+    };
+
+    /**
+     * @brief Longest delay a queue supports, the largest delay an edge can store
+     */
+    static const uint32_t DELAY_LIMIT = UINT16_MAX;
+
+    /**
+     * @brief Constructor for DeliveryQueue
+     * @param maxDelay Longest supported delay in ticks (clamped to 1..DELAY_LIMIT)
+     * @param slotCapacity Maximum number of events per delay slot
+     */
+    DeliveryQueue(uint32_t maxDelay = 16, size_t slotCapacity = 1u << 20);
+
+    /**
+     * @brief Queue a signal for delivery
+     * @param target Index of the receiving neuron
+     * @param generation Generation of the receiving slot
+     * @param signal The signal to deliver
+     * @param delay Ticks until delivery (clamped to 1..maxDelay)
+     * @return True if queued, false if the slot was full and the signal dropped
+     */
+    bool schedule(uint32_t target, uint32_t generation, SynapsePtr signal, uint32_t delay);
+
+    /**
+     * @brief Deliver every event due in the current tick, in scheduling order
+     * @param deliver Function called for each due event
+     */
+    template<typename Deliver>
+    void drain(Deliver deliver) {
+        Ring& due = slots[tick % slots.size()];
+        Event event;
+        while (due.pop(event)) {
+            --pending;
+            deliver(event);
+        }
+    }
+
+    /**
+     * @brief Move on to the next tick
+     */
+    void advance();
+
+    /**
+     * @brief Discard every pending event and continue at another tick
+     * @param tick The new current tick
+     */
+    void restart(uint64_t tick) { clear(); this->tick = tick; }
+
+    /**
+     * @brief Get the current tick number
+     * @return Number of ticks advanced so far
+     */
+    uint64_t getTick() const { return tick; }
+
+    /**
+     * @brief Change the longest supported delay; queued events are kept
+     * @param maxDelay Longest supported delay in ticks (clamped to 1..DELAY_LIMIT)
+     */
+    void setMaxDelay(uint32_t maxDelay);
+
+    /**
+     * @brief Get the longest supported delay
+     * @return Maximum delay in ticks
+     */
+    uint32_t getMaxDelay() const { return static_cast<uint32_t>(slots.size() - 1); }
+
+    /**
+     * @brief Change the maximum number of events per delay slot
+     * @param slotCapacity New capacity; applies to future scheduling
+     */
+    void setSlotCapacity(size_t slotCapacity) { capacity = slotCapacity; }
+
+    /**
+     * @brief Get the maximum number of events per delay slot
+     * @return Slot capacity
+     */
+    size_t getSlotCapacity() const { return capacity; }
+
+    /**
+     * @brief Get the number of events waiting for delivery
+     * @return Pending event count
+     */
+    size_t pendingCount() const { return pending; }
+
+    /**
+     * @brief Get the number of events dropped because a slot was full
+     * @return Dropped event count
+     */
+    uint64_t droppedCount() const { return dropped; }
+
+    /**
+     * @brief Visit every pending event
+     * @param visit Function receiving the event and the ticks until it is due
+     */
+    void forEachPending(const std::function<void(const Event&, uint32_t)>& visit) const;
+
+    /**
+     * @brief Discard every pending event
+     */
+    void clear();
+
+private:
+    /**
+     * @brief FIFO ring buffer that grows on demand up to the slot capacity
+     */
+    class Ring {
+    public:
+        Ring() : head(0), count(0) {}
+        bool push(Event&& event, size_t limit);
+        bool pop(Event& event);
+        size_t size() const { return count; }
+        const Event& at(size_t i) const { return buffer[(head + i) % buffer.size()]; }
+        void clear();
+
+    private:
+        std::vector<Event> buffer;
+        size_t head;
+        size_t count;
+    };
+
+    std::vector<Ring> slots;  // One ring per tick of delay, indexed by due tick
+    uint64_t tick;            // Current tick
+    size_t capacity;          // Maximum events per slot
+    size_t pending;           // Events waiting in all slots
+    uint64_t dropped;         // Events rejected because a slot was full
+};
+
+#endif // DELIVERY_QUEUE_H
@@ -0,0 +1,268 @@
+/**
+ * @file edge_store.h
+ * @brief Compressed-sparse-row storage for connections between neurons.
+ *
+ * The edge store keeps every connection of a simulation core in flat
+ * arrays: per-neuron row offsets plus parallel target-index and weight
+ * arrays. Outgoing rows carry weights; a mirrored set of incoming rows
+ * records the sources of each neuron. Every outgoing edge also carries a
+ * delivery delay in ticks. Rows are kept with a little slack so
+ * that topology can still change at runtime; freezing the store packs the
+ * rows back to back and rejects structural changes, which turns fan-out on
+ * static topologies into a single linear scan.
+ */
+
+#ifndef EDGE_STORE_H
+#define EDGE_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief CSR adjacency of a simulation core
+ */
+class EdgeStore {
+public:
+    /**
+     * @brief Marker returned when an edge does not exist
+     */
+    static const uint32_t NOT_FOUND = 0xFFFFFFFFu;
+
+    /**
+     * @brief Constructor for EdgeStore
+     */
+    EdgeStore();
+
+    /**
+     * @brief Make sure rows exist for a number of neurons
+     * @param neuronCount Number of neuron slots that need rows
+     */
+    void resize(uint32_t neuronCount);
+
+    /**
+     * @brief Reserve storage for a number of edges
+     * @param edgeCount Number of edges to reserve room for
+     */
+    void reserve(size_t edgeCount);
+
+    /**
+     * @brief Add an edge or update the weight of an existing one
+     * @param source Index of the source neuron
+     * @param target Index of the target neuron
+     * @param weight Connection weight
+     * @return True if the edge exists with the given weight afterwards
+     */
+    bool connect(uint32_t source, uint32_t target, float weight);
+
+    /**
+     * @brief An edge to add with connectBatch
+     */
+    struct BatchEdge {
+        uint32_t source;  // Index of the source neuron
+        uint32_t target;  // Index of the target neuron
+        float weight;     // Connection weight
+        uint16_t delay;   // Delay in ticks (at least 1)
+    };
+    
+    /**
+     * @brief Add or update many edges at once
+     * 
+     * The result is the same as calling connect() and then setDelay() for
+     * each edge in order: rows keep insertion order, and an edge given more
+     * than once keeps its first position and its last weight and delay.
+     * Every row grows at most once, and rows of new neurons are laid out
+     * back to back.
+     * 
+     * @param batch The edges
+     * @return Number of edges added (existing edges are only updated)
+     */
+    size_t connectBatch(const std::vector<BatchEdge>& batch);
+    
+    /**
+     * @brief Replace the whole store with packed rows
+     * 
+     * Row i of each direction holds the entries [start[i], start[i + 1]) of
+     * the arrays; the arrays are copied in one block each.
+     * 
+     * @param neuronCount Number of rows
+     * @param outStart Row starts of the outgoing rows (neuronCount + 1 entries)
+     * @param outTargets Targets of the outgoing rows
+     * @param outWeights Weights of the outgoing rows
+     * @param outDelays Delays of the outgoing rows
+     * @param inStart Row starts of the incoming rows (neuronCount + 1 entries)
+     * @param inSources Sources of the incoming rows
+     */
+    void assign(uint32_t neuronCount,
+                const uint64_t* outStart, const uint32_t* outTargets,
+                const float* outWeights, const uint16_t* outDelays,
+                const uint64_t* inStart, const uint32_t* inSources);
+    
+    /**
+     * @brief Remove an edge
+     * @param source Index of the source neuron
+     * @param target Index of the target neuron
+     * @return True if the edge existed and was removed
+     */
+    bool disconnect(uint32_t source, uint32_t target);
+
+    /**
+     * @brief Remove every edge that starts or ends at a neuron
+     * @param neuron Index of the neuron
+     */
+    void removeNeuron(uint32_t neuron);
+
+    /**
+     * @brief Remove all edges
+     */
+    void clear();
+
+    /**
+     * @brief Find the position of an edge within its source row
+     * @param source Index of the source neuron
+     * @param target Index of the target neuron
+     * @return Position in the row or NOT_FOUND
+     */
+    uint32_t find(uint32_t source, uint32_t target) const;
+
+    /**
+     * @brief Get the weight of an edge
+     * @param source Index of the source neuron
+     * @param target Index of the target neuron
+     * @return The weight or 0 if the edge does not exist
+     */
+    float getWeight(uint32_t source, uint32_t target) const;
+
+    /**
+     * @brief Set the weight of an existing edge (allowed while frozen)
+     * @param source Index of the source neuron
+     * @param target Index of the target neuron
+     * @param weight New connection weight
+     * @return True if the edge exists and was updated
+     */
+    bool setWeight(uint32_t source, uint32_t target, float weight);
+
+    /**
+     * @brief Get the delivery delay of an edge
+     * @param source Index of the source neuron
+     * @param target Index of the target neuron
+     * @return The delay in ticks or 0 if the edge does not exist
+     */
+    uint16_t getDelay(uint32_t source, uint32_t target) const;
+
+    /**
+     * @brief Set the delivery delay of an existing edge (allowed while frozen)
+     * @param source Index of the source neuron
+     * @param target Index of the target neuron
+     * @param delay Delay in ticks (at least 1)
+     * @return True if the edge exists and was updated
+     */
+    bool setDelay(uint32_t source, uint32_t target, uint16_t delay);
+
+    // Outgoing row access
+    uint32_t outDegree(uint32_t source) const { return out.counts[source]; }
+    const uint32_t* outTargets(uint32_t source) const { return out.columns.data() + out.offsets[source]; }
+    const float* outWeights(uint32_t source) const { return out.values.data() + out.offsets[source]; }
+    float* outWeights(uint32_t source) { return out.values.data() + out.offsets[source]; }
+    const uint16_t* outDelays(uint32_t source) const { return out.delays.data() + out.offsets[source]; }
+    uint16_t* outDelays(uint32_t source) { return out.delays.data() + out.offsets[source]; }
+
+    // Incoming row access
+    uint32_t inDegree(uint32_t target) const { return in.counts[target]; }
+    const uint32_t* inSources(uint32_t target) const { return in.columns.data() + in.offsets[target]; }
+
+    /**
+     * @brief Get the total number of edges
+     * @return Edge count
+     */
+    size_t edgeCount() const { return edges; }
+
+    /**
+     * @brief Pack all rows back to back in neuron order
+     */
+    void compact();
+
+    /**
+     * @brief Pack the store and reject structural changes until thawed
+     */
+    void freeze();
+
+    /**
+     * @brief Allow structural changes again after a freeze
+     */
+    void thaw();
+
+    /**
+     * @brief Check whether the topology is frozen
+     * @return True if structural changes are rejected
+     */
+    bool isFrozen() const { return frozen; }
+
+    /**
+     * @brief Assign every neuron a level in the condensation of the graph
+     *
+     * Strongly connected components are collapsed into single nodes and
+     * each component gets the length of the longest path that reaches it
+     * from a component without incoming edges. An edge between two
+     * components therefore always leads to a higher level, while the
+     * neurons of a cycle share one level.
+     *
+     * @param levels Receives the level of each row
+     * @return Number of levels
+     */
+    uint32_t levelize(std::vector<uint32_t>& levels) const;
+
+    /**
+     * @brief Check whether weights or delays of a row changed since clearChanges()
+     * 
+     * Updates through setWeight, setDelay, connect and connectBatch are
+     * tracked; writes through the mutable row pointers are not.
+     * 
+     * @param source Index of the source neuron
+     * @return True if the row changed
+     */
+    bool isRowChanged(uint32_t source) const { return changedRows[source] != 0; }
+
+    /**
+     * @brief Forget which rows changed
+     */
+    void clearChanges();
+
+    /**
+     * @brief Get a counter bumped on every edge addition or removal
+     * @return Structure revision
+     */
+    uint64_t getStructureRevision() const { return structureRevision; }
+
+private:
+    /**
+     * @brief One direction of the adjacency in slack-CSR form
+     */
+    struct Rows {
+        std::vector<uint32_t> offsets;     // Start of each row in columns
+        std::vector<uint32_t> counts;      // Used entries per row
+        std::vector<uint32_t> capacities;  // Reserved entries per row
+        std::vector<uint32_t> columns;     // Neighbour indices
+        std::vector<float> values;         // Weights (outgoing rows only)
+        std::vector<uint16_t> delays;      // Delays in ticks (outgoing rows only)
+        bool weighted;                     // Whether values and delays are maintained
+
+        void append(uint32_t row, uint32_t column, float value, uint16_t delay, size_t liveEntries);
+        void reserveRow(uint32_t row, uint32_t extra);
+        void push(uint32_t row, uint32_t column, float value, uint16_t delay);
+        void compactIfSparse(size_t liveEntries);
+        void erase(uint32_t row, uint32_t position);
+        uint32_t find(uint32_t row, uint32_t column) const;
+        void compact();
+    };
+
+    Rows out;       // Outgoing edges with weights
+    Rows in;        // Incoming edges (sources only)
+    size_t edges;   // Number of live edges
+    bool frozen;    // Whether structural changes are rejected
+    
+    std::vector<uint8_t> changedRows;  // Per source row: weights or delays changed
+    uint64_t structureRevision;        // Bumped when edges are added or removed
+};
+
+#endif // EDGE_STORE_H
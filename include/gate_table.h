@@ -0,0 +1,174 @@
+/**
+ * @file gate_table.h
+ * @brief Structure-of-arrays storage for gate parameters.
+ *
+ * Gate objects are handles: the threshold, adaptation rate, modulation
+ * factor and active flag of every gate live in one column per parameter
+ * of a GateTable, the same way neuron state lives in a SimulationCore.
+ * Each simulation core owns a table for the gates of its neurons, so the
+ * gates of a whole network can be adapted from a learning signal in a
+ * single pass over contiguous memory. Gates created on their own start
+ * in a private table and move into the core's table when they are added
+ * to a neuron, and along with their neuron when it changes cores.
+ *
+ * The bulk adaptation runs vectorized (AVX-512, AVX2 or NEON, following
+ * the variant selected by IntegrationKernel) and, given a thread pool, in
+ * parallel chunks. Every variant produces the same thresholds as calling
+ * NeuronGate::adapt() on each gate.
+ */
+
+#ifndef GATE_TABLE_H
+#define GATE_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Forward declarations
+class NeuronGate;
+class ThreadPool;
+
+/**
+ * @brief Columnar parameters of a set of gates
+ */
+class GateTable : public std::enable_shared_from_this<GateTable> {
+public:
+    /**
+     * @brief Marker for a gate that belongs to no neuron
+     */
+    static const uint32_t NO_NEURON = UINT32_MAX;
+
+    /**
+     * @brief Default number of gates per parallel chunk in adaptAll()
+     */
+    static const size_t DEFAULT_GRAIN = 16384;
+
+    /**
+     * @brief Adapt one threshold, as NeuronGate::adapt() does
+     * @param threshold Current threshold
+     * @param rate Adaptation rate
+     * @param success Whether the gate's operation was successful
+     * @return Threshold lowered by rate (not below 0.1) on success, raised (not above 0.9) otherwise
+     */
+    static float adaptThreshold(float threshold, float rate, bool success) {
+        float lowered = threshold - rate;
+        float raised = threshold + rate;
+        return success ? (lowered > 0.1f ? lowered : 0.1f) : (raised < 0.9f ? raised : 0.9f);
+    }
+
+    /**
+     * @brief Constructor for an empty table
+     */
+    GateTable();
+
+    /**
+     * @brief Move a gate's parameters into this table
+     * @param gate The gate; its slot in the previous table is released
+     * @param neuron Slot of the owning neuron in its core, or NO_NEURON
+     */
+    void transfer(NeuronGate& gate, uint32_t neuron = NO_NEURON);
+
+    /**
+     * @brief Get the number of slots (including released ones)
+     * @return Upper bound of valid slots; adaptAll() expects this many entries
+     */
+    uint32_t capacity() const { return static_cast<uint32_t>(handles.size()); }
+
+    /**
+     * @brief Get the number of gates in the table
+     * @return Count of occupied slots
+     */
+    size_t size() const { return handles.size() - freeSlots.size(); }
+
+    /**
+     * @brief Get the gate stored in a slot
+     * @param slot Slot index
+     * @return The gate, or nullptr if the slot is free
+     */
+    NeuronGate* getGate(uint32_t slot) const { return handles[slot]; }
+
+    /**
+     * @brief Get the neuron a gate belongs to
+     * @param slot Slot index
+     * @return Slot of the owning neuron in its core, or NO_NEURON
+     */
+    uint32_t getNeuron(uint32_t slot) const { return neurons[slot]; }
+
+    /**
+     * @brief Set the neuron a gate belongs to
+     * @param slot Slot index
+     * @param neuron Slot of the owning neuron in its core, or NO_NEURON
+     */
+    void setNeuron(uint32_t slot, uint32_t neuron) { neurons[slot] = neuron; }
+
+    float getThreshold(uint32_t slot) const { return thresholds[slot]; }
+    void setThreshold(uint32_t slot, float threshold) { thresholds[slot] = threshold; }
+    float getAdaptationRate(uint32_t slot) const { return adaptationRates[slot]; }
+    void setAdaptationRate(uint32_t slot, float rate) { adaptationRates[slot] = rate; }
+    float getFactor(uint32_t slot) const { return factors[slot]; }
+    void setFactor(uint32_t slot, float factor) { factors[slot] = factor; }
+    bool isActive(uint32_t slot) const { return actives[slot] != 0; }
+
+    /**
+     * @brief Set a gate's active state
+     *
+     * Changing it makes the owning neuron recompile its gate chain, as
+     * NeuronGate::setActive() does.
+     *
+     * @param slot Slot index
+     * @param active The new active state
+     */
+    void setActive(uint32_t slot, bool active);
+
+    /**
+     * @brief Get the threshold column
+     * @return capacity() thresholds, indexed by slot
+     */
+    const float* thresholdData() const { return thresholds.data(); }
+
+    /**
+     * @brief Adapt every gate of the table in one pass
+     *
+     * Equivalent to calling adapt(success[slot] != 0) on the gate in each
+     * slot, except that gate classes overriding adapt() get the base rule
+     * too. Free slots are updated as well; their values are reset when
+     * the slot is reused.
+     *
+     * @param success One entry per slot, capacity() in total: non-zero if the gate succeeded
+     * @param pool Pool to split the work over, or nullptr to run on the calling thread
+     * @param grain Maximum number of gates per parallel chunk
+     */
+    void adaptAll(const uint8_t* success, ThreadPool* pool = nullptr, size_t grain = DEFAULT_GRAIN);
+
+private:
+    friend class NeuronGate;
+
+    std::vector<float> thresholds;       // Activation threshold per gate
+    std::vector<float> adaptationRates;  // Step by which adaptation moves the threshold
+    std::vector<float> factors;          // Modulation factor (used by modulator gates)
+    std::vector<uint8_t> actives;        // Whether each gate is active
+    std::vector<uint32_t> neurons;       // Slot of the owning neuron in its core (NO_NEURON if none)
+    std::vector<NeuronGate*> handles;    // Gate object per slot (nullptr if free)
+    std::vector<uint32_t> freeSlots;     // Released slots available for reuse
+
+    /**
+     * @brief Occupy a slot for a gate
+     * @param gate The gate
+     * @param threshold Initial threshold
+     * @param rate Initial adaptation rate
+     * @param factor Initial modulation factor
+     * @param active Initial active state
+     * @param neuron Slot of the owning neuron, or NO_NEURON
+     * @return Slot index
+     */
+    uint32_t allocate(NeuronGate* gate, float threshold, float rate, float factor, bool active, uint32_t neuron);
+
+    /**
+     * @brief Free a slot for reuse
+     * @param slot Slot index
+     */
+    void release(uint32_t slot);
+};
+
+#endif // GATE_TABLE_H
@@ -0,0 +1,160 @@
+/**
+ * @file graph_generator.h
+ * @brief Synthetic network topologies for load testing.
+ *
+ * The generator produces large random graphs (Erdős–Rényi, Watts–Strogatz
+ * small-world, Barabási–Albert scale-free and layered feed-forward) as
+ * flat arrays of neuron types and edges, and builds them into a Network in
+ * bulk. Generation only depends on the configuration: the same seed yields
+ * the same graph on every platform, and topology, neuron types and weights
+ * are drawn from separate streams, so changing the type mix or the weight
+ * distribution leaves the edges untouched.
+ */
+
+#ifndef GRAPH_GENERATOR_H
+#define GRAPH_GENERATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "neuron.h"
+
+class Network;
+
+/**
+ * @brief Generator of synthetic networks
+ */
+class GraphGenerator {
+public:
+    /**
+     * @brief Random graph models
+     */
+    enum class Topology {
+        ERDOS_RENYI,      // Every directed pair connected with the same probability
+        WATTS_STROGATZ,   // Ring lattice with randomly rewired edges (small world)
+        BARABASI_ALBERT,  // Preferential attachment (scale-free degrees)
+        LAYERED           // Feed-forward layers, each connected to the next
+    };
+
+    /**
+     * @brief Distributions for connection weights
+     */
+    enum class WeightDistribution {
+        CONSTANT,    // Always weightA
+        UNIFORM,     // Uniform in [weightA, weightB)
+        NORMAL,      // Mean weightA, standard deviation weightB
+        LOG_NORMAL   // exp of a normal with mean weightA and deviation weightB
+    };
+
+    /**
+     * @brief Parameters of a generated graph
+     */
+    struct Config {
+        Topology topology;            // Graph model
+        size_t neuronCount;           // Number of neurons
+        double meanDegree;            // Mean out-degree (Erdős–Rényi) or lattice degree (Watts–Strogatz)
+        double rewireProbability;     // Chance of rewiring each lattice edge (Watts–Strogatz)
+        size_t attachEdges;           // Edges added per new neuron (Barabási–Albert)
+        size_t layerCount;            // Number of layers (layered)
+        size_t layerFanOut;           // Targets per neuron in the next layer, 0 for all (layered)
+        std::vector<std::pair<Neuron::NeuronType, double>> typeMix;  // Relative share of each type
+        WeightDistribution weights;   // Weight distribution
+        float weightA;                // First weight parameter
+        float weightB;                // Second weight parameter
+        size_t inputCount;            // Neurons registered as network inputs
+        size_t outputCount;           // Neurons registered as network outputs
+        uint64_t seed;                // Random seed
+
+        /**
+         * @brief Constructor for Config with defaults
+         *
+         * 1000 Erdős–Rényi neurons of mean degree 8, all PROCESSING, with
+         * weights uniform in [0.1, 0.5), 16 inputs, 16 outputs and seed 1.
+         */
+        Config();
+    };
+
+    /**
+     * @brief A directed, weighted edge between neuron positions
+     */
+    struct Edge {
+        uint32_t source;  // Position of the source neuron
+        uint32_t target;  // Position of the target neuron
+        float weight;     // Connection weight
+    };
+
+    /**
+     * @brief A generated graph, independent of any network
+     */
+    struct Graph {
+        std::vector<Neuron::NeuronType> types;  // Type of each neuron
+        std::vector<Edge> edges;                // Edges, grouped by source
+        std::vector<uint32_t> inputs;           // Positions of input neurons
+        std::vector<uint32_t> outputs;          // Positions of output neurons
+    };
+
+    /**
+     * @brief Generate a graph
+     *
+     * The graph has no self-loops and no duplicate edges. Input neurons
+     * are SENSORY and output neurons OUTPUT; in a layered graph they are
+     * taken from the first and last layer, which are entirely SENSORY and
+     * OUTPUT, otherwise they are the first and last neurons.
+     *
+     * @param config Graph parameters
+     * @return The generated graph
+     */
+    static Graph generate(const Config& config);
+
+    /**
+     * @brief Build a generated graph into a network
+     *
+     * The graph is added through a NetworkBuilder, so storage is reserved
+     * up front and everything is added under a single lock acquisition.
+     * Neuron i gets the ID idPrefix + i.
+     *
+     * @param graph The graph to build
+     * @param network The network to populate
+     * @param idPrefix Prefix of the neuron IDs
+     * @return The neurons, in graph order
+     */
+    static std::vector<std::shared_ptr<Neuron>> build(const Graph& graph, Network& network,
+                                                      const std::string& idPrefix = "n");
+
+    /**
+     * @brief Generate a graph and build it into a new network
+     * @param config Graph parameters
+     * @param networkId ID of the new network
+     * @return The populated network
+     */
+    static std::shared_ptr<Network> createNetwork(const Config& config, const std::string& networkId);
+
+    /**
+     * @brief Parse a topology name (er, ws, ba or layered)
+     * @param name The name
+     * @param topology Receives the topology
+     * @return True if the name is known
+     */
+    static bool parseTopology(const std::string& name, Topology& topology);
+
+    /**
+     * @brief Parse a weight distribution name (constant, uniform, normal or lognormal)
+     * @param name The name
+     * @param distribution Receives the distribution
+     * @return True if the name is known
+     */
+    static bool parseWeightDistribution(const std::string& name, WeightDistribution& distribution);
+
+    /**
+     * @brief Parse a neuron type name such as "processing" or "memory"
+     * @param name The name
+     * @param type Receives the type
+     * @return True if the name is known
+     */
+    static bool parseNeuronType(const std::string& name, Neuron::NeuronType& type);
+};
+
+#endif // GRAPH_GENERATOR_H
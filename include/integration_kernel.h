@@ -0,0 +1,85 @@
+/**
+ * @file integration_kernel.h
+ * @brief Vectorized membrane integration over the flat state of a core.
+ *
+ * Once every neuron of a tick has reduced its gated input to a single
+ * current, the remaining work is the same arithmetic for every slot: decay
+ * the potential, add the current, clamp to [0, 1] and compare against the
+ * threshold. The decay differs per slot, since each neuron was last
+ * updated at a different tick. The kernel does this for a contiguous range of slots, 4 to 16
+ * neurons per instruction, and reports the neurons that reached their
+ * threshold as a bitmask.
+ *
+ * Variants exist for AVX-512, AVX2, NEON and plain C++. The best variant
+ * the CPU supports is picked at first use; all of them produce bit-identical
+ * results, so the choice never changes the outcome of a simulation.
+ */
+
+#ifndef INTEGRATION_KERNEL_H
+#define INTEGRATION_KERNEL_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Runtime-dispatched integrate-and-compare kernel
+ */
+class IntegrationKernel {
+public:
+    /**
+     * @brief Instruction sets the kernel is implemented for
+     */
+    enum class Isa {
+        SCALAR,   // Portable C++
+        NEON,     // ARM Advanced SIMD, 4 lanes
+        AVX2,     // x86 AVX2, 8 lanes
+        AVX512    // x86 AVX-512F, 16 lanes
+    };
+
+    /**
+     * @brief Integrate a range of slots
+     *
+     * For every slot i with active[i] != 0:
+     *   potentials[i] = clamp(potentials[i] * decays[i] + currents[i], 0, 1)
+     * and bit i of @p fired is set if the new potential is at least
+     * thresholds[i]. Inactive slots keep their potential and a clear bit.
+     *
+     * @param potentials Membrane potentials, updated in place
+     * @param thresholds Firing thresholds
+     * @param currents Input current of each slot
+     * @param active Non-zero for slots that received input this tick
+     * @param count Number of slots
+     * @param decays Factor applied to each potential before adding the current
+     * @param fired Receives one bit per slot, (count + 63) / 64 words
+     */
+    static void integrate(float* potentials, const float* thresholds, const float* currents,
+                          const uint8_t* active, const float* decays, size_t count, uint64_t* fired);
+
+    /**
+     * @brief Get the variant in use
+     * @return Instruction set of the selected variant
+     */
+    static Isa getIsa();
+
+    /**
+     * @brief Get the best variant this CPU supports
+     * @return Instruction set detected at runtime
+     */
+    static Isa detect();
+
+    /**
+     * @brief Force a variant, e.g. to compare them in benchmarks
+     * @param isa Instruction set to use
+     * @return True if the CPU supports it and it is now in use
+     */
+    static bool setIsa(Isa isa);
+
+    /**
+     * @brief Get a printable name for a variant
+     * @param isa Instruction set
+     * @return Name such as "avx2"
+     */
+    static const char* getIsaName(Isa isa);
+};
+
+#endif // INTEGRATION_KERNEL_H
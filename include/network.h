@@ -18,14 +18,27 @@
 #include <thread>
 #include <atomic>
 #include <functional>
+#include <utility>
 #include "neuron.h"
 #include "synapse.h"
+#include "simulation_core.h"
+
+class ThreadPool;
 
 /**
  * @brief Base class for all networks in the O3 architecture
  */
 class Network {
 public:
+    /**
+     * @brief How a tick finds the neurons to run
+     */
+    enum class SchedulingMode {
+        DENSE,         // Scan every neuron for queued input
+        EVENT_DRIVEN,  // Run only neurons on the core's list of active slots
+        LEVELIZED      // Run active neurons level by level in topological order
+    };
+    
     /**
      * @brief Constructor for Network
      * @param id Unique identifier for this network
@@ -51,10 +64,34 @@ public:
      */
     std::shared_ptr<Neuron> createNeuron(const std::string& id, Neuron::NeuronType type);
     
+    /**
+     * @brief Create many neurons under a single lock acquisition
+     * 
+     * Neurons whose ID already exists are returned as they are, like
+     * createNeuron does.
+     * 
+     * @param ids Unique identifiers for the neurons
+     * @param types Type of each neuron (same length as ids)
+     * @return The neurons, in the order of ids
+     */
+    std::vector<std::shared_ptr<Neuron>> createNeurons(const std::vector<std::string>& ids,
+                                                       const std::vector<Neuron::NeuronType>& types);
+    
+    /**
+     * @brief Reserve storage ahead of adding many neurons and connections
+     * @param neuronCount Number of neurons about to be added
+     * @param connectionCount Number of connections about to be added
+     */
+    void reserve(size_t neuronCount, size_t connectionCount);
+    
     /**
      * @brief Add an existing neuron to the network
+     * 
+     * The neuron, together with any neurons it is already connected to,
+     * is moved into the network's simulation core.
+     * 
      * @param neuron Neuron to add
-     * @return True if added successfully
+     * @return True if added successfully (false if it belongs to another network)
      */
     bool addNeuron(std::shared_ptr<Neuron> neuron);
     
@@ -109,17 +146,190 @@ public:
      */
     std::vector<std::shared_ptr<Neuron>> getNeuronsByTag(const std::string& tag) const;
     
+    /**
+     * @brief Get neurons by interned tag
+     * @param tag Symbol of the tag in the global symbol table
+     * @return Vector of neurons with the matching tag
+     */
+    std::vector<std::shared_ptr<Neuron>> getNeuronsByTag(Symbol tag) const;
+    
+    /**
+     * @brief Get neurons matching a combination of tags and types
+     * 
+     * Answered from the type and tag indexes of the network's simulation
+     * core, for example NeuronQuery().withTag("a").ofType(MEMORY).withoutTag("b").
+     * 
+     * @param query The filter to apply
+     * @return Matching neurons in slot order
+     */
+    std::vector<std::shared_ptr<Neuron>> findNeurons(const NeuronQuery& query) const;
+    
     /**
      * @brief Process signals through the network
-     * This method propagates signals through all neurons in the network
+     * 
+     * Runs one tick: signals due in this tick are delivered, every neuron
+     * integrates its queued input, and signals fired now are queued for
+     * delivery after the delay of their connection (the next tick by
+     * default). A signal therefore advances one hop per tick.
+     * 
+     * A tick has two phases separated by a barrier. In the integrate phase
+     * each neuron updates only its own potential, so neurons can be spread
+     * across worker threads (see setParallelism()). In the commit phase the
+     * neurons that reached their threshold fire and run their callbacks one
+     * at a time, input neurons first, then the rest in index order, output
+     * neurons last. Results therefore do not depend on the number of
+     * workers. Signals received from callbacks are integrated next tick.
      */
     void processSignals();
     
     /**
      * @brief Reset all neurons in the network to their initial state
+     * and discard signals still in flight
      */
     void reset();
     
+    /**
+     * @brief Adapt the gates of every neuron from a learning signal
+     * 
+     * Each gate adapts as with NeuronGate::adapt(), in one vectorized pass
+     * over the network's gate table, split over the thread pool if
+     * parallelism is configured.
+     * 
+     * @param success One entry per neuron slot (see Neuron::getIndex()),
+     *        non-zero if the neuron's gates succeeded
+     * @return False if success has fewer than getNeuronSlotCount() entries
+     */
+    bool adaptGates(const std::vector<uint8_t>& success);
+    
+    /**
+     * @brief Set the delivery delay of a connection
+     * @param sourceId ID of the source neuron
+     * @param targetId ID of the target neuron
+     * @param ticks Delay in ticks (at least 1, at most the maximum signal delay)
+     * @return True if the connection exists and was updated
+     */
+    bool setConnectionDelay(const std::string& sourceId, const std::string& targetId, uint32_t ticks);
+    
+    /**
+     * @brief Set the longest delay a connection may have
+     * @param ticks Maximum delay in ticks (at most DeliveryQueue::DELAY_LIMIT)
+     */
+    void setMaxSignalDelay(uint32_t ticks);
+    
+    /**
+     * @brief Set how many signals may wait in a single delay slot
+     * 
+     * Signals fired into a full slot are dropped and counted.
+     * 
+     * @param capacity Maximum number of signals per slot
+     */
+    void setSignalSlotCapacity(size_t capacity);
+    
+    /**
+     * @brief Set the membrane dynamics of every neuron in the network
+     * 
+     * The default model accumulates input without decay. Use
+     * NeuronModel::leakyIntegrateAndFire() for a leaky integrate-and-fire
+     * model with a membrane time constant, a refractory period in ticks and
+     * a reset potential.
+     * 
+     * @param model The neuron model
+     */
+    void setNeuronModel(const NeuronModel& model);
+    
+    /**
+     * @brief Get the membrane dynamics of the network
+     * @return Copy of the neuron model
+     */
+    NeuronModel getNeuronModel() const;
+    
+    /**
+     * @brief Choose how a tick finds its work
+     * 
+     * A dense tick scans every neuron for queued input, so its cost grows
+     * with the size of the network. An event-driven tick only looks at the
+     * neurons that received input, which the simulation core lists as
+     * signals arrive, so its cost follows the activity instead. Decaying
+     * potentials need no work between inputs in either mode. Both modes
+     * run the same neurons in the same order.
+     * 
+     * A levelized tick compiles the connections into levels: cycles are
+     * collapsed into single components and every component is placed one
+     * level after the last component feeding it. The tick then runs the
+     * active neurons level by level, each level as one integrate and commit
+     * batch, and signals along connections to a higher level arrive one
+     * tick sooner than their delay says. With the default delay a signal
+     * thus crosses a whole feed-forward network in a single tick, while
+     * connections inside a cycle keep their delay. Levels are recompiled
+     * only when the topology changes.
+     * 
+     * @param mode Scheduling mode
+     */
+    void setSchedulingMode(SchedulingMode mode);
+    
+    /**
+     * @brief Get how a tick finds its work
+     * @return Scheduling mode
+     */
+    SchedulingMode getSchedulingMode() const;
+    
+    /**
+     * @brief Get the number of ticks processed so far
+     * @return Current tick
+     */
+    uint64_t getCurrentTick() const;
+    
+    /**
+     * @brief Get the number of signals waiting for delivery
+     * @return Count of queued signals
+     */
+    size_t getPendingSignalCount() const;
+    
+    /**
+     * @brief Get the number of signals dropped because a delay slot was full
+     * @return Count of dropped signals
+     */
+    uint64_t getDroppedSignalCount() const;
+    
+    /**
+     * @brief Configure parallel execution of the integrate phase
+     * 
+     * The neurons of a tick are split into partitions of @p grain neurons
+     * that are integrated on a work-stealing thread pool owned by the
+     * network; the thread calling processSignals() takes part as one of
+     * the workers. Ticks with no more than one partition of work run on the
+     * calling thread. Custom gates must be safe to call from worker threads
+     * when more than one worker is used.
+     * 
+     * @param workers Number of threads integrating neurons (0 or 1 runs serially)
+     * @param grain Number of neurons per partition
+     * @param pinWorkers Whether to pin pool threads to CPUs (Linux only)
+     */
+    void setParallelism(size_t workers, size_t grain = 1024, bool pinWorkers = false);
+    
+    /**
+     * @brief Get the number of worker threads used for the integrate phase
+     * @return Worker count (1 if serial)
+     */
+    size_t getWorkerCount() const;
+    
+    /**
+     * @brief Get the number of neurons per parallel partition
+     * @return Partition size
+     */
+    size_t getPartitionGrain() const;
+    
+    /**
+     * @brief Get the thread pool used for parallel ticks
+     * 
+     * Callbacks may submit their own work to the pool and wait for it;
+     * waiting threads help run queued tasks, so this is safe even from
+     * inside a tick.
+     * 
+     * @return The pool, or nullptr while running serially
+     */
+    ThreadPool* getThreadPool() const;
+    
     /**
      * @brief Add a neuron to the input layer
      * @param inputNeuron Neuron to add as input
@@ -150,13 +360,24 @@ public:
      * @param targetId The ID of the target neuron (or empty for all input neurons)
      * @return True if the signal was delivered
      */
-    bool injectSignal(std::shared_ptr<Synapse> signal, const std::string& targetId = "");
+    bool injectSignal(SynapsePtr signal, const std::string& targetId = "");
     
     /**
      * @brief Register a callback for network events
      * @param callback Function to call when the network processes signals
+     * @return Handle for removeProcessCallback(), 0 if the callback is empty
+     */
+    size_t onProcess(std::function<void(Network&)> callback);
+    
+    /**
+     * @brief Unregister a callback added by onProcess()
+     * 
+     * Must not be called from a process callback.
+     * 
+     * @param handle Handle returned by onProcess()
+     * @return True if the callback was registered
      */
-    void onProcess(std::function<void(Network&)> callback);
+    bool removeProcessCallback(size_t handle);
     
     /**
      * @brief Generate a visual representation of the network
@@ -170,22 +391,55 @@ public:
      */
     size_t getNeuronCount() const;
     
+    /**
+     * @brief Get the number of neuron slots, including released ones
+     * @return One past the largest Neuron::getIndex() in the network
+     */
+    size_t getNeuronSlotCount() const;
+    
     /**
      * @brief Get the number of connections in the network
      * @return Count of connections between neurons
      */
     size_t getConnectionCount() const;
     
+    /**
+     * @brief Freeze the network topology
+     * 
+     * Packs the connection store into plain CSR form for fast fan-out.
+     * While frozen, new connections and disconnections are rejected;
+     * weights of existing connections can still be changed.
+     */
+    void freezeTopology();
+    
+    /**
+     * @brief Allow topology changes again after freezeTopology()
+     */
+    void thawTopology();
+    
+    /**
+     * @brief Check whether the network topology is frozen
+     * @return True if structural changes are rejected
+     */
+    bool isTopologyFrozen() const;
+    
     /**
      * @brief Get the network's processing state
      * @return True if the network is currently processing signals
      */
     bool isProcessing() const;
     
+protected:
+    // Contiguous hot state of every neuron in the network
+    std::shared_ptr<SimulationCore> core;
+    
 private:
+    friend class NetworkBuilder;
+    friend class NetworkSnapshot;
+    
     std::string id;  // Unique identifier
     
-    // Neuron storage
+    // Neuron storage, keyed by ID
     std::unordered_map<std::string, std::shared_ptr<Neuron>> neurons;
     
     // Input and output layers
@@ -196,10 +450,55 @@ private:
     std::atomic<bool> processing;
     
     // Callbacks
-    std::vector<std::function<void(Network&)>> processCallbacks;
+    std::vector<std::pair<size_t, std::function<void(Network&)>>> processCallbacks;  // By handle
+    size_t nextCallbackHandle;                                                       // Handle of the next callback
+    
+    // Tick execution
+    std::unique_ptr<ThreadPool> threadPool;      // Workers for the integrate phase (null if serial)
+    size_t workerCount;                          // Number of worker threads
+    size_t partitionGrain;                       // Neurons per parallel partition
+    std::vector<uint32_t> planSlots;             // Input slots, other slots in index order, output slots
+    size_t planHiddenBegin;                      // First entry of planSlots past the inputs
+    size_t planHiddenEnd;                        // First output entry of planSlots
+    uint64_t planRevision;                       // Core structure revision planSlots was built for
+    SchedulingMode scheduling;                   // How a tick finds its work
+    SchedulingMode planMode;                     // Scheduling mode planSlots was built for
+    std::vector<Neuron*> executionOrder;         // Neurons to run this tick, in commit order
+    std::vector<uint32_t> executionSlots;        // Core slot of each entry of executionOrder
+    std::vector<uint8_t> thresholdReached;       // Integrate phase result per entry of executionOrder
+    std::vector<uint8_t> repeatedEntries;        // Entries of executionOrder that repeat an earlier slot (commit only)
+    std::vector<uint64_t> firedSlots;            // Kernel result, one bit per core slot
+    std::vector<uint32_t> activeSlots;           // Slots with queued input (event-driven ticks)
+    std::vector<std::vector<uint32_t>> levelBuckets;  // Slots to run per level (levelized ticks)
+    std::vector<uint32_t> deferredSlots;         // Slots whose level already ran this tick
     
     // Thread synchronization
     mutable std::mutex neuronMutex;
+    
+    /**
+     * @brief Rebuild planSlots if neurons, connections, layers or the scheduling mode changed
+     */
+    void refreshPlan();
+    
+    /**
+     * @brief Run the integrate phase over executionOrder, in parallel if configured
+     */
+    void integrateAll();
+    
+    /**
+     * @brief Collect and run the neurons of a dense or event-driven tick
+     */
+    void processBatch();
+    
+    /**
+     * @brief Run the commit phase over executionOrder, skipping removed neurons
+     */
+    void commitAll();
+    
+    /**
+     * @brief Run the neurons of a levelized tick, one level at a time
+     */
+    void processLevels();
 };
 
 /**
@@ -235,6 +534,8 @@ public:
     virtual void processSignals();
     
 private:
+    friend class NetworkSnapshot;
+    
     std::string focusedNeuronId;  // ID of the neuron currently in focus
     float attentionStrength;      // Strength of attention focus
 };
@@ -268,15 +569,34 @@ public:
     virtual void processSignals() ;
     
 private:
+    friend class NetworkSnapshot;
+    
+    /**
+     * @brief A tag or metadata key that patterns wait for
+     */
+    struct PatternItem {
+        bool present;                    // Whether some member carries it
+        std::vector<uint32_t> patterns;  // Patterns containing it
+    };
+    
     // Patterns stored as sequences of keys/values to match
     std::vector<std::pair<std::vector<std::string>, std::vector<std::string>>> patterns;
+    std::vector<std::vector<Symbol>> patternSymbols;  // Interned items of each pattern
+    
+    // Incremental matching: a pattern matches once every distinct item is present
+    std::unordered_map<Symbol, PatternItem> patternItems;  // Pattern items by symbol
+    std::vector<uint32_t> itemCounts;                    // Distinct items per pattern
+    std::vector<uint32_t> presentCounts;                 // Items of each pattern some member carries
+    std::vector<uint8_t> matched;                        // Whether each pattern matches
+    std::vector<uint32_t> matchedPatterns;               // Matching patterns in increasing order
+    std::vector<Symbol> presenceChanges;                 // Symbols taken from the neuron index
     
     /**
-     * @brief Check if a pattern matches current network state
-     * @param pattern The pattern to check
-     * @return True if the pattern matches
+     * @brief Bring the matches up to date with tags and metadata added or removed since the last call
+     *
+     * Only patterns containing an item whose presence changed are looked at.
      */
-    bool matchesPattern(const std::vector<std::string>& pattern) const;
+    void updateMatches();
     
     /**
      * @brief Generate a response for a matched pattern
@@ -313,6 +633,8 @@ public:
     virtual void processSignals() ;
     
 private:
+    friend class NetworkSnapshot;
+    
     // Signal filtering rules
     std::vector<std::pair<std::string, std::string>> filterRules;
     
@@ -321,7 +643,7 @@ private:
      * @param signal The signal to check
      * @return True if the signal passes all filters
      */
-    bool passesFilters(const std::shared_ptr<Synapse>& signal) const;
+    bool passesFilters(const SynapsePtr& signal) const;
 };
 
 /**
@@ -0,0 +1,159 @@
+/**
+ * @file network_builder.h
+ * @brief Bulk construction of networks.
+ *
+ * Building a large network one createNeuron/connectNeurons call at a time
+ * takes the network lock and grows the edge rows on every call. The
+ * builder instead collects neuron and edge specifications in flat arrays
+ * and applies them in finalize() under one lock acquisition: storage is
+ * reserved once, every edge row grows at most once and the input and
+ * output layers are deduplicated in a single pass. The resulting network
+ * is the same as the one the equivalent sequence of incremental calls
+ * would produce.
+ */
+
+#ifndef NETWORK_BUILDER_H
+#define NETWORK_BUILDER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "neuron.h"
+
+class Network;
+
+/**
+ * @brief Collects neurons and connections and adds them to a network at once
+ *
+ * Neurons are referred to by their position in the builder, in the order
+ * they were added. Nothing touches the network until finalize().
+ */
+class NetworkBuilder {
+public:
+    /**
+     * @brief A neuron to create
+     */
+    struct NeuronSpec {
+        std::string id;           // Unique identifier
+        Neuron::NeuronType type;  // Neuron type
+
+        /**
+         * @brief Constructor for NeuronSpec
+         * @param id Unique identifier
+         * @param type Neuron type
+         */
+        NeuronSpec(const std::string& id = "", Neuron::NeuronType type = Neuron::NeuronType::PROCESSING);
+    };
+
+    /**
+     * @brief A connection to create between neuron positions
+     */
+    struct EdgeSpec {
+        uint32_t source;  // Position of the source neuron
+        uint32_t target;  // Position of the target neuron
+        float weight;     // Connection weight
+        uint32_t delay;   // Delivery delay in ticks
+
+        /**
+         * @brief Constructor for EdgeSpec
+         * @param source Position of the source neuron
+         * @param target Position of the target neuron
+         * @param weight Connection weight
+         * @param delay Delivery delay in ticks
+         */
+        EdgeSpec(uint32_t source = 0, uint32_t target = 0, float weight = 1.0f, uint32_t delay = 1);
+    };
+
+    /**
+     * @brief Constructor for NetworkBuilder
+     * @param network The network to populate
+     */
+    explicit NetworkBuilder(Network& network);
+
+    /**
+     * @brief Reserve room for the specifications about to be added
+     * @param neuronCount Number of neurons
+     * @param edgeCount Number of connections
+     */
+    void reserve(size_t neuronCount, size_t edgeCount);
+
+    /**
+     * @brief Add a neuron
+     * @param id Unique identifier
+     * @param type Neuron type
+     * @return Position of the neuron in the builder
+     */
+    uint32_t addNeuron(const std::string& id, Neuron::NeuronType type);
+
+    /**
+     * @brief Add several neurons
+     * @param specs The neurons
+     * @return Position of the first of them in the builder
+     */
+    uint32_t addNeurons(const std::vector<NeuronSpec>& specs);
+
+    /**
+     * @brief Add a connection
+     * @param source Position of the source neuron
+     * @param target Position of the target neuron
+     * @param weight Connection weight
+     * @param delay Delivery delay in ticks
+     */
+    void addEdge(uint32_t source, uint32_t target, float weight = 1.0f, uint32_t delay = 1);
+
+    /**
+     * @brief Add several connections
+     * @param specs The connections
+     */
+    void addEdges(const std::vector<EdgeSpec>& specs);
+
+    /**
+     * @brief Register a neuron as a network input
+     * @param position Position of the neuron
+     */
+    void addInput(uint32_t position);
+
+    /**
+     * @brief Register a neuron as a network output
+     * @param position Position of the neuron
+     */
+    void addOutput(uint32_t position);
+
+    /**
+     * @brief Get the number of neurons added so far
+     * @return Neuron count
+     */
+    size_t getNeuronCount() const;
+
+    /**
+     * @brief Get the number of connections added so far
+     * @return Connection count
+     */
+    size_t getEdgeCount() const;
+
+    /**
+     * @brief Add everything to the network and clear the builder
+     *
+     * The result matches calling createNeuron for every neuron, then
+     * connectNeurons and setConnectionDelay for every connection and
+     * finally addInputNeuron and addOutputNeuron, all in the order they
+     * were added: neurons whose ID already exists are reused, self-loops
+     * are skipped, a connection given twice keeps its last weight and
+     * delay, and delays are clamped to the network's delivery horizon.
+     * Connections that refer to positions outside the builder are skipped.
+     *
+     * @return The neurons, by position
+     */
+    std::vector<std::shared_ptr<Neuron>> finalize();
+
+private:
+    Network& network;                  // Network being populated
+    std::vector<NeuronSpec> neurons;   // Neurons to create
+    std::vector<EdgeSpec> edges;       // Connections to create
+    std::vector<uint32_t> inputs;      // Positions of input neurons
+    std::vector<uint32_t> outputs;     // Positions of output neurons
+};
+
+#endif // NETWORK_BUILDER_H
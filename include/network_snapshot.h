@@ -0,0 +1,343 @@
+/**
+ * @file network_snapshot.h
+ * @brief Binary snapshots of networks.
+ *
+ * A snapshot holds everything needed to bring a network back: its neurons
+ * (ID, type, threshold, potential, state, tags and metadata), connections
+ * with weights and delays, gate configurations, input and output layers,
+ * the neuron model with the current tick and the extras of the tier networks (attention focus, patterns and
+ * filter rules). Signals in flight and callbacks are not part of it.
+ *
+ * The file is little-endian and versioned. It starts with a fixed header
+ * and a table of sections; every section is one flat, 8-byte aligned
+ * array, so a snapshot opened through mmap exposes the large arrays
+ * (per-neuron state and the CSR rows) without copying or parsing them, and
+ * restoring a network copies each of them in a single block. Readers skip
+ * sections they do not know, so sections can be added without breaking
+ * older files.
+ *
+ * Checkpoints extend the format with delta files: a delta carries only the
+ * neuron state and edge rows that changed since the previous checkpoint of
+ * the same lineage, and is applied on top of the network restored from the
+ * base snapshot (see Checkpointer).
+ */
+
+#ifndef NETWORK_SNAPSHOT_H
+#define NETWORK_SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "network.h"
+
+/**
+ * @brief A snapshot file mapped into memory, and the functions to write one
+ */
+class NetworkSnapshot {
+public:
+    /**
+     * @brief Version written by save(); files of later versions are rejected
+     */
+    static const uint32_t FORMAT_VERSION = 1;
+
+    /**
+     * @brief Write a snapshot of a network
+     *
+     * Neurons are written in slot order and renumbered densely. The network
+     * should not be processing signals while it is saved.
+     *
+     * @param network The network to save
+     * @param path Destination file (replaced if it exists)
+     * @param error Receives a description of the failure, if not null
+     * @return True if the snapshot was written
+     */
+    static bool save(const Network& network, const std::string& path, std::string* error = nullptr);
+
+    /**
+     * @brief Open a snapshot file and create the network it describes
+     * @param path The snapshot file
+     * @param error Receives a description of the failure, if not null
+     * @return The restored network (of the saved tier), or null on failure
+     */
+    static std::shared_ptr<Network> load(const std::string& path, std::string* error = nullptr);
+
+    /**
+     * @brief Sections captured from a network, ready to be written
+     */
+    class Image;
+
+    /**
+     * @brief Bookkeeping that links the checkpoints of one network
+     */
+    struct Lineage {
+        uint64_t baseSequence;          // Sequence number of the current base snapshot
+        uint64_t sequence;              // Sequence number of the last checkpoint
+        uint64_t snapshotRevision;      // Snapshot revision captured by the base
+        uint64_t edgeCount;             // Connections in the base
+        std::vector<uint32_t> slots;    // Core slot of each dense neuron index
+        std::vector<uint32_t> dense;    // Dense index of each core slot
+
+        /**
+         * @brief Constructor for an empty Lineage
+         */
+        Lineage();
+    };
+
+    /**
+     * @brief Capture a full snapshot that starts a new checkpoint lineage
+     *
+     * Clears the change tracking of the network, so the next delta holds
+     * only what changed after this call.
+     *
+     * @param network The network to capture
+     * @param lineage Lineage to reset to the new base
+     * @return The captured image
+     */
+    static std::shared_ptr<Image> captureBase(Network& network, Lineage& lineage);
+
+    /**
+     * @brief Capture what changed since the previous checkpoint of a lineage
+     *
+     * Only neuron state (potential, threshold, state, clocks) and the weights and
+     * delays of existing connections are tracked; any other change makes a
+     * delta impossible and the caller has to capture a new base.
+     *
+     * @param network The network to capture
+     * @param lineage Lineage the delta extends
+     * @return The captured delta, or null if a new base is needed
+     */
+    static std::shared_ptr<Image> captureChanges(Network& network, Lineage& lineage);
+
+    /**
+     * @brief Write a captured image to a file
+     *
+     * Does not touch the network, so it can run on another thread.
+     *
+     * @param image The image to write
+     * @param path Destination file (replaced if it exists)
+     * @param error Receives a description of the failure, if not null
+     * @return True if the file was written
+     */
+    static bool write(const Image& image, const std::string& path, std::string* error = nullptr);
+
+    /**
+     * @brief Constructor for an empty NetworkSnapshot
+     */
+    NetworkSnapshot();
+
+    /**
+     * @brief Destructor for NetworkSnapshot, unmapping the file
+     */
+    ~NetworkSnapshot();
+
+    NetworkSnapshot(const NetworkSnapshot&) = delete;
+    NetworkSnapshot& operator=(const NetworkSnapshot&) = delete;
+
+    /**
+     * @brief Map a snapshot file and validate it
+     * @param path The snapshot file
+     * @return True if the file is a valid snapshot
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Unmap the file
+     */
+    void close();
+
+    /**
+     * @brief Check whether a snapshot is open
+     * @return True if open() succeeded
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Get the reason the last open() or restore() failed
+     * @return Error description
+     */
+    const std::string& getError() const;
+
+    /**
+     * @brief Restore the snapshot into a network
+     *
+     * The network must be empty; its tier extras are restored if it is of
+     * the saved tier. Custom gates come back with the default processor
+     * and need their processor set again.
+     *
+     * @param network The network to populate
+     * @return True if the network was restored
+     */
+    bool restore(Network& network);
+
+    /**
+     * @brief Apply a delta file to a network restored from its base
+     *
+     * The network must hold exactly the neurons and connections of the
+     * base, in the slots restore() gave them.
+     *
+     * @param network The network to update
+     * @return True if the changes were applied
+     */
+    bool applyChanges(Network& network);
+
+    /**
+     * @brief Check whether the open file is a delta
+     * @return True for a delta, false for a full snapshot
+     */
+    bool isDelta() const;
+
+    /**
+     * @brief Get the checkpoint sequence number of the file
+     * @return Sequence number, or 0 for a snapshot written by save()
+     */
+    uint64_t getSequence() const;
+
+    /**
+     * @brief Get the sequence number of the base the file belongs to
+     * @return Base sequence number, or 0 for a snapshot written by save()
+     */
+    uint64_t getBaseSequence() const;
+
+    /**
+     * @brief Get the tier of the saved network
+     * @return The network type
+     */
+    NetworkFactory::NetworkType getNetworkType() const;
+
+    /**
+     * @brief Get the ID of the saved network
+     * @return The network ID
+     */
+    std::string getNetworkId() const;
+
+    /**
+     * @brief Get the number of neurons
+     * @return Neuron count
+     */
+    uint32_t getNeuronCount() const;
+
+    /**
+     * @brief Get the number of connections
+     * @return Connection count
+     */
+    size_t getConnectionCount() const;
+
+    /**
+     * @brief Get the ID of a neuron
+     * @param neuron Dense neuron index
+     * @return The neuron ID
+     */
+    std::string getNeuronId(uint32_t neuron) const;
+
+    // Zero-copy views of the mapped arrays, indexed by dense neuron index
+    const uint8_t* types() const { return neuronTypes; }
+    const uint8_t* states() const { return neuronStates; }
+    const float* thresholds() const { return neuronThresholds; }
+    const float* potentials() const { return neuronPotentials; }
+
+    // Outgoing rows: row i is [outStart()[i], outStart()[i + 1])
+    const uint64_t* outStart() const { return outRowStart; }
+    const uint32_t* outTargets() const { return outRowTargets; }
+    const float* outWeights() const { return outRowWeights; }
+    const uint16_t* outDelays() const { return outRowDelays; }
+
+    // Incoming rows: row i is [inStart()[i], inStart()[i + 1])
+    const uint64_t* inStart() const { return inRowStart; }
+    const uint32_t* inSources() const { return inRowSources; }
+
+private:
+    /**
+     * @brief Capture a full image of a network; the caller holds the network lock
+     * @param network The network to capture
+     * @param slots Receives the core slot of each dense index, if not null
+     * @param dense Receives the dense index of each core slot, if not null
+     * @return The captured image
+     */
+    static std::shared_ptr<Image> capture(const Network& network, std::vector<uint32_t>* slots,
+                                          std::vector<uint32_t>* dense);
+
+    /**
+     * @brief Locate a section and check its element size and count
+     * @param kind Section kind
+     * @param elementSize Expected element size
+     * @param count Receives the element count
+     * @param required Whether a missing section is an error
+     * @return Pointer to the first element, or null
+     */
+    const void* section(uint32_t kind, size_t elementSize, size_t& count, bool required);
+
+    /**
+     * @brief Check the sections of a delta file
+     * @return True if the changed indices and rows are consistent and in range
+     */
+    bool validDelta();
+
+    /**
+     * @brief Check the neuron model section, if present
+     * @return True if it is absent or names a known model
+     */
+    bool validModel();
+
+    /**
+     * @brief Apply the saved neuron model and tick to a core
+     * @param core The core of the network being restored
+     */
+    void restoreModel(SimulationCore& core);
+
+    /**
+     * @brief Check that a row-start array is monotonic and ends at the element count
+     * @param start Row starts (rows + 1 entries)
+     * @param rows Number of rows
+     * @param elements Number of elements in the rows
+     * @return True if the starts are valid
+     */
+    static bool validStarts(const uint64_t* start, size_t rows, uint64_t elements);
+
+    /**
+     * @brief Get a string from the string table
+     * @param index String index
+     * @return The string
+     */
+    std::string string(uint32_t index) const;
+
+    /**
+     * @brief Record a failure
+     * @param message Error description
+     * @return False
+     */
+    bool fail(const std::string& message);
+
+    const uint8_t* data;      // Mapped file
+    size_t size;              // Size of the mapping
+    bool mapped;              // Whether data came from mmap (else from the heap)
+    std::string error;        // Last error
+
+    uint32_t networkType;     // Saved NetworkFactory::NetworkType
+    uint32_t networkId;       // String index of the network ID
+    uint32_t flags;           // Header flags
+    uint32_t neuronCount;     // Number of neurons
+    uint64_t edgeCount;       // Number of connections
+    uint64_t sequence;        // Checkpoint sequence number
+    uint64_t baseSequence;    // Sequence number of the base
+
+    const uint64_t* stringStart;   // String table offsets (stringCount + 1)
+    const char* stringData;        // String table characters
+    size_t stringCount;            // Number of strings
+
+    const uint32_t* neuronIds;     // String index of each neuron ID
+    const uint8_t* neuronTypes;    // Neuron::NeuronType per neuron
+    const uint8_t* neuronStates;   // Neuron::NeuronState per neuron
+    const float* neuronThresholds; // Threshold per neuron
+    const float* neuronPotentials; // Potential per neuron
+
+    const uint64_t* outRowStart;   // Outgoing row starts
+    const uint32_t* outRowTargets; // Outgoing targets
+    const float* outRowWeights;    // Outgoing weights
+    const uint16_t* outRowDelays;  // Outgoing delays
+    const uint64_t* inRowStart;    // Incoming row starts
+    const uint32_t* inRowSources;  // Incoming sources
+};
+
+#endif // NETWORK_SNAPSHOT_H
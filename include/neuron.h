@@ -9,13 +9,17 @@
 #ifndef NEURON_H
 #define NEURON_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
-#include <map>
 #include <functional>
 #include "synapse.h"
 #include "neuron_gate.h"
+#include "gate_chain.h"
+#include "symbol_table.h"
+
+class SimulationCore;
 
 /**
  * @brief The Neuron class simulates a biological neuron
@@ -52,6 +56,14 @@ public:
      */
     Neuron(const std::string& id, NeuronType type);
     
+    /**
+     * @brief Constructor for a Neuron stored in an existing simulation core
+     * @param id Unique identifier
+     * @param type Type of the neuron
+     * @param core The simulation core that holds the neuron's state
+     */
+    Neuron(const std::string& id, NeuronType type, std::shared_ptr<SimulationCore> core);
+    
     /**
      * @brief Destructor for Neuron
      */
@@ -69,6 +81,18 @@ public:
      */
     NeuronType getType() const;
     
+    /**
+     * @brief Get the dense index of this neuron in its simulation core
+     * @return The neuron index
+     */
+    uint32_t getIndex() const;
+    
+    /**
+     * @brief Get the simulation core holding this neuron's state
+     * @return Pointer to the simulation core
+     */
+    SimulationCore* getCore() const;
+    
     /**
      * @brief Create a new neuron gate for pathway control
      * @param gateType The type of gate to create
@@ -102,6 +126,12 @@ public:
     
     /**
      * @brief Connect this neuron to another
+     * 
+     * Connections are stored in the edge store of the neuron's simulation
+     * core. Connecting to a neuron in another core merges the two cores,
+     * which fails if both belong to different networks. New connections are
+     * rejected while the core's topology is frozen.
+     * 
      * @param target Target neuron to connect to
      * @param weight Initial connection weight
      * @return True if connection was successful
@@ -117,17 +147,26 @@ public:
     
     /**
      * @brief Receive a synaptic signal
+     * 
+     * The signal is queued and handled by the next call to processSignals().
+     * 
      * @param signal The incoming synapse
      */
-    void receiveSignal(std::shared_ptr<Synapse> signal);
+    void receiveSignal(SynapsePtr signal);
     
     /**
      * @brief Process accumulated signals
+     * 
+     * Equivalent to the integrate and commit phases of a network tick run
+     * back to back for this neuron alone.
      */
     void processSignals();
     
     /**
      * @brief Fire a signal to connected neurons
+     * 
+     * Outgoing signals are placed in the simulation core's delivery queue
+     * and reach their targets after the delay of each connection.
      */
     void fire();
     
@@ -137,6 +176,12 @@ public:
      */
     void addTag(const std::string& tag);
     
+    /**
+     * @brief Add an interned tag to this neuron
+     * @param tag Symbol of the tag
+     */
+    void addTag(Symbol tag);
+    
     /**
      * @brief Check if neuron has a specific tag
      * @param tag The tag to check
@@ -144,12 +189,25 @@ public:
      */
     bool hasTag(const std::string& tag) const;
     
+    /**
+     * @brief Check if neuron has a specific interned tag
+     * @param tag Symbol of the tag
+     * @return True if neuron has the tag
+     */
+    bool hasTag(Symbol tag) const;
+    
     /**
      * @brief Get all tags for this neuron
      * @return Vector of tags
      */
     std::vector<std::string> getTags() const;
     
+    /**
+     * @brief Get all tags for this neuron as interned symbols
+     * @return Tag symbols, in the order they were added
+     */
+    const std::vector<Symbol>& getTagSymbols() const;
+    
     /**
      * @brief Set neuron metadata
      * @param key Metadata key
@@ -157,6 +215,13 @@ public:
      */
     void setMetadata(const std::string& key, const std::string& value);
     
+    /**
+     * @brief Set neuron metadata under an interned key
+     * @param key Symbol of the metadata key
+     * @param value Metadata value
+     */
+    void setMetadata(Symbol key, const std::string& value);
+    
     /**
      * @brief Get neuron metadata
      * @param key Metadata key
@@ -164,6 +229,13 @@ public:
      */
     std::string getMetadata(const std::string& key) const;
     
+    /**
+     * @brief Get neuron metadata under an interned key
+     * @param key Symbol of the metadata key
+     * @return Metadata value or empty string if not found
+     */
+    std::string getMetadata(Symbol key) const;
+    
     /**
      * @brief Check if this neuron has a specific metadata key
      * @param key The key to check
@@ -171,6 +243,13 @@ public:
      */
     bool hasMetadata(const std::string& key) const;
     
+    /**
+     * @brief Check if this neuron has a specific interned metadata key
+     * @param key Symbol of the metadata key
+     * @return True if the metadata key exists
+     */
+    bool hasMetadata(Symbol key) const;
+    
     /**
      * @brief Get current activation potential
      * @return Activation potential (0.0 to 1.0)
@@ -216,39 +295,137 @@ public:
      */
     bool setConnectionWeight(std::shared_ptr<Neuron> target, float weight);
     
+    /**
+     * @brief Get the delivery delay of a connection
+     * @param target The target neuron
+     * @return The delay in ticks or 0 if not connected
+     */
+    uint32_t getConnectionDelay(std::shared_ptr<Neuron> target) const;
+    
+    /**
+     * @brief Set the delivery delay of a connection
+     * @param target The target neuron
+     * @param ticks Delay in ticks (at least 1, clamped to the core's maximum delay)
+     * @return True if connection exists and delay was updated
+     */
+    bool setConnectionDelay(std::shared_ptr<Neuron> target, uint32_t ticks);
+    
 private:
+    friend class SimulationCore;
+    friend class Network;
+    friend class NetworkSnapshot;
+    friend class NeuronGate;
+    friend class GateTable;
+    
     std::string id;                // Unique identifier
     NeuronType type;               // Neuron type
-    NeuronState state;             // Current state
-    float threshold;               // Activation threshold
-    float potential;               // Current activation potential
     bool refractoryPeriod;         // Whether in refractory period
     
-    std::vector<std::shared_ptr<Synapse>> inputSignals;  // Accumulated input signals
-    std::vector<std::shared_ptr<Synapse>> outputSignals; // Output signals
+    std::shared_ptr<SimulationCore> core;  // Storage for potential, threshold and state
+    uint32_t index;                        // Slot of this neuron in the core
+    
+    /**
+     * @brief A signal that went through the gates
+     * 
+     * Without gate tracing, a signal a gate let through is kept as the
+     * input signal plus the strength the gate gave it, instead of a
+     * derived synapse; it counts and fires as the derived synapse would.
+     */
+    struct GatedSignal {
+        SynapsePtr signal;   // The signal, or the input a gate let through
+        float gateStrength;  // Strength given by the gate, negative if signal is used as is
+        
+        /**
+         * @brief Get the strength the signal adds to the potential
+         * @return Payload strength
+         */
+        float getPayloadStrength() const;
+        
+        /**
+         * @brief Derive the synapse to send on
+         * @return New synapse with the signal's tags and strength
+         */
+        SynapsePtr derive() const;
+    };
     
-    std::map<std::shared_ptr<Neuron>, float> connections;  // Outgoing connections with weights
-    std::vector<std::weak_ptr<Neuron>> inputs;             // Incoming connections (weak to avoid circular references)
+    std::vector<SynapsePtr> inputSignals;  // Accumulated input signals
+    std::vector<GatedSignal> processedSignals; // Integrated signals awaiting commit
+    std::vector<GatedSignal> outputSignals; // Output signals
     
-    std::vector<std::string> tags;                   // Tags for categorization
-    std::map<std::string, std::string> metadata;     // Additional metadata
+    std::vector<Symbol> tags;                                // Tags for categorization
+    std::vector<std::pair<Symbol, std::string>> metadata;    // Additional metadata, in insertion order
     
     std::vector<std::shared_ptr<NeuronGate>> gates;  // Signal processing gates
+    GateChain gateChain;                             // Active gates compiled for routing
+    bool gateChainStale;                             // Whether gateChain must be recompiled
     
     // Callbacks
     std::vector<std::function<void(std::shared_ptr<Neuron>)>> fireCallbacks;
     std::vector<std::function<void(std::shared_ptr<Neuron>, NeuronState, NeuronState)>> stateChangeCallbacks;
     
+    /**
+     * @brief Find the metadata entry for a key
+     * @param key Symbol of the metadata key
+     * @return The entry or nullptr if not found
+     */
+    const std::pair<Symbol, std::string>* findMetadata(Symbol key) const;
+    
+    /**
+     * @brief Add a gate to the end of the chain
+     * @param gate The gate; it must not belong to another neuron
+     */
+    void addGate(std::shared_ptr<NeuronGate> gate);
+    
+    /**
+     * @brief Recompile the gate chain before the next signals are gated
+     */
+    void invalidateGateChain() { gateChainStale = true; }
+    
     /**
      * @brief Reset the neuron to resting state
      */
     void reset();
     
     /**
-     * @brief Integrate incoming signals
+     * @brief Integrate incoming signals (first phase of a tick)
+     * 
+     * Runs the input signals through the gates and updates the potential.
+     * Only touches this neuron's own state, so different neurons may
+     * integrate concurrently.
+     * 
      * @return True if threshold is exceeded
      */
     bool integrate();
+    
+    /**
+     * @brief Gate incoming signals and stage their current in the core
+     * 
+     * The first half of integrate(): the potential is left to the core's
+     * integration kernel, which updates many staged neurons at once.
+     * 
+     * @return True if input was staged
+     */
+    bool stageInput();
+    
+    /**
+     * @brief Run the input signals through the gates into processedSignals
+     * 
+     * A compiled gate chain routes all signals in one call. Otherwise
+     * each gate evaluates the signals no earlier gate took in a single
+     * batch call, and gates without a batch kernel fall back to process()
+     * per signal.
+     */
+    void applyGates();
+    
+    /**
+     * @brief Fire and pass on the integrated signals (second phase of a tick)
+     * 
+     * Runs callbacks and queues outgoing signals, so ticks call it for one
+     * neuron at a time in execution order.
+     * 
+     * @param thresholdReached Result of the preceding integrate()
+     */
+    void commit(bool thresholdReached);
 };
 
 #endif // NEURON_H
@@ -6,19 +6,26 @@
  * between neurons, as described in the Ozone (O3) architecture.
  * These gates are inspired by logic gates but can be dynamically
  * reconfigured based on data flow.
+ * 
+ * Gate parameters are stored in a GateTable; a gate object is a handle
+ * to its slot there (see gate_table.h).
  */
 
 #ifndef NEURON_GATE_H
 #define NEURON_GATE_H
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <string>
 #include <functional>
+#include "gate_table.h"
 #include "synapse.h"
 
-// Forward declaration
+// Forward declarations
 class CustomGate;
+class Neuron;
 
 /**
  * @brief Base class for all neuron gates
@@ -38,6 +45,26 @@ public:
         CUSTOM      // Custom - user-defined processing
     };
     
+    /**
+     * @brief Turn recording of gate provenance on or off
+     * 
+     * With tracing on, every signal a gate lets through becomes a derived
+     * synapse carrying gate_id, gate_type and the gate_processed tag. With
+     * tracing off (the default), process() results carry no gate
+     * information, and neurons keep a passing signal together with the
+     * strength the gate gave it instead of deriving a synapse; strengths
+     * and firing are the same either way.
+     * 
+     * @param enabled True to record provenance
+     */
+    static void setTracing(bool enabled);
+    
+    /**
+     * @brief Check whether gate provenance is recorded
+     * @return True if tracing is on
+     */
+    static bool isTracing();
+    
     /**
      * @brief Constructor for NeuronGate
      * @param id Unique identifier
@@ -50,6 +77,9 @@ public:
      */
     virtual ~NeuronGate();
     
+    NeuronGate(const NeuronGate&) = delete;
+    NeuronGate& operator=(const NeuronGate&) = delete;
+    
     /**
      * @brief Get the gate type
      * @return The gate type
@@ -74,12 +104,44 @@ public:
      */
     float getThreshold() const;
     
+    /**
+     * @brief Set the step by which adapt() moves the threshold
+     * @param rate The adaptation rate
+     */
+    void setAdaptationRate(float rate);
+    
+    /**
+     * @brief Get the step by which adapt() moves the threshold
+     * @return The adaptation rate
+     */
+    float getAdaptationRate() const;
+    
     /**
      * @brief Adapt the gate based on success/failure
+     * 
+     * To adapt all gates of a network at once, use GateTable::adaptAll()
+     * or Network::adaptGates().
+     * 
      * @param success Whether the gate's operation was successful
      */
     virtual void adapt(bool success);
     
+    /**
+     * @brief Get the table holding the gate's parameters
+     * 
+     * This is the table of the owning neuron's core, or a private table
+     * if the gate belongs to no neuron.
+     * 
+     * @return The table
+     */
+    GateTable& getTable() const;
+    
+    /**
+     * @brief Get the gate's slot in its table
+     * @return Slot index
+     */
+    uint32_t getSlot() const;
+    
     /**
      * @brief Check if the gate is active
      * @return True if active, false otherwise
@@ -88,6 +150,9 @@ public:
     
     /**
      * @brief Set the gate's active state
+     * 
+     * Changing it makes the owning neuron recompile its gate chain.
+     * 
      * @param active The new active state
      */
     void setActive(bool active);
@@ -97,14 +162,64 @@ public:
      * @param inputs Vector of input synapses
      * @return Output synapse after processing
      */
-    virtual std::shared_ptr<Synapse> process(const std::vector<std::shared_ptr<Synapse>>& inputs) = 0;
+    virtual SynapsePtr process(const std::vector<SynapsePtr>& inputs) = 0;
+    
+    /**
+     * @brief Evaluate the gate on a batch of independent signals
+     * 
+     * Each entry is treated like a signal processed on its own, i.e. like
+     * process() with that signal as the only input: outputs[i] receives the
+     * strength of the result and passed[i] whether the gate lets the signal
+     * through. An inactive gate lets nothing through.
+     * 
+     * @param strengths Strength of each signal
+     * @param count Number of signals
+     * @param outputs Receives the output strength of each signal
+     * @param passed Receives 1 for each signal the gate lets through, 0 otherwise
+     * @return False if the gate has no batch evaluation and needs process() per signal
+     */
+    bool evaluate(const float* strengths, size_t count, float* outputs, uint8_t* passed) const;
+    
+    /**
+     * @brief Create the synapse a passing signal turns into
+     * @param input The signal that passed the gate
+     * @param strength Output strength from evaluate()
+     * @return Derived synapse, carrying the gate information while tracing
+     */
+    SynapsePtr createResult(const SynapsePtr& input, float strength) const;
     
 protected:
+    friend class Neuron;
+    friend class GateTable;
+    
     std::string id;  // Unique identifier
     GateType type;   // Gate type
-    float threshold; // Activation threshold
-    bool active;     // Whether the gate is active
-    float adaptationRate; // Rate of adaptation
+    std::shared_ptr<GateTable> table;  // Table holding the parameters
+    uint32_t slot;   // Slot in the table
+    Neuron* owner;   // Neuron the gate belongs to (nullptr if none)
+    
+    /**
+     * @brief Batch kernel behind evaluate(), called for active gates only
+     * @param strengths Strength of each signal
+     * @param count Number of signals
+     * @param outputs Receives the output strength of each signal
+     * @param passed Receives 1 for each signal the gate lets through, 0 otherwise
+     * @return False if the gate has no batch kernel (the default)
+     */
+    virtual bool evaluateBatch(const float* strengths, size_t count, float* outputs, uint8_t* passed) const;
+    
+    /**
+     * @brief Process one signal through the batch kernel, whether or not the gate is active
+     * @param input The signal
+     * @return Result synapse, or nullptr if the gate does not let it through
+     */
+    SynapsePtr processSingle(const SynapsePtr& input) const;
+    
+    /**
+     * @brief Record the gate information on a result
+     * @param result Synapse produced by the gate
+     */
+    virtual void annotate(Synapse& result) const;
 };
 
 /**
@@ -123,7 +238,13 @@ public:
      * @param inputs Vector of input synapses
      * @return Output synapse after processing
      */
-    std::shared_ptr<Synapse> process(const std::vector<std::shared_ptr<Synapse>>& inputs) override;
+    SynapsePtr process(const std::vector<SynapsePtr>& inputs) override;
+
+protected:
+    /**
+     * @brief Batch kernel, see NeuronGate::evaluate()
+     */
+    bool evaluateBatch(const float* strengths, size_t count, float* outputs, uint8_t* passed) const override;
 };
 
 /**
@@ -142,7 +263,13 @@ public:
      * @param inputs Vector of input synapses
      * @return Output synapse after processing
      */
-    std::shared_ptr<Synapse> process(const std::vector<std::shared_ptr<Synapse>>& inputs) override;
+    SynapsePtr process(const std::vector<SynapsePtr>& inputs) override;
+
+protected:
+    /**
+     * @brief Batch kernel, see NeuronGate::evaluate()
+     */
+    bool evaluateBatch(const float* strengths, size_t count, float* outputs, uint8_t* passed) const override;
 };
 
 /**
@@ -161,7 +288,13 @@ public:
      * @param inputs Vector of input synapses
      * @return Output synapse after processing
      */
-    std::shared_ptr<Synapse> process(const std::vector<std::shared_ptr<Synapse>>& inputs) override;
+    SynapsePtr process(const std::vector<SynapsePtr>& inputs) override;
+
+protected:
+    /**
+     * @brief Batch kernel, see NeuronGate::evaluate()
+     */
+    bool evaluateBatch(const float* strengths, size_t count, float* outputs, uint8_t* passed) const override;
 };
 
 /**
@@ -180,7 +313,13 @@ public:
      * @param inputs Vector of input synapses
      * @return Output synapse after processing
      */
-    std::shared_ptr<Synapse> process(const std::vector<std::shared_ptr<Synapse>>& inputs) override;
+    SynapsePtr process(const std::vector<SynapsePtr>& inputs) override;
+
+protected:
+    /**
+     * @brief Batch kernel, see NeuronGate::evaluate()
+     */
+    bool evaluateBatch(const float* strengths, size_t count, float* outputs, uint8_t* passed) const override;
 };
 
 /**
@@ -200,7 +339,13 @@ public:
      * @param inputs Vector of input synapses
      * @return Output synapse after processing
      */
-    std::shared_ptr<Synapse> process(const std::vector<std::shared_ptr<Synapse>>& inputs) override;
+    SynapsePtr process(const std::vector<SynapsePtr>& inputs) override;
+
+protected:
+    /**
+     * @brief Batch kernel, see NeuronGate::evaluate()
+     */
+    bool evaluateBatch(const float* strengths, size_t count, float* outputs, uint8_t* passed) const override;
 };
 
 /**
@@ -220,7 +365,7 @@ public:
      * @param inputs Vector of input synapses
      * @return Output synapse after processing
      */
-    std::shared_ptr<Synapse> process(const std::vector<std::shared_ptr<Synapse>>& inputs) override;
+    SynapsePtr process(const std::vector<SynapsePtr>& inputs) override;
     
     /**
      * @brief Set the modulation factor
@@ -234,8 +379,16 @@ public:
      */
     float getFactor() const;
     
-private:
-    float factor;  // Modulation factor
+protected:
+    /**
+     * @brief Batch kernel, see NeuronGate::evaluate()
+     */
+    bool evaluateBatch(const float* strengths, size_t count, float* outputs, uint8_t* passed) const override;
+    
+    /**
+     * @brief Record the gate information and the modulation factor
+     */
+    void annotate(Synapse& result) const override;
 };
 
 /**
@@ -249,23 +402,23 @@ public:
      * @param processor Function that processes inputs to produce output
      */
     CustomGate(const std::string& id, 
-               std::function<std::shared_ptr<Synapse>(const std::vector<std::shared_ptr<Synapse>>&)> processor);
+               std::function<SynapsePtr(const std::vector<SynapsePtr>&)> processor);
     
     /**
      * @brief Process inputs through custom logic
      * @param inputs Vector of input synapses
      * @return Output synapse after processing
      */
-    std::shared_ptr<Synapse> process(const std::vector<std::shared_ptr<Synapse>>& inputs) override;
+    SynapsePtr process(const std::vector<SynapsePtr>& inputs) override;
     
     /**
      * @brief Set the processor function
      * @param processor Function that processes inputs to produce output
      */
-    void setProcessor(const std::function<std::shared_ptr<Synapse>(const std::vector<std::shared_ptr<Synapse>>&)>& processor);
+    void setProcessor(const std::function<SynapsePtr(const std::vector<SynapsePtr>&)>& processor);
 
 private:
-    std::function<std::shared_ptr<Synapse>(const std::vector<std::shared_ptr<Synapse>>&)> processor;
+    std::function<SynapsePtr(const std::vector<SynapsePtr>&)> processor;
 };
 
 /**
@@ -289,7 +442,7 @@ public:
      */
     static std::shared_ptr<CustomGate> createCustomGate(
         const std::string& id,
-        std::function<std::shared_ptr<Synapse>(const std::vector<std::shared_ptr<Synapse>>&)> processor);
+        std::function<SynapsePtr(const std::vector<SynapsePtr>&)> processor);
 };
 
 #endif // NEURON_GATE_H
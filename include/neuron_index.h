@@ -0,0 +1,289 @@
+/**
+ * @file neuron_index.h
+ * @brief Secondary indexes over the neurons of a simulation core.
+ *
+ * The index keeps one posting per neuron type, per tag and per metadata
+ * key, listing the core slots that carry it, plus one listing the slots
+ * whose neuron is a member of the network owning the core (a core also
+ * holds outside neurons connected to its members); queries only return
+ * members. A posting starts as a sorted list of slots and
+ * turns into a bitset once it covers more than one slot in 32, where the
+ * bitset is the smaller of the two. Queries combine postings (tags that
+ * must or must not be present, types that are allowed or excluded) without
+ * looking at the neuron objects: a sparse posting drives the evaluation
+ * and the others are probed per slot, otherwise the bitsets are combined
+ * a word at a time.
+ *
+ * The index also counts, per tag or metadata key, the members carrying
+ * it. With presence tracking on, it records every symbol that appears on
+ * its first member or disappears with its last, so consumers such as
+ * pattern matchers can follow changes without rescanning.
+ */
+
+#ifndef NEURON_INDEX_H
+#define NEURON_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "neuron.h"
+#include "symbol_table.h"
+
+/**
+ * @brief Boolean filter over neuron tags and types
+ *
+ * A neuron matches if it carries every required tag, none of the excluded
+ * tags, and has one of the allowed types. Without any ofType() call every
+ * type is allowed.
+ */
+class NeuronQuery {
+public:
+    /**
+     * @brief Constructor for a query that matches every neuron
+     */
+    NeuronQuery();
+
+    /**
+     * @brief Require a tag
+     * @param tag The tag (a tag that was never used makes the query match nothing)
+     * @return This query
+     */
+    NeuronQuery& withTag(const std::string& tag);
+    NeuronQuery& withTag(Symbol tag);
+
+    /**
+     * @brief Exclude neurons carrying a tag
+     * @param tag The tag
+     * @return This query
+     */
+    NeuronQuery& withoutTag(const std::string& tag);
+    NeuronQuery& withoutTag(Symbol tag);
+
+    /**
+     * @brief Allow a neuron type; repeated calls allow any of the types
+     * @param type The type
+     * @return This query
+     */
+    NeuronQuery& ofType(Neuron::NeuronType type);
+
+    /**
+     * @brief Exclude a neuron type
+     * @param type The type
+     * @return This query
+     */
+    NeuronQuery& notOfType(Neuron::NeuronType type);
+
+    /**
+     * @brief Get the tags a neuron must carry
+     * @return Required tag symbols (INVALID_SYMBOL for an unknown tag)
+     */
+    const std::vector<Symbol>& getRequiredTags() const { return requiredTags; }
+
+    /**
+     * @brief Get the tags a neuron must not carry
+     * @return Excluded tag symbols
+     */
+    const std::vector<Symbol>& getExcludedTags() const { return excludedTags; }
+
+    /**
+     * @brief Get the types a neuron may have
+     * @return Bit mask with bit n set for the NeuronType of value n
+     */
+    uint32_t getTypeMask() const;
+
+private:
+    std::vector<Symbol> requiredTags;  // Tags every match carries
+    std::vector<Symbol> excludedTags;  // Tags no match carries
+    uint32_t allowedTypes;             // Types named by ofType (0 for all)
+    uint32_t excludedTypes;            // Types named by notOfType
+};
+
+/**
+ * @brief Type and tag postings over the slots of a simulation core
+ */
+class NeuronIndex {
+public:
+    /**
+     * @brief Constructor for an empty NeuronIndex
+     */
+    NeuronIndex();
+
+    /**
+     * @brief Set the number of slots the index covers
+     * @param capacity Upper bound of slot indices
+     */
+    void resize(uint32_t capacity);
+
+    /**
+     * @brief Index a newly occupied slot under its type
+     * @param slot Slot index
+     * @param type Type of the neuron in the slot
+     */
+    void insert(uint32_t slot, Neuron::NeuronType type);
+
+    /**
+     * @brief Record that the neuron in a slot is a member of the owning network
+     * @param slot Slot index (membership ends when the slot is erased)
+     * @param slotTags Tags of the neuron in the slot
+     * @param slotKeys Metadata keys of the neuron in the slot
+     */
+    void addMember(uint32_t slot, const std::vector<Symbol>& slotTags, const std::vector<Symbol>& slotKeys);
+
+    /**
+     * @brief Check whether the neuron in a slot is a member of the owning network
+     * @param slot Slot index
+     * @return True if the slot was added as a member
+     */
+    bool isMember(uint32_t slot) const { return members.contains(slot); }
+
+    /**
+     * @brief Remove a slot from the index
+     *
+     * Erase the slot's metadata keys first, while it still counts as a member.
+     *
+     * @param slot Slot index
+     * @param type Type of the neuron in the slot
+     * @param tags Tags of the neuron in the slot
+     */
+    void erase(uint32_t slot, Neuron::NeuronType type, const std::vector<Symbol>& tags);
+
+    /**
+     * @brief Index a slot under a tag
+     * @param slot Slot index
+     * @param tag Symbol of the tag
+     */
+    void addTag(uint32_t slot, Symbol tag);
+
+    /**
+     * @brief Index a slot under a metadata key
+     * @param slot Slot index
+     * @param key Symbol of the metadata key
+     */
+    void addMetadataKey(uint32_t slot, Symbol key);
+
+    /**
+     * @brief Remove a slot from the posting of a metadata key
+     * @param slot Slot index
+     * @param key Symbol of the metadata key
+     */
+    void eraseMetadataKey(uint32_t slot, Symbol key);
+
+    /**
+     * @brief Drop every posting
+     */
+    void clear();
+
+    /**
+     * @brief Turn recording of presence changes on or off
+     * @param enabled True to record, false to stop and forget recorded changes
+     */
+    void setPresenceTracking(bool enabled);
+
+    /**
+     * @brief Take the symbols whose presence may have changed since the last call
+     *
+     * A symbol is listed when it became a tag or metadata key of some
+     * member while no member had it, or stopped being one of the last
+     * member that had it. It may be listed more than once and may have changed
+     * back; compare isPresent() with the previous state.
+     *
+     * @param symbols Receives the symbols (cleared first)
+     */
+    void takePresenceChanges(std::vector<Symbol>& symbols);
+
+    /**
+     * @brief Get the number of slots holding a type
+     * @param type The type
+     * @return Slot count
+     */
+    size_t countType(Neuron::NeuronType type) const;
+
+    /**
+     * @brief Get the number of slots carrying a tag
+     * @param tag Symbol of the tag
+     * @return Slot count
+     */
+    size_t countTag(Symbol tag) const;
+
+    /**
+     * @brief Get the number of slots with a metadata key
+     * @param key Symbol of the metadata key
+     * @return Slot count
+     */
+    size_t countMetadataKey(Symbol key) const;
+
+    /**
+     * @brief Check whether any member carries a symbol as a tag or metadata key
+     * @param symbol The symbol
+     * @return True if some member has it
+     */
+    bool isPresent(Symbol symbol) const { return memberCounts.find(symbol) != memberCounts.end(); }
+
+    /**
+     * @brief Find the member slots matching a query
+     * @param query The filter
+     * @param slots Receives the matching slots in increasing order (cleared first)
+     */
+    void select(const NeuronQuery& query, std::vector<uint32_t>& slots) const;
+
+private:
+    /**
+     * @brief Set of slots stored as a sorted list or a bitset, whichever is smaller
+     */
+    class Posting {
+    public:
+        Posting();
+
+        void insert(uint32_t slot, uint32_t capacity);
+        void erase(uint32_t slot);
+        bool contains(uint32_t slot) const;
+
+        size_t size() const { return count; }
+        bool isDense() const { return dense; }
+        const std::vector<uint32_t>& list() const { return slots; }
+        uint64_t word(size_t position) const { return position < bits.size() ? bits[position] : 0; }
+
+    private:
+        std::vector<uint32_t> slots;  // Sorted slots while sparse
+        std::vector<uint64_t> bits;   // One bit per slot once dense
+        size_t count;                 // Number of slots in the set
+        bool dense;                   // Whether bits is in use
+    };
+
+    static const size_t TYPE_COUNT = static_cast<size_t>(Neuron::NeuronType::REGULATORY) + 1;
+
+    using PostingMap = std::unordered_map<Symbol, Posting>;
+
+    std::vector<Posting> types;                    // Posting per NeuronType
+    Posting members;                               // Slots of network members
+    PostingMap tags;                               // Posting per tag
+    PostingMap keys;                               // Posting per metadata key
+    std::unordered_map<Symbol, uint32_t> memberCounts;  // Tag and key occurrences on members (absent if none)
+    uint32_t capacity;                             // Slots covered
+    bool tracking;                                 // Whether presence changes are recorded
+    std::vector<Symbol> presenceChanges;           // Symbols that appeared or disappeared (while tracking)
+
+    /**
+     * @brief Add a slot to the posting of a symbol, counting it if the slot is a member
+     */
+    void insertPosting(PostingMap& postings, uint32_t slot, Symbol symbol);
+
+    /**
+     * @brief Remove a slot from the posting of a symbol, uncounting it if the slot is a member
+     */
+    void erasePosting(PostingMap& postings, uint32_t slot, Symbol symbol);
+
+    /**
+     * @brief Count one more member occurrence of a symbol, recording a first appearance
+     */
+    void countMember(Symbol symbol);
+
+    /**
+     * @brief Count one less member occurrence of a symbol, recording a disappearance
+     */
+    void uncountMember(Symbol symbol);
+};
+
+#endif // NEURON_INDEX_H
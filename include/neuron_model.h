@@ -0,0 +1,108 @@
+/**
+ * @file neuron_model.h
+ * @brief Membrane dynamics shared by the neurons of a network.
+ *
+ * The default model accumulates input without loss and lets a neuron that
+ * fired take input again in the next tick. The leaky integrate-and-fire
+ * model adds a membrane time constant, so the potential decays towards 0
+ * between inputs, an absolute refractory period during which input is
+ * discarded, and the potential a neuron is reset to after firing.
+ *
+ * Both are evaluated lazily: a neuron's potential and refractory period are
+ * only brought up to date when it receives input or is inspected, using the
+ * closed form exp(-elapsed * tickDuration / membraneTimeConstant) of the
+ * decay, so a neuron without input costs nothing per tick.
+ */
+
+#ifndef NEURON_MODEL_H
+#define NEURON_MODEL_H
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Membrane dynamics of a network's neurons
+ */
+class NeuronModel {
+public:
+    /**
+     * @brief Available models
+     */
+    enum class Kind {
+        ACCUMULATE,               // No decay, no refractory period
+        LEAKY_INTEGRATE_AND_FIRE  // Exponential decay and absolute refractory period
+    };
+
+    /**
+     * @brief Constructor for the default accumulating model
+     */
+    NeuronModel();
+
+    /**
+     * @brief Create a leaky integrate-and-fire model
+     * @param membraneTimeConstant Time for the potential to decay to 1/e, in the unit of tickDuration
+     *                             (a non-positive value disables the decay)
+     * @param refractoryTicks Ticks after firing during which input is discarded
+     * @param resetPotential Potential after firing, within [0, 1]
+     * @param tickDuration Simulated time per tick
+     * @return The model
+     */
+    static NeuronModel leakyIntegrateAndFire(float membraneTimeConstant, uint32_t refractoryTicks,
+                                             float resetPotential = 0.0f, float tickDuration = 1.0f);
+
+    /**
+     * @brief Get the kind of model
+     * @return Model kind
+     */
+    Kind getKind() const { return kind; }
+
+    /**
+     * @brief Get the membrane time constant
+     * @return Time constant, 0 if the potential does not decay
+     */
+    float getMembraneTimeConstant() const { return membraneTimeConstant; }
+
+    /**
+     * @brief Get the absolute refractory period
+     * @return Ticks after firing during which input is discarded
+     */
+    uint32_t getRefractoryTicks() const { return refractoryTicks; }
+
+    /**
+     * @brief Get the potential a neuron is reset to after firing
+     * @return Reset potential
+     */
+    float getResetPotential() const { return resetPotential; }
+
+    /**
+     * @brief Get the simulated time per tick
+     * @return Tick duration
+     */
+    float getTickDuration() const { return tickDuration; }
+
+    /**
+     * @brief Get the factor a potential decays by over a number of ticks
+     * @param ticks Elapsed ticks
+     * @return Decay factor in (0, 1], 1 for no decay
+     */
+    float getDecay(uint64_t ticks) const {
+        return ticks < decayTable.size() ? decayTable[ticks] : computeDecay(ticks);
+    }
+
+private:
+    Kind kind;                      // Model kind
+    float membraneTimeConstant;     // Decay time constant (0 for none)
+    uint32_t refractoryTicks;       // Absolute refractory period
+    float resetPotential;           // Potential after firing
+    float tickDuration;             // Simulated time per tick
+    std::vector<float> decayTable;  // Decay over 0..n-1 ticks, the common case
+
+    /**
+     * @brief Evaluate the decay for a gap beyond the table
+     * @param ticks Elapsed ticks
+     * @return Decay factor
+     */
+    float computeDecay(uint64_t ticks) const;
+};
+
+#endif // NEURON_MODEL_H
@@ -0,0 +1,539 @@
+/**
+ * @file simulation_core.h
+ * @brief Structure-of-arrays storage for the hot state of neurons.
+ *
+ * The simulation core keeps the per-tick state of every neuron (potential,
+ * threshold, state, type and pending input count) in contiguous arrays
+ * indexed by a dense 32-bit neuron index. Neuron objects act as thin
+ * handles into this storage, so a network tick walks flat arrays instead
+ * of scattered heap objects. Connections between neurons of a core are kept
+ * in its CSR edge store, and signals travelling along them wait in its
+ * delivery queue until the tick they are due.
+ *
+ * Potentials follow the core's neuron model. Each slot remembers the tick
+ * its potential was last brought up to date and the tick its refractory
+ * period ends; decay and refractory expiry are applied when the slot next
+ * receives input, so slots without input are never touched. With activity
+ * tracking on, the core also lists the slots that have queued input, so an
+ * event-driven tick finds its work without scanning every slot.
+ *
+ * Neurons created outside a network start in a private core. Connecting two
+ * neurons from different cores merges the cores, so a core always holds a
+ * connected group of neurons; a core owned by a network is pinned and never
+ * merged into another core.
+ */
+
+#ifndef SIMULATION_CORE_H
+#define SIMULATION_CORE_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "neuron.h"
+#include "gate_table.h"
+#include "edge_store.h"
+#include "delivery_queue.h"
+#include "neuron_index.h"
+#include "neuron_model.h"
+
+/**
+ * @brief Contiguous per-neuron state shared by all neurons of a network
+ */
+class SimulationCore : public std::enable_shared_from_this<SimulationCore> {
+public:
+    /**
+     * @brief Marker for an index that does not refer to a neuron
+     */
+    static const uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+    /**
+     * @brief Layer membership flags of a slot, set by the owning network
+     */
+    enum Role : uint8_t {
+        ROLE_INPUT = 1,   // Member of the input layer
+        ROLE_OUTPUT = 2   // Member of the output layer
+    };
+
+    /**
+     * @brief Constructor for SimulationCore
+     */
+    SimulationCore();
+
+    /**
+     * @brief Reserve storage for a number of neurons
+     * @param count Number of neurons to reserve room for
+     */
+    void reserve(size_t count);
+
+    /**
+     * @brief Allocate a slot for a neuron
+     * @param handle The neuron object that owns the slot
+     * @param type Type of the neuron
+     * @param threshold Initial activation threshold
+     * @return Dense index of the new slot
+     */
+    uint32_t allocate(Neuron* handle, Neuron::NeuronType type, float threshold);
+
+    /**
+     * @brief Release a slot so it can be reused
+     * @param index Index of the slot to release
+     */
+    void release(uint32_t index);
+
+    /**
+     * @brief Move a neuron, together with the core it lives in, into this core
+     * @param neuron The neuron to adopt
+     * @return True if the neuron now lives in this core
+     */
+    bool adopt(Neuron& neuron);
+
+    /**
+     * @brief Move every neuron and edge of another core into this one
+     * @param other The core to absorb; it is left empty
+     */
+    void merge(SimulationCore& other);
+
+    /**
+     * @brief Make sure two neurons share a core so they can be connected
+     * @param a First neuron
+     * @param b Second neuron
+     * @return True if both neurons live in the same core afterwards
+     */
+    static bool unify(Neuron& a, Neuron& b);
+
+    /**
+     * @brief Move a neuron out of its core into a private core of its own
+     * @param neuron The neuron to detach; its connections are dropped
+     */
+    static void detach(Neuron& neuron);
+
+    /**
+     * @brief Mark the core as owned by a network
+     * @param pinned True if the core must not be merged into another core
+     */
+    void setPinned(bool pinned) { this->pinned = pinned; }
+
+    /**
+     * @brief Check whether the core is owned by a network
+     * @return True if the core is pinned
+     */
+    bool isPinned() const { return pinned; }
+
+    /**
+     * @brief Get the connections between neurons of this core
+     * @return Reference to the edge store
+     */
+    EdgeStore& edges() { return edgeStore; }
+    const EdgeStore& edges() const { return edgeStore; }
+
+    /**
+     * @brief Get the parameters of the gates of this core's neurons
+     * @return Reference to the gate table
+     */
+    GateTable& gateParameters() { return *gateTable; }
+    const GateTable& gateParameters() const { return *gateTable; }
+
+    /**
+     * @brief Get the number of slots (including released ones)
+     * @return Upper bound of valid indices
+     */
+    uint32_t capacity() const { return static_cast<uint32_t>(handles.size()); }
+
+    /**
+     * @brief Get the number of live neurons
+     * @return Count of occupied slots
+     */
+    size_t size() const { return handles.size() - freeSlots.size(); }
+
+    /**
+     * @brief Get the neuron object stored at an index
+     * @param index Slot index
+     * @return Neuron handle or nullptr for a released slot
+     */
+    Neuron* handle(uint32_t index) const { return handles[index]; }
+
+    /**
+     * @brief Get the type, tag and metadata key indexes of the neurons in this core
+     * @return Reference to the neuron index
+     */
+    NeuronIndex& neuronIndex() { return indexes; }
+    const NeuronIndex& neuronIndex() const { return indexes; }
+
+    /**
+     * @brief Record that a neuron of this core is a member of the owning network
+     *
+     * Membership ends when the slot is released. Neurons merged into the
+     * core only because a member connects to them are not members.
+     *
+     * @param slot Slot index
+     */
+    void indexMember(uint32_t slot);
+
+    /**
+     * @brief Record that a neuron of this core gained a tag
+     * @param slot Slot index
+     * @param tag Symbol of the tag
+     */
+    void indexTag(uint32_t slot, Symbol tag) { indexes.addTag(slot, tag); }
+
+    /**
+     * @brief Record that a neuron of this core gained a metadata key
+     * @param slot Slot index
+     * @param key Symbol of the metadata key
+     */
+    void indexMetadataKey(uint32_t slot, Symbol key) { indexes.addMetadataKey(slot, key); }
+
+    /**
+     * @brief Get the queue of signals waiting for delivery
+     * @return Reference to the delivery queue
+     */
+    DeliveryQueue& signalQueue() { return queue; }
+    const DeliveryQueue& signalQueue() const { return queue; }
+
+    /**
+     * @brief Queue a signal for a neuron of this core
+     * @param target Index of the receiving neuron
+     * @param signal The signal to deliver
+     * @param delay Ticks until delivery
+     * @return True if queued, false if it was dropped
+     */
+    bool scheduleSignal(uint32_t target, SynapsePtr signal, uint32_t delay) {
+        return queue.schedule(target, generations[target], std::move(signal), delay);
+    }
+
+    /**
+     * @brief Send a signal along a connection of this core
+     *
+     * While slot levels are set, a connection to a higher level delivers
+     * one tick earlier than its delay says: with the default delay of one
+     * tick the target receives the signal right away, in the tick it was
+     * fired. Other connections queue the signal for its full delay.
+     *
+     * @param source Index of the sending neuron
+     * @param target Index of the receiving neuron
+     * @param signal The signal to deliver
+     * @param delay Delay of the connection in ticks
+     * @return True if delivered or queued, false if it was dropped
+     */
+    bool sendSignal(uint32_t source, uint32_t target, SynapsePtr signal, uint32_t delay) {
+        if (target < levels.size() && source < levels.size() && levels[target] > levels[source]) {
+            if (delay <= 1 && handles[target]) {
+                handles[target]->receiveSignal(std::move(signal));
+                return true;
+            }
+            --delay;
+        }
+        return scheduleSignal(target, std::move(signal), delay);
+    }
+
+    /**
+     * @brief Set the level of each slot, enabling same-tick delivery
+     * @param levels Level per slot as computed by EdgeStore::levelize(), or empty to disable
+     */
+    void setLevels(std::vector<uint32_t> levels) { this->levels = std::move(levels); }
+
+    /**
+     * @brief Get the level of a slot
+     * @param index Slot index
+     * @return Level, 0 if levels are not set or the slot is newer than them
+     */
+    uint32_t level(uint32_t index) const { return index < levels.size() ? levels[index] : 0; }
+
+    /**
+     * @brief Hand every signal due in the current tick to its target neuron
+     */
+    void deliverDueSignals();
+
+    /**
+     * @brief Move the delivery queue on to the next tick
+     */
+    void advanceTick() { queue.advance(); }
+
+    /**
+     * @brief Get the current tick
+     * @return Number of ticks advanced so far
+     */
+    uint64_t getTick() const { return queue.getTick(); }
+
+    /**
+     * @brief Restart the tick count, e.g. when restoring a saved network
+     * @param tick The new current tick; pending signals are discarded
+     */
+    void restartTick(uint64_t tick) { queue.restart(tick); }
+
+    /**
+     * @brief Change the membrane dynamics
+     *
+     * Potentials are first brought up to date under the previous model.
+     *
+     * @param model The new model
+     */
+    void setNeuronModel(const NeuronModel& model);
+
+    /**
+     * @brief Get the membrane dynamics
+     * @return Reference to the neuron model
+     */
+    const NeuronModel& neuronModel() const { return model; }
+
+    /**
+     * @brief Check whether the hot state of a neuron changed since clearChanges()
+     * @param index Slot index
+     * @return True if potential, threshold or state was set
+     */
+    bool isChanged(uint32_t index) const { return changed[index] != 0; }
+
+    /**
+     * @brief Forget which neurons and edge rows changed
+     */
+    void clearChanges();
+
+    /**
+     * @brief Record a change to the shape of the network
+     *
+     * Called when neuron roles (network layers) change; slot allocation
+     * and edge additions or removals are recorded automatically. A new
+     * structure revision makes the network rebuild its tick schedule.
+     */
+    void markStructureChanged() { ++structureRevision; }
+
+    /**
+     * @brief Record a change that only a full snapshot can capture
+     *
+     * Called for changes to neuron attributes (tags, metadata, gates), the
+     * neuron model and tier extras, none of which affect the tick schedule.
+     */
+    void markAttributesChanged() { ++attributeRevision; }
+
+    /**
+     * @brief Get a counter that moves on every structural change
+     * @return Structure revision of the core and its edges
+     */
+    uint64_t getStructureRevision() const { return structureRevision + edgeStore.getStructureRevision(); }
+
+    /**
+     * @brief Get a counter that moves on every change a checkpoint delta cannot hold
+     * @return Structure revision plus attribute revision
+     */
+    uint64_t getSnapshotRevision() const { return getStructureRevision() + attributeRevision; }
+
+    // Hot state accessors; setters record the neuron as changed
+    float potential(uint32_t index) const { return potentials[index]; }
+    void setPotential(uint32_t index, float value) {
+        potentials[index] = value;
+        updatedAt[index] = getTick();
+        changed[index] = 1;
+    }
+
+    float threshold(uint32_t index) const { return thresholds[index]; }
+    void setThreshold(uint32_t index, float value) { thresholds[index] = value; changed[index] = 1; }
+
+    Neuron::NeuronState state(uint32_t index) const { return states[index]; }
+    void setState(uint32_t index, Neuron::NeuronState value) {
+        states[index] = value;
+        if (value == Neuron::NeuronState::REFRACTORY) {
+            refractoryEnds[index] = UINT64_MAX;  // Until startRefractory() times it or the state changes
+        }
+        changed[index] = 1;
+    }
+
+    Neuron::NeuronType type(uint32_t index) const { return types[index]; }
+
+    uint8_t roles(uint32_t index) const { return roleFlags[index]; }
+    void addRole(uint32_t index, Role role) { roleFlags[index] |= role; }
+    void removeRole(uint32_t index, Role role) { roleFlags[index] &= static_cast<uint8_t>(~role); }
+
+    /**
+     * @brief Get a potential with the decay since its last update applied
+     * @param index Slot index
+     * @return Potential at the current tick
+     */
+    float currentPotential(uint32_t index) const {
+        return potentials[index] * model.getDecay(getTick() - updatedAt[index]);
+    }
+
+    /**
+     * @brief Get a state with an expired refractory period resolved
+     * @param index Slot index
+     * @return State at the current tick
+     */
+    Neuron::NeuronState currentState(uint32_t index) const {
+        return states[index] == Neuron::NeuronState::REFRACTORY && isRefractoryOver(index)
+            ? Neuron::NeuronState::RESTING : states[index];
+    }
+
+    /**
+     * @brief Start the refractory period of a slot that just fired
+     *
+     * Resets the potential and sets the tick at which the slot takes input
+     * again. The caller sets the state, so state callbacks run.
+     *
+     * @param index Slot index
+     */
+    void startRefractory(uint32_t index) {
+        setPotential(index, model.getResetPotential());
+        refractoryEnds[index] = getTick() + model.getRefractoryTicks() + 1;
+    }
+
+    /**
+     * @brief Check whether the refractory period of a slot has ended
+     * @param index Slot index
+     * @return True if the slot takes input in the current tick
+     */
+    bool isRefractoryOver(uint32_t index) const { return getTick() >= refractoryEnds[index]; }
+
+    /**
+     * @brief Get the clocks of a slot
+     * @param index Slot index
+     * @param updated Receives the tick the potential was last brought up to date
+     * @param refractoryEnd Receives the first tick after the refractory period
+     */
+    void clocks(uint32_t index, uint64_t& updated, uint64_t& refractoryEnd) const {
+        updated = updatedAt[index];
+        refractoryEnd = refractoryEnds[index];
+    }
+
+    /**
+     * @brief Set the clocks of a slot, e.g. when restoring a saved network
+     * @param index Slot index
+     * @param updated Tick the potential was last brought up to date
+     * @param refractoryEnd First tick after the refractory period
+     */
+    void setClocks(uint32_t index, uint64_t updated, uint64_t refractoryEnd) {
+        updatedAt[index] = updated;
+        refractoryEnds[index] = refractoryEnd;
+        changed[index] = 1;
+    }
+
+    uint32_t pendingSignals(uint32_t index) const { return pending[index]; }
+    void addPendingSignal(uint32_t index) {
+        if (pending[index]++ == 0 && tracking && !listed[index]) {
+            listed[index] = 1;
+            activeSlots.push_back(index);
+        }
+    }
+    void clearPendingSignals(uint32_t index) { pending[index] = 0; }
+
+    /**
+     * @brief Turn the list of slots with queued input on or off
+     * @param enabled True to track active slots
+     */
+    void setActivityTracking(bool enabled);
+
+    /**
+     * @brief Check whether active slots are tracked
+     * @return True if tracking is on
+     */
+    bool isTrackingActivity() const { return tracking; }
+
+    /**
+     * @brief Take the list of slots with queued input
+     * @param slots Receives the occupied slots with queued input, in increasing order (cleared first)
+     */
+    void takeActiveSlots(std::vector<uint32_t>& slots);
+
+    /**
+     * @brief Put slots whose input is still queued back on the active list
+     *
+     * Called after a tick for the slots it ran, since a neuron that could
+     * not take its input (e.g. while inhibited) keeps it for later.
+     *
+     * @param slots Slots to check
+     */
+    void relistActiveSlots(const std::vector<uint32_t>& slots);
+
+    /**
+     * @brief Stage the input current of a neuron for the next integrate()
+     *
+     * Also stages the decay of the potential since its last update.
+     *
+     * @param index Slot index
+     * @param current Input current to add to the potential
+     */
+    void stageInput(uint32_t index, float current) {
+        uint64_t tick = getTick();
+        currents[index] = current;
+        decays[index] = model.getDecay(tick - updatedAt[index]);
+        updatedAt[index] = tick;
+        staged[index] = 1;
+        changed[index] = 1;
+    }
+
+    /**
+     * @brief Integrate the staged input of a range of slots
+     *
+     * Runs the vectorized integration kernel over the slots, which updates
+     * the potentials of staged slots and reports those that reached their
+     * threshold. The staged input of the range is consumed.
+     *
+     * @param begin First slot
+     * @param count Number of slots
+     * @param fired Receives one bit per slot, relative to begin ((count + 63) / 64 words)
+     */
+    void integrate(uint32_t begin, uint32_t count, uint64_t* fired);
+
+private:
+    std::vector<float> potentials;               // Current activation potentials
+    std::vector<float> thresholds;               // Activation thresholds
+    std::vector<Neuron::NeuronState> states;     // Current states
+    std::vector<Neuron::NeuronType> types;       // Neuron types
+    std::vector<uint8_t> roleFlags;              // Role bits (layer membership) per slot
+    std::vector<uint32_t> pending;               // Number of queued input signals
+    std::vector<uint32_t> generations;           // Bumped on release to invalidate queued signals
+    std::vector<uint8_t> changed;                // Set when the hot state changes (one byte per slot,
+                                                 // so parallel integrate phases never share a flag)
+    std::vector<float> currents;                 // Staged input current per slot
+    std::vector<uint8_t> staged;                 // Whether currents holds input for the next integrate
+    std::vector<float> decays;                   // Staged decay factor per slot
+    std::vector<uint64_t> updatedAt;             // Tick each potential was last brought up to date
+    std::vector<uint64_t> refractoryEnds;        // First tick after each refractory period
+    std::vector<uint8_t> listed;                 // Whether a slot is in activeSlots
+    std::vector<uint32_t> activeSlots;           // Slots that received input (while tracking)
+    std::vector<uint32_t> levels;                // Topological level per slot (empty unless levelized)
+
+    std::vector<Neuron*> handles;                // Owning neuron object per slot (nullptr if free)
+    std::vector<uint32_t> freeSlots;             // Released slots available for reuse
+
+    EdgeStore edgeStore;                         // Connections between slots
+    std::shared_ptr<GateTable> gateTable;        // Parameters of the neurons' gates (shared with the gates)
+    NeuronIndex indexes;                         // Slots by type, tag and metadata key
+    DeliveryQueue queue;                         // Signals in flight between slots
+    NeuronModel model;                           // Membrane dynamics
+    bool pinned;                                 // Whether a network owns this core
+    bool tracking;                               // Whether activeSlots is maintained
+    uint64_t structureRevision;                  // Bumped on slot and role changes
+    uint64_t attributeRevision;                  // Bumped on attribute changes
+
+    /**
+     * @brief Add an occupied slot to the type, tag and metadata key indexes
+     * @param slot Slot index
+     */
+    void indexSlot(uint32_t slot);
+
+    /**
+     * @brief Copy the hot state of a slot of another core into a slot of this one
+     *
+     * Time is carried over relative to each core's tick: the potential is
+     * decayed up to the other core's tick and the remaining refractory
+     * period is kept.
+     *
+     * @param slot Slot index in this core
+     * @param other The core to copy from
+     * @param otherSlot Slot index in the other core
+     */
+    void copyState(uint32_t slot, const SimulationCore& other, uint32_t otherSlot);
+
+    /**
+     * @brief Move a single neuron's state into this core without its edges
+     * @param neuron The neuron to move
+     */
+    void transfer(Neuron& neuron);
+
+    /**
+     * @brief Move the parameters of a neuron's gates into this core's gate table
+     * @param neuron The neuron, already rebound to its slot in this core
+     */
+    void transferGates(Neuron& neuron);
+};
+
+#endif // SIMULATION_CORE_H
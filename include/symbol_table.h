@@ -0,0 +1,118 @@
+/**
+ * @file symbol_table.h
+ * @brief Process-wide string interner.
+ *
+ * Strings that are compared or looked up over and over, such as payload
+ * keys, tags and metadata keys, are interned once and afterwards handled
+ * as 32-bit symbols. Interning takes a lock; turning a symbol back into
+ * its string does not, because interned strings never move or disappear.
+ * Since the table never shrinks, it is meant for a small vocabulary;
+ * names given to single objects, such as neuron IDs, are not interned.
+ */
+
+#ifndef SYMBOL_TABLE_H
+#define SYMBOL_TABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @brief Interned string handle
+ */
+typedef uint32_t Symbol;
+
+/**
+ * @brief Interner mapping strings to dense symbols and back
+ */
+class SymbolTable {
+public:
+    /**
+     * @brief Symbol that never refers to a string
+     */
+    static const Symbol INVALID_SYMBOL = 0xFFFFFFFFu;
+
+    /**
+     * @brief Get the process-wide table
+     * @return Reference to the global symbol table
+     */
+    static SymbolTable& global();
+
+    /**
+     * @brief Constructor for SymbolTable
+     */
+    SymbolTable();
+
+    /**
+     * @brief Destructor for SymbolTable
+     */
+    ~SymbolTable();
+
+    /**
+     * @brief Get the symbol of a string, interning it if needed
+     * @param text The string to intern
+     * @return Its symbol
+     */
+    Symbol intern(const std::string& text);
+
+    /**
+     * @brief Get the symbol of a string without interning it
+     * @param text The string to look up
+     * @return Its symbol or INVALID_SYMBOL if it was never interned
+     */
+    Symbol lookup(const std::string& text) const;
+
+    /**
+     * @brief Get the string behind a symbol (lock-free)
+     * @param symbol A symbol returned by this table
+     * @return The interned string
+     */
+    const std::string& name(Symbol symbol) const {
+        return chunks[symbol >> CHUNK_BITS].load(std::memory_order_acquire)[symbol & CHUNK_MASK];
+    }
+
+    /**
+     * @brief Get the number of interned strings
+     * @return Symbol count
+     */
+    size_t size() const { return count.load(std::memory_order_acquire); }
+
+private:
+    SymbolTable(const SymbolTable&) = delete;
+    SymbolTable& operator=(const SymbolTable&) = delete;
+
+    // Strings live in fixed-size chunks so they never move once interned
+    static const uint32_t CHUNK_BITS = 12;
+    static const uint32_t CHUNK_SIZE = 1u << CHUNK_BITS;
+    static const uint32_t CHUNK_MASK = CHUNK_SIZE - 1;
+    static const uint32_t MAX_CHUNKS = 1u << 16;
+
+    /**
+     * @brief Hash of the string a key points to
+     */
+    struct TextHash {
+        size_t operator()(const std::string* text) const { return std::hash<std::string>()(*text); }
+    };
+
+    /**
+     * @brief Equality of the strings two keys point to
+     */
+    struct TextEqual {
+        bool operator()(const std::string* a, const std::string* b) const { return *a == *b; }
+    };
+
+    // Keys point into the chunks, so every string is stored once
+    typedef std::unordered_map<const std::string*, Symbol, TextHash, TextEqual> SymbolMap;
+
+    std::unique_ptr<std::atomic<std::string*>[]> chunks;  // Chunk pointers, allocated on demand
+    std::atomic<size_t> count;                            // Number of interned strings
+    SymbolMap symbols;                                    // String to symbol
+    mutable std::mutex mutex;                             // Guards symbols and interning
+};
+
+#endif // SYMBOL_TABLE_H
@@ -12,6 +12,9 @@
 
 #include <string>
 #include <vector>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <unordered_map>
 #include <sstream>
 #include <iostream>
@@ -19,9 +22,85 @@
 #include <typeindex>
 #include <typeinfo>
 #include <utility>  // For std::pair
+#include "symbol_table.h"
+#include "synapse_payload.h"
+
+class Synapse;
+
+/**
+ * @brief Reference-counted handle to a synapse
+ *
+ * The count lives inside the synapse itself, so a handle is one pointer
+ * wide and creating a signal needs no separate control block. Handles may
+ * be copied and released from any thread.
+ */
+class SynapsePtr {
+public:
+    /**
+     * @brief Constructor for an empty SynapsePtr
+     */
+    SynapsePtr() : synapse(nullptr) {}
+    
+    /**
+     * @brief Constructor for an empty SynapsePtr from nullptr
+     */
+    SynapsePtr(std::nullptr_t) : synapse(nullptr) {}
+    
+    /**
+     * @brief Take a reference to a synapse
+     * @param target Synapse allocated with new (may be null)
+     */
+    explicit SynapsePtr(Synapse* target);
+    
+    SynapsePtr(const SynapsePtr& other);
+    SynapsePtr(SynapsePtr&& other) : synapse(other.synapse) { other.synapse = nullptr; }
+    SynapsePtr& operator=(SynapsePtr other) { swap(other); return *this; }
+    
+    /**
+     * @brief Destructor for SynapsePtr; deletes the synapse with its last reference
+     */
+    ~SynapsePtr() { reset(); }
+    
+    /**
+     * @brief Get the referenced synapse
+     * @return Raw pointer (nullptr if empty)
+     */
+    Synapse* get() const { return synapse; }
+    
+    Synapse* operator->() const { return synapse; }
+    Synapse& operator*() const { return *synapse; }
+    explicit operator bool() const { return synapse != nullptr; }
+    
+    /**
+     * @brief Drop the reference, leaving the handle empty
+     */
+    void reset();
+    
+    /**
+     * @brief Exchange the referenced synapses of two handles
+     * @param other The other handle
+     */
+    void swap(SynapsePtr& other) {
+        Synapse* held = synapse;
+        synapse = other.synapse;
+        other.synapse = held;
+    }
+    
+    /**
+     * @brief Get the number of handles referencing the synapse
+     * @return Reference count (0 if empty)
+     */
+    long use_count() const;
+    
+private:
+    Synapse* synapse;  // Referenced synapse
+};
 
 /**
  * @brief Class representing a synapse for data transfer between neurons.
+ *
+ * Synapses are allocated from the MemoryManager pools and shared through
+ * SynapsePtr; use Synapse::create to make one.
  */
 class Synapse {
 public:
@@ -31,8 +110,31 @@ public:
         MODULATORY      // Modulatory synapse (changes behavior)
     };
     
+    /**
+     * @brief How synapses created without an explicit ID are identified
+     */
+    enum class IdPolicy {
+        COUNTER,        // 64-bit process-wide counter, formatted as text only on demand
+        UUID            // Random UUID string generated at construction
+    };
+    
+    /**
+     * @brief Select the ID policy for synapses created from now on
+     * @param policy The policy to use (COUNTER by default)
+     */
+    static void setIdPolicy(IdPolicy policy);
+    
+    /**
+     * @brief Get the current ID policy
+     * @return The active policy
+     */
+    static IdPolicy getIdPolicy();
+    
     /**
      * @brief Constructor for Synapse class
+     * 
+     * The synapse gets an ID according to the current IdPolicy.
+     * 
      * @param type Type of the synapse
      * @param strength Strength of the synapse signal (0.0 to 1.0)
      */
@@ -46,6 +148,30 @@ public:
      */
     Synapse(const std::string& id, SynapseType type = SynapseType::EXCITATORY, float strength = 1.0f);
     
+    /**
+     * @brief Create a pooled synapse
+     * @param args Constructor arguments
+     * @return Handle to the new synapse
+     */
+    template<typename... Args>
+    static SynapsePtr create(Args&&... args) {
+        return SynapsePtr(new Synapse(std::forward<Args>(args)...));
+    }
+    
+    /**
+     * @brief Allocate a synapse from the MemoryManager pool
+     * @param size Object size
+     * @return Pointer to the memory
+     */
+    static void* operator new(size_t size);
+    
+    /**
+     * @brief Return a synapse to the MemoryManager pool
+     * @param ptr Pointer to the memory
+     * @param size Object size
+     */
+    static void operator delete(void* ptr, size_t size);
+    
     /**
      * @brief Set the source ID (the neuron that created this synapse)
      * @param sourceId The ID of the source neuron
@@ -90,57 +216,64 @@ public:
     
     /**
      * @brief Add a data value to the synapse payload
+     * 
+     * Integers, floats, doubles, bools and strings are stored in their
+     * native type.
+     * 
      * @param key The key identifier for the data
      * @param value The data value
      */
     template<typename T>
     void setData(const std::string& key, const T& value) {
-        // Store data as string representation for now
-        // In C++17, this would use std::any
-        if constexpr (std::is_same<T, std::string>::value) {
-            stringPayload[key] = value;
-        } else {
-            // Simple conversion to string for basic types
-            stringPayload[key] = std::to_string(value);
-        }
+        payload.insert(SymbolTable::global().intern(key)).set(value);
+    }
+    
+    /**
+     * @brief Add a data value under an interned key
+     * @param key The interned key
+     * @param value The data value
+     */
+    template<typename T>
+    void setData(Symbol key, const T& value) {
+        payload.insert(key).set(value);
     }
     
     /**
      * @brief Retrieve a data value from the synapse payload
+     * 
+     * Values are converted if they were stored with another type; numbers
+     * read as strings are formatted with std::to_string.
+     * 
      * @param key The key identifier for the data
      * @return The data value or default-constructed T if not found
      */
     template<typename T>
     T getData(const std::string& key) const {
-        auto it = stringPayload.find(key);
-        if (it != stringPayload.end()) {
-            if constexpr (std::is_same<T, std::string>::value) {
-                return it->second;
-            } else if constexpr (std::is_same<T, int>::value) {
-                try {
-                    return std::stoi(it->second);
-                } catch (...) {
-                    return 0;
-                }
-            } else if constexpr (std::is_same<T, float>::value) {
-                try {
-                    return std::stof(it->second);
-                } catch (...) {
-                    return 0.0f;
-                }
-            } else if constexpr (std::is_same<T, double>::value) {
-                try {
-                    return std::stod(it->second);
-                } catch (...) {
-                    return 0.0;
-                }
-            } else if constexpr (std::is_same<T, bool>::value) {
-                return it->second == "true" || it->second == "1";
-            }
+        return getData<T>(SymbolTable::global().lookup(key));
+    }
+    
+    /**
+     * @brief Retrieve a data value stored under an interned key
+     * @param key The interned key
+     * @return The data value or default-constructed T if not found
+     */
+    template<typename T>
+    T getData(Symbol key) const {
+        T value = T();
+        const PayloadValue* stored = payload.find(key);
+        if (stored) {
+            stored->get(value);
         }
-        
-        // Default construction for unhandled types or missing keys
-        return T();
+        return value;
+    }
+    
+    /**
+     * @brief Get direct access to a typed payload value
+     * @param key The interned key
+     * @return Pointer to the value or nullptr if the key is absent
+     */
+    const PayloadValue* findData(Symbol key) const {
+        return payload.find(key);
     }
     
     /**
@@ -150,6 +283,13 @@ public:
      */
     bool hasData(const std::string& key) const;
     
+    /**
+     * @brief Check if the synapse contains an interned data key
+     * @param key The interned key
+     * @return True if the key exists, false otherwise
+     */
+    bool hasData(Symbol key) const { return payload.find(key) != nullptr; }
+    
     /**
      * @brief Get all keys in the payload
      * @return Vector of all keys
@@ -180,14 +320,14 @@ public:
      * @param strength The strength for the new synapse (defaults to current strength)
      * @return A new synapse with copied metadata and empty payload
      */
-    std::shared_ptr<Synapse> derive(float strength = -1.0f) const;
+    SynapsePtr derive(float strength = -1.0f) const;
     
     /**
      * @brief Combine this synapse with another
      * @param other The other synapse to combine with
      * @return A new synapse with combined data
      */
-    std::shared_ptr<Synapse> combine(const std::shared_ptr<Synapse>& other) const;
+    SynapsePtr combine(const SynapsePtr& other) const;
     
     /**
      * @brief Record a digital signature of this synapse
@@ -197,23 +337,75 @@ public:
     
     /**
      * @brief Get the ID of this synapse
+     * 
+     * Counter IDs are formatted as decimal text on the first call.
+     * 
      * @return The synapse ID
      */
     const std::string& getId() const;
+    
+    /**
+     * @brief Get the numeric counter ID of this synapse
+     * @return The counter value, or 0 if the ID is a UUID or was given explicitly
+     */
+    uint64_t getSerial() const;
 
 private:
-    std::string id;        // Unique identifier
+    friend class SynapsePtr;
+    
+    Synapse(const Synapse&) = delete;
+    Synapse& operator=(const Synapse&) = delete;
+    
+    mutable std::atomic<uint32_t> refCount; // Number of SynapsePtr handles
+    uint64_t serial;                       // Counter ID (0 if the ID is text only)
+    mutable std::string id;                // Unique identifier, formatted lazily for counter IDs
+    mutable std::atomic<uint8_t> idState;  // Whether id holds the formatted text yet
     std::string sourceId;  // ID of the source neuron
     std::string targetId;  // ID of the target neuron
     SynapseType type;      // Type of the synapse
     float strength;        // Strength of the synapse (0.0 to 1.0)
     
-    // Simplified payload storage for C++11 compatibility
-    std::unordered_map<std::string, std::string> stringPayload;
+    // Typed payload with interned keys
+    SynapsePayload payload;
     
     // Tags for categorization and filtering
     std::vector<std::string> tags;
+    
+    /**
+     * @brief Store the ID of another synapse in the payload
+     * @param key Payload key to store it under
+     * @param origin The synapse whose ID is recorded
+     */
+    void recordOrigin(Symbol key, const Synapse& origin);
 };
 
+inline SynapsePtr::SynapsePtr(Synapse* target) : synapse(target) {
+    if (synapse) {
+        synapse->refCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+inline SynapsePtr::SynapsePtr(const SynapsePtr& other) : synapse(other.synapse) {
+    if (synapse) {
+        synapse->refCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+inline void SynapsePtr::reset() {
+    if (synapse && synapse->refCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete synapse;
+    }
+    synapse = nullptr;
+}
+
+inline long SynapsePtr::use_count() const {
+    return synapse ? static_cast<long>(synapse->refCount.load(std::memory_order_relaxed)) : 0;
+}
+
+inline bool operator==(const SynapsePtr& a, const SynapsePtr& b) { return a.get() == b.get(); }
+inline bool operator!=(const SynapsePtr& a, const SynapsePtr& b) { return a.get() != b.get(); }
+inline bool operator==(const SynapsePtr& a, std::nullptr_t) { return !a; }
+inline bool operator!=(const SynapsePtr& a, std::nullptr_t) { return static_cast<bool>(a); }
+
 #endif // SYNAPSE_H
 
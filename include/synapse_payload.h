@@ -0,0 +1,231 @@
+/**
+ * @file synapse_payload.h
+ * @brief Typed key/value payload carried by a synapse.
+ *
+ * Values keep their native type (integer, float, double, bool or string)
+ * instead of being converted to text, and keys are interned symbols. The
+ * first few entries live inside the payload itself, so a typical signal
+ * carries its data without any heap allocation; reading or writing a
+ * numeric value is a short scan over the inline keys.
+ */
+
+#ifndef SYNAPSE_PAYLOAD_H
+#define SYNAPSE_PAYLOAD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "symbol_table.h"
+
+/**
+ * @brief A single payload value stored in its native type
+ */
+class PayloadValue {
+public:
+    /**
+     * @brief Native type of a stored value
+     */
+    enum class Type : uint8_t {
+        NONE,    // No value stored
+        INT,     // Any integer, stored as 64 bits
+        FLOAT,   // Single precision
+        DOUBLE,  // Double precision
+        BOOL,    // Boolean flag
+        STRING   // Text
+    };
+
+    /**
+     * @brief Constructor for an empty PayloadValue
+     */
+    PayloadValue() : type(Type::NONE) { number.i = 0; }
+
+    /**
+     * @brief Get the type of the stored value
+     * @return The value type
+     */
+    Type getType() const { return type; }
+
+    // Store a value, replacing the previous one
+    void set(float value) { clearText(); type = Type::FLOAT; number.f = value; }
+    void set(double value) { clearText(); type = Type::DOUBLE; number.d = value; }
+    void set(bool value) { clearText(); type = Type::BOOL; number.b = value; }
+    void set(const std::string& value) { type = Type::STRING; text = value; }
+    void set(const char* value) { type = Type::STRING; text = value ? value : ""; }
+
+    template<typename T>
+    typename std::enable_if<std::is_integral<T>::value>::type set(T value) {
+        clearText();
+        type = Type::INT;
+        number.i = static_cast<int64_t>(value);
+    }
+
+    /**
+     * @brief Read the value as a float
+     * @param fallback Returned if there is no value or the text is not a number
+     * @return The value converted to float
+     */
+    float asFloat(float fallback = 0.0f) const {
+        return type == Type::FLOAT ? number.f : static_cast<float>(asDouble(fallback));
+    }
+
+    /**
+     * @brief Read the value as a double
+     * @param fallback Returned if there is no value or the text is not a number
+     * @return The value converted to double
+     */
+    double asDouble(double fallback = 0.0) const;
+
+    /**
+     * @brief Read the value as an integer
+     * @param fallback Returned if there is no value or the text is not a number
+     * @return The value converted to a 64-bit integer
+     */
+    int64_t asInt(int64_t fallback = 0) const;
+
+    /**
+     * @brief Read the value as a bool
+     * @return True for non-zero numbers and the strings "true" and "1"
+     */
+    bool asBool() const;
+
+    /**
+     * @brief Read the value as text
+     *
+     * Numbers are formatted with std::to_string, as they were when the
+     * payload stored everything as strings.
+     *
+     * @return The value converted to a string
+     */
+    std::string asString() const;
+
+    // Typed reads used by Synapse::getData; other types are left untouched
+    void get(float& out) const { out = asFloat(out); }
+    void get(double& out) const { out = asDouble(out); }
+    void get(bool& out) const { out = asBool(); }
+    void get(std::string& out) const { out = asString(); }
+
+    template<typename T>
+    void get(T& out) const { getInteger(out, std::is_integral<T>()); }
+
+private:
+    Type type;          // Type of the stored value
+    union {
+        int64_t i;
+        float f;
+        double d;
+        bool b;
+    } number;           // Numeric storage
+    std::string text;   // String storage (short strings stay inline)
+
+    void clearText() {
+        if (type == Type::STRING) {
+            text.clear();
+        }
+    }
+
+    template<typename T>
+    void getInteger(T& out, std::true_type) const { out = static_cast<T>(asInt(0)); }
+
+    template<typename T>
+    void getInteger(T&, std::false_type) const {}
+};
+
+/**
+ * @brief Small map from interned keys to typed values
+ */
+class SynapsePayload {
+public:
+    /**
+     * @brief Number of entries stored without heap allocation
+     */
+    static const size_t INLINE_CAPACITY = 4;
+
+    /**
+     * @brief Constructor for an empty SynapsePayload
+     */
+    SynapsePayload() : inlineCount(0) {}
+
+    /**
+     * @brief Find the value stored under a key
+     * @param key Interned key
+     * @return Pointer to the value or nullptr if the key is absent
+     */
+    const PayloadValue* find(Symbol key) const {
+        for (size_t i = 0; i < inlineCount; ++i) {
+            if (inlineEntries[i].key == key) {
+                return &inlineEntries[i].value;
+            }
+        }
+        return overflow.empty() ? nullptr : findOverflow(key);
+    }
+
+    PayloadValue* find(Symbol key) {
+        return const_cast<PayloadValue*>(static_cast<const SynapsePayload*>(this)->find(key));
+    }
+
+    /**
+     * @brief Get the value stored under a key, adding an empty one if absent
+     * @param key Interned key
+     * @return Reference to the value
+     */
+    PayloadValue& insert(Symbol key) {
+        PayloadValue* value = find(key);
+        if (value) {
+            return *value;
+        }
+
+        if (inlineCount < INLINE_CAPACITY) {
+            inlineEntries[inlineCount].key = key;
+            return inlineEntries[inlineCount++].value;
+        }
+
+        overflow.push_back(Entry());
+        overflow.back().key = key;
+        return overflow.back().value;
+    }
+
+    /**
+     * @brief Get the number of entries
+     * @return Entry count
+     */
+    size_t size() const { return inlineCount + overflow.size(); }
+
+    /**
+     * @brief Get the key of an entry, in insertion order
+     * @param i Entry position (less than size())
+     * @return The interned key
+     */
+    Symbol keyAt(size_t i) const {
+        return i < inlineCount ? inlineEntries[i].key : overflow[i - inlineCount].key;
+    }
+
+    /**
+     * @brief Get the value of an entry, in insertion order
+     * @param i Entry position (less than size())
+     * @return The value
+     */
+    const PayloadValue& valueAt(size_t i) const {
+        return i < inlineCount ? inlineEntries[i].value : overflow[i - inlineCount].value;
+    }
+
+private:
+    /**
+     * @brief A key and its value
+     */
+    struct Entry {
+        Symbol key;
+        PayloadValue value;
+
+        Entry() : key(SymbolTable::INVALID_SYMBOL) {}
+    };
+
+    Entry inlineEntries[INLINE_CAPACITY];  // First entries, stored in place
+    size_t inlineCount;                    // Used inline entries
+    std::vector<Entry> overflow;           // Entries beyond the inline capacity
+
+    const PayloadValue* findOverflow(Symbol key) const;
+};
+
+#endif // SYNAPSE_PAYLOAD_H
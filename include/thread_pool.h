@@ -0,0 +1,328 @@
+/**
+ * @file thread_pool.h
+ * @brief Work-stealing thread pool for parallel neural processing.
+ *
+ * Every worker owns a Chase-Lev deque: it pushes and pops tasks at the
+ * bottom without locking, while idle workers steal from the top of other
+ * workers' deques. Threads that are not workers of the pool submit through
+ * a shared injection queue. Tasks belong to a TaskGroup, and waiting on a
+ * group lets the waiting thread execute pending tasks instead of blocking,
+ * so tasks may themselves submit and wait on nested work (for example a
+ * neuron callback running inside a parallel tick).
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Lock-free single-owner, multi-thief deque (Chase-Lev)
+ *
+ * Only the owning thread may call push() and pop(); any thread may call
+ * steal(). Storage grows on demand; outgrown buffers are kept until the
+ * deque is destroyed because a concurrent thief may still read from them.
+ */
+template<typename T>
+class WorkStealingDeque {
+public:
+    /**
+     * @brief Constructor for WorkStealingDeque
+     * @param capacity Initial capacity (rounded up to a power of two)
+     */
+    explicit WorkStealingDeque(size_t capacity = 256) : top(0), bottom(0) {
+        size_t rounded = 1;
+        while (rounded < capacity) {
+            rounded <<= 1;
+        }
+        buffers.emplace_back(new Buffer(rounded));
+        buffer.store(buffers.back().get(), std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Push an item at the bottom (owner only)
+     * @param item The item to push
+     */
+    void push(T* item) {
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        int64_t t = top.load(std::memory_order_acquire);
+        Buffer* current = buffer.load(std::memory_order_relaxed);
+
+        if (b - t >= static_cast<int64_t>(current->capacity)) {
+            current = grow(current, t, b);
+        }
+
+        current->put(b, item);
+        bottom.store(b + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Pop the most recently pushed item (owner only)
+     * @return The item or nullptr if the deque is empty
+     */
+    T* pop() {
+        int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        Buffer* current = buffer.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;  // Empty
+        }
+
+        T* item = current->get(b);
+        if (t == b) {
+            // Last item: race against thieves for it
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                             std::memory_order_relaxed)) {
+                item = nullptr;
+            }
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+
+        return item;
+    }
+
+    /**
+     * @brief Steal the oldest item (any thread)
+     * @return The item or nullptr if the deque is empty or the race was lost
+     */
+    T* steal() {
+        int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = bottom.load(std::memory_order_acquire);
+
+        if (t >= b) {
+            return nullptr;  // Empty
+        }
+
+        T* item = buffer.load(std::memory_order_acquire)->get(t);
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                         std::memory_order_relaxed)) {
+            return nullptr;  // Another thread took it
+        }
+
+        return item;
+    }
+
+    /**
+     * @brief Check whether the deque looks empty (may be stale)
+     * @return True if no items were visible
+     */
+    bool empty() const {
+        return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed);
+    }
+
+private:
+    /**
+     * @brief Circular array of item pointers
+     */
+    struct Buffer {
+        size_t capacity;                      // Number of slots (power of two)
+        std::unique_ptr<std::atomic<T*>[]> slots;
+
+        explicit Buffer(size_t capacity) : capacity(capacity), slots(new std::atomic<T*>[capacity]) {}
+        T* get(int64_t i) const { return slots[i & (capacity - 1)].load(std::memory_order_relaxed); }
+        void put(int64_t i, T* item) { slots[i & (capacity - 1)].store(item, std::memory_order_relaxed); }
+    };
+
+    Buffer* grow(Buffer* current, int64_t t, int64_t b) {
+        buffers.emplace_back(new Buffer(current->capacity * 2));
+        Buffer* grown = buffers.back().get();
+        for (int64_t i = t; i < b; ++i) {
+            grown->put(i, current->get(i));
+        }
+        buffer.store(grown, std::memory_order_release);
+        return grown;
+    }
+
+    std::atomic<int64_t> top;                     // Next item to steal
+    std::atomic<int64_t> bottom;                  // Next free slot for the owner
+    std::atomic<Buffer*> buffer;                  // Current storage
+    std::vector<std::unique_ptr<Buffer>> buffers; // Every buffer ever used (owner only)
+};
+
+/**
+ * @brief A set of tasks that can be waited on together
+ *
+ * A group must outlive the tasks submitted to it. If a task throws, the
+ * first exception is rethrown by ThreadPool::wait().
+ */
+class TaskGroup {
+public:
+    /**
+     * @brief Constructor for TaskGroup
+     */
+    TaskGroup() : pending(0) {}
+
+    /**
+     * @brief Check whether every submitted task has finished
+     * @return True if no task of the group is pending
+     */
+    bool done() const { return pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class ThreadPool;
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    std::atomic<size_t> pending;      // Tasks submitted but not finished
+    std::mutex mutex;                 // Guards error and blocking waits
+    std::condition_variable finished; // Signalled when pending drops to zero
+    std::exception_ptr error;         // First exception thrown by a task
+};
+
+/**
+ * @brief A work-stealing thread pool for parallel execution of neural processing
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief Constructor
+     * @param numThreads Number of worker threads
+     * @param pinThreads Whether to pin worker i to CPU i (Linux only, ignored elsewhere)
+     */
+    explicit ThreadPool(size_t numThreads, bool pinThreads = false);
+
+    /**
+     * @brief Destructor; finishes queued tasks before the workers exit
+     */
+    ~ThreadPool();
+
+    /**
+     * @brief Add a task to the pool's default group
+     * @param task Function to execute
+     */
+    void enqueue(std::function<void()> task);
+
+    /**
+     * @brief Add a task to a group
+     * @param group Group the task belongs to
+     * @param task Function to execute
+     */
+    void submit(TaskGroup& group, std::function<void()> task);
+
+    /**
+     * @brief Add several tasks to a group at once
+     * @param group Group the tasks belong to
+     * @param tasks Functions to execute; the vector is emptied
+     */
+    void submitBatch(TaskGroup& group, std::vector<std::function<void()>>& tasks);
+
+    /**
+     * @brief Wait until every task of a group has finished
+     *
+     * The calling thread executes pending tasks while it waits, so it is
+     * safe to call from inside a task.
+     *
+     * @param group The group to wait for
+     */
+    void wait(TaskGroup& group);
+
+    /**
+     * @brief Run a function over an index range split into chunks
+     *
+     * Blocks until every chunk has run; the calling thread takes part.
+     *
+     * @param begin First index
+     * @param end One past the last index
+     * @param grain Maximum number of indices per chunk
+     * @param body Function receiving the bounds [first, last) of a chunk
+     */
+    void parallelFor(size_t begin, size_t end, size_t grain,
+                     const std::function<void(size_t, size_t)>& body);
+
+    /**
+     * @brief Wait for all tasks added with enqueue() to complete
+     */
+    void waitForCompletion();
+
+    /**
+     * @brief Get the number of worker threads
+     * @return Worker count
+     */
+    size_t size() const { return workers.size(); }
+
+    /**
+     * @brief Get the index of the calling thread within this pool
+     * @return Worker index, or size() if the caller is not a worker
+     */
+    size_t currentWorker() const;
+
+private:
+    /**
+     * @brief A queued unit of work
+     */
+    struct Task {
+        std::function<void()> function;  // Work to run
+        TaskGroup* group;                // Group to notify on completion
+    };
+
+    /**
+     * @brief Per-worker state
+     */
+    struct Worker {
+        WorkStealingDeque<Task> deque;   // Tasks pushed by this worker
+        std::thread thread;              // The worker thread
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    std::mutex injectionMutex;           // Guards the injection queue
+    std::deque<Task*> injection;         // Tasks submitted by non-worker threads
+    std::atomic<size_t> injected;        // Size of the injection queue, read without the lock
+
+    std::mutex sleepMutex;               // Guards idle workers going to sleep
+    std::condition_variable wake;        // Signalled when work arrives or on stop
+    std::atomic<size_t> queued;          // Tasks queued but not yet taken
+    std::atomic<size_t> sleeping;        // Workers blocked on wake
+    std::atomic<bool> stop;              // Set when the pool shuts down
+
+    TaskGroup defaultGroup;              // Group used by enqueue()
+
+    /**
+     * @brief Main loop of a worker thread
+     * @param index Index of the worker
+     */
+    void workerLoop(size_t index);
+
+    /**
+     * @brief Queue a task on the caller's deque or the injection queue
+     * @param task The task to queue
+     */
+    void push(Task* task);
+
+    /**
+     * @brief Wake sleeping workers after tasks were queued
+     * @param count Number of tasks queued
+     */
+    void notify(size_t count);
+
+    /**
+     * @brief Find a task to run: own deque, injection queue, then stealing
+     * @param self Worker index of the caller, or size() for other threads
+     * @return A task or nullptr if none was found
+     */
+    Task* take(size_t self);
+
+    /**
+     * @brief Run a task and count it off its group
+     * @param task The task; it is deleted afterwards
+     */
+    void run(Task* task);
+};
+
+#endif // THREAD_POOL_H
@@ -17,8 +17,11 @@
 #include <functional>
 #include <thread>
 #include <mutex>
+#include <atomic>
+#include <cstdint>
 #include <condition_variable>
 #include <queue>
+#include "thread_pool.h"
 
 // Forward declarations to avoid circular dependencies
 class Synapse;
@@ -106,48 +109,14 @@ public:
     static std::string simpleHash(const std::string& str);
 };
 
-/**
- * @brief A thread pool for parallel execution of neural processing
- */
-class ThreadPool {
-public:
-    /**
-     * @brief Constructor
-     * @param numThreads Number of worker threads
-     */
-    ThreadPool(size_t numThreads);
-    
-    /**
-     * @brief Destructor
-     */
-    ~ThreadPool();
-    
-    /**
-     * @brief Add a task to the thread pool
-     * @param task Function to execute
-     */
-    void enqueue(std::function<void()> task);
-    
-    /**
-     * @brief Wait for all tasks to complete
-     */
-    void waitForCompletion();
-    
-private:
-    std::vector<std::thread> workers;
-    std::queue<std::function<void()>> tasks;
-    
-    std::mutex queueMutex;
-    std::condition_variable condition;
-    bool stop;
-    
-    int pendingTasks;
-    std::mutex counterMutex;
-    std::condition_variable counterCondition;
-};
-
 /**
  * @brief Memory manager for optimized allocation of neural components
+ *
+ * Synapses are carved out of slabs of fixed-size blocks. Each thread keeps
+ * a small cache of free blocks and only touches the shared free list, under
+ * a lock, to move a batch of blocks in or out, so allocating and freeing a
+ * synapse is normally a pointer pop or push. Statistics are counted per
+ * thread cache by its owner and summed when read.
  */
 class MemoryManager {
 public:
@@ -157,45 +126,119 @@ public:
      */
     static MemoryManager& getInstance();
     
+    /**
+     * @brief Destructor for MemoryManager
+     */
+    ~MemoryManager();
+    
     /**
      * @brief Allocate memory for a synapse
-     * @return Pointer to allocated memory
+     * @return Pointer to a block of getSynapseBlockSize() bytes
      */
     void* allocateSynapse();
     
     /**
      * @brief Deallocate memory used by a synapse
-     * @param ptr Pointer to memory to deallocate
+     * @param ptr Pointer returned by allocateSynapse (may be null)
      */
     void deallocateSynapse(void* ptr);
     
+    /**
+     * @brief Get the size of the blocks handed out by allocateSynapse
+     * @return Block size in bytes
+     */
+    size_t getSynapseBlockSize() const;
+    
     /**
      * @brief Get the number of active synapses
-     * @return Count of active synapses
+     * @return Count of synapse blocks currently in use
      */
     size_t getActiveSynapseCount() const;
     
     /**
      * @brief Get the total number of synapses created
-     * @return Total synapse count
+     * @return Synapse blocks allocated since construction or the last resetStats
      */
     size_t getTotalSynapseCount() const;
     
+    /**
+     * @brief Get the number of synapse blocks reserved from the system
+     * @return Capacity of all slabs, in blocks
+     */
+    size_t getReservedSynapseCount() const;
+    
     /**
      * @brief Reset the memory manager statistics
+     *
+     * Restarts the total count. The active count keeps tracking the blocks
+     * that are still in use.
      */
     void resetStats();
     
 private:
+    struct ThreadCache;
+    
     // Private constructor for singleton
     MemoryManager();
     // Prevent copying
     MemoryManager(const MemoryManager&) = delete;
     MemoryManager& operator=(const MemoryManager&) = delete;
     
-    std::mutex mutex;
-    size_t activeSynapses;
-    size_t totalSynapses;
+    /**
+     * @brief Get the calling thread's cache
+     * @return The cache, or nullptr once it has been destroyed at thread exit
+     */
+    ThreadCache* localCache();
+    
+    /**
+     * @brief Move a batch of free blocks from the shared list into a cache
+     * @param cache The cache to fill
+     */
+    void refill(ThreadCache& cache);
+    
+    /**
+     * @brief Move free blocks from a cache back to the shared list
+     * @param cache The cache to drain
+     * @param keep Number of blocks the cache keeps
+     */
+    void drain(ThreadCache& cache, size_t keep);
+    
+    /**
+     * @brief Carve a new slab into blocks on the shared free list
+     *
+     * The caller must hold the mutex.
+     */
+    void addSlab();
+    
+    /**
+     * @brief Start tracking a new thread cache
+     * @param cache The cache
+     */
+    void registerCache(ThreadCache* cache);
+    
+    /**
+     * @brief Fold an exiting thread's cache into the shared state
+     * @param cache The cache
+     */
+    void retireCache(ThreadCache* cache);
+    
+    /**
+     * @brief Sum the allocation counters of all caches
+     * @param allocations Receives the number of allocations
+     * @param deallocations Receives the number of deallocations
+     *
+     * The caller must hold the mutex.
+     */
+    void collectStats(uint64_t& allocations, uint64_t& deallocations) const;
+    
+    mutable std::mutex mutex;           // Guards everything below
+    void* freeList;                     // Shared free blocks, linked through their first word
+    size_t freeCount;                   // Blocks on the shared free list
+    std::vector<void*> slabs;           // Slabs obtained from the system
+    std::vector<ThreadCache*> caches;   // Caches of running threads
+    uint64_t retiredAllocations;        // Allocations counted by caches of exited threads
+    uint64_t retiredDeallocations;      // Deallocations counted by caches of exited threads
+    uint64_t totalBaseline;             // Allocation count at the last resetStats
 };
 
 #endif // UTILS_H
@@ -0,0 +1,370 @@
+/**
+ * @file checkpointer.cpp
+ * @brief Implementation of incremental network checkpoints.
+ */
+
+#include "../include/checkpointer.h"
+#include "../include/network_snapshot.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// First line of the manifest
+const char* const MANIFEST_HEADER = "o3-checkpoints 1";
+
+// Name of the manifest inside the checkpoint directory
+const char* const MANIFEST_NAME = "manifest";
+
+// A checkpoint file listed in the manifest
+typedef std::pair<uint64_t, std::string> ChainEntry;
+
+bool report(std::string* error, const std::string& message) {
+    if (error) {
+        *error = message;
+    }
+    return false;
+}
+
+std::string joinPath(const std::string& directory, const std::string& name) {
+    if (directory.empty() || directory[directory.size() - 1] == '/') {
+        return directory + name;
+    }
+    return directory + "/" + name;
+}
+
+std::string fileName(uint64_t sequence, bool base) {
+    return "checkpoint-" + std::to_string(sequence) + (base ? ".o3s" : ".o3d");
+}
+
+/**
+ * @brief Read the chain listed in a manifest, base first
+ */
+bool readManifest(const std::string& directory, std::vector<ChainEntry>& chain, std::string* error) {
+    chain.clear();
+
+    std::string path = joinPath(directory, MANIFEST_NAME);
+    std::ifstream stream(path.c_str());
+    if (!stream) {
+        return report(error, "Cannot open " + path);
+    }
+
+    std::string line;
+    if (!std::getline(stream, line) || line != MANIFEST_HEADER) {
+        return report(error, path + " is not a checkpoint manifest");
+    }
+
+    while (std::getline(stream, line)) {
+        if (line.empty()) {
+            continue;
+        }
+
+        std::istringstream fields(line);
+        ChainEntry entry;
+        if (!(fields >> entry.first >> entry.second) || entry.second.find('/') != std::string::npos) {
+            return report(error, path + " has a malformed entry: " + line);
+        }
+        chain.push_back(entry);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Replace the manifest atomically
+ */
+bool writeManifest(const std::string& directory, const std::vector<ChainEntry>& chain, std::string* error) {
+    std::string path = joinPath(directory, MANIFEST_NAME);
+    std::string temporary = path + ".tmp";
+
+    {
+        std::ofstream stream(temporary.c_str(), std::ios::trunc);
+        stream << MANIFEST_HEADER << "\n";
+        for (const ChainEntry& entry : chain) {
+            stream << entry.first << " " << entry.second << "\n";
+        }
+        stream.flush();
+        if (!stream) {
+            std::remove(temporary.c_str());
+            return report(error, "Cannot write " + temporary);
+        }
+    }
+
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        // Some platforms refuse to rename over an existing file
+        std::remove(path.c_str());
+        if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+            std::remove(temporary.c_str());
+            return report(error, "Cannot replace " + path);
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
+// ============== State ==============
+
+/**
+ * @brief Checkpointing state shared by the caller, the tick callback and the writer thread
+ */
+struct Checkpointer::State {
+    std::string directory;                     // Where the files go
+
+    std::mutex captureMutex;                   // Serializes captures
+    NetworkSnapshot::Lineage lineage;          // Links the captured checkpoints (under captureMutex)
+    size_t deltasSinceBase;                    // Deltas captured since the base (under captureMutex)
+
+    std::atomic<size_t> interval;              // Ticks between automatic checkpoints
+    std::atomic<size_t> baseInterval;          // Deltas allowed after a base
+    std::atomic<size_t> ticks;                 // Ticks seen by the callback
+    std::atomic<uint64_t> sequence;            // Last captured sequence number
+
+    mutable std::mutex mutex;                  // Guards the fields below
+    std::condition_variable wake;              // Signals the writer
+    std::condition_variable idle;              // Signals flush()
+    std::shared_ptr<NetworkSnapshot::Image> pending;  // Captured checkpoint waiting to be written
+    uint64_t pendingSequence;                  // Its sequence number
+    bool pendingBase;                          // Whether it is a base
+    bool writing;                              // Whether the writer is busy
+    bool stopping;                             // Whether the writer should exit
+    bool needBase;                             // Whether the next checkpoint must be a base
+    bool failed;                               // Whether any write failed
+    std::string error;                         // Last write error
+    std::vector<ChainEntry> chain;             // Files in the manifest (writer thread only)
+
+    std::thread writer;                        // Background writer
+
+    State(const std::string& directory, size_t interval)
+        : directory(directory), deltasSinceBase(0), interval(interval), baseInterval(64), ticks(0),
+          sequence(0), pendingSequence(0), pendingBase(false), writing(false), stopping(false),
+          needBase(true), failed(false) {
+    }
+
+    /**
+     * @brief Capture a checkpoint and hand it to the writer
+     * @param wait Whether to wait for the previous write instead of skipping
+     */
+    bool capture(Network& network, bool wait) {
+        std::lock_guard<std::mutex> captureLock(captureMutex);
+
+        bool base;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (wait) {
+                idle.wait(lock, [this] { return stopping || (!pending && !writing); });
+            }
+            if (stopping || pending || writing) {
+                return false;  // Changes stay tracked until the writer catches up
+            }
+            base = needBase || deltasSinceBase >= baseInterval;
+            needBase = false;
+        }
+
+        std::shared_ptr<NetworkSnapshot::Image> image;
+        if (!base) {
+            image = NetworkSnapshot::captureChanges(network, lineage);
+        }
+        if (image) {
+            ++deltasSinceBase;
+        } else {
+            image = NetworkSnapshot::captureBase(network, lineage);
+            base = true;
+            deltasSinceBase = 0;
+        }
+        sequence = lineage.sequence;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        pending = image;
+        pendingSequence = lineage.sequence;
+        pendingBase = base;
+        wake.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Writer thread: write queued checkpoints and keep the manifest current
+     */
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            wake.wait(lock, [this] { return pending || stopping; });
+            if (!pending) {
+                break;
+            }
+
+            std::shared_ptr<NetworkSnapshot::Image> image;
+            image.swap(pending);
+            uint64_t number = pendingSequence;
+            bool base = pendingBase;
+            writing = true;
+            lock.unlock();
+
+            std::string message;
+            std::string name = fileName(number, base);
+            bool written = NetworkSnapshot::write(*image, joinPath(directory, name), &message);
+            image.reset();
+
+            if (written) {
+                std::vector<ChainEntry> updated = base ? std::vector<ChainEntry>() : chain;
+                updated.push_back(ChainEntry(number, name));
+                written = writeManifest(directory, updated, &message);
+
+                if (written) {
+                    // The old chain is no longer referenced once the new base is listed
+                    if (base) {
+                        for (const ChainEntry& entry : chain) {
+                            if (entry.second != name) {
+                                std::remove(joinPath(directory, entry.second).c_str());
+                            }
+                        }
+                    }
+                    chain.swap(updated);
+                } else if (base) {
+                    std::remove(joinPath(directory, name).c_str());
+                }
+            }
+
+            lock.lock();
+            writing = false;
+            if (!written) {
+                // Changes captured in the lost file are gone; only a new base recovers them
+                failed = true;
+                error = message;
+                needBase = true;
+            }
+            idle.notify_all();
+        }
+    }
+};
+
+// ============== Checkpointer Implementation ==============
+
+Checkpointer::Checkpointer(Network& network, const std::string& directory, size_t interval)
+    : network(network), state(std::make_shared<State>(directory, interval)), callbackHandle(0) {
+    // Continue the numbering of an earlier run so its files are never overwritten
+    if (readManifest(directory, state->chain, nullptr) && !state->chain.empty()) {
+        state->lineage.sequence = state->chain.back().first;
+        state->sequence = state->lineage.sequence;
+    }
+
+    state->writer = std::thread(&State::run, state.get());
+
+    std::weak_ptr<State> weak = state;
+    callbackHandle = network.onProcess([weak](Network& processed) {
+        std::shared_ptr<State> shared = weak.lock();
+        if (!shared) {
+            return;
+        }
+
+        size_t every = shared->interval;
+        if (every > 0 && ++shared->ticks % every == 0) {
+            shared->capture(processed, false);
+        }
+    });
+}
+
+Checkpointer::~Checkpointer() {
+    network.removeProcessCallback(callbackHandle);
+
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->stopping = true;
+    }
+    state->wake.notify_one();
+    state->writer.join();  // Writes the pending checkpoint first
+}
+
+bool Checkpointer::checkpoint() {
+    return state->capture(network, true);
+}
+
+bool Checkpointer::flush() {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->idle.wait(lock, [this] { return !state->pending && !state->writing; });
+    return !state->failed;
+}
+
+void Checkpointer::setInterval(size_t ticks) {
+    state->interval = ticks;
+}
+
+size_t Checkpointer::getInterval() const {
+    return state->interval;
+}
+
+void Checkpointer::setBaseInterval(size_t deltas) {
+    state->baseInterval = deltas;
+}
+
+size_t Checkpointer::getBaseInterval() const {
+    return state->baseInterval;
+}
+
+uint64_t Checkpointer::getSequence() const {
+    return state->sequence;
+}
+
+std::string Checkpointer::getError() const {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    return state->error;
+}
+
+std::shared_ptr<Network> Checkpointer::restore(const std::string& directory, std::string* error) {
+    std::vector<ChainEntry> chain;
+    if (!readManifest(directory, chain, error)) {
+        return nullptr;
+    }
+    if (chain.empty()) {
+        report(error, "No checkpoint in " + directory);
+        return nullptr;
+    }
+
+    // Base snapshot
+    NetworkSnapshot snapshot;
+    std::string path = joinPath(directory, chain[0].second);
+    if (!snapshot.open(path)) {
+        report(error, snapshot.getError());
+        return nullptr;
+    }
+    if (snapshot.isDelta() || snapshot.getSequence() != chain[0].first) {
+        report(error, path + " is not the base listed in the manifest");
+        return nullptr;
+    }
+
+    uint64_t baseSequence = snapshot.getSequence();
+    std::shared_ptr<Network> network = NetworkFactory::createNetwork(snapshot.getNetworkType(),
+                                                                     snapshot.getNetworkId());
+    if (!snapshot.restore(*network)) {
+        report(error, snapshot.getError());
+        return nullptr;
+    }
+
+    // Deltas, which must follow the base without gaps
+    for (size_t i = 1; i < chain.size(); ++i) {
+        path = joinPath(directory, chain[i].second);
+        if (!snapshot.open(path)) {
+            report(error, snapshot.getError());
+            return nullptr;
+        }
+        if (!snapshot.isDelta() || snapshot.getBaseSequence() != baseSequence ||
+            snapshot.getSequence() != chain[i].first || chain[i].first != chain[i - 1].first + 1) {
+            report(error, path + " does not continue the checkpoint chain");
+            return nullptr;
+        }
+        if (!snapshot.applyChanges(*network)) {
+            report(error, snapshot.getError());
+            return nullptr;
+        }
+    }
+
+    return network;
+}
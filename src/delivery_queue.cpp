@@ -0,0 +1,123 @@
+/**
+ * @file delivery_queue.cpp
+ * @brief Implementation of the tick-based signal delivery queue.
+ */
+
+#include "../include/delivery_queue.h"
+#include <algorithm>
+
+// ============== Ring Buffer ==============
+
+bool DeliveryQueue::Ring::push(Event&& event, size_t limit) {
+    if (count >= limit) {
+        return false;  // Slot is full
+    }
+
+    if (count == buffer.size()) {
+        // Grow geometrically up to the limit, unwrapping the contents
+        size_t grown = std::min(limit, std::max<size_t>(16, buffer.size() * 2));
+        std::vector<Event> resized(grown);
+        for (size_t i = 0; i < count; ++i) {
+            resized[i] = std::move(buffer[(head + i) % buffer.size()]);
+        }
+
+        buffer.swap(resized);
+        head = 0;
+    }
+
+    buffer[(head + count) % buffer.size()] = std::move(event);
+    ++count;
+    return true;
+}
+
+bool DeliveryQueue::Ring::pop(Event& event) {
+    if (count == 0) {
+        return false;
+    }
+
+    event = std::move(buffer[head]);
+    buffer[head].signal.reset();
+    head = (head + 1) % buffer.size();
+    --count;
+    return true;
+}
+
+void DeliveryQueue::Ring::clear() {
+    buffer.clear();
+    head = 0;
+    count = 0;
+}
+
+const uint32_t DeliveryQueue::DELAY_LIMIT;
+
+// ============== DeliveryQueue Implementation ==============
+
+DeliveryQueue::DeliveryQueue(uint32_t maxDelay, size_t slotCapacity)
+    : slots(std::min(std::max<uint32_t>(1, maxDelay), DELAY_LIMIT) + 1), tick(0), capacity(slotCapacity),
+      pending(0), dropped(0) {
+}
+
+bool DeliveryQueue::schedule(uint32_t target, uint32_t generation,
+                             SynapsePtr signal, uint32_t delay) {
+    delay = std::min(std::max<uint32_t>(1, delay), getMaxDelay());
+
+    Event event;
+    event.target = target;
+    event.generation = generation;
+    event.signal = std::move(signal);
+
+    if (!slots[(tick + delay) % slots.size()].push(std::move(event), capacity)) {
+        ++dropped;
+        return false;
+    }
+
+    ++pending;
+    return true;
+}
+
+void DeliveryQueue::advance() {
+    ++tick;
+}
+
+void DeliveryQueue::setMaxDelay(uint32_t maxDelay) {
+    maxDelay = std::min(std::max<uint32_t>(1, maxDelay), DELAY_LIMIT);
+    if (maxDelay == getMaxDelay()) {
+        return;
+    }
+
+    // Re-bucket the pending events into a wheel of the new size
+    std::vector<Ring> previous(maxDelay + 1);
+    previous.swap(slots);
+
+    size_t previousCount = previous.size();
+    pending = 0;
+
+    for (size_t due = 0; due < previousCount; ++due) {
+        Ring& ring = previous[(tick + due) % previousCount];
+        Event event;
+        while (ring.pop(event)) {
+            uint32_t delay = std::min<uint32_t>(static_cast<uint32_t>(due), maxDelay);
+            if (slots[(tick + delay) % slots.size()].push(std::move(event), capacity)) {
+                ++pending;
+            } else {
+                ++dropped;
+            }
+        }
+    }
+}
+
+void DeliveryQueue::forEachPending(const std::function<void(const Event&, uint32_t)>& visit) const {
+    for (size_t due = 0; due < slots.size(); ++due) {
+        const Ring& ring = slots[(tick + due) % slots.size()];
+        for (size_t i = 0; i < ring.size(); ++i) {
+            visit(ring.at(i), static_cast<uint32_t>(due));
+        }
+    }
+}
+
+void DeliveryQueue::clear() {
+    for (Ring& ring : slots) {
+        ring.clear();
+    }
+    pending = 0;
+}
@@ -0,0 +1,572 @@
+/**
+ * @file edge_store.cpp
+ * @brief Implementation of the compressed-sparse-row edge store.
+ */
+
+#include "../include/edge_store.h"
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+// Smallest row segment allocated when a row first grows
+const uint32_t MIN_ROW_CAPACITY = 4;
+
+// Abandoned slots tolerated before rows are packed again
+const size_t COMPACTION_SLACK = 1024;
+
+} // namespace
+
+// ============== Row Storage ==============
+
+void EdgeStore::Rows::append(uint32_t row, uint32_t column, float value, uint16_t delay, size_t liveEntries) {
+    uint32_t count = counts[row];
+    uint32_t capacity = capacities[row];
+
+    if (count == capacity) {
+        uint32_t grow = std::max(MIN_ROW_CAPACITY, capacity);
+
+        if (offsets[row] + capacity == columns.size()) {
+            // Row is the last segment, so it can grow in place
+            columns.resize(columns.size() + grow);
+            if (weighted) {
+                values.resize(columns.size());
+                delays.resize(columns.size());
+            }
+        } else {
+            // Move the row to the end with room to grow
+            uint32_t newOffset = static_cast<uint32_t>(columns.size());
+            columns.resize(columns.size() + capacity + grow);
+            std::copy(columns.begin() + offsets[row], columns.begin() + offsets[row] + count,
+                      columns.begin() + newOffset);
+
+            if (weighted) {
+                values.resize(columns.size());
+                delays.resize(columns.size());
+                std::copy(values.begin() + offsets[row], values.begin() + offsets[row] + count,
+                          values.begin() + newOffset);
+                std::copy(delays.begin() + offsets[row], delays.begin() + offsets[row] + count,
+                          delays.begin() + newOffset);
+            }
+
+            offsets[row] = newOffset;
+        }
+
+        capacities[row] = capacity + grow;
+    }
+
+    columns[offsets[row] + count] = column;
+    if (weighted) {
+        values[offsets[row] + count] = value;
+        delays[offsets[row] + count] = delay;
+    }
+    counts[row] = count + 1;
+
+    compactIfSparse(liveEntries + 1);
+}
+
+void EdgeStore::Rows::reserveRow(uint32_t row, uint32_t extra) {
+    uint32_t count = counts[row];
+    uint32_t capacity = capacities[row];
+    uint32_t needed = count + extra;
+
+    if (needed <= capacity) {
+        return;
+    }
+
+    if (offsets[row] + capacity == columns.size()) {
+        // Row is the last segment, so it can grow in place
+        columns.resize(columns.size() + (needed - capacity));
+        if (weighted) {
+            values.resize(columns.size());
+            delays.resize(columns.size());
+        }
+    } else {
+        // Move the row to the end with exactly the room required
+        uint32_t newOffset = static_cast<uint32_t>(columns.size());
+        columns.resize(columns.size() + needed);
+        std::copy(columns.begin() + offsets[row], columns.begin() + offsets[row] + count,
+                  columns.begin() + newOffset);
+
+        if (weighted) {
+            values.resize(columns.size());
+            delays.resize(columns.size());
+            std::copy(values.begin() + offsets[row], values.begin() + offsets[row] + count,
+                      values.begin() + newOffset);
+            std::copy(delays.begin() + offsets[row], delays.begin() + offsets[row] + count,
+                      delays.begin() + newOffset);
+        }
+
+        offsets[row] = newOffset;
+    }
+
+    capacities[row] = needed;
+}
+
+void EdgeStore::Rows::push(uint32_t row, uint32_t column, float value, uint16_t delay) {
+    uint32_t position = offsets[row] + counts[row];
+
+    columns[position] = column;
+    if (weighted) {
+        values[position] = value;
+        delays[position] = delay;
+    }
+    ++counts[row];
+}
+
+void EdgeStore::Rows::compactIfSparse(size_t liveEntries) {
+    // Pack the rows once relocations have left too many holes behind
+    if (columns.size() > 2 * (liveEntries + 1) + COMPACTION_SLACK) {
+        compact();
+    }
+}
+
+void EdgeStore::Rows::erase(uint32_t row, uint32_t position) {
+    // Shift the rest of the row down to keep insertion order
+    uint32_t begin = offsets[row];
+    uint32_t count = counts[row];
+
+    std::copy(columns.begin() + begin + position + 1, columns.begin() + begin + count,
+              columns.begin() + begin + position);
+    if (weighted) {
+        std::copy(values.begin() + begin + position + 1, values.begin() + begin + count,
+                  values.begin() + begin + position);
+        std::copy(delays.begin() + begin + position + 1, delays.begin() + begin + count,
+                  delays.begin() + begin + position);
+    }
+
+    counts[row] = count - 1;
+}
+
+uint32_t EdgeStore::Rows::find(uint32_t row, uint32_t column) const {
+    const uint32_t* begin = columns.data() + offsets[row];
+    const uint32_t* end = begin + counts[row];
+    const uint32_t* it = std::find(begin, end, column);
+
+    return it != end ? static_cast<uint32_t>(it - begin) : NOT_FOUND;
+}
+
+void EdgeStore::Rows::compact() {
+    size_t live = 0;
+    for (uint32_t count : counts) {
+        live += count;
+    }
+
+    std::vector<uint32_t> packedColumns;
+    std::vector<float> packedValues;
+    std::vector<uint16_t> packedDelays;
+    packedColumns.reserve(live);
+    if (weighted) {
+        packedValues.reserve(live);
+        packedDelays.reserve(live);
+    }
+
+    for (size_t row = 0; row < offsets.size(); ++row) {
+        uint32_t begin = offsets[row];
+        offsets[row] = static_cast<uint32_t>(packedColumns.size());
+        capacities[row] = counts[row];
+
+        packedColumns.insert(packedColumns.end(), columns.begin() + begin,
+                             columns.begin() + begin + counts[row]);
+        if (weighted) {
+            packedValues.insert(packedValues.end(), values.begin() + begin,
+                                values.begin() + begin + counts[row]);
+            packedDelays.insert(packedDelays.end(), delays.begin() + begin,
+                                delays.begin() + begin + counts[row]);
+        }
+    }
+
+    columns.swap(packedColumns);
+    values.swap(packedValues);
+    delays.swap(packedDelays);
+}
+
+// ============== EdgeStore Implementation ==============
+
+const uint32_t EdgeStore::NOT_FOUND;
+
+EdgeStore::EdgeStore() : edges(0), frozen(false), structureRevision(0) {
+    out.weighted = true;
+    in.weighted = false;
+}
+
+void EdgeStore::resize(uint32_t neuronCount) {
+    if (neuronCount <= out.offsets.size()) {
+        return;
+    }
+
+    // New rows start empty; their offset is irrelevant until they grow
+    Rows* directions[] = { &out, &in };
+    for (Rows* rows : directions) {
+        rows->offsets.resize(neuronCount, static_cast<uint32_t>(rows->columns.size()));
+        rows->counts.resize(neuronCount, 0);
+        rows->capacities.resize(neuronCount, 0);
+    }
+    changedRows.resize(neuronCount, 0);
+}
+
+void EdgeStore::reserve(size_t edgeCount) {
+    out.columns.reserve(edgeCount);
+    out.values.reserve(edgeCount);
+    out.delays.reserve(edgeCount);
+    in.columns.reserve(edgeCount);
+}
+
+bool EdgeStore::connect(uint32_t source, uint32_t target, float weight) {
+    resize(std::max(source, target) + 1);
+
+    // Update the weight if the edge already exists
+    uint32_t position = out.find(source, target);
+    if (position != NOT_FOUND) {
+        outWeights(source)[position] = weight;
+        changedRows[source] = 1;
+        return true;
+    }
+
+    if (frozen) {
+        return false;  // Topology is static
+    }
+
+    // New edges deliver on the next tick
+    out.append(source, target, weight, 1, edges);
+    in.append(target, source, 0.0f, 0, edges);
+    ++edges;
+    ++structureRevision;
+
+    return true;
+}
+
+size_t EdgeStore::connectBatch(const std::vector<BatchEdge>& batch) {
+    if (batch.empty()) {
+        return 0;
+    }
+
+    uint32_t neuronCount = static_cast<uint32_t>(out.offsets.size());
+    for (const BatchEdge& edge : batch) {
+        neuronCount = std::max(neuronCount, std::max(edge.source, edge.target) + 1);
+    }
+    resize(neuronCount);
+
+    // Group the batch by source, keeping batch order within each group
+    std::vector<uint32_t> groupStart(neuronCount + 1, 0);
+    for (const BatchEdge& edge : batch) {
+        ++groupStart[edge.source + 1];
+    }
+    for (uint32_t i = 0; i < neuronCount; ++i) {
+        groupStart[i + 1] += groupStart[i];
+    }
+    std::vector<uint32_t> grouped(batch.size());
+    {
+        std::vector<uint32_t> fill(groupStart.begin(), groupStart.end() - 1);
+        for (uint32_t i = 0; i < batch.size(); ++i) {
+            grouped[fill[batch[i].source]++] = i;
+        }
+    }
+
+    // Resolve each group in batch order. Edges that already exist are
+    // updated in place (the last entry wins); a new edge is added once, at
+    // its first entry, with the values of its last entry.
+    std::vector<uint32_t> lastEntry(batch.size(), NOT_FOUND);  // Per first entry of a new edge
+    std::vector<uint32_t> seenSource(neuronCount, NOT_FOUND);  // Group that last saw each target
+    std::vector<uint32_t> seenEntry(neuronCount);              // First entry of a new edge, or NOT_FOUND
+    std::vector<uint32_t> seenPosition(neuronCount);           // Row position of an existing edge, or NOT_FOUND
+    std::vector<uint32_t> outExtra(neuronCount, 0);            // New edges per source
+    std::vector<uint32_t> inExtra(neuronCount, 0);             // New edges per target
+
+    for (uint32_t source = 0; source < neuronCount; ++source) {
+        for (uint32_t g = groupStart[source]; g < groupStart[source + 1]; ++g) {
+            uint32_t entry = grouped[g];
+            uint32_t target = batch[entry].target;
+
+            if (seenSource[target] != source) {
+                seenSource[target] = source;
+                seenPosition[target] = out.counts[source] ? out.find(source, target) : NOT_FOUND;
+                seenEntry[target] = NOT_FOUND;
+
+                if (seenPosition[target] == NOT_FOUND && !frozen) {
+                    seenEntry[target] = entry;
+                    ++outExtra[source];
+                    ++inExtra[target];
+                }
+            }
+
+            if (seenPosition[target] != NOT_FOUND) {
+                uint32_t position = out.offsets[source] + seenPosition[target];
+                out.values[position] = batch[entry].weight;
+                out.delays[position] = std::max<uint16_t>(1, batch[entry].delay);
+                changedRows[source] = 1;
+            } else if (seenEntry[target] != NOT_FOUND) {
+                lastEntry[seenEntry[target]] = entry;
+            }
+        }
+    }
+
+    // Grow every row once, in index order
+    for (uint32_t i = 0; i < neuronCount; ++i) {
+        if (outExtra[i]) out.reserveRow(i, outExtra[i]);
+    }
+    for (uint32_t i = 0; i < neuronCount; ++i) {
+        if (inExtra[i]) in.reserveRow(i, inExtra[i]);
+    }
+
+    // Append the new edges in batch order so rows keep insertion order
+    size_t added = 0;
+    for (uint32_t entry = 0; entry < batch.size(); ++entry) {
+        if (lastEntry[entry] == NOT_FOUND) {
+            continue;
+        }
+
+        const BatchEdge& edge = batch[entry];
+        const BatchEdge& last = batch[lastEntry[entry]];
+        out.push(edge.source, edge.target, last.weight, std::max<uint16_t>(1, last.delay));
+        in.push(edge.target, edge.source, 0.0f, 0);
+        ++added;
+    }
+
+    edges += added;
+    structureRevision += added ? 1 : 0;
+    out.compactIfSparse(edges);
+    in.compactIfSparse(edges);
+
+    return added;
+}
+
+void EdgeStore::assign(uint32_t neuronCount,
+                       const uint64_t* outStart, const uint32_t* outTargets,
+                       const float* outWeights, const uint16_t* outDelays,
+                       const uint64_t* inStart, const uint32_t* inSources) {
+    size_t outCount = static_cast<size_t>(outStart[neuronCount]);
+    size_t inCount = static_cast<size_t>(inStart[neuronCount]);
+
+    out.columns.assign(outTargets, outTargets + outCount);
+    out.values.assign(outWeights, outWeights + outCount);
+    out.delays.assign(outDelays, outDelays + outCount);
+    in.columns.assign(inSources, inSources + inCount);
+
+    Rows* directions[] = { &out, &in };
+    const uint64_t* starts[] = { outStart, inStart };
+    for (size_t d = 0; d < 2; ++d) {
+        Rows& rows = *directions[d];
+        rows.offsets.resize(neuronCount);
+        rows.counts.resize(neuronCount);
+        rows.capacities.resize(neuronCount);
+
+        for (uint32_t i = 0; i < neuronCount; ++i) {
+            rows.offsets[i] = static_cast<uint32_t>(starts[d][i]);
+            rows.counts[i] = static_cast<uint32_t>(starts[d][i + 1] - starts[d][i]);
+            rows.capacities[i] = rows.counts[i];
+        }
+    }
+
+    changedRows.assign(neuronCount, 0);
+    edges = outCount;
+    ++structureRevision;
+}
+
+bool EdgeStore::disconnect(uint32_t source, uint32_t target) {
+    if (frozen || source >= out.offsets.size() || target >= in.offsets.size()) {
+        return false;
+    }
+
+    uint32_t position = out.find(source, target);
+    if (position == NOT_FOUND) {
+        return false;  // Not connected
+    }
+
+    out.erase(source, position);
+    in.erase(target, in.find(target, source));
+    --edges;
+    ++structureRevision;
+
+    return true;
+}
+
+void EdgeStore::removeNeuron(uint32_t neuron) {
+    if (neuron >= out.offsets.size()) {
+        return;
+    }
+
+    // Drop the mirrored entries of every outgoing edge
+    for (uint32_t i = 0; i < out.counts[neuron]; ++i) {
+        uint32_t target = outTargets(neuron)[i];
+        in.erase(target, in.find(target, neuron));
+    }
+    edges -= out.counts[neuron];
+    out.counts[neuron] = 0;
+
+    // Drop every incoming edge from its source row
+    for (uint32_t i = 0; i < in.counts[neuron]; ++i) {
+        uint32_t source = inSources(neuron)[i];
+        out.erase(source, out.find(source, neuron));
+    }
+    edges -= in.counts[neuron];
+    in.counts[neuron] = 0;
+    ++structureRevision;
+}
+
+void EdgeStore::clear() {
+    Rows* directions[] = { &out, &in };
+    for (Rows* rows : directions) {
+        std::fill(rows->offsets.begin(), rows->offsets.end(), 0);
+        std::fill(rows->counts.begin(), rows->counts.end(), 0);
+        std::fill(rows->capacities.begin(), rows->capacities.end(), 0);
+        rows->columns.clear();
+        rows->values.clear();
+        rows->delays.clear();
+    }
+
+    edges = 0;
+    ++structureRevision;
+}
+
+uint32_t EdgeStore::find(uint32_t source, uint32_t target) const {
+    if (source >= out.offsets.size()) {
+        return NOT_FOUND;
+    }
+
+    return out.find(source, target);
+}
+
+float EdgeStore::getWeight(uint32_t source, uint32_t target) const {
+    uint32_t position = find(source, target);
+    return position != NOT_FOUND ? outWeights(source)[position] : 0.0f;
+}
+
+bool EdgeStore::setWeight(uint32_t source, uint32_t target, float weight) {
+    uint32_t position = find(source, target);
+    if (position == NOT_FOUND) {
+        return false;
+    }
+
+    outWeights(source)[position] = weight;
+    changedRows[source] = 1;
+    return true;
+}
+
+uint16_t EdgeStore::getDelay(uint32_t source, uint32_t target) const {
+    uint32_t position = find(source, target);
+    return position != NOT_FOUND ? outDelays(source)[position] : 0;
+}
+
+bool EdgeStore::setDelay(uint32_t source, uint32_t target, uint16_t delay) {
+    uint32_t position = find(source, target);
+    if (position == NOT_FOUND) {
+        return false;
+    }
+
+    out.delays[out.offsets[source] + position] = std::max<uint16_t>(1, delay);
+    changedRows[source] = 1;
+    return true;
+}
+
+void EdgeStore::compact() {
+    out.compact();
+    in.compact();
+}
+
+void EdgeStore::freeze() {
+    compact();
+    frozen = true;
+}
+
+void EdgeStore::thaw() {
+    frozen = false;
+}
+
+uint32_t EdgeStore::levelize(std::vector<uint32_t>& levels) const {
+    uint32_t rows = static_cast<uint32_t>(out.counts.size());
+    std::vector<uint32_t> order(rows, NOT_FOUND);      // Discovery order
+    std::vector<uint32_t> low(rows, 0);                // Lowest order reachable on the stack
+    std::vector<uint32_t> component(rows, NOT_FOUND);  // Strongly connected component
+    std::vector<uint32_t> open;                        // Rows not yet assigned a component
+    std::vector<std::pair<uint32_t, uint32_t>> path;   // Depth-first path: row and next edge
+    uint32_t discovered = 0;
+    uint32_t components = 0;
+
+    // Tarjan's algorithm without recursion, so deep chains cannot overflow
+    // the stack; components come out sinks first
+    for (uint32_t root = 0; root < rows; ++root) {
+        if (order[root] != NOT_FOUND) {
+            continue;
+        }
+
+        order[root] = low[root] = discovered++;
+        open.push_back(root);
+        path.emplace_back(root, 0);
+
+        while (!path.empty()) {
+            uint32_t row = path.back().first;
+            uint32_t edge = path.back().second;
+            if (edge < out.counts[row]) {
+                ++path.back().second;
+                uint32_t next = out.columns[out.offsets[row] + edge];
+                if (order[next] == NOT_FOUND) {
+                    order[next] = low[next] = discovered++;
+                    open.push_back(next);
+                    path.emplace_back(next, 0);
+                } else if (component[next] == NOT_FOUND) {
+                    low[row] = std::min(low[row], order[next]);
+                }
+                continue;
+            }
+
+            path.pop_back();
+            if (!path.empty()) {
+                uint32_t parent = path.back().first;
+                low[parent] = std::min(low[parent], low[row]);
+            }
+
+            if (low[row] == order[row]) {
+                uint32_t member;
+                do {
+                    member = open.back();
+                    open.pop_back();
+                    component[member] = components;
+                } while (member != row);
+                ++components;
+            }
+        }
+    }
+
+    // Group the rows by component
+    std::vector<uint32_t> starts(components + 1, 0);
+    for (uint32_t row = 0; row < rows; ++row) {
+        ++starts[component[row] + 1];
+    }
+    for (uint32_t c = 0; c < components; ++c) {
+        starts[c + 1] += starts[c];
+    }
+    std::vector<uint32_t> members(rows);
+    std::vector<uint32_t> fill(starts.begin(), starts.end() - 1);
+    for (uint32_t row = 0; row < rows; ++row) {
+        members[fill[component[row]]++] = row;
+    }
+
+    // Longest path over the condensation, visiting components sources first
+    std::vector<uint32_t> componentLevels(components, 0);
+    uint32_t levelCount = 0;
+    for (uint32_t c = components; c-- > 0;) {
+        uint32_t level = componentLevels[c];
+        levelCount = std::max(levelCount, level + 1);
+        for (uint32_t i = starts[c]; i < starts[c + 1]; ++i) {
+            uint32_t row = members[i];
+            const uint32_t* targets = out.columns.data() + out.offsets[row];
+            for (uint32_t edge = 0; edge < out.counts[row]; ++edge) {
+                uint32_t next = component[targets[edge]];
+                if (next != c) {
+                    componentLevels[next] = std::max(componentLevels[next], level + 1);
+                }
+            }
+        }
+    }
+
+    levels.resize(rows);
+    for (uint32_t row = 0; row < rows; ++row) {
+        levels[row] = componentLevels[component[row]];
+    }
+    return levelCount;
+}
+
+void EdgeStore::clearChanges() {
+    std::fill(changedRows.begin(), changedRows.end(), 0);
+}
@@ -0,0 +1,248 @@
+/**
+ * @file gate_chain.cpp
+ * @brief Implementation of compiled gate chains.
+ */
+
+#include "../include/gate_chain.h"
+#include <algorithm>
+#include <typeinfo>
+
+namespace {
+
+using GateType = NeuronGate::GateType;
+using Stage = GateChain::Stage;
+using Kernel = GateChain::Kernel;
+
+// Longest chain a stage index fits in the taken byte for
+const size_t MAX_STAGES = 254;
+
+/**
+ * @brief Evaluate one stage on a lone signal, like the gate's evaluate()
+ * @param stage The stage
+ * @param strength Signal strength
+ * @param output Receives the output strength if the stage takes the signal
+ * @return True if the stage takes the signal
+ */
+template <GateType Type>
+inline bool evaluateStage(const Stage& stage, float strength, float& output);
+
+template <>
+inline bool evaluateStage<GateType::AND>(const Stage& stage, float strength, float& output) {
+    output = strength;
+    return strength >= stage.threshold;
+}
+
+template <>
+inline bool evaluateStage<GateType::OR>(const Stage& stage, float strength, float& output) {
+    output = strength;
+    return strength >= stage.threshold && strength > 0.0f;
+}
+
+template <>
+inline bool evaluateStage<GateType::NOT>(const Stage&, float strength, float& output) {
+    output = 1.0f - strength;
+    return true;
+}
+
+template <>
+inline bool evaluateStage<GateType::XOR>(const Stage&, float, float&) {
+    return false;
+}
+
+template <>
+inline bool evaluateStage<GateType::THRESHOLD>(const Stage& stage, float strength, float& output) {
+    output = strength;
+    return strength >= stage.threshold;
+}
+
+template <>
+inline bool evaluateStage<GateType::MODULATOR>(const Stage& stage, float strength, float& output) {
+    output = std::min(1.0f, std::max(0.0f, strength * stage.factor));
+    return true;
+}
+
+/**
+ * @brief Stages of known types, unrolled at compile time
+ */
+template <GateType... Types>
+struct Route;
+
+template <>
+struct Route<> {
+    static inline uint8_t take(const Stage*, uint8_t, float, float&) {
+        return 0;
+    }
+};
+
+template <GateType First, GateType... Rest>
+struct Route<First, Rest...> {
+    /**
+     * @brief Find the first stage that takes a signal
+     * @return 1 + the stage, 0 if none takes it
+     */
+    static inline uint8_t take(const Stage* stages, uint8_t stage, float strength, float& output) {
+        return evaluateStage<First>(stages[0], strength, output)
+                   ? stage
+                   : Route<Rest...>::take(stages + 1, static_cast<uint8_t>(stage + 1), strength, output);
+    }
+};
+
+/**
+ * @brief Kernel for a chain of known stage types, all inlined into one loop
+ */
+template <GateType... Types>
+void runFixed(const Stage* stages, size_t, const float* strengths, size_t count, float* outputs, uint8_t* taken) {
+    for (size_t i = 0; i < count; ++i) {
+        float output = strengths[i];
+        taken[i] = Route<Types...>::take(stages, 1, strengths[i], output);
+        outputs[i] = output;
+    }
+}
+
+/**
+ * @brief Kernel for chains of any length, dispatching on the stage type
+ */
+void runGeneric(const Stage* stages, size_t stageCount, const float* strengths, size_t count,
+                float* outputs, uint8_t* taken) {
+    for (size_t i = 0; i < count; ++i) {
+        float strength = strengths[i];
+        float output = strength;
+        uint8_t winner = 0;
+
+        for (size_t s = 0; s < stageCount && !winner; ++s) {
+            bool passed = false;
+            switch (stages[s].type) {
+                case GateType::AND: passed = evaluateStage<GateType::AND>(stages[s], strength, output); break;
+                case GateType::OR: passed = evaluateStage<GateType::OR>(stages[s], strength, output); break;
+                case GateType::NOT: passed = evaluateStage<GateType::NOT>(stages[s], strength, output); break;
+                case GateType::XOR: passed = evaluateStage<GateType::XOR>(stages[s], strength, output); break;
+                case GateType::THRESHOLD:
+                    passed = evaluateStage<GateType::THRESHOLD>(stages[s], strength, output);
+                    break;
+                case GateType::MODULATOR:
+                    passed = evaluateStage<GateType::MODULATOR>(stages[s], strength, output);
+                    break;
+                default: break;
+            }
+            if (passed) {
+                winner = static_cast<uint8_t>(s + 1);
+            }
+        }
+
+        outputs[i] = output;
+        taken[i] = winner;
+    }
+}
+
+/**
+ * @brief Kernel for an empty chain: nothing is taken
+ */
+void runEmpty(const Stage*, size_t, const float* strengths, size_t count, float* outputs, uint8_t* taken) {
+    std::copy(strengths, strengths + count, outputs);
+    std::fill(taken, taken + count, 0);
+}
+
+/**
+ * @brief Get the kernel for a chain of two gates whose first gate is known
+ */
+template <GateType First>
+Kernel pairKernel(GateType second) {
+    switch (second) {
+        case GateType::AND: return &runFixed<First, GateType::AND>;
+        case GateType::OR: return &runFixed<First, GateType::OR>;
+        case GateType::NOT: return &runFixed<First, GateType::NOT>;
+        case GateType::XOR: return &runFixed<First, GateType::XOR>;
+        case GateType::THRESHOLD: return &runFixed<First, GateType::THRESHOLD>;
+        case GateType::MODULATOR: return &runFixed<First, GateType::MODULATOR>;
+        default: return &runGeneric;
+    }
+}
+
+/**
+ * @brief Get the kernel specialized for a chain of one or two gates
+ * @param stages The stages
+ * @return Kernel, or runGeneric for longer chains
+ */
+Kernel selectKernel(const std::vector<Stage>& stages) {
+    if (stages.empty()) {
+        return &runEmpty;
+    }
+
+    if (stages.size() == 1) {
+        switch (stages[0].type) {
+            case GateType::AND: return &runFixed<GateType::AND>;
+            case GateType::OR: return &runFixed<GateType::OR>;
+            case GateType::NOT: return &runFixed<GateType::NOT>;
+            case GateType::XOR: return &runFixed<GateType::XOR>;
+            case GateType::THRESHOLD: return &runFixed<GateType::THRESHOLD>;
+            case GateType::MODULATOR: return &runFixed<GateType::MODULATOR>;
+            default: return &runGeneric;
+        }
+    }
+
+    if (stages.size() == 2) {
+        switch (stages[0].type) {
+            case GateType::AND: return pairKernel<GateType::AND>(stages[1].type);
+            case GateType::OR: return pairKernel<GateType::OR>(stages[1].type);
+            case GateType::NOT: return pairKernel<GateType::NOT>(stages[1].type);
+            case GateType::XOR: return pairKernel<GateType::XOR>(stages[1].type);
+            case GateType::THRESHOLD: return pairKernel<GateType::THRESHOLD>(stages[1].type);
+            case GateType::MODULATOR: return pairKernel<GateType::MODULATOR>(stages[1].type);
+            default: return &runGeneric;
+        }
+    }
+
+    return &runGeneric;
+}
+
+/**
+ * @brief Check whether a gate is exactly one of the built-in gate classes
+ */
+bool isNative(const NeuronGate& gate) {
+    const std::type_info& type = typeid(gate);
+    switch (gate.getType()) {
+        case GateType::AND: return type == typeid(AndGate);
+        case GateType::OR: return type == typeid(OrGate);
+        case GateType::NOT: return type == typeid(NotGate);
+        case GateType::XOR: return type == typeid(XorGate);
+        case GateType::THRESHOLD: return type == typeid(ThresholdGate);
+        case GateType::MODULATOR: return type == typeid(ModulatorGate);
+        default: return false;
+    }
+}
+
+} // namespace
+
+GateChain::GateChain() : kernel(&runEmpty), compiled(false) {
+}
+
+bool GateChain::compile(const std::vector<std::shared_ptr<NeuronGate>>& gates) {
+    stages.clear();
+    kernel = &runEmpty;
+    compiled = false;
+
+    for (const auto& gate : gates) {
+        if (!gate || !gate->isActive()) {
+            continue;
+        }
+        if (!isNative(*gate) || stages.size() == MAX_STAGES) {
+            stages.clear();
+            return false;
+        }
+        stages.push_back({ gate->getType(), 0.0f, 1.0f, gate.get() });
+    }
+
+    kernel = selectKernel(stages);
+    compiled = true;
+    return true;
+}
+
+void GateChain::run(const float* strengths, size_t count, float* outputs, uint8_t* taken) {
+    for (Stage& stage : stages) {
+        stage.threshold = stage.gate->getThreshold();
+        if (stage.type == GateType::MODULATOR) {
+            stage.factor = static_cast<const ModulatorGate*>(stage.gate)->getFactor();
+        }
+    }
+    kernel(stages.data(), stages.size(), strengths, count, outputs, taken);
+}
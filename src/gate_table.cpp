@@ -0,0 +1,220 @@
+/**
+ * @file gate_table.cpp
+ * @brief Implementation of the columnar gate parameter table.
+ */
+
+#include "../include/gate_table.h"
+#include "../include/integration_kernel.h"
+#include "../include/neuron.h"
+#include "../include/neuron_gate.h"
+#include "../include/thread_pool.h"
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define O3_GATE_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define O3_GATE_NEON 1
+#include <arm_neon.h>
+#endif
+
+const uint32_t GateTable::NO_NEURON;
+const size_t GateTable::DEFAULT_GRAIN;
+
+namespace {
+
+/**
+ * @brief Adapt slots [begin, end) one at a time
+ */
+inline void adaptTail(float* thresholds, const float* rates, const uint8_t* success, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        thresholds[i] = GateTable::adaptThreshold(thresholds[i], rates[i], success[i] != 0);
+    }
+}
+
+#if O3_GATE_X86
+
+__attribute__((target("avx2")))
+void adaptAvx2(float* thresholds, const float* rates, const uint8_t* success, size_t begin, size_t end) {
+    const __m256 low = _mm256_set1_ps(0.1f);
+    const __m256 high = _mm256_set1_ps(0.9f);
+    const __m256i none = _mm256_setzero_si256();
+
+    size_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        __m256i flags = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(success + i)));
+        __m256 mask = _mm256_castsi256_ps(_mm256_cmpgt_epi32(flags, none));
+
+        __m256 threshold = _mm256_loadu_ps(thresholds + i);
+        __m256 rate = _mm256_loadu_ps(rates + i);
+        __m256 lowered = _mm256_max_ps(_mm256_sub_ps(threshold, rate), low);
+        __m256 raised = _mm256_min_ps(_mm256_add_ps(threshold, rate), high);
+        _mm256_storeu_ps(thresholds + i, _mm256_blendv_ps(raised, lowered, mask));
+    }
+
+    adaptTail(thresholds, rates, success, i, end);
+}
+
+__attribute__((target("avx512f")))
+void adaptAvx512(float* thresholds, const float* rates, const uint8_t* success, size_t begin, size_t end) {
+    const __m512 low = _mm512_set1_ps(0.1f);
+    const __m512 high = _mm512_set1_ps(0.9f);
+
+    size_t i = begin;
+    for (; i + 16 <= end; i += 16) {
+        __m512i flags = _mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(success + i)));
+        __mmask16 mask = _mm512_test_epi32_mask(flags, flags);
+
+        __m512 threshold = _mm512_loadu_ps(thresholds + i);
+        __m512 rate = _mm512_loadu_ps(rates + i);
+        __m512 lowered = _mm512_max_ps(_mm512_sub_ps(threshold, rate), low);
+        __m512 raised = _mm512_min_ps(_mm512_add_ps(threshold, rate), high);
+        _mm512_storeu_ps(thresholds + i, _mm512_mask_blend_ps(mask, raised, lowered));
+    }
+
+    adaptTail(thresholds, rates, success, i, end);
+}
+
+#endif // O3_GATE_X86
+
+#if O3_GATE_NEON
+
+void adaptNeon(float* thresholds, const float* rates, const uint8_t* success, size_t begin, size_t end) {
+    const float32x4_t low = vdupq_n_f32(0.1f);
+    const float32x4_t high = vdupq_n_f32(0.9f);
+
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        uint32_t packed;
+        std::memcpy(&packed, success + i, sizeof(packed));
+        uint16x8_t widened = vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(packed)));
+        uint32x4_t mask = vcgtq_u32(vmovl_u16(vget_low_u16(widened)), vdupq_n_u32(0));
+
+        float32x4_t threshold = vld1q_f32(thresholds + i);
+        float32x4_t rate = vld1q_f32(rates + i);
+        float32x4_t lowered = vsubq_f32(threshold, rate);
+        float32x4_t raised = vaddq_f32(threshold, rate);
+        lowered = vbslq_f32(vcgtq_f32(lowered, low), lowered, low);
+        raised = vbslq_f32(vcltq_f32(raised, high), raised, high);
+        vst1q_f32(thresholds + i, vbslq_f32(mask, lowered, raised));
+    }
+
+    adaptTail(thresholds, rates, success, i, end);
+}
+
+#endif // O3_GATE_NEON
+
+/**
+ * @brief Adapt slots [begin, end) with the variant IntegrationKernel selected
+ */
+void adaptRange(float* thresholds, const float* rates, const uint8_t* success, size_t begin, size_t end) {
+    switch (IntegrationKernel::getIsa()) {
+#if O3_GATE_X86
+        case IntegrationKernel::Isa::AVX512:
+            adaptAvx512(thresholds, rates, success, begin, end);
+            return;
+        case IntegrationKernel::Isa::AVX2:
+            adaptAvx2(thresholds, rates, success, begin, end);
+            return;
+#endif
+#if O3_GATE_NEON
+        case IntegrationKernel::Isa::NEON:
+            adaptNeon(thresholds, rates, success, begin, end);
+            return;
+#endif
+        default:
+            adaptTail(thresholds, rates, success, begin, end);
+            return;
+    }
+}
+
+} // namespace
+
+GateTable::GateTable() {
+}
+
+uint32_t GateTable::allocate(NeuronGate* gate, float threshold, float rate, float factor, bool active,
+                             uint32_t neuron) {
+    // Reuse a released slot if one is available
+    if (!freeSlots.empty()) {
+        uint32_t slot = freeSlots.back();
+        freeSlots.pop_back();
+
+        thresholds[slot] = threshold;
+        adaptationRates[slot] = rate;
+        factors[slot] = factor;
+        actives[slot] = active ? 1 : 0;
+        neurons[slot] = neuron;
+        handles[slot] = gate;
+        return slot;
+    }
+
+    // Otherwise append a new slot at the end of every column
+    uint32_t slot = static_cast<uint32_t>(handles.size());
+
+    thresholds.push_back(threshold);
+    adaptationRates.push_back(rate);
+    factors.push_back(factor);
+    actives.push_back(active ? 1 : 0);
+    neurons.push_back(neuron);
+    handles.push_back(gate);
+    return slot;
+}
+
+void GateTable::release(uint32_t slot) {
+    if (slot >= handles.size() || !handles[slot]) {
+        return;  // Already free
+    }
+
+    handles[slot] = nullptr;
+    neurons[slot] = NO_NEURON;
+    freeSlots.push_back(slot);
+}
+
+void GateTable::transfer(NeuronGate& gate, uint32_t neuron) {
+    GateTable* previous = gate.table.get();
+    if (previous == this) {
+        neurons[gate.slot] = neuron;
+        return;
+    }
+
+    uint32_t oldSlot = gate.slot;
+    uint32_t newSlot = allocate(&gate, previous->thresholds[oldSlot], previous->adaptationRates[oldSlot],
+                                previous->factors[oldSlot], previous->actives[oldSlot] != 0, neuron);
+    previous->release(oldSlot);
+
+    // Rebind the handle; this may destroy the previous table if it was private
+    gate.slot = newSlot;
+    gate.table = shared_from_this();
+}
+
+void GateTable::setActive(uint32_t slot, bool active) {
+    uint8_t flag = active ? 1 : 0;
+    if (actives[slot] == flag) {
+        return;
+    }
+    actives[slot] = flag;
+
+    // A compiled chain holds only the gates that were active when it was compiled
+    NeuronGate* gate = handles[slot];
+    if (gate && gate->owner) {
+        gate->owner->invalidateGateChain();
+    }
+}
+
+void GateTable::adaptAll(const uint8_t* success, ThreadPool* pool, size_t grain) {
+    float* values = thresholds.data();
+    const float* rates = adaptationRates.data();
+    size_t count = handles.size();
+
+    if (!pool || count <= grain) {
+        adaptRange(values, rates, success, 0, count);
+        return;
+    }
+
+    pool->parallelFor(0, count, grain, [values, rates, success](size_t begin, size_t end) {
+        adaptRange(values, rates, success, begin, end);
+    });
+}
@@ -0,0 +1,430 @@
+/**
+ * @file graph_generator.cpp
+ * @brief Implementation of the synthetic graph generator.
+ */
+
+#include "../include/graph_generator.h"
+#include "../include/network.h"
+#include "../include/network_builder.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace {
+
+// Seeds of the independent random streams are derived from the configured seed
+const uint64_t TOPOLOGY_STREAM = 0x9E3779B97F4A7C15ULL;
+const uint64_t TYPE_STREAM = 0xBF58476D1CE4E5B9ULL;
+const uint64_t WEIGHT_STREAM = 0x94D049BB133111EBULL;
+
+/**
+ * @brief Random source that gives identical sequences on every platform
+ *
+ * std::mt19937_64 output is fixed by the standard, but the standard
+ * distributions are not, so the conversions are done here.
+ */
+class GraphRandom {
+public:
+    explicit GraphRandom(uint64_t seed) : engine(seed), hasSpare(false), spare(0.0) {}
+
+    // Uniform in [0, 1)
+    double uniform() {
+        return static_cast<double>(engine() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    // Uniform integer in [0, bound)
+    uint64_t below(uint64_t bound) {
+        const uint64_t limit = std::numeric_limits<uint64_t>::max() -
+                               std::numeric_limits<uint64_t>::max() % bound;
+        uint64_t value;
+        do {
+            value = engine();
+        } while (value >= limit);
+        return value % bound;
+    }
+
+    // Standard normal (Box-Muller)
+    double normal() {
+        if (hasSpare) {
+            hasSpare = false;
+            return spare;
+        }
+        double u = 1.0 - uniform();  // (0, 1]
+        double v = uniform();
+        double radius = std::sqrt(-2.0 * std::log(u));
+        double angle = 6.283185307179586 * v;
+        spare = radius * std::sin(angle);
+        hasSpare = true;
+        return radius * std::cos(angle);
+    }
+
+private:
+    std::mt19937_64 engine;  // Bit source
+    bool hasSpare;           // Whether spare holds the second Box-Muller value
+    double spare;            // Second Box-Muller value
+};
+
+uint64_t streamSeed(uint64_t seed, uint64_t stream) {
+    // SplitMix64 finalizer
+    uint64_t z = seed + stream;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+bool containsTarget(const std::vector<uint32_t>& row, uint32_t target) {
+    return std::find(row.begin(), row.end(), target) != row.end();
+}
+
+/**
+ * @brief Collects edges and draws their weights
+ */
+class EdgeSink {
+public:
+    EdgeSink(const GraphGenerator::Config& config, std::vector<GraphGenerator::Edge>& edges)
+        : config(config), edges(edges), random(streamSeed(config.seed, WEIGHT_STREAM)) {}
+
+    void add(uint32_t source, uint32_t target) {
+        GraphGenerator::Edge edge;
+        edge.source = source;
+        edge.target = target;
+        edge.weight = drawWeight();
+        edges.push_back(edge);
+    }
+
+private:
+    float drawWeight() {
+        switch (config.weights) {
+            case GraphGenerator::WeightDistribution::CONSTANT:
+                return config.weightA;
+            case GraphGenerator::WeightDistribution::UNIFORM:
+                return static_cast<float>(config.weightA + (config.weightB - config.weightA) * random.uniform());
+            case GraphGenerator::WeightDistribution::NORMAL:
+                return static_cast<float>(config.weightA + config.weightB * random.normal());
+            case GraphGenerator::WeightDistribution::LOG_NORMAL:
+                return static_cast<float>(std::exp(config.weightA + config.weightB * random.normal()));
+        }
+        return config.weightA;
+    }
+
+    const GraphGenerator::Config& config;   // Weight parameters
+    std::vector<GraphGenerator::Edge>& edges;  // Output
+    GraphRandom random;                     // Weight stream
+};
+
+void generateErdosRenyi(const GraphGenerator::Config& config, GraphRandom& random, EdgeSink& sink) {
+    const uint64_t n = config.neuronCount;
+    if (n < 2 || config.meanDegree <= 0.0) {
+        return;
+    }
+
+    double p = std::min(1.0, config.meanDegree / static_cast<double>(n - 1));
+
+    // Skip over absent pairs with geometric jumps, so the cost is linear in
+    // the number of edges rather than quadratic in the number of neurons
+    double logMiss = p < 1.0 ? std::log(1.0 - p) : 0.0;
+
+    for (uint64_t source = 0; source < n; ++source) {
+        int64_t position = -1;
+        for (;;) {
+            if (p < 1.0) {
+                double skip = std::floor(std::log(1.0 - random.uniform()) / logMiss);
+                position += 1 + static_cast<int64_t>(std::min(skip, static_cast<double>(n)));
+            } else {
+                position += 1;
+            }
+            if (position >= static_cast<int64_t>(n - 1)) {
+                break;
+            }
+
+            // Positions cover every neuron except the source itself
+            uint64_t target = static_cast<uint64_t>(position) < source ? position : position + 1;
+            sink.add(static_cast<uint32_t>(source), static_cast<uint32_t>(target));
+        }
+    }
+}
+
+void generateWattsStrogatz(const GraphGenerator::Config& config, GraphRandom& random, EdgeSink& sink) {
+    const uint64_t n = config.neuronCount;
+    if (n < 2) {
+        return;
+    }
+
+    uint64_t degree = static_cast<uint64_t>(std::max(0.0, std::floor(config.meanDegree + 0.5)));
+    degree = std::min(degree, n - 1);
+
+    std::vector<uint32_t> row;
+    for (uint64_t source = 0; source < n; ++source) {
+        // Lattice neighbours alternate sides: +1, -1, +2, -2, ...
+        row.clear();
+        for (uint64_t j = 1; j <= degree; ++j) {
+            uint64_t distance = (j + 1) / 2;
+            uint64_t target = (j % 2) ? (source + distance) % n : (source + n - distance % n) % n;
+            if (target != source && !containsTarget(row, static_cast<uint32_t>(target))) {
+                row.push_back(static_cast<uint32_t>(target));
+            }
+        }
+
+        // Rewire each lattice edge to a uniformly chosen new target
+        for (size_t i = 0; i < row.size(); ++i) {
+            if (random.uniform() >= config.rewireProbability || row.size() >= n - 1) {
+                continue;
+            }
+            uint32_t target;
+            do {
+                target = static_cast<uint32_t>(random.below(n));
+            } while (target == source || containsTarget(row, target));
+            row[i] = target;
+        }
+
+        for (uint32_t target : row) {
+            sink.add(static_cast<uint32_t>(source), target);
+        }
+    }
+}
+
+void generateBarabasiAlbert(const GraphGenerator::Config& config, GraphRandom& random, EdgeSink& sink) {
+    const uint64_t n = config.neuronCount;
+    const uint64_t m = std::max<uint64_t>(1, config.attachEdges);
+    if (n < 2) {
+        return;
+    }
+
+    // Every edge endpoint is recorded once, so drawing uniformly from this
+    // list picks neurons in proportion to their degree
+    std::vector<uint32_t> endpoints;
+    endpoints.reserve(static_cast<size_t>(2 * m * n));
+
+    // Seed with a complete graph on the first m + 1 neurons
+    uint64_t seedCount = std::min(n, m + 1);
+    for (uint64_t source = 1; source < seedCount; ++source) {
+        for (uint64_t target = 0; target < source; ++target) {
+            sink.add(static_cast<uint32_t>(source), static_cast<uint32_t>(target));
+            endpoints.push_back(static_cast<uint32_t>(source));
+            endpoints.push_back(static_cast<uint32_t>(target));
+        }
+    }
+
+    // Each new neuron attaches to m distinct existing neurons
+    std::vector<uint32_t> chosen;
+    for (uint64_t source = seedCount; source < n; ++source) {
+        chosen.clear();
+        while (chosen.size() < m) {
+            uint32_t target = endpoints[random.below(endpoints.size())];
+            if (!containsTarget(chosen, target)) {
+                chosen.push_back(target);
+            }
+        }
+        for (uint32_t target : chosen) {
+            sink.add(static_cast<uint32_t>(source), target);
+            endpoints.push_back(static_cast<uint32_t>(source));
+            endpoints.push_back(target);
+        }
+    }
+}
+
+void generateLayered(const GraphGenerator::Config& config, GraphRandom& random, EdgeSink& sink,
+                     std::vector<uint64_t>& layerStarts) {
+    const uint64_t n = config.neuronCount;
+    const uint64_t layers = std::max<uint64_t>(1, std::min<uint64_t>(config.layerCount, n));
+
+    // Split neurons as evenly as possible, earlier layers taking the remainder
+    layerStarts.clear();
+    uint64_t start = 0;
+    for (uint64_t layer = 0; layer < layers; ++layer) {
+        layerStarts.push_back(start);
+        start += n / layers + (layer < n % layers ? 1 : 0);
+    }
+    layerStarts.push_back(n);
+
+    std::vector<uint32_t> chosen;
+    for (uint64_t layer = 0; layer + 1 < layers; ++layer) {
+        uint64_t nextStart = layerStarts[layer + 1];
+        uint64_t nextWidth = layerStarts[layer + 2] - nextStart;
+        bool dense = config.layerFanOut == 0 || config.layerFanOut >= nextWidth;
+
+        for (uint64_t source = layerStarts[layer]; source < nextStart; ++source) {
+            if (dense) {
+                for (uint64_t j = 0; j < nextWidth; ++j) {
+                    sink.add(static_cast<uint32_t>(source), static_cast<uint32_t>(nextStart + j));
+                }
+                continue;
+            }
+
+            // Floyd's algorithm: fan-out distinct targets in one pass
+            chosen.clear();
+            for (uint64_t j = nextWidth - config.layerFanOut; j < nextWidth; ++j) {
+                uint32_t pick = static_cast<uint32_t>(random.below(j + 1));
+                chosen.push_back(containsTarget(chosen, pick) ? static_cast<uint32_t>(j) : pick);
+            }
+            for (uint32_t offset : chosen) {
+                sink.add(static_cast<uint32_t>(source), static_cast<uint32_t>(nextStart + offset));
+            }
+        }
+    }
+}
+
+} // namespace
+
+// ============== GraphGenerator Implementation ==============
+
+GraphGenerator::Config::Config()
+    : topology(Topology::ERDOS_RENYI), neuronCount(1000), meanDegree(8.0),
+      rewireProbability(0.1), attachEdges(4), layerCount(4), layerFanOut(8),
+      weights(WeightDistribution::UNIFORM), weightA(0.1f), weightB(0.5f),
+      inputCount(16), outputCount(16), seed(1) {
+    typeMix.push_back(std::make_pair(Neuron::NeuronType::PROCESSING, 1.0));
+}
+
+GraphGenerator::Graph GraphGenerator::generate(const Config& config) {
+    Graph graph;
+    const size_t n = config.neuronCount;
+
+    // Topology
+    GraphRandom topologyRandom(streamSeed(config.seed, TOPOLOGY_STREAM));
+    EdgeSink sink(config, graph.edges);
+    std::vector<uint64_t> layerStarts;
+
+    switch (config.topology) {
+        case Topology::ERDOS_RENYI:
+            graph.edges.reserve(static_cast<size_t>(config.meanDegree * n * 1.05));
+            generateErdosRenyi(config, topologyRandom, sink);
+            break;
+        case Topology::WATTS_STROGATZ:
+            graph.edges.reserve(static_cast<size_t>(config.meanDegree + 0.5) * n);
+            generateWattsStrogatz(config, topologyRandom, sink);
+            break;
+        case Topology::BARABASI_ALBERT:
+            graph.edges.reserve(std::max<size_t>(1, config.attachEdges) * n);
+            generateBarabasiAlbert(config, topologyRandom, sink);
+            break;
+        case Topology::LAYERED:
+            generateLayered(config, topologyRandom, sink, layerStarts);
+            break;
+    }
+
+    // Neuron types drawn from the mix
+    double totalShare = 0.0;
+    for (const auto& share : config.typeMix) {
+        totalShare += std::max(0.0, share.second);
+    }
+
+    GraphRandom typeRandom(streamSeed(config.seed, TYPE_STREAM));
+    graph.types.resize(n, Neuron::NeuronType::PROCESSING);
+    for (size_t i = 0; i < n && totalShare > 0.0; ++i) {
+        double draw = typeRandom.uniform() * totalShare;
+        for (const auto& share : config.typeMix) {
+            draw -= std::max(0.0, share.second);
+            if (draw < 0.0) {
+                graph.types[i] = share.first;
+                break;
+            }
+        }
+    }
+
+    // Input and output layers
+    size_t inputBegin = 0;
+    size_t inputEnd = std::min(n, config.inputCount);
+    size_t outputBegin = n - std::min(n, config.outputCount);
+    size_t outputEnd = n;
+
+    if (config.topology == Topology::LAYERED && layerStarts.size() > 2) {
+        size_t firstEnd = static_cast<size_t>(layerStarts[1]);
+        size_t lastBegin = static_cast<size_t>(layerStarts[layerStarts.size() - 2]);
+
+        std::fill(graph.types.begin(), graph.types.begin() + firstEnd, Neuron::NeuronType::SENSORY);
+        std::fill(graph.types.begin() + lastBegin, graph.types.end(), Neuron::NeuronType::OUTPUT);
+
+        inputEnd = std::min(firstEnd, config.inputCount);
+        outputBegin = std::max(lastBegin, n - std::min(n, config.outputCount));
+    }
+
+    for (size_t i = inputBegin; i < inputEnd; ++i) {
+        graph.types[i] = Neuron::NeuronType::SENSORY;
+        graph.inputs.push_back(static_cast<uint32_t>(i));
+    }
+    for (size_t i = std::max(outputBegin, inputEnd); i < outputEnd; ++i) {
+        graph.types[i] = Neuron::NeuronType::OUTPUT;
+        graph.outputs.push_back(static_cast<uint32_t>(i));
+    }
+
+    return graph;
+}
+
+std::vector<std::shared_ptr<Neuron>> GraphGenerator::build(const Graph& graph, Network& network,
+                                                           const std::string& idPrefix) {
+    NetworkBuilder builder(network);
+    builder.reserve(graph.types.size(), graph.edges.size());
+
+    for (size_t i = 0; i < graph.types.size(); ++i) {
+        builder.addNeuron(idPrefix + std::to_string(i), graph.types[i]);
+    }
+    for (const Edge& edge : graph.edges) {
+        builder.addEdge(edge.source, edge.target, edge.weight);
+    }
+    for (uint32_t input : graph.inputs) {
+        builder.addInput(input);
+    }
+    for (uint32_t output : graph.outputs) {
+        builder.addOutput(output);
+    }
+
+    return builder.finalize();
+}
+
+std::shared_ptr<Network> GraphGenerator::createNetwork(const Config& config, const std::string& networkId) {
+    auto network = std::make_shared<Network>(networkId);
+    build(generate(config), *network);
+    return network;
+}
+
+bool GraphGenerator::parseTopology(const std::string& name, Topology& topology) {
+    if (name == "er" || name == "erdos-renyi") {
+        topology = Topology::ERDOS_RENYI;
+    } else if (name == "ws" || name == "watts-strogatz") {
+        topology = Topology::WATTS_STROGATZ;
+    } else if (name == "ba" || name == "barabasi-albert") {
+        topology = Topology::BARABASI_ALBERT;
+    } else if (name == "layered") {
+        topology = Topology::LAYERED;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool GraphGenerator::parseWeightDistribution(const std::string& name, WeightDistribution& distribution) {
+    if (name == "constant") {
+        distribution = WeightDistribution::CONSTANT;
+    } else if (name == "uniform") {
+        distribution = WeightDistribution::UNIFORM;
+    } else if (name == "normal") {
+        distribution = WeightDistribution::NORMAL;
+    } else if (name == "lognormal") {
+        distribution = WeightDistribution::LOG_NORMAL;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool GraphGenerator::parseNeuronType(const std::string& name, Neuron::NeuronType& type) {
+    static const std::pair<const char*, Neuron::NeuronType> names[] = {
+        {"sensory", Neuron::NeuronType::SENSORY},
+        {"processing", Neuron::NeuronType::PROCESSING},
+        {"memory", Neuron::NeuronType::MEMORY},
+        {"integration", Neuron::NeuronType::INTEGRATION},
+        {"association", Neuron::NeuronType::ASSOCIATION},
+        {"output", Neuron::NeuronType::OUTPUT},
+        {"regulatory", Neuron::NeuronType::REGULATORY}
+    };
+
+    for (const auto& entry : names) {
+        if (name == entry.first) {
+            type = entry.second;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,229 @@
+/**
+ * @file integration_kernel.cpp
+ * @brief Scalar, AVX2, AVX-512 and NEON variants of the integration kernel.
+ *
+ * Every variant computes potential * decay + current with a fused
+ * multiply-add and clamps with the "a > b ? a : b" semantics of the x86
+ * max/min instructions, so they all round identically.
+ */
+
+#include "../include/integration_kernel.h"
+#include <atomic>
+#include <cmath>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define O3_KERNEL_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define O3_KERNEL_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+// Variant in use, or -1 before the first call
+std::atomic<int> selectedIsa(-1);
+
+/**
+ * @brief Integrate one slot; shared by the scalar variant and the vector tails
+ */
+inline bool integrateOne(float& potential, float threshold, float current, float decay) {
+    // Without decay the fused form equals a plain add, which avoids a libm call on old CPUs
+    float value = decay == 1.0f ? potential + current : std::fma(potential, decay, current);
+    value = value > 0.0f ? value : 0.0f;
+    value = value < 1.0f ? value : 1.0f;
+    potential = value;
+    return value >= threshold;
+}
+
+/**
+ * @brief Integrate slots [begin, count) one at a time
+ */
+inline void integrateTail(float* potentials, const float* thresholds, const float* currents,
+                          const uint8_t* active, const float* decays, size_t begin, size_t count, uint64_t* fired) {
+    for (size_t i = begin; i < count; ++i) {
+        if (active[i] && integrateOne(potentials[i], thresholds[i], currents[i], decays[i])) {
+            fired[i >> 6] |= uint64_t(1) << (i & 63);
+        }
+    }
+}
+
+void integrateScalar(float* potentials, const float* thresholds, const float* currents,
+                     const uint8_t* active, const float* decays, size_t count, uint64_t* fired) {
+    integrateTail(potentials, thresholds, currents, active, decays, 0, count, fired);
+}
+
+#if O3_KERNEL_X86
+
+__attribute__((target("avx2,fma")))
+void integrateAvx2(float* potentials, const float* thresholds, const float* currents,
+                   const uint8_t* active, const float* decays, size_t count, uint64_t* fired) {
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256i none = _mm256_setzero_si256();
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i flags = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(active + i)));
+        __m256 mask = _mm256_castsi256_ps(_mm256_cmpgt_epi32(flags, none));
+        if (_mm256_testz_ps(mask, mask)) {
+            continue;  // No slot of this block received input
+        }
+
+        __m256 before = _mm256_loadu_ps(potentials + i);
+        __m256 after = _mm256_fmadd_ps(before, _mm256_loadu_ps(decays + i), _mm256_loadu_ps(currents + i));
+        after = _mm256_min_ps(_mm256_max_ps(after, zero), one);
+        _mm256_storeu_ps(potentials + i, _mm256_blendv_ps(before, after, mask));
+
+        __m256 reached = _mm256_and_ps(_mm256_cmp_ps(after, _mm256_loadu_ps(thresholds + i), _CMP_GE_OQ), mask);
+        fired[i >> 6] |= static_cast<uint64_t>(_mm256_movemask_ps(reached)) << (i & 63);
+    }
+
+    integrateTail(potentials, thresholds, currents, active, decays, i, count, fired);
+}
+
+__attribute__((target("avx512f")))
+void integrateAvx512(float* potentials, const float* thresholds, const float* currents,
+                     const uint8_t* active, const float* decays, size_t count, uint64_t* fired) {
+    const __m512 zero = _mm512_setzero_ps();
+    const __m512 one = _mm512_set1_ps(1.0f);
+
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m512i flags = _mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(active + i)));
+        __mmask16 mask = _mm512_test_epi32_mask(flags, flags);
+        if (!mask) {
+            continue;  // No slot of this block received input
+        }
+
+        __m512 after = _mm512_fmadd_ps(_mm512_loadu_ps(potentials + i), _mm512_loadu_ps(decays + i),
+                                       _mm512_loadu_ps(currents + i));
+        after = _mm512_min_ps(_mm512_max_ps(after, zero), one);
+        _mm512_mask_storeu_ps(potentials + i, mask, after);
+
+        __mmask16 reached = _mm512_mask_cmp_ps_mask(mask, after, _mm512_loadu_ps(thresholds + i), _CMP_GE_OQ);
+        fired[i >> 6] |= static_cast<uint64_t>(reached) << (i & 63);
+    }
+
+    integrateTail(potentials, thresholds, currents, active, decays, i, count, fired);
+}
+
+#endif // O3_KERNEL_X86
+
+#if O3_KERNEL_NEON
+
+void integrateNeon(float* potentials, const float* thresholds, const float* currents,
+                   const uint8_t* active, const float* decays, size_t count, uint64_t* fired) {
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const uint32x4_t lanes = { 1, 2, 4, 8 };
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        uint32_t packed;
+        std::memcpy(&packed, active + i, sizeof(packed));
+        if (!packed) {
+            continue;  // No slot of this block received input
+        }
+        uint16x8_t widened = vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(packed)));
+        uint32x4_t mask = vcgtq_u32(vmovl_u16(vget_low_u16(widened)), vdupq_n_u32(0));
+
+        float32x4_t before = vld1q_f32(potentials + i);
+        float32x4_t after = vfmaq_f32(vld1q_f32(currents + i), before, vld1q_f32(decays + i));
+        after = vbslq_f32(vcgtq_f32(after, zero), after, zero);
+        after = vbslq_f32(vcltq_f32(after, one), after, one);
+        vst1q_f32(potentials + i, vbslq_f32(mask, after, before));
+
+        uint32x4_t reached = vandq_u32(vcgeq_f32(after, vld1q_f32(thresholds + i)), mask);
+        fired[i >> 6] |= static_cast<uint64_t>(vaddvq_u32(vandq_u32(reached, lanes))) << (i & 63);
+    }
+
+    integrateTail(potentials, thresholds, currents, active, decays, i, count, fired);
+}
+
+#endif // O3_KERNEL_NEON
+
+bool supports(IntegrationKernel::Isa isa) {
+    switch (isa) {
+        case IntegrationKernel::Isa::SCALAR:
+            return true;
+#if O3_KERNEL_X86
+        case IntegrationKernel::Isa::AVX2:
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        case IntegrationKernel::Isa::AVX512:
+            return __builtin_cpu_supports("avx512f");
+#endif
+#if O3_KERNEL_NEON
+        case IntegrationKernel::Isa::NEON:
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+} // namespace
+
+void IntegrationKernel::integrate(float* potentials, const float* thresholds, const float* currents,
+                                  const uint8_t* active, const float* decays, size_t count, uint64_t* fired) {
+    std::memset(fired, 0, ((count + 63) >> 6) * sizeof(uint64_t));
+
+    switch (getIsa()) {
+#if O3_KERNEL_X86
+        case Isa::AVX512:
+            integrateAvx512(potentials, thresholds, currents, active, decays, count, fired);
+            return;
+        case Isa::AVX2:
+            integrateAvx2(potentials, thresholds, currents, active, decays, count, fired);
+            return;
+#endif
+#if O3_KERNEL_NEON
+        case Isa::NEON:
+            integrateNeon(potentials, thresholds, currents, active, decays, count, fired);
+            return;
+#endif
+        default:
+            integrateScalar(potentials, thresholds, currents, active, decays, count, fired);
+            return;
+    }
+}
+
+IntegrationKernel::Isa IntegrationKernel::getIsa() {
+    int isa = selectedIsa.load(std::memory_order_relaxed);
+    if (isa < 0) {
+        isa = static_cast<int>(detect());
+        selectedIsa.store(isa, std::memory_order_relaxed);
+    }
+    return static_cast<Isa>(isa);
+}
+
+IntegrationKernel::Isa IntegrationKernel::detect() {
+    const Isa preference[] = { Isa::AVX512, Isa::AVX2, Isa::NEON };
+    for (Isa isa : preference) {
+        if (supports(isa)) {
+            return isa;
+        }
+    }
+    return Isa::SCALAR;
+}
+
+bool IntegrationKernel::setIsa(Isa isa) {
+    if (!supports(isa)) {
+        return false;
+    }
+    selectedIsa.store(static_cast<int>(isa), std::memory_order_relaxed);
+    return true;
+}
+
+const char* IntegrationKernel::getIsaName(Isa isa) {
+    switch (isa) {
+        case Isa::NEON: return "neon";
+        case Isa::AVX2: return "avx2";
+        case Isa::AVX512: return "avx512";
+        case Isa::SCALAR:
+        default: return "scalar";
+    }
+}
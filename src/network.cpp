@@ -4,26 +4,38 @@
  */
 
 #include "../include/network.h"
+#include "../include/thread_pool.h"
 #include <algorithm>
 #include <sstream>
 #include <iostream>
 
 // ============== Base Network Implementation ==============
 
-Network::Network(const std::string& id) : id(id), processing(false) {
+namespace {
+
+// Below one active neuron per this many slots, a tick skips the kernel sweep
+const size_t SPARSE_TICK_RATIO = 16;
+
+// Marks planSlots as never built
+const uint64_t NO_PLAN = UINT64_MAX;
+
+} // namespace
+
+Network::Network(const std::string& id)
+    : core(std::make_shared<SimulationCore>()), id(id), processing(false), nextCallbackHandle(1),
+      workerCount(1), partitionGrain(1024), planHiddenBegin(0), planHiddenEnd(0), planRevision(NO_PLAN),
+      scheduling(SchedulingMode::DENSE), planMode(SchedulingMode::DENSE) {
+    core->setPinned(true);
 }
 
 Network::~Network() {
     // Ensure processing is stopped
     processing = false;
+    threadPool.reset();
     
     // Clear all connections between neurons
-    for (auto& [_, neuron] : neurons) {
-        auto outputs = neuron->getOutputs();
-        for (auto& output : outputs) {
-            neuron->disconnectFrom(output);
-        }
-    }
+    core->edges().clear();
+    core->setPinned(false);
     
     // Clear all collections
     inputNeurons.clear();
@@ -38,16 +50,45 @@ const std::string& Network::getId() const {
 std::shared_ptr<Neuron> Network::createNeuron(const std::string& id, Neuron::NeuronType type) {
     std::lock_guard<std::mutex> lock(neuronMutex);
     
-    // Check if a neuron with this ID already exists
-    if (neurons.find(id) != neurons.end()) {
-        return neurons[id];  // Return existing neuron
+    // Return the existing neuron if one with this ID exists
+    std::shared_ptr<Neuron>& slot = neurons[id];
+    if (!slot) {
+        // Create a new neuron directly inside the network's simulation core
+        slot = std::make_shared<Neuron>(id, type, core);
+        core->indexMember(slot->getIndex());
+    }
+    
+    return slot;
+}
+
+std::vector<std::shared_ptr<Neuron>> Network::createNeurons(const std::vector<std::string>& ids,
+                                                            const std::vector<Neuron::NeuronType>& types) {
+    std::vector<std::shared_ptr<Neuron>> created;
+    created.reserve(ids.size());
+    
+    std::lock_guard<std::mutex> lock(neuronMutex);
+    
+    neurons.reserve(neurons.size() + ids.size());
+    core->reserve(core->size() + ids.size());
+    
+    for (size_t i = 0; i < ids.size() && i < types.size(); ++i) {
+        std::shared_ptr<Neuron>& slot = neurons[ids[i]];
+        if (!slot) {
+            slot = std::make_shared<Neuron>(ids[i], types[i], core);
+            core->indexMember(slot->getIndex());
+        }
+        created.push_back(slot);
     }
     
-    // Create a new neuron
-    auto neuron = std::make_shared<Neuron>(id, type);
-    neurons[id] = neuron;
+    return created;
+}
+
+void Network::reserve(size_t neuronCount, size_t connectionCount) {
+    std::lock_guard<std::mutex> lock(neuronMutex);
     
-    return neuron;
+    neurons.reserve(neurons.size() + neuronCount);
+    core->reserve(core->size() + neuronCount);
+    core->edges().reserve(core->edges().edgeCount() + connectionCount);
 }
 
 bool Network::addNeuron(std::shared_ptr<Neuron> neuron) {
@@ -62,7 +103,13 @@ bool Network::addNeuron(std::shared_ptr<Neuron> neuron) {
         return false;  // Already exists
     }
     
+    // Move the neuron's hot state into this network's core
+    if (!core->adopt(*neuron)) {
+        return false;  // Belongs to another network
+    }
+    
     neurons[neuron->getId()] = neuron;
+    core->indexMember(neuron->getIndex());
     return true;
 }
 
@@ -87,28 +134,25 @@ bool Network::removeNeuron(const std::string& id) {
     
     auto neuron = it->second;
     
-    // Disconnect this neuron from all others
-    auto outputs = neuron->getOutputs();
-    for (auto& output : outputs) {
-        neuron->disconnectFrom(output);
+    // Remove from input/output collections if present
+    uint8_t roles = core->roles(neuron->getIndex());
+    if (roles & SimulationCore::ROLE_INPUT) {
+        inputNeurons.erase(
+            std::remove(inputNeurons.begin(), inputNeurons.end(), neuron),
+            inputNeurons.end()
+        );
     }
     
-    // Disconnect all inputs to this neuron
-    auto inputs = neuron->getInputs();
-    for (auto& input : inputs) {
-        input->disconnectFrom(neuron);
+    if (roles & SimulationCore::ROLE_OUTPUT) {
+        outputNeurons.erase(
+            std::remove(outputNeurons.begin(), outputNeurons.end(), neuron),
+            outputNeurons.end()
+        );
     }
     
-    // Remove from input/output collections if present
-    inputNeurons.erase(
-        std::remove(inputNeurons.begin(), inputNeurons.end(), neuron),
-        inputNeurons.end()
-    );
-    
-    outputNeurons.erase(
-        std::remove(outputNeurons.begin(), outputNeurons.end(), neuron),
-        outputNeurons.end()
-    );
+    // Hand the neuron a private core so outside references stay valid;
+    // this also drops every connection to and from it
+    SimulationCore::detach(*neuron);
     
     // Remove from main collection
     neurons.erase(it);
@@ -152,28 +196,28 @@ std::vector<std::shared_ptr<Neuron>> Network::getAllNeurons() const {
 }
 
 std::vector<std::shared_ptr<Neuron>> Network::getNeuronsByType(Neuron::NeuronType type) const {
-    std::lock_guard<std::mutex> lock(neuronMutex);
-    
-    std::vector<std::shared_ptr<Neuron>> result;
-    
-    for (const auto& [_, neuron] : neurons) {
-        if (neuron->getType() == type) {
-            result.push_back(neuron);
-        }
-    }
-    
-    return result;
+    return findNeurons(NeuronQuery().ofType(type));
 }
 
 std::vector<std::shared_ptr<Neuron>> Network::getNeuronsByTag(const std::string& tag) const {
+    return findNeurons(NeuronQuery().withTag(tag));
+}
+
+std::vector<std::shared_ptr<Neuron>> Network::getNeuronsByTag(Symbol tag) const {
+    return findNeurons(NeuronQuery().withTag(tag));
+}
+
+std::vector<std::shared_ptr<Neuron>> Network::findNeurons(const NeuronQuery& query) const {
     std::lock_guard<std::mutex> lock(neuronMutex);
     
-    std::vector<std::shared_ptr<Neuron>> result;
+    // Resolve the query on the core's indexes instead of scanning neurons
+    std::vector<uint32_t> slots;
+    core->neuronIndex().select(query, slots);
     
-    for (const auto& [_, neuron] : neurons) {
-        if (neuron->hasTag(tag)) {
-            result.push_back(neuron);
-        }
+    std::vector<std::shared_ptr<Neuron>> result;
+    result.reserve(slots.size());
+    for (uint32_t slot : slots) {
+        result.push_back(core->handle(slot)->shared_from_this());
     }
     
     return result;
@@ -184,43 +228,362 @@ void Network::processSignals() {
         return;  // Already processing
     }
     
-    // Process all neurons in the network
-    auto allNeurons = getAllNeurons();
+    // Deliver the signals fired in earlier ticks that are due now
+    core->deliverDueSignals();
     
-    // First process input neurons
-    for (auto& neuron : inputNeurons) {
-        neuron->processSignals();
+    refreshPlan();
+    if (scheduling == SchedulingMode::LEVELIZED) {
+        processLevels();
+    } else {
+        processBatch();
     }
     
-    // Then process all other neurons (excluding input and output)
-    for (auto& neuron : allNeurons) {
-        // Skip if this is an input or output neuron
-        if (std::find(inputNeurons.begin(), inputNeurons.end(), neuron) != inputNeurons.end() ||
-            std::find(outputNeurons.begin(), outputNeurons.end(), neuron) != outputNeurons.end()) {
-            continue;
+    // Call process callbacks
+    for (auto& callback : processCallbacks) {
+        callback.second(*this);
+    }
+    
+    // Signals fired during this tick become due from the next one on
+    core->advanceTick();
+    
+    processing = false;
+}
+
+void Network::processBatch() {
+    // Collect this tick's work: input neurons first, then every other
+    // neuron with queued input in index order, output neurons last. The
+    // slots are remembered, since callbacks in phase 2 may remove neurons.
+    executionOrder.clear();
+    executionSlots.clear();
+    repeatedEntries.clear();
+    auto schedule = [this](uint32_t slot, bool repeated) {
+        executionOrder.push_back(core->handle(slot));
+        executionSlots.push_back(slot);
+        repeatedEntries.push_back(repeated ? 1 : 0);
+    };
+    
+    for (size_t i = 0; i < planHiddenBegin; ++i) {
+        schedule(planSlots[i], false);
+    }
+    
+    // An event-driven tick only visits the slots listed as active
+    bool eventDriven = scheduling == SchedulingMode::EVENT_DRIVEN;
+    if (eventDriven) {
+        core->takeActiveSlots(activeSlots);
+        for (uint32_t slot : activeSlots) {
+            if (core->roles(slot) == 0) {
+                schedule(slot, false);
+            }
+        }
+    } else {
+        for (size_t i = planHiddenBegin; i < planHiddenEnd; ++i) {
+            if (core->pendingSignals(planSlots[i]) != 0) {
+                schedule(planSlots[i], false);
+            }
         }
-        
-        neuron->processSignals();
     }
     
-    // Finally process output neurons
-    for (auto& neuron : outputNeurons) {
-        neuron->processSignals();
+    // A neuron that is also an input already has an entry above; its
+    // output entry only commits
+    for (size_t i = planHiddenEnd; i < planSlots.size(); ++i) {
+        schedule(planSlots[i], (core->roles(planSlots[i]) & SimulationCore::ROLE_INPUT) != 0);
     }
     
-    // Call process callbacks
-    for (auto& callback : processCallbacks) {
-        callback(*this);
+    // Phase 1: every neuron integrates its input independently
+    integrateAll();
+    
+    // Phase 2: fire one neuron at a time in execution order
+    commitAll();
+    
+    // Neurons that kept their input (e.g. while inhibited) stay active
+    if (eventDriven) {
+        core->relistActiveSlots(executionSlots);
+    }
+}
+
+void Network::processLevels() {
+    // Input and output neurons run every tick, the others when they have
+    // queued input; each waits in the bucket of its level. Input that
+    // reaches a level which already ran is kept for the next tick.
+    size_t current = 0;
+    deferredSlots.clear();
+    auto enqueue = [this, &current](uint32_t slot) {
+        uint32_t level = core->level(slot);
+        if (level < current || level >= levelBuckets.size()) {
+            deferredSlots.push_back(slot);
+        } else {
+            levelBuckets[level].push_back(slot);
+        }
+    };
+    
+    for (uint32_t slot : planSlots) {
+        enqueue(slot);
     }
     
-    processing = false;
+    for (; current < levelBuckets.size(); ++current) {
+        // Pick up the neurons that received input since the previous
+        // level, including the signals it fired in this tick
+        core->takeActiveSlots(activeSlots);
+        for (uint32_t slot : activeSlots) {
+            enqueue(slot);
+        }
+        
+        std::vector<uint32_t>& bucket = levelBuckets[current];
+        if (bucket.empty()) {
+            continue;
+        }
+        
+        // Neurons of one level never signal each other within the tick,
+        // so the level runs as one integrate and commit batch
+        std::sort(bucket.begin(), bucket.end());
+        bucket.erase(std::unique(bucket.begin(), bucket.end()), bucket.end());
+        executionOrder.clear();
+        executionSlots.clear();
+        for (uint32_t slot : bucket) {
+            if (slot < core->capacity() && core->handle(slot)) {
+                executionOrder.push_back(core->handle(slot));
+                executionSlots.push_back(slot);
+            }
+        }
+        repeatedEntries.assign(executionOrder.size(), 0);
+        bucket.clear();
+        
+        integrateAll();
+        commitAll();
+        core->relistActiveSlots(executionSlots);
+    }
+    
+    core->relistActiveSlots(deferredSlots);
+}
+
+void Network::commitAll() {
+    // Fire one neuron at a time in execution order, skipping neurons that
+    // an earlier callback removed from the network
+    for (size_t i = 0; i < executionOrder.size(); ++i) {
+        if (core->capacity() <= executionSlots[i] ||
+            core->handle(executionSlots[i]) != executionOrder[i]) {
+            continue;
+        }
+        
+        executionOrder[i]->commit(thresholdReached[i] != 0);
+    }
 }
 
 void Network::reset() {
     std::lock_guard<std::mutex> lock(neuronMutex);
     
+    // Clear potentials and buffered signals as well as the state
     for (auto& [_, neuron] : neurons) {
-        neuron->setState(Neuron::NeuronState::RESTING);
+        neuron->reset();
+    }
+    
+    // Drop signals still travelling between neurons
+    core->signalQueue().clear();
+}
+
+bool Network::adaptGates(const std::vector<uint8_t>& success) {
+    std::lock_guard<std::mutex> lock(neuronMutex);
+    
+    if (success.size() < core->capacity()) {
+        return false;
+    }
+    
+    // Gates take the outcome of their neuron; free slots are left as is
+    GateTable& table = core->gateParameters();
+    std::vector<uint8_t> gateSuccess(table.capacity(), 0);
+    for (uint32_t slot = 0; slot < table.capacity(); ++slot) {
+        uint32_t neuron = table.getNeuron(slot);
+        if (neuron != GateTable::NO_NEURON) {
+            gateSuccess[slot] = success[neuron];
+        }
+    }
+    
+    table.adaptAll(gateSuccess.data(), threadPool.get());
+    return true;
+}
+
+bool Network::setConnectionDelay(const std::string& sourceId, const std::string& targetId, uint32_t ticks) {
+    auto source = getNeuron(sourceId);
+    auto target = getNeuron(targetId);
+    
+    if (!source || !target) {
+        return false;  // One or both neurons not found
+    }
+    
+    return source->setConnectionDelay(target, ticks);
+}
+
+void Network::setMaxSignalDelay(uint32_t ticks) {
+    std::lock_guard<std::mutex> lock(neuronMutex);
+    core->signalQueue().setMaxDelay(ticks);
+}
+
+void Network::setSignalSlotCapacity(size_t capacity) {
+    std::lock_guard<std::mutex> lock(neuronMutex);
+    core->signalQueue().setSlotCapacity(capacity);
+}
+
+void Network::setSchedulingMode(SchedulingMode mode) {
+    std::lock_guard<std::mutex> lock(neuronMutex);
+    scheduling = mode;
+    core->setActivityTracking(mode != SchedulingMode::DENSE);
+}
+
+Network::SchedulingMode Network::getSchedulingMode() const {
+    std::lock_guard<std::mutex> lock(neuronMutex);
+    return scheduling;
+}
+
+void Network::setNeuronModel(const NeuronModel& model) {
+    std::lock_guard<std::mutex> lock(neuronMutex);
+    core->setNeuronModel(model);
+    core->markAttributesChanged();  // Checkpoint deltas assume an unchanged model
+}
+
+NeuronModel Network::getNeuronModel() const {
+    std::lock_guard<std::mutex> lock(neuronMutex);
+    return core->neuronModel();
+}
+
+uint64_t Network::getCurrentTick() const {
+    return core->signalQueue().getTick();
+}
+
+size_t Network::getPendingSignalCount() const {
+    return core->signalQueue().pendingCount();
+}
+
+uint64_t Network::getDroppedSignalCount() const {
+    return core->signalQueue().droppedCount();
+}
+
+void Network::setParallelism(size_t workers, size_t grain, bool pinWorkers) {
+    std::lock_guard<std::mutex> lock(neuronMutex);
+    
+    workers = std::max<size_t>(1, workers);
+    partitionGrain = std::max<size_t>(1, grain);
+    
+    // The calling thread works through partitions too, so it counts as a worker
+    threadPool.reset(workers > 1 ? new ThreadPool(workers - 1, pinWorkers) : nullptr);
+    workerCount = workers;
+}
+
+size_t Network::getWorkerCount() const {
+    std::lock_guard<std::mutex> lock(neuronMutex);
+    return workerCount;
+}
+
+size_t Network::getPartitionGrain() const {
+    std::lock_guard<std::mutex> lock(neuronMutex);
+    return partitionGrain;
+}
+
+ThreadPool* Network::getThreadPool() const {
+    std::lock_guard<std::mutex> lock(neuronMutex);
+    return threadPool.get();
+}
+
+void Network::refreshPlan() {
+    uint64_t revision = core->getStructureRevision();
+    if (revision == planRevision && scheduling == planMode) {
+        return;
+    }
+    bool dense = scheduling == SchedulingMode::DENSE;
+    
+    planSlots.clear();
+    for (const auto& neuron : inputNeurons) {
+        planSlots.push_back(neuron->getIndex());
+    }
+    planHiddenBegin = planSlots.size();
+    
+    // Event-driven and levelized ticks take the other slots from the
+    // active list instead
+    for (uint32_t index = 0; dense && index < core->capacity(); ++index) {
+        if (core->handle(index) && core->roles(index) == 0) {
+            planSlots.push_back(index);
+        }
+    }
+    planHiddenEnd = planSlots.size();
+    
+    for (const auto& neuron : outputNeurons) {
+        planSlots.push_back(neuron->getIndex());
+    }
+    
+    // Levelized ticks also need the level of every slot
+    std::vector<uint32_t> levels;
+    uint32_t levelCount = 0;
+    if (scheduling == SchedulingMode::LEVELIZED) {
+        levelCount = core->edges().levelize(levels);
+    }
+    core->setLevels(std::move(levels));
+    levelBuckets.resize(levelCount);
+    
+    planRevision = revision;
+    planMode = scheduling;
+}
+
+void Network::integrateAll() {
+    size_t count = executionOrder.size();
+    thresholdReached.assign(count, 0);
+    
+    // With few active neurons a sweep over every slot costs more than it
+    // saves; integrate them one by one instead
+    uint32_t capacity = core->capacity();
+    bool sparse = count * SPARSE_TICK_RATIO < capacity;
+    
+    // Repeated entries are skipped, so each neuron integrates once even
+    // when partitions run in parallel
+    auto integrateRange = [this, sparse](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (repeatedEntries[i]) {
+                continue;
+            }
+            if (sparse) {
+                thresholdReached[i] = executionOrder[i]->integrate();
+            } else {
+                executionOrder[i]->stageInput();
+            }
+        }
+    };
+    
+    // Partitions of whole bitmask words, so no two share a word
+    size_t words = (static_cast<size_t>(capacity) + 63) >> 6;
+    firedSlots.assign(words, 0);
+    auto sweepRange = [this, capacity](size_t begin, size_t end) {
+        uint32_t first = static_cast<uint32_t>(begin << 6);
+        uint32_t last = static_cast<uint32_t>(std::min<size_t>(end << 6, capacity));
+        core->integrate(first, last - first, firedSlots.data() + begin);
+    };
+    
+    if (!threadPool) {
+        integrateRange(0, count);
+        if (!sparse) {
+            sweepRange(0, words);
+        }
+    } else {
+        // Each partition writes only its own neurons and result entries;
+        // parallelFor returns once all of them are done, which is the barrier
+        // between the integrate and commit phases
+        threadPool->parallelFor(0, count, partitionGrain, integrateRange);
+        if (!sparse) {
+            threadPool->parallelFor(0, words, (partitionGrain + 63) >> 6, sweepRange);
+        }
+    }
+    
+    if (sparse) {
+        return;
+    }
+    
+    // Map the fired bits back to executionOrder; a neuron listed twice
+    // (input and output) reaches its threshold only at its first entry
+    for (size_t i = 0; i < count; ++i) {
+        if (repeatedEntries[i]) {
+            continue;
+        }
+        uint32_t slot = executionSlots[i];
+        uint64_t mask = uint64_t(1) << (slot & 63);
+        thresholdReached[i] = (firedSlots[slot >> 6] & mask) != 0;
+        firedSlots[slot >> 6] &= ~mask;
     }
 }
 
@@ -231,18 +594,27 @@ void Network::addInputNeuron(std::shared_ptr<Neuron> inputNeuron) {
     
     std::lock_guard<std::mutex> lock(neuronMutex);
     
-    // Check if already in the collection
-    if (std::find(inputNeurons.begin(), inputNeurons.end(), inputNeuron) != inputNeurons.end()) {
-        return;  // Already added
-    }
-    
     // Add to the network if not already there
-    if (neurons.find(inputNeuron->getId()) == neurons.end()) {
+    auto it = neurons.find(inputNeuron->getId());
+    if (it == neurons.end()) {
+        if (!core->adopt(*inputNeuron)) {
+            return;  // Belongs to another network
+        }
         neurons[inputNeuron->getId()] = inputNeuron;
+        core->indexMember(inputNeuron->getIndex());
+    } else if (it->second != inputNeuron) {
+        return;  // Another neuron of the network has this ID
+    }
+    
+    // Check if already in the collection
+    if (core->roles(inputNeuron->getIndex()) & SimulationCore::ROLE_INPUT) {
+        return;  // Already added
     }
     
     // Add to input collection
     inputNeurons.push_back(inputNeuron);
+    core->addRole(inputNeuron->getIndex(), SimulationCore::ROLE_INPUT);
+    core->markStructureChanged();
 }
 
 void Network::addOutputNeuron(std::shared_ptr<Neuron> outputNeuron) {
@@ -252,18 +624,27 @@ void Network::addOutputNeuron(std::shared_ptr<Neuron> outputNeuron) {
     
     std::lock_guard<std::mutex> lock(neuronMutex);
     
-    // Check if already in the collection
-    if (std::find(outputNeurons.begin(), outputNeurons.end(), outputNeuron) != outputNeurons.end()) {
-        return;  // Already added
-    }
-    
     // Add to the network if not already there
-    if (neurons.find(outputNeuron->getId()) == neurons.end()) {
+    auto it = neurons.find(outputNeuron->getId());
+    if (it == neurons.end()) {
+        if (!core->adopt(*outputNeuron)) {
+            return;  // Belongs to another network
+        }
         neurons[outputNeuron->getId()] = outputNeuron;
+        core->indexMember(outputNeuron->getIndex());
+    } else if (it->second != outputNeuron) {
+        return;  // Another neuron of the network has this ID
+    }
+    
+    // Check if already in the collection
+    if (core->roles(outputNeuron->getIndex()) & SimulationCore::ROLE_OUTPUT) {
+        return;  // Already added
     }
     
     // Add to output collection
     outputNeurons.push_back(outputNeuron);
+    core->addRole(outputNeuron->getIndex(), SimulationCore::ROLE_OUTPUT);
+    core->markStructureChanged();
 }
 
 std::vector<std::shared_ptr<Neuron>> Network::getInputNeurons() const {
@@ -276,7 +657,7 @@ std::vector<std::shared_ptr<Neuron>> Network::getOutputNeurons() const {
     return outputNeurons;
 }
 
-bool Network::injectSignal(std::shared_ptr<Synapse> signal, const std::string& targetId) {
+bool Network::injectSignal(SynapsePtr signal, const std::string& targetId) {
     if (!signal) {
         return false;
     }
@@ -303,10 +684,24 @@ bool Network::injectSignal(std::shared_ptr<Synapse> signal, const std::string& t
     return delivered;
 }
 
-void Network::onProcess(std::function<void(Network&)> callback) {
-    if (callback) {
-        processCallbacks.push_back(callback);
+size_t Network::onProcess(std::function<void(Network&)> callback) {
+    if (!callback) {
+        return 0;
+    }
+    
+    size_t handle = nextCallbackHandle++;
+    processCallbacks.push_back(std::make_pair(handle, callback));
+    return handle;
+}
+
+bool Network::removeProcessCallback(size_t handle) {
+    for (auto it = processCallbacks.begin(); it != processCallbacks.end(); ++it) {
+        if (it->first == handle) {
+            processCallbacks.erase(it);
+            return true;
+        }
     }
+    return false;
 }
 
 std::string Network::visualize() const {
@@ -346,16 +741,29 @@ size_t Network::getNeuronCount() const {
     return neurons.size();
 }
 
+size_t Network::getNeuronSlotCount() const {
+    std::lock_guard<std::mutex> lock(neuronMutex);
+    return core->capacity();
+}
+
 size_t Network::getConnectionCount() const {
     std::lock_guard<std::mutex> lock(neuronMutex);
-    
-    size_t count = 0;
-    
-    for (const auto& [_, neuron] : neurons) {
-        count += neuron->getOutputs().size();
-    }
-    
-    return count;
+    return core->edges().edgeCount();
+}
+
+void Network::freezeTopology() {
+    std::lock_guard<std::mutex> lock(neuronMutex);
+    core->edges().freeze();
+}
+
+void Network::thawTopology() {
+    std::lock_guard<std::mutex> lock(neuronMutex);
+    core->edges().thaw();
+}
+
+bool Network::isTopologyFrozen() const {
+    std::lock_guard<std::mutex> lock(neuronMutex);
+    return core->edges().isFrozen();
 }
 
 bool Network::isProcessing() const {
@@ -370,6 +778,7 @@ ConsciousNetwork::ConsciousNetwork(const std::string& id)
 
 void ConsciousNetwork::setAttentionFocus(const std::string& neuronId) {
     focusedNeuronId = neuronId;
+    core->markAttributesChanged();
 }
 
 std::string ConsciousNetwork::getAttentionFocus() const {
@@ -385,16 +794,16 @@ void ConsciousNetwork::processSignals() {
     
     // If there's a focused neuron, boost its activation
     if (!focusedNeuronId.empty()) {
-        auto focusedNeuron = getNeuron(focusedNeuronId);
-        if (focusedNeuron) {
+        auto neuron = getNeuron(focusedNeuronId);
+        if (neuron) {
             // Create an attention signal
-            auto attentionSignal = std::make_shared<Synapse>("attention_signal");
+            auto attentionSignal = Synapse::create("attention_signal");
             attentionSignal->setStrength(attentionStrength);
             attentionSignal->setData("type", std::string("attention"));
             attentionSignal->setData("source", std::string("conscious_control"));
             
             // Inject into the focused neuron
-            focusedNeuron->receiveSignal(attentionSignal);
+            neuron->receiveSignal(attentionSignal);
         }
     }
     
@@ -406,11 +815,54 @@ void ConsciousNetwork::processSignals() {
 
 SubconsciousNetwork::SubconsciousNetwork(const std::string& id)
     : Network(id) {
+    // Follow tags and metadata keys appearing and disappearing
+    core->neuronIndex().setPresenceTracking(true);
 }
 
 void SubconsciousNetwork::addPattern(const std::vector<std::string>& pattern, 
                                     const std::vector<std::string>& response) {
+    // Catch up first, so the new pattern starts from the current presence
+    updateMatches();
+    
+    uint32_t patternIndex = static_cast<uint32_t>(patterns.size());
     patterns.push_back(std::make_pair(pattern, response));
+    
+    // Intern the items once so matching compares symbols
+    SymbolTable& symbols = SymbolTable::global();
+    std::vector<Symbol> items;
+    items.reserve(pattern.size());
+    for (const auto& item : pattern) {
+        items.push_back(symbols.intern(item));
+    }
+    
+    // Register each distinct item and count the ones already present
+    const NeuronIndex& index = core->neuronIndex();
+    uint32_t itemCount = 0;
+    uint32_t presentCount = 0;
+    for (size_t i = 0; i < items.size(); ++i) {
+        if (std::find(items.begin(), items.begin() + i, items[i]) != items.begin() + i) {
+            continue;  // Repeated item
+        }
+        
+        auto inserted = patternItems.emplace(items[i], PatternItem());
+        PatternItem& entry = inserted.first->second;
+        if (inserted.second) {
+            entry.present = index.isPresent(items[i]);
+        }
+        entry.patterns.push_back(patternIndex);
+        
+        ++itemCount;
+        presentCount += entry.present ? 1 : 0;
+    }
+    
+    patternSymbols.push_back(items);
+    itemCounts.push_back(itemCount);
+    presentCounts.push_back(presentCount);
+    matched.push_back(presentCount == itemCount ? 1 : 0);
+    if (matched.back()) {
+        matchedPatterns.push_back(patternIndex);  // The highest index so far, so still in order
+    }
+    core->markAttributesChanged();
 }
 
 void SubconsciousNetwork::processSignals() {
@@ -418,38 +870,67 @@ void SubconsciousNetwork::processSignals() {
         return;  // Already processing
     }
     
-    // Check for pattern matches before normal processing
-    for (const auto& [pattern, response] : patterns) {
-        if (matchesPattern(pattern)) {
-            generateResponse(response);
-        }
+    // Respond to every matching pattern before normal processing
+    updateMatches();
+    for (uint32_t patternIndex : matchedPatterns) {
+        generateResponse(patterns[patternIndex].second);
     }
     
     // Proceed with normal processing
     Network::processSignals();
 }
 
-bool SubconsciousNetwork::matchesPattern(const std::vector<std::string>& pattern) const {
-    // Simplified pattern matching
-    // A real implementation would be more sophisticated
+void SubconsciousNetwork::updateMatches() {
+    const NeuronIndex& index = core->neuronIndex();
+    core->neuronIndex().takePresenceChanges(presenceChanges);
     
-    // For this example, we'll check if any neuron has metadata matching each pattern item
-    for (const auto& patternItem : pattern) {
-        bool found = false;
+    bool added = false;
+    bool removed = false;
+    for (Symbol symbol : presenceChanges) {
+        auto it = patternItems.find(symbol);
+        if (it == patternItems.end()) {
+            continue;  // No pattern waits for it
+        }
         
-        for (const auto& [_, neuron] : neurons) {
-            if (neuron->hasMetadata(patternItem) || neuron->hasTag(patternItem)) {
-                found = true;
-                break;
-            }
+        // The symbol may have been listed more than once, or changed back
+        PatternItem& entry = it->second;
+        bool present = index.isPresent(symbol);
+        if (present == entry.present) {
+            continue;
         }
+        entry.present = present;
         
-        if (!found) {
-            return false;  // Pattern item not found
+        for (uint32_t patternIndex : entry.patterns) {
+            if (present) {
+                ++presentCounts[patternIndex];
+            } else {
+                --presentCounts[patternIndex];
+            }
+            uint8_t matches = presentCounts[patternIndex] == itemCounts[patternIndex] ? 1 : 0;
+            if (matches == matched[patternIndex]) {
+                continue;
+            }
+            
+            matched[patternIndex] = matches;
+            if (matches) {
+                matchedPatterns.push_back(patternIndex);
+                added = true;
+            } else {
+                removed = true;
+            }
         }
     }
     
-    return true;  // All pattern items found
+    // Responses go out in pattern order
+    if (removed) {
+        matchedPatterns.erase(std::remove_if(matchedPatterns.begin(), matchedPatterns.end(),
+                                             [this](uint32_t patternIndex) { return !matched[patternIndex]; }),
+                              matchedPatterns.end());
+    }
+    if (added) {
+        std::sort(matchedPatterns.begin(), matchedPatterns.end());
+        matchedPatterns.erase(std::unique(matchedPatterns.begin(), matchedPatterns.end()), matchedPatterns.end());
+    }
 }
 
 void SubconsciousNetwork::generateResponse(const std::vector<std::string>& response) {
@@ -458,7 +939,7 @@ void SubconsciousNetwork::generateResponse(const std::vector<std::string>& respo
     
     for (const auto& outputNeuron : getOutputNeurons()) {
         // Create a response signal
-        auto responseSignal = std::make_shared<Synapse>("response_signal");
+        auto responseSignal = Synapse::create("response_signal");
         responseSignal->setStrength(0.8f);
         
         // Add response data
@@ -479,6 +960,7 @@ UnconsciousNetwork::UnconsciousNetwork(const std::string& id)
 
 void UnconsciousNetwork::addFilterRule(const std::string& key, const std::string& value) {
     filterRules.push_back(std::make_pair(key, value));
+    core->markAttributesChanged();
 }
 
 void UnconsciousNetwork::processSignals() {
@@ -489,13 +971,13 @@ void UnconsciousNetwork::processSignals() {
     // In unconscious processing, we filter signals before processing
     
     // Collect all signals from input neurons
-    std::vector<std::shared_ptr<Synapse>> inputSignals;
+    std::vector<SynapsePtr> inputSignals;
     
     // Process filtered signals
     Network::processSignals();
 }
 
-bool UnconsciousNetwork::passesFilters(const std::shared_ptr<Synapse>& signal) const {
+bool UnconsciousNetwork::passesFilters(const SynapsePtr& signal) const {
     if (!signal) {
         return false;
     }
@@ -0,0 +1,139 @@
+/**
+ * @file network_builder.cpp
+ * @brief Implementation of bulk network construction.
+ */
+
+#include "../include/network_builder.h"
+#include "../include/network.h"
+#include <algorithm>
+
+// ============== Specifications ==============
+
+NetworkBuilder::NeuronSpec::NeuronSpec(const std::string& id, Neuron::NeuronType type)
+    : id(id), type(type) {
+}
+
+NetworkBuilder::EdgeSpec::EdgeSpec(uint32_t source, uint32_t target, float weight, uint32_t delay)
+    : source(source), target(target), weight(weight), delay(delay) {
+}
+
+// ============== NetworkBuilder Implementation ==============
+
+NetworkBuilder::NetworkBuilder(Network& network) : network(network) {
+}
+
+void NetworkBuilder::reserve(size_t neuronCount, size_t edgeCount) {
+    neurons.reserve(neurons.size() + neuronCount);
+    edges.reserve(edges.size() + edgeCount);
+}
+
+uint32_t NetworkBuilder::addNeuron(const std::string& id, Neuron::NeuronType type) {
+    neurons.push_back(NeuronSpec(id, type));
+    return static_cast<uint32_t>(neurons.size() - 1);
+}
+
+uint32_t NetworkBuilder::addNeurons(const std::vector<NeuronSpec>& specs) {
+    uint32_t first = static_cast<uint32_t>(neurons.size());
+    neurons.insert(neurons.end(), specs.begin(), specs.end());
+    return first;
+}
+
+void NetworkBuilder::addEdge(uint32_t source, uint32_t target, float weight, uint32_t delay) {
+    edges.push_back(EdgeSpec(source, target, weight, delay));
+}
+
+void NetworkBuilder::addEdges(const std::vector<EdgeSpec>& specs) {
+    edges.insert(edges.end(), specs.begin(), specs.end());
+}
+
+void NetworkBuilder::addInput(uint32_t position) {
+    inputs.push_back(position);
+}
+
+void NetworkBuilder::addOutput(uint32_t position) {
+    outputs.push_back(position);
+}
+
+size_t NetworkBuilder::getNeuronCount() const {
+    return neurons.size();
+}
+
+size_t NetworkBuilder::getEdgeCount() const {
+    return edges.size();
+}
+
+std::vector<std::shared_ptr<Neuron>> NetworkBuilder::finalize() {
+    std::vector<std::shared_ptr<Neuron>> created;
+    created.reserve(neurons.size());
+
+    std::lock_guard<std::mutex> lock(network.neuronMutex);
+    SimulationCore& core = *network.core;
+
+    // Neurons, in order, so slots are assigned exactly as createNeuron would
+    network.neurons.reserve(network.neurons.size() + neurons.size());
+    core.reserve(core.size() + neurons.size());
+
+    for (const NeuronSpec& spec : neurons) {
+        std::shared_ptr<Neuron>& slot = network.neurons[spec.id];
+        if (!slot) {
+            slot = std::make_shared<Neuron>(spec.id, spec.type, network.core);
+            core.indexMember(slot->getIndex());
+        }
+        created.push_back(slot);
+    }
+
+    // Connections, translated from positions to core slots
+    uint32_t maxDelay = core.signalQueue().getMaxDelay();
+    std::vector<EdgeStore::BatchEdge> batch;
+    batch.reserve(edges.size());
+
+    for (const EdgeSpec& spec : edges) {
+        if (spec.source >= created.size() || spec.target >= created.size()) {
+            continue;
+        }
+
+        EdgeStore::BatchEdge edge;
+        edge.source = created[spec.source]->getIndex();
+        edge.target = created[spec.target]->getIndex();
+        edge.weight = spec.weight;
+        edge.delay = static_cast<uint16_t>(spec.delay < maxDelay ? spec.delay : maxDelay);
+
+        if (edge.source != edge.target) {
+            batch.push_back(edge);  // Self-loops are rejected like Neuron::connectTo does
+        }
+    }
+
+    core.edges().reserve(core.edges().edgeCount() + batch.size());
+    core.edges().connectBatch(batch);
+
+    // Input and output layers, skipping neurons already registered
+    struct Layer {
+        const std::vector<uint32_t>* positions;
+        std::vector<std::shared_ptr<Neuron>>* neurons;
+        SimulationCore::Role role;
+    };
+    Layer layers[] = { { &inputs, &network.inputNeurons, SimulationCore::ROLE_INPUT },
+                       { &outputs, &network.outputNeurons, SimulationCore::ROLE_OUTPUT } };
+
+    for (const Layer& layer : layers) {
+        for (uint32_t position : *layer.positions) {
+            if (position >= created.size()) {
+                continue;
+            }
+
+            uint32_t slot = created[position]->getIndex();
+            if (!(core.roles(slot) & layer.role)) {
+                core.addRole(slot, layer.role);
+                layer.neurons->push_back(created[position]);
+                core.markStructureChanged();
+            }
+        }
+    }
+
+    neurons.clear();
+    edges.clear();
+    inputs.clear();
+    outputs.clear();
+
+    return created;
+}
@@ -0,0 +1,1333 @@
+/**
+ * @file network_snapshot.cpp
+ * @brief Implementation of binary network snapshots.
+ */
+
+#include "../include/network_snapshot.h"
+#include "../include/neuron_gate.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define O3_SNAPSHOT_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// File signature
+const char MAGIC[8] = { 'O', '3', 'S', 'N', 'A', 'P', '\r', '\n' };
+
+// Written as a native integer; reads back differently on a host of the other byte order
+const uint32_t BYTE_ORDER_MARK = 0x01020304u;
+
+// String index meaning "no string"
+const uint32_t NO_STRING = 0xFFFFFFFFu;
+
+// Header flag: the edge store was frozen
+const uint32_t FLAG_FROZEN = 1u;
+
+// Header flag: the file is a checkpoint delta rather than a full snapshot
+const uint32_t FLAG_DELTA = 2u;
+
+// Section kinds. Values are part of the format and must never be reused.
+enum SectionKind : uint32_t {
+    STRING_START = 1,      // uint64_t[strings + 1], offsets into STRING_DATA
+    STRING_DATA = 2,       // char[], string characters
+    NEURON_IDS = 3,        // uint32_t[neurons], string index of each ID
+    NEURON_TYPES = 4,      // uint8_t[neurons]
+    NEURON_STATES = 5,     // uint8_t[neurons]
+    NEURON_THRESHOLDS = 6, // float[neurons]
+    NEURON_POTENTIALS = 7, // float[neurons]
+    TAG_START = 8,         // uint64_t[neurons + 1], rows of TAGS
+    TAGS = 9,              // uint32_t[], string indices
+    METADATA_START = 10,   // uint64_t[neurons + 1], rows of METADATA
+    METADATA = 11,         // StringPair[]
+    OUT_START = 12,        // uint64_t[neurons + 1], outgoing rows
+    OUT_TARGETS = 13,      // uint32_t[edges]
+    OUT_WEIGHTS = 14,      // float[edges]
+    OUT_DELAYS = 15,       // uint16_t[edges]
+    IN_START = 16,         // uint64_t[neurons + 1], incoming rows
+    IN_SOURCES = 17,       // uint32_t[edges]
+    GATE_START = 18,       // uint64_t[neurons + 1], rows of GATES
+    GATES = 19,            // GateRecord[]
+    INPUTS = 20,           // uint32_t[], input neuron indices
+    OUTPUTS = 21,          // uint32_t[], output neuron indices
+    ATTENTION = 22,        // AttentionRecord[1] (conscious tier)
+    PATTERN_START = 23,    // uint64_t[2 * patterns + 1], rows of PATTERN_STRINGS (items, response, ...)
+    PATTERN_STRINGS = 24,  // uint32_t[], string indices
+    FILTER_RULES = 25,     // StringPair[] (unconscious tier)
+    CHECKPOINT = 26,       // uint64_t[2], base sequence and sequence of a checkpoint
+    CHANGED_NEURONS = 27,  // uint32_t[changed], increasing neuron indices (delta)
+    CHANGED_THRESHOLDS = 28, // float[changed]
+    CHANGED_POTENTIALS = 29, // float[changed]
+    CHANGED_STATES = 30,   // uint8_t[changed]
+    CHANGED_ROWS = 31,     // uint32_t[rows], increasing indices of changed outgoing rows (delta)
+    CHANGED_ROW_START = 32, // uint64_t[rows + 1], rows of CHANGED_WEIGHTS and CHANGED_DELAYS
+    CHANGED_WEIGHTS = 33,  // float[], full weights of each changed row
+    CHANGED_DELAYS = 34,   // uint16_t[], full delays of each changed row
+    NEURON_MODEL = 35,     // ModelRecord[1]
+    NEURON_CLOCKS = 36,    // ClockRecord[neurons]
+    CHANGED_CLOCKS = 37    // ClockRecord[changed]
+};
+
+struct FileHeader {
+    char magic[8];          // MAGIC
+    uint32_t version;       // Format version
+    uint32_t byteOrder;     // BYTE_ORDER_MARK
+    uint32_t networkType;   // NetworkFactory::NetworkType
+    uint32_t networkId;     // String index of the network ID
+    uint32_t flags;         // FLAG_* bits
+    uint32_t sectionCount;  // Entries in the section table
+    uint32_t neuronCount;   // Number of neurons
+    uint32_t reserved;      // Zero
+    uint64_t edgeCount;     // Number of connections
+    uint64_t tableOffset;   // Position of the section table
+    uint64_t fileSize;      // Total file size
+};
+
+struct SectionEntry {
+    uint32_t kind;          // SectionKind
+    uint32_t elementSize;   // Size of one element in bytes
+    uint64_t offset;        // Position of the first element (8-byte aligned)
+    uint64_t count;         // Number of elements
+};
+
+struct StringPair {
+    uint32_t key;           // String index of the key
+    uint32_t value;         // String index of the value
+};
+
+struct GateRecord {
+    uint32_t id;            // String index of the gate ID
+    uint8_t type;           // NeuronGate::GateType
+    uint8_t active;         // Whether the gate is active
+    uint16_t reserved;      // Zero
+    float threshold;        // Gate threshold
+    float adaptationRate;   // Adaptation step
+    float factor;           // Modulation factor (modulator gates)
+};
+
+struct AttentionRecord {
+    uint32_t focus;         // String index of the focused neuron, or NO_STRING
+    float strength;         // Attention strength
+};
+
+struct ModelRecord {
+    uint32_t kind;          // NeuronModel::Kind
+    uint32_t refractoryTicks; // Absolute refractory period
+    float membraneTimeConstant; // Decay time constant (0 for none)
+    float tickDuration;     // Simulated time per tick
+    float resetPotential;   // Potential after firing
+    uint32_t reserved;      // Zero
+    uint64_t tick;          // Current tick of the network
+};
+
+struct ClockRecord {
+    uint64_t updated;       // Tick the potential was last brought up to date
+    uint64_t refractoryEnd; // First tick after the refractory period
+};
+
+static_assert(sizeof(FileHeader) == 64, "Snapshot header layout changed");
+static_assert(sizeof(SectionEntry) == 24, "Snapshot section layout changed");
+static_assert(sizeof(StringPair) == 8, "Snapshot string pair layout changed");
+static_assert(sizeof(GateRecord) == 20, "Snapshot gate layout changed");
+static_assert(sizeof(AttentionRecord) == 8, "Snapshot attention layout changed");
+static_assert(sizeof(ModelRecord) == 32, "Snapshot model layout changed");
+static_assert(sizeof(ClockRecord) == 16, "Snapshot clock layout changed");
+
+bool hostIsLittleEndian() {
+    const uint32_t probe = 1;
+    uint8_t first;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+/**
+ * @brief Describe the neuron model and tick of a core
+ *
+ * A capture taken by a callback during a tick (as the checkpointer's is)
+ * sees the state at the end of that tick, so it is recorded as the next.
+ */
+std::vector<ModelRecord> modelRecord(const SimulationCore& core, bool midTick) {
+    const NeuronModel& model = core.neuronModel();
+    std::vector<ModelRecord> record(1);
+    record[0].kind = static_cast<uint32_t>(model.getKind());
+    record[0].refractoryTicks = model.getRefractoryTicks();
+    record[0].membraneTimeConstant = model.getMembraneTimeConstant();
+    record[0].tickDuration = model.getTickDuration();
+    record[0].resetPotential = model.getResetPotential();
+    record[0].reserved = 0;
+    record[0].tick = core.getTick() + (midTick ? 1 : 0);
+    return record;
+}
+
+/**
+ * @brief Get the clocks of a core slot
+ */
+ClockRecord clockRecord(const SimulationCore& core, uint32_t slot) {
+    ClockRecord record;
+    core.clocks(slot, record.updated, record.refractoryEnd);
+    return record;
+}
+
+bool report(std::string* error, const std::string& message) {
+    if (error) {
+        *error = message;
+    }
+    return false;
+}
+
+/**
+ * @brief Deduplicating table of the strings written to a snapshot
+ */
+class StringTable {
+public:
+    uint32_t intern(const std::string& text) {
+        auto it = indices.find(text);
+        if (it != indices.end()) {
+            return it->second;
+        }
+
+        uint32_t index = static_cast<uint32_t>(start.size() - 1);
+        indices.emplace(text, index);
+        characters.insert(characters.end(), text.begin(), text.end());
+        start.push_back(characters.size());
+        return index;
+    }
+
+    StringTable() : start(1, 0) {}
+
+    std::vector<uint64_t> start;                       // Offsets of each string
+    std::vector<char> characters;                      // String characters
+
+private:
+    std::unordered_map<std::string, uint32_t> indices; // Index of each string
+};
+
+/**
+ * @brief Sequential writer of sections and the section table
+ */
+class SectionWriter {
+public:
+    explicit SectionWriter(FILE* file) : file(file), position(0), failed(false) {}
+
+    void begin(uint32_t kind, uint32_t elementSize) {
+        SectionEntry entry;
+        entry.kind = kind;
+        entry.elementSize = elementSize;
+        entry.offset = position;
+        entry.count = 0;
+        sections.push_back(entry);
+    }
+
+    void write(const void* data, size_t count) {
+        SectionEntry& entry = sections.back();
+        raw(data, count * entry.elementSize);
+        entry.count += count;
+    }
+
+    template<typename T>
+    void section(uint32_t kind, const std::vector<T>& values) {
+        begin(kind, sizeof(T));
+        write(values.data(), values.size());
+        end();
+    }
+
+    void end() {
+        static const char zeros[8] = { 0 };
+        raw(zeros, (8 - position % 8) % 8);
+    }
+
+    void raw(const void* data, size_t bytes) {
+        if (bytes && std::fwrite(data, 1, bytes, file) != bytes) {
+            failed = true;
+        }
+        position += bytes;
+    }
+
+    FILE* file;                          // Destination
+    uint64_t position;                   // Bytes written so far
+    bool failed;                         // Whether a write failed
+    std::vector<SectionEntry> sections;  // Sections written so far
+};
+
+} // namespace
+
+// ============== Images ==============
+
+/**
+ * @brief Sections captured from a network, ready to be written
+ */
+class NetworkSnapshot::Image {
+public:
+    struct Section {
+        uint32_t kind;                      // SectionKind
+        uint32_t elementSize;               // Size of one element in bytes
+        size_t count;                       // Number of elements
+        const void* data;                   // First element
+        std::shared_ptr<const void> owner;  // Storage of the elements
+    };
+
+    Image() : networkType(0), networkId(0), flags(0), neuronCount(0), edgeCount(0) {}
+
+    /**
+     * @brief Add a section, taking over the contents of a vector
+     */
+    template<typename T>
+    void add(uint32_t kind, std::vector<T>& values) {
+        std::shared_ptr<std::vector<T>> holder = std::make_shared<std::vector<T>>();
+        holder->swap(values);
+
+        Section section;
+        section.kind = kind;
+        section.elementSize = sizeof(T);
+        section.count = holder->size();
+        section.data = holder->data();
+        section.owner = holder;
+        sections.push_back(section);
+    }
+
+    uint32_t networkType;            // NetworkFactory::NetworkType
+    uint32_t networkId;              // String index of the network ID
+    uint32_t flags;                  // FLAG_* bits
+    uint32_t neuronCount;            // Number of neurons
+    uint64_t edgeCount;              // Number of connections
+    StringTable strings;             // Strings referenced by the sections
+    std::vector<Section> sections;   // Sections in file order
+};
+
+NetworkSnapshot::Lineage::Lineage()
+    : baseSequence(0), sequence(0), snapshotRevision(0), edgeCount(0) {
+}
+
+// ============== Saving ==============
+
+const uint32_t NetworkSnapshot::FORMAT_VERSION;
+
+std::shared_ptr<NetworkSnapshot::Image> NetworkSnapshot::capture(const Network& network,
+                                                                 std::vector<uint32_t>* slots,
+                                                                 std::vector<uint32_t>* denseIndices) {
+    const SimulationCore& core = *network.core;
+    const EdgeStore& edges = core.edges();
+    std::shared_ptr<Image> image = std::make_shared<Image>();
+    StringTable& strings = image->strings;
+    const SymbolTable& symbols = SymbolTable::global();
+
+    // Number the neurons densely, in slot order
+    std::vector<const Neuron*> neurons;
+    neurons.reserve(network.neurons.size());
+    for (const auto& entry : network.neurons) {
+        neurons.push_back(entry.second.get());
+    }
+    std::sort(neurons.begin(), neurons.end(),
+              [](const Neuron* a, const Neuron* b) { return a->index < b->index; });
+
+    uint32_t neuronCount = static_cast<uint32_t>(neurons.size());
+    std::vector<uint32_t> dense(core.capacity(), SimulationCore::INVALID_INDEX);
+    for (uint32_t i = 0; i < neuronCount; ++i) {
+        dense[neurons[i]->index] = i;
+    }
+
+    // Per-neuron arrays
+    std::vector<uint32_t> ids(neuronCount);
+    std::vector<uint8_t> types(neuronCount);
+    std::vector<uint8_t> states(neuronCount);
+    std::vector<float> thresholds(neuronCount);
+    std::vector<float> potentials(neuronCount);
+    std::vector<ClockRecord> clocks(neuronCount);
+    std::vector<uint64_t> tagStart(1, 0);
+    std::vector<uint32_t> tags;
+    std::vector<uint64_t> metadataStart(1, 0);
+    std::vector<StringPair> metadata;
+    std::vector<uint64_t> gateStart(1, 0);
+    std::vector<GateRecord> gates;
+    std::vector<uint64_t> outStart(1, 0);
+    std::vector<uint32_t> outTargets;
+    std::vector<float> outWeights;
+    std::vector<uint16_t> outDelays;
+    std::vector<uint64_t> inStart(1, 0);
+    std::vector<uint32_t> inSources;
+
+    outTargets.reserve(edges.edgeCount());
+    outWeights.reserve(edges.edgeCount());
+    outDelays.reserve(edges.edgeCount());
+    inSources.reserve(edges.edgeCount());
+
+    for (uint32_t i = 0; i < neuronCount; ++i) {
+        const Neuron& neuron = *neurons[i];
+        uint32_t slot = neuron.index;
+
+        ids[i] = strings.intern(neuron.id);
+        types[i] = static_cast<uint8_t>(neuron.type);
+        states[i] = static_cast<uint8_t>(core.state(slot));
+        thresholds[i] = core.threshold(slot);
+        potentials[i] = core.potential(slot);
+        clocks[i] = clockRecord(core, slot);
+
+        for (Symbol tag : neuron.tags) {
+            tags.push_back(strings.intern(symbols.name(tag)));
+        }
+        tagStart.push_back(tags.size());
+
+        for (const auto& entry : neuron.metadata) {
+            StringPair pair;
+            pair.key = strings.intern(symbols.name(entry.first));
+            pair.value = strings.intern(entry.second);
+            metadata.push_back(pair);
+        }
+        metadataStart.push_back(metadata.size());
+
+        for (const auto& gate : neuron.gates) {
+            GateRecord record;
+            record.id = strings.intern(gate->getId());
+            record.type = static_cast<uint8_t>(gate->getType());
+            record.active = gate->isActive() ? 1 : 0;
+            record.reserved = 0;
+            record.threshold = gate->getThreshold();
+            record.adaptationRate = gate->getAdaptationRate();
+            const ModulatorGate* modulator = dynamic_cast<const ModulatorGate*>(gate.get());
+            record.factor = modulator ? modulator->getFactor() : 1.0f;
+            gates.push_back(record);
+        }
+        gateStart.push_back(gates.size());
+
+        // Connections to neurons outside the network are left out
+        for (uint32_t k = 0; k < edges.outDegree(slot); ++k) {
+            uint32_t target = dense[edges.outTargets(slot)[k]];
+            if (target != SimulationCore::INVALID_INDEX) {
+                outTargets.push_back(target);
+                outWeights.push_back(edges.outWeights(slot)[k]);
+                outDelays.push_back(edges.outDelays(slot)[k]);
+            }
+        }
+        outStart.push_back(outTargets.size());
+
+        for (uint32_t k = 0; k < edges.inDegree(slot); ++k) {
+            uint32_t source = dense[edges.inSources(slot)[k]];
+            if (source != SimulationCore::INVALID_INDEX) {
+                inSources.push_back(source);
+            }
+        }
+        inStart.push_back(inSources.size());
+    }
+
+    // Layers
+    std::vector<uint32_t> inputs;
+    for (const auto& neuron : network.inputNeurons) {
+        if (neuron->core.get() == &core && dense[neuron->index] != SimulationCore::INVALID_INDEX) {
+            inputs.push_back(dense[neuron->index]);
+        }
+    }
+    std::vector<uint32_t> outputs;
+    for (const auto& neuron : network.outputNeurons) {
+        if (neuron->core.get() == &core && dense[neuron->index] != SimulationCore::INVALID_INDEX) {
+            outputs.push_back(dense[neuron->index]);
+        }
+    }
+
+    image->networkType = static_cast<uint32_t>(NetworkFactory::NetworkType::BASIC);
+    image->flags = edges.isFrozen() ? FLAG_FROZEN : 0;
+    image->neuronCount = neuronCount;
+    image->edgeCount = outTargets.size();
+
+    image->add(NEURON_IDS, ids);
+    image->add(NEURON_TYPES, types);
+    image->add(NEURON_STATES, states);
+    image->add(NEURON_THRESHOLDS, thresholds);
+    image->add(NEURON_POTENTIALS, potentials);
+    std::vector<ModelRecord> model = modelRecord(core, network.processing);
+    image->add(NEURON_MODEL, model);
+    image->add(NEURON_CLOCKS, clocks);
+    image->add(TAG_START, tagStart);
+    image->add(TAGS, tags);
+    image->add(METADATA_START, metadataStart);
+    image->add(METADATA, metadata);
+    image->add(GATE_START, gateStart);
+    image->add(GATES, gates);
+    image->add(OUT_START, outStart);
+    image->add(OUT_TARGETS, outTargets);
+    image->add(OUT_WEIGHTS, outWeights);
+    image->add(OUT_DELAYS, outDelays);
+    image->add(IN_START, inStart);
+    image->add(IN_SOURCES, inSources);
+    image->add(INPUTS, inputs);
+    image->add(OUTPUTS, outputs);
+
+    // Tier extras
+    if (const ConsciousNetwork* conscious = dynamic_cast<const ConsciousNetwork*>(&network)) {
+        image->networkType = static_cast<uint32_t>(NetworkFactory::NetworkType::CONSCIOUS);
+        std::vector<AttentionRecord> attention(1);
+        attention[0].focus = conscious->focusedNeuronId.empty() ? NO_STRING : strings.intern(conscious->focusedNeuronId);
+        attention[0].strength = conscious->attentionStrength;
+        image->add(ATTENTION, attention);
+    } else if (const SubconsciousNetwork* subconscious = dynamic_cast<const SubconsciousNetwork*>(&network)) {
+        image->networkType = static_cast<uint32_t>(NetworkFactory::NetworkType::SUBCONSCIOUS);
+        std::vector<uint64_t> patternStart(1, 0);
+        std::vector<uint32_t> patternStrings;
+        for (const auto& pattern : subconscious->patterns) {
+            for (const auto& item : pattern.first) {
+                patternStrings.push_back(strings.intern(item));
+            }
+            patternStart.push_back(patternStrings.size());
+            for (const auto& item : pattern.second) {
+                patternStrings.push_back(strings.intern(item));
+            }
+            patternStart.push_back(patternStrings.size());
+        }
+        image->add(PATTERN_START, patternStart);
+        image->add(PATTERN_STRINGS, patternStrings);
+    } else if (const UnconsciousNetwork* unconscious = dynamic_cast<const UnconsciousNetwork*>(&network)) {
+        image->networkType = static_cast<uint32_t>(NetworkFactory::NetworkType::UNCONSCIOUS);
+        std::vector<StringPair> filterRules;
+        for (const auto& rule : unconscious->filterRules) {
+            StringPair pair;
+            pair.key = strings.intern(rule.first);
+            pair.value = strings.intern(rule.second);
+            filterRules.push_back(pair);
+        }
+        image->add(FILTER_RULES, filterRules);
+    }
+
+    image->networkId = strings.intern(network.id);
+
+    if (slots) {
+        slots->resize(neuronCount);
+        for (uint32_t i = 0; i < neuronCount; ++i) {
+            (*slots)[i] = neurons[i]->index;
+        }
+    }
+    if (denseIndices) {
+        denseIndices->swap(dense);
+    }
+
+    return image;
+}
+
+bool NetworkSnapshot::write(const Image& image, const std::string& path, std::string* error) {
+    if (!hostIsLittleEndian()) {
+        return report(error, "Snapshots require a little-endian host");
+    }
+
+    // Write to a temporary file first so an existing file survives a failure
+    std::string temporary = path + ".tmp";
+    FILE* file = std::fopen(temporary.c_str(), "wb");
+    if (!file) {
+        return report(error, "Cannot create " + temporary);
+    }
+
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+
+    SectionWriter writer(file);
+    writer.raw(&header, sizeof(header));
+
+    writer.section(STRING_START, image.strings.start);
+    writer.section(STRING_DATA, image.strings.characters);
+    for (const Image::Section& section : image.sections) {
+        writer.begin(section.kind, section.elementSize);
+        writer.write(section.data, section.count);
+        writer.end();
+    }
+
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = FORMAT_VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.networkType = image.networkType;
+    header.networkId = image.networkId;
+    header.flags = image.flags;
+    header.sectionCount = static_cast<uint32_t>(writer.sections.size());
+    header.neuronCount = image.neuronCount;
+    header.edgeCount = image.edgeCount;
+    header.tableOffset = writer.position;
+
+    std::vector<SectionEntry> table = writer.sections;
+    writer.raw(table.data(), table.size() * sizeof(SectionEntry));
+    header.fileSize = writer.position;
+
+    bool written = !writer.failed && std::fseek(file, 0, SEEK_SET) == 0 &&
+                   std::fwrite(&header, sizeof(header), 1, file) == 1;
+    written = (std::fclose(file) == 0) && written;
+
+    if (!written) {
+        std::remove(temporary.c_str());
+        return report(error, "Cannot write " + temporary);
+    }
+
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        // Some platforms refuse to rename over an existing file
+        std::remove(path.c_str());
+        if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+            std::remove(temporary.c_str());
+            return report(error, "Cannot replace " + path);
+        }
+    }
+
+    return true;
+}
+
+bool NetworkSnapshot::save(const Network& network, const std::string& path, std::string* error) {
+    std::shared_ptr<Image> image;
+    {
+        std::lock_guard<std::mutex> lock(network.neuronMutex);
+        image = capture(network, nullptr, nullptr);
+    }
+
+    return write(*image, path, error);
+}
+
+std::shared_ptr<NetworkSnapshot::Image> NetworkSnapshot::captureBase(Network& network, Lineage& lineage) {
+    std::lock_guard<std::mutex> lock(network.neuronMutex);
+
+    std::shared_ptr<Image> image = capture(network, &lineage.slots, &lineage.dense);
+
+    lineage.sequence += 1;
+    lineage.baseSequence = lineage.sequence;
+    lineage.snapshotRevision = network.core->getSnapshotRevision();
+    lineage.edgeCount = image->edgeCount;
+    network.core->clearChanges();
+
+    std::vector<uint64_t> checkpoint(2, lineage.sequence);
+    image->add(CHECKPOINT, checkpoint);
+
+    return image;
+}
+
+std::shared_ptr<NetworkSnapshot::Image> NetworkSnapshot::captureChanges(Network& network, Lineage& lineage) {
+    std::lock_guard<std::mutex> lock(network.neuronMutex);
+    SimulationCore& core = *network.core;
+    const EdgeStore& edges = core.edges();
+
+    if (lineage.baseSequence == 0 || core.getSnapshotRevision() != lineage.snapshotRevision) {
+        return nullptr;  // Only a new base snapshot can capture the network now
+    }
+
+    std::vector<uint32_t> neurons;
+    std::vector<float> thresholds;
+    std::vector<float> potentials;
+    std::vector<uint8_t> states;
+    std::vector<ClockRecord> clocks;
+    std::vector<uint32_t> rows;
+    std::vector<uint64_t> rowStart(1, 0);
+    std::vector<float> weights;
+    std::vector<uint16_t> delays;
+
+    for (uint32_t i = 0; i < lineage.slots.size(); ++i) {
+        uint32_t slot = lineage.slots[i];
+
+        if (core.isChanged(slot)) {
+            neurons.push_back(i);
+            thresholds.push_back(core.threshold(slot));
+            potentials.push_back(core.potential(slot));
+            states.push_back(static_cast<uint8_t>(core.state(slot)));
+            clocks.push_back(clockRecord(core, slot));
+        }
+
+        if (edges.isRowChanged(slot)) {
+            rows.push_back(i);
+            for (uint32_t k = 0; k < edges.outDegree(slot); ++k) {
+                if (lineage.dense[edges.outTargets(slot)[k]] != SimulationCore::INVALID_INDEX) {
+                    weights.push_back(edges.outWeights(slot)[k]);
+                    delays.push_back(edges.outDelays(slot)[k]);
+                }
+            }
+            rowStart.push_back(weights.size());
+        }
+    }
+
+    core.clearChanges();
+    lineage.sequence += 1;
+
+    std::shared_ptr<Image> image = std::make_shared<Image>();
+    image->networkType = static_cast<uint32_t>(NetworkFactory::NetworkType::BASIC);
+    image->flags = FLAG_DELTA;
+    image->neuronCount = static_cast<uint32_t>(lineage.slots.size());
+    image->edgeCount = lineage.edgeCount;
+
+    std::vector<uint64_t> checkpoint;
+    checkpoint.push_back(lineage.baseSequence);
+    checkpoint.push_back(lineage.sequence);
+    image->add(CHECKPOINT, checkpoint);
+    image->add(CHANGED_NEURONS, neurons);
+    image->add(CHANGED_THRESHOLDS, thresholds);
+    image->add(CHANGED_POTENTIALS, potentials);
+    image->add(CHANGED_STATES, states);
+    image->add(CHANGED_CLOCKS, clocks);
+    std::vector<ModelRecord> model = modelRecord(core, network.processing);
+    image->add(NEURON_MODEL, model);
+    image->add(CHANGED_ROWS, rows);
+    image->add(CHANGED_ROW_START, rowStart);
+    image->add(CHANGED_WEIGHTS, weights);
+    image->add(CHANGED_DELAYS, delays);
+
+    return image;
+}
+
+std::shared_ptr<Network> NetworkSnapshot::load(const std::string& path, std::string* error) {
+    NetworkSnapshot snapshot;
+    if (!snapshot.open(path)) {
+        report(error, snapshot.getError());
+        return nullptr;
+    }
+
+    std::shared_ptr<Network> network = NetworkFactory::createNetwork(snapshot.getNetworkType(),
+                                                                     snapshot.getNetworkId());
+    if (!snapshot.restore(*network)) {
+        report(error, snapshot.getError());
+        return nullptr;
+    }
+
+    return network;
+}
+
+// ============== Reading ==============
+
+NetworkSnapshot::NetworkSnapshot()
+    : data(nullptr), size(0), mapped(false) {
+    close();
+}
+
+NetworkSnapshot::~NetworkSnapshot() {
+    close();
+}
+
+void NetworkSnapshot::close() {
+    if (data) {
+#ifdef O3_SNAPSHOT_MMAP
+        if (mapped) {
+            munmap(const_cast<uint8_t*>(data), size);
+        } else
+#endif
+        {
+            delete[] reinterpret_cast<const uint64_t*>(data);
+        }
+    }
+
+    data = nullptr;
+    size = 0;
+    mapped = false;
+    networkType = 0;
+    networkId = 0;
+    flags = 0;
+    neuronCount = 0;
+    edgeCount = 0;
+    sequence = 0;
+    baseSequence = 0;
+    stringStart = nullptr;
+    stringData = nullptr;
+    stringCount = 0;
+    neuronIds = nullptr;
+    neuronTypes = nullptr;
+    neuronStates = nullptr;
+    neuronThresholds = nullptr;
+    neuronPotentials = nullptr;
+    outRowStart = nullptr;
+    outRowTargets = nullptr;
+    outRowWeights = nullptr;
+    outRowDelays = nullptr;
+    inRowStart = nullptr;
+    inRowSources = nullptr;
+}
+
+bool NetworkSnapshot::isOpen() const {
+    return data != nullptr;
+}
+
+const std::string& NetworkSnapshot::getError() const {
+    return error;
+}
+
+bool NetworkSnapshot::fail(const std::string& message) {
+    error = message;
+    return false;
+}
+
+bool NetworkSnapshot::open(const std::string& path) {
+    close();
+    error.clear();
+
+    if (!hostIsLittleEndian()) {
+        return fail("Snapshots require a little-endian host");
+    }
+
+#ifdef O3_SNAPSHOT_MMAP
+    int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        return fail("Cannot open " + path);
+    }
+
+    struct stat status;
+    if (fstat(descriptor, &status) != 0 || status.st_size < static_cast<off_t>(sizeof(FileHeader))) {
+        ::close(descriptor);
+        return fail(path + " is not a network snapshot");
+    }
+
+    size = static_cast<size_t>(status.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    ::close(descriptor);
+
+    if (mapping == MAP_FAILED) {
+        size = 0;
+        return fail("Cannot map " + path);
+    }
+
+    data = static_cast<const uint8_t*>(mapping);
+    mapped = true;
+#else
+    std::ifstream stream(path.c_str(), std::ios::binary | std::ios::ate);
+    if (!stream) {
+        return fail("Cannot open " + path);
+    }
+
+    size = static_cast<size_t>(stream.tellg());
+    if (size < sizeof(FileHeader)) {
+        size = 0;
+        return fail(path + " is not a network snapshot");
+    }
+
+    // Keep the buffer 8-byte aligned like a mapping
+    uint64_t* buffer = new uint64_t[(size + 7) / 8];
+    stream.seekg(0);
+    stream.read(reinterpret_cast<char*>(buffer), static_cast<std::streamsize>(size));
+    data = reinterpret_cast<const uint8_t*>(buffer);
+    if (!stream) {
+        close();
+        return fail("Cannot read " + path);
+    }
+#endif
+
+    const FileHeader& header = *reinterpret_cast<const FileHeader*>(data);
+    bool valid = true;
+
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        valid = fail(path + " is not a network snapshot");
+    } else if (header.byteOrder != BYTE_ORDER_MARK) {
+        valid = fail(path + " was written with another byte order");
+    } else if (header.version == 0 || header.version > FORMAT_VERSION) {
+        valid = fail(path + " has unsupported format version " + std::to_string(header.version));
+    } else if (header.fileSize != size) {
+        valid = fail(path + " is truncated");
+    } else if (header.tableOffset % 8 != 0 || header.tableOffset > size ||
+               (size - header.tableOffset) / sizeof(SectionEntry) < header.sectionCount) {
+        valid = fail(path + " has a corrupt section table");
+    }
+
+    if (!valid) {
+        std::string message = error;
+        close();
+        return fail(message);
+    }
+
+    networkType = header.networkType;
+    networkId = header.networkId;
+    flags = header.flags;
+    neuronCount = header.neuronCount;
+    edgeCount = header.edgeCount;
+
+    size_t count = 0;
+    const uint64_t* checkpoint = static_cast<const uint64_t*>(section(CHECKPOINT, sizeof(uint64_t), count, false));
+    if (checkpoint && count == 2) {
+        baseSequence = checkpoint[0];
+        sequence = checkpoint[1];
+    }
+
+    if (flags & FLAG_DELTA) {
+        if (!checkpoint || count != 2 || !validDelta()) {
+            std::string message = error.empty() ? path + " is a corrupt checkpoint delta" : error;
+            close();
+            return fail(message);
+        }
+        return true;
+    }
+
+    // Required sections
+    size_t rows = static_cast<size_t>(neuronCount) + 1;
+
+    stringStart = static_cast<const uint64_t*>(section(STRING_START, sizeof(uint64_t), count, true));
+    stringCount = count ? count - 1 : 0;
+    valid = stringStart && count > 0;
+
+    size_t characterCount = 0;
+    stringData = static_cast<const char*>(section(STRING_DATA, 1, characterCount, true));
+    valid = valid && (stringData || characterCount == 0) &&
+            validStarts(stringStart, stringCount, characterCount);
+
+    neuronIds = static_cast<const uint32_t*>(section(NEURON_IDS, sizeof(uint32_t), count, true));
+    valid = valid && count == neuronCount;
+    neuronTypes = static_cast<const uint8_t*>(section(NEURON_TYPES, 1, count, true));
+    valid = valid && count == neuronCount;
+    neuronStates = static_cast<const uint8_t*>(section(NEURON_STATES, 1, count, true));
+    valid = valid && count == neuronCount;
+    neuronThresholds = static_cast<const float*>(section(NEURON_THRESHOLDS, sizeof(float), count, true));
+    valid = valid && count == neuronCount;
+    neuronPotentials = static_cast<const float*>(section(NEURON_POTENTIALS, sizeof(float), count, true));
+    valid = valid && count == neuronCount;
+
+    outRowStart = static_cast<const uint64_t*>(section(OUT_START, sizeof(uint64_t), count, true));
+    valid = valid && count == rows && validStarts(outRowStart, neuronCount, edgeCount);
+    outRowTargets = static_cast<const uint32_t*>(section(OUT_TARGETS, sizeof(uint32_t), count, true));
+    valid = valid && count == edgeCount;
+    outRowWeights = static_cast<const float*>(section(OUT_WEIGHTS, sizeof(float), count, true));
+    valid = valid && count == edgeCount;
+    outRowDelays = static_cast<const uint16_t*>(section(OUT_DELAYS, sizeof(uint16_t), count, true));
+    valid = valid && count == edgeCount;
+    inRowStart = static_cast<const uint64_t*>(section(IN_START, sizeof(uint64_t), count, true));
+    valid = valid && count == rows && validStarts(inRowStart, neuronCount, edgeCount);
+    inRowSources = static_cast<const uint32_t*>(section(IN_SOURCES, sizeof(uint32_t), count, true));
+    valid = valid && count == edgeCount;
+
+    if (!valid) {
+        std::string message = error.empty() ? path + " has inconsistent sections" : error;
+        close();
+        return fail(message);
+    }
+
+    // Indices must stay in range so a restored network never reads outside its arrays
+    valid = networkId < stringCount && networkType <= static_cast<uint32_t>(NetworkFactory::NetworkType::UNCONSCIOUS);
+    for (uint32_t i = 0; valid && i < neuronCount; ++i) {
+        valid = neuronIds[i] < stringCount &&
+                neuronTypes[i] <= static_cast<uint8_t>(Neuron::NeuronType::REGULATORY) &&
+                neuronStates[i] <= static_cast<uint8_t>(Neuron::NeuronState::INHIBITED);
+    }
+    for (uint64_t k = 0; valid && k < edgeCount; ++k) {
+        valid = outRowTargets[k] < neuronCount && inRowSources[k] < neuronCount;
+    }
+
+    // Optional sections
+    const uint64_t* start;
+    const uint32_t* indices;
+    size_t listCount;
+
+    start = static_cast<const uint64_t*>(section(TAG_START, sizeof(uint64_t), count, false));
+    indices = static_cast<const uint32_t*>(section(TAGS, sizeof(uint32_t), listCount, false));
+    valid = valid && (!start || (count == rows && validStarts(start, neuronCount, listCount)));
+    for (size_t k = 0; valid && k < listCount; ++k) {
+        valid = indices[k] < stringCount;
+    }
+
+    start = static_cast<const uint64_t*>(section(METADATA_START, sizeof(uint64_t), count, false));
+    const StringPair* pairs = static_cast<const StringPair*>(section(METADATA, sizeof(StringPair), listCount, false));
+    valid = valid && (!start || (count == rows && validStarts(start, neuronCount, listCount)));
+    for (size_t k = 0; valid && k < listCount; ++k) {
+        valid = pairs[k].key < stringCount && pairs[k].value < stringCount;
+    }
+
+    start = static_cast<const uint64_t*>(section(GATE_START, sizeof(uint64_t), count, false));
+    const GateRecord* gates = static_cast<const GateRecord*>(section(GATES, sizeof(GateRecord), listCount, false));
+    valid = valid && (!start || (count == rows && validStarts(start, neuronCount, listCount)));
+    for (size_t k = 0; valid && k < listCount; ++k) {
+        valid = gates[k].id < stringCount && gates[k].type <= static_cast<uint8_t>(NeuronGate::GateType::CUSTOM);
+    }
+
+    const uint32_t layerKinds[] = { INPUTS, OUTPUTS };
+    for (uint32_t kind : layerKinds) {
+        indices = static_cast<const uint32_t*>(section(kind, sizeof(uint32_t), listCount, false));
+        for (size_t k = 0; valid && k < listCount; ++k) {
+            valid = indices[k] < neuronCount;
+        }
+    }
+
+    const AttentionRecord* attention =
+        static_cast<const AttentionRecord*>(section(ATTENTION, sizeof(AttentionRecord), count, false));
+    valid = valid && (!attention || (count == 1 && (attention->focus == NO_STRING || attention->focus < stringCount)));
+
+    start = static_cast<const uint64_t*>(section(PATTERN_START, sizeof(uint64_t), count, false));
+    indices = static_cast<const uint32_t*>(section(PATTERN_STRINGS, sizeof(uint32_t), listCount, false));
+    valid = valid && (!start || (count % 2 == 1 && validStarts(start, count - 1, listCount)));
+    for (size_t k = 0; valid && k < listCount; ++k) {
+        valid = indices[k] < stringCount;
+    }
+
+    pairs = static_cast<const StringPair*>(section(FILTER_RULES, sizeof(StringPair), listCount, false));
+    for (size_t k = 0; valid && k < listCount; ++k) {
+        valid = pairs[k].key < stringCount && pairs[k].value < stringCount;
+    }
+
+    valid = valid && validModel();
+    const ClockRecord* clocks = static_cast<const ClockRecord*>(section(NEURON_CLOCKS, sizeof(ClockRecord), count, false));
+    valid = valid && (!clocks || count == neuronCount);
+
+    if (!valid || !error.empty()) {
+        std::string message = error.empty() ? path + " has out-of-range indices" : error;
+        close();
+        return fail(message);
+    }
+
+    return true;
+}
+
+const void* NetworkSnapshot::section(uint32_t kind, size_t elementSize, size_t& count, bool required) {
+    count = 0;
+    if (!data) {
+        return nullptr;
+    }
+
+    const FileHeader& header = *reinterpret_cast<const FileHeader*>(data);
+    const SectionEntry* table = reinterpret_cast<const SectionEntry*>(data + header.tableOffset);
+
+    for (uint32_t i = 0; i < header.sectionCount; ++i) {
+        const SectionEntry& entry = table[i];
+        if (entry.kind != kind) {
+            continue;
+        }
+
+        if (entry.elementSize != elementSize || entry.offset % 8 != 0 || entry.offset > size ||
+            entry.count > (size - entry.offset) / elementSize) {
+            fail("Snapshot section " + std::to_string(kind) + " is corrupt");
+            return nullptr;
+        }
+
+        count = static_cast<size_t>(entry.count);
+        return data + entry.offset;
+    }
+
+    if (required) {
+        fail("Snapshot section " + std::to_string(kind) + " is missing");
+    }
+    return nullptr;
+}
+
+bool NetworkSnapshot::validDelta() {
+    size_t changed = 0;
+    size_t count = 0;
+
+    const uint32_t* neurons = static_cast<const uint32_t*>(section(CHANGED_NEURONS, sizeof(uint32_t), changed, true));
+    bool valid = neurons || changed == 0;
+    section(CHANGED_THRESHOLDS, sizeof(float), count, true);
+    valid = valid && count == changed;
+    section(CHANGED_POTENTIALS, sizeof(float), count, true);
+    valid = valid && count == changed;
+    const uint8_t* states = static_cast<const uint8_t*>(section(CHANGED_STATES, 1, count, true));
+    valid = valid && count == changed;
+    const ClockRecord* clocks = static_cast<const ClockRecord*>(section(CHANGED_CLOCKS, sizeof(ClockRecord), count, false));
+    valid = valid && (!clocks || count == changed) && validModel();
+
+    for (size_t k = 0; valid && k < changed; ++k) {
+        valid = neurons[k] < neuronCount && (k == 0 || neurons[k - 1] < neurons[k]) &&
+                states[k] <= static_cast<uint8_t>(Neuron::NeuronState::INHIBITED);
+    }
+
+    size_t rows = 0;
+    size_t weights = 0;
+    const uint32_t* indices = static_cast<const uint32_t*>(section(CHANGED_ROWS, sizeof(uint32_t), rows, true));
+    const uint64_t* start = static_cast<const uint64_t*>(section(CHANGED_ROW_START, sizeof(uint64_t), count, true));
+    section(CHANGED_WEIGHTS, sizeof(float), weights, true);
+    valid = valid && count == rows + 1 && validStarts(start, rows, weights);
+    section(CHANGED_DELAYS, sizeof(uint16_t), count, true);
+    valid = valid && count == weights && weights <= edgeCount;
+
+    for (size_t k = 0; valid && k < rows; ++k) {
+        valid = indices[k] < neuronCount && (k == 0 || indices[k - 1] < indices[k]);
+    }
+
+    return valid && error.empty();
+}
+
+bool NetworkSnapshot::validModel() {
+    size_t count = 0;
+    const ModelRecord* model = static_cast<const ModelRecord*>(section(NEURON_MODEL, sizeof(ModelRecord), count, false));
+    return !model || (count == 1 && model->kind <= static_cast<uint32_t>(NeuronModel::Kind::LEAKY_INTEGRATE_AND_FIRE));
+}
+
+void NetworkSnapshot::restoreModel(SimulationCore& core) {
+    size_t count = 0;
+    const ModelRecord* model = static_cast<const ModelRecord*>(section(NEURON_MODEL, sizeof(ModelRecord), count, false));
+    if (!model) {
+        return;  // Written before neuron models existed
+    }
+
+    NeuronModel saved;
+    if (static_cast<NeuronModel::Kind>(model->kind) == NeuronModel::Kind::LEAKY_INTEGRATE_AND_FIRE) {
+        saved = NeuronModel::leakyIntegrateAndFire(model->membraneTimeConstant, model->refractoryTicks,
+                                                   model->resetPotential, model->tickDuration);
+    }
+
+    // Deltas carry the model of their base; leave the potentials of a restored core as they are
+    const NeuronModel& current = core.neuronModel();
+    if (saved.getKind() != current.getKind() ||
+        saved.getMembraneTimeConstant() != current.getMembraneTimeConstant() ||
+        saved.getRefractoryTicks() != current.getRefractoryTicks() ||
+        saved.getResetPotential() != current.getResetPotential() ||
+        saved.getTickDuration() != current.getTickDuration()) {
+        core.setNeuronModel(saved);
+    }
+    core.restartTick(model->tick);
+}
+
+bool NetworkSnapshot::validStarts(const uint64_t* start, size_t rows, uint64_t elements) {
+    if (!start || start[0] != 0 || start[rows] != elements) {
+        return false;
+    }
+    for (size_t i = 0; i < rows; ++i) {
+        if (start[i] > start[i + 1]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string NetworkSnapshot::string(uint32_t index) const {
+    return std::string(stringData + stringStart[index], stringData + stringStart[index + 1]);
+}
+
+NetworkFactory::NetworkType NetworkSnapshot::getNetworkType() const {
+    return static_cast<NetworkFactory::NetworkType>(networkType);
+}
+
+std::string NetworkSnapshot::getNetworkId() const {
+    return isOpen() && networkId < stringCount ? string(networkId) : std::string();
+}
+
+bool NetworkSnapshot::isDelta() const {
+    return (flags & FLAG_DELTA) != 0;
+}
+
+uint64_t NetworkSnapshot::getSequence() const {
+    return sequence;
+}
+
+uint64_t NetworkSnapshot::getBaseSequence() const {
+    return baseSequence;
+}
+
+uint32_t NetworkSnapshot::getNeuronCount() const {
+    return neuronCount;
+}
+
+size_t NetworkSnapshot::getConnectionCount() const {
+    return static_cast<size_t>(edgeCount);
+}
+
+std::string NetworkSnapshot::getNeuronId(uint32_t neuron) const {
+    return neuron < neuronCount ? string(neuronIds[neuron]) : std::string();
+}
+
+// ============== Restoring ==============
+
+bool NetworkSnapshot::restore(Network& network) {
+    if (!isOpen()) {
+        return fail("No snapshot is open");
+    }
+    if (isDelta()) {
+        return fail("A checkpoint delta can only be applied to a restored network");
+    }
+
+    std::lock_guard<std::mutex> lock(network.neuronMutex);
+    SimulationCore& core = *network.core;
+
+    // Neurons land in slots 0..n-1 only in a core that never held any
+    if (!network.neurons.empty() || core.capacity() != 0) {
+        return fail("Snapshots can only be restored into an empty network");
+    }
+
+    // Claim every ID first so a duplicate leaves the network untouched
+    network.neurons.reserve(neuronCount);
+    std::vector<std::string> ids(neuronCount);
+    std::vector<std::shared_ptr<Neuron>*> slots(neuronCount);
+    for (uint32_t i = 0; i < neuronCount; ++i) {
+        ids[i] = string(neuronIds[i]);
+        auto inserted = network.neurons.emplace(ids[i], nullptr);
+        if (!inserted.second) {
+            network.neurons.clear();
+            return fail("Snapshot contains duplicate neuron ID " + ids[i]);
+        }
+        slots[i] = &inserted.first->second;
+    }
+
+    // The model and tick come first, so potentials are stamped with the saved tick
+    restoreModel(core);
+    size_t count = 0;
+
+    // Neurons and their hot state
+    core.reserve(neuronCount);
+    std::vector<Neuron*> created(neuronCount);
+    for (uint32_t i = 0; i < neuronCount; ++i) {
+        std::shared_ptr<Neuron> neuron = std::make_shared<Neuron>(
+            ids[i], static_cast<Neuron::NeuronType>(neuronTypes[i]), network.core);
+        core.indexMember(i);
+
+        core.setThreshold(i, neuronThresholds[i]);
+        core.setPotential(i, neuronPotentials[i]);
+        core.setState(i, static_cast<Neuron::NeuronState>(neuronStates[i]));
+
+        created[i] = neuron.get();
+        *slots[i] = neuron;
+    }
+
+    // Clocks of the lazily evaluated decay and refractory periods
+    const ClockRecord* clocks = static_cast<const ClockRecord*>(section(NEURON_CLOCKS, sizeof(ClockRecord), count, false));
+    for (uint32_t i = 0; clocks && i < neuronCount; ++i) {
+        core.setClocks(i, clocks[i].updated, clocks[i].refractoryEnd);
+    }
+
+    // Connections, one block copy per array
+    core.edges().assign(neuronCount, outRowStart, outRowTargets, outRowWeights, outRowDelays,
+                        inRowStart, inRowSources);
+    if (flags & FLAG_FROZEN) {
+        core.edges().freeze();
+    }
+
+    // Tags, metadata and gates
+    size_t listCount = 0;
+
+    const uint64_t* start = static_cast<const uint64_t*>(section(TAG_START, sizeof(uint64_t), count, false));
+    const uint32_t* indices = static_cast<const uint32_t*>(section(TAGS, sizeof(uint32_t), listCount, false));
+    for (uint32_t i = 0; start && i < neuronCount; ++i) {
+        for (uint64_t k = start[i]; k < start[i + 1]; ++k) {
+            created[i]->addTag(string(indices[k]));
+        }
+    }
+
+    start = static_cast<const uint64_t*>(section(METADATA_START, sizeof(uint64_t), count, false));
+    const StringPair* pairs = static_cast<const StringPair*>(section(METADATA, sizeof(StringPair), listCount, false));
+    for (uint32_t i = 0; start && i < neuronCount; ++i) {
+        for (uint64_t k = start[i]; k < start[i + 1]; ++k) {
+            created[i]->setMetadata(string(pairs[k].key), string(pairs[k].value));
+        }
+    }
+
+    start = static_cast<const uint64_t*>(section(GATE_START, sizeof(uint64_t), count, false));
+    const GateRecord* gates = static_cast<const GateRecord*>(section(GATES, sizeof(GateRecord), listCount, false));
+    for (uint32_t i = 0; start && i < neuronCount; ++i) {
+        for (uint64_t k = start[i]; k < start[i + 1]; ++k) {
+            const GateRecord& record = gates[k];
+            std::shared_ptr<NeuronGate> gate = NeuronGateFactory::createGate(
+                static_cast<NeuronGate::GateType>(record.type), string(record.id));
+            if (!gate) {
+                continue;
+            }
+
+            gate->setThreshold(record.threshold);
+            gate->setAdaptationRate(record.adaptationRate);
+            gate->setActive(record.active != 0);
+            if (ModulatorGate* modulator = dynamic_cast<ModulatorGate*>(gate.get())) {
+                modulator->setFactor(record.factor);
+            }
+            created[i]->addGate(gate);
+        }
+    }
+
+    // Layers
+    indices = static_cast<const uint32_t*>(section(INPUTS, sizeof(uint32_t), listCount, false));
+    for (size_t k = 0; k < listCount; ++k) {
+        if (!(core.roles(indices[k]) & SimulationCore::ROLE_INPUT)) {
+            core.addRole(indices[k], SimulationCore::ROLE_INPUT);
+            network.inputNeurons.push_back(*slots[indices[k]]);
+        }
+    }
+    indices = static_cast<const uint32_t*>(section(OUTPUTS, sizeof(uint32_t), listCount, false));
+    for (size_t k = 0; k < listCount; ++k) {
+        if (!(core.roles(indices[k]) & SimulationCore::ROLE_OUTPUT)) {
+            core.addRole(indices[k], SimulationCore::ROLE_OUTPUT);
+            network.outputNeurons.push_back(*slots[indices[k]]);
+        }
+    }
+
+    // Tier extras, when the network is of the saved tier
+    if (ConsciousNetwork* conscious = dynamic_cast<ConsciousNetwork*>(&network)) {
+        const AttentionRecord* attention =
+            static_cast<const AttentionRecord*>(section(ATTENTION, sizeof(AttentionRecord), count, false));
+        if (attention) {
+            conscious->setAttentionFocus(attention->focus == NO_STRING ? std::string() : string(attention->focus));
+            conscious->attentionStrength = attention->strength;
+        }
+    } else if (SubconsciousNetwork* subconscious = dynamic_cast<SubconsciousNetwork*>(&network)) {
+        start = static_cast<const uint64_t*>(section(PATTERN_START, sizeof(uint64_t), count, false));
+        indices = static_cast<const uint32_t*>(section(PATTERN_STRINGS, sizeof(uint32_t), listCount, false));
+        for (size_t p = 0; start && p + 2 < count; p += 2) {
+            std::vector<std::string> pattern;
+            std::vector<std::string> response;
+            for (uint64_t k = start[p]; k < start[p + 1]; ++k) {
+                pattern.push_back(string(indices[k]));
+            }
+            for (uint64_t k = start[p + 1]; k < start[p + 2]; ++k) {
+                response.push_back(string(indices[k]));
+            }
+            subconscious->addPattern(pattern, response);
+        }
+    } else if (UnconsciousNetwork* unconscious = dynamic_cast<UnconsciousNetwork*>(&network)) {
+        pairs = static_cast<const StringPair*>(section(FILTER_RULES, sizeof(StringPair), listCount, false));
+        for (size_t k = 0; k < listCount; ++k) {
+            unconscious->addFilterRule(string(pairs[k].key), string(pairs[k].value));
+        }
+    }
+
+    return true;
+}
+
+bool NetworkSnapshot::applyChanges(Network& network) {
+    if (!isOpen()) {
+        return fail("No snapshot is open");
+    }
+    if (!isDelta()) {
+        return fail("The open file is not a checkpoint delta");
+    }
+
+    std::lock_guard<std::mutex> lock(network.neuronMutex);
+    SimulationCore& core = *network.core;
+    EdgeStore& edges = core.edges();
+
+    if (network.neurons.size() != neuronCount || edges.edgeCount() != edgeCount) {
+        return fail("Checkpoint delta does not match the network");
+    }
+
+    // Dense indices follow slot order, as in capture()
+    std::vector<uint32_t> slots;
+    slots.reserve(neuronCount);
+    for (const auto& entry : network.neurons) {
+        slots.push_back(entry.second->index);
+    }
+    std::sort(slots.begin(), slots.end());
+
+    size_t changed = 0;
+    size_t count = 0;
+    const uint32_t* neurons = static_cast<const uint32_t*>(section(CHANGED_NEURONS, sizeof(uint32_t), changed, true));
+    const float* thresholds = static_cast<const float*>(section(CHANGED_THRESHOLDS, sizeof(float), count, true));
+    const float* potentials = static_cast<const float*>(section(CHANGED_POTENTIALS, sizeof(float), count, true));
+    const uint8_t* states = static_cast<const uint8_t*>(section(CHANGED_STATES, 1, count, true));
+
+    size_t rows = 0;
+    const uint32_t* indices = static_cast<const uint32_t*>(section(CHANGED_ROWS, sizeof(uint32_t), rows, true));
+    const uint64_t* start = static_cast<const uint64_t*>(section(CHANGED_ROW_START, sizeof(uint64_t), count, true));
+    const float* weights = static_cast<const float*>(section(CHANGED_WEIGHTS, sizeof(float), count, true));
+    const uint16_t* delays = static_cast<const uint16_t*>(section(CHANGED_DELAYS, sizeof(uint16_t), count, true));
+
+    // Check every row before touching anything so a mismatch leaves the network as it was
+    for (size_t k = 0; k < rows; ++k) {
+        if (edges.outDegree(slots[indices[k]]) != start[k + 1] - start[k]) {
+            return fail("Checkpoint delta does not match the connections of the network");
+        }
+    }
+
+    const ClockRecord* clocks = static_cast<const ClockRecord*>(section(CHANGED_CLOCKS, sizeof(ClockRecord), count, false));
+    restoreModel(core);
+
+    for (size_t k = 0; k < changed; ++k) {
+        uint32_t slot = slots[neurons[k]];
+        core.setThreshold(slot, thresholds[k]);
+        core.setPotential(slot, potentials[k]);
+        core.setState(slot, static_cast<Neuron::NeuronState>(states[k]));
+        if (clocks) {
+            core.setClocks(slot, clocks[k].updated, clocks[k].refractoryEnd);
+        }
+    }
+
+    for (size_t k = 0; k < rows; ++k) {
+        uint32_t slot = slots[indices[k]];
+        size_t degree = static_cast<size_t>(start[k + 1] - start[k]);
+        if (degree) {
+            std::memcpy(edges.outWeights(slot), weights + start[k], degree * sizeof(float));
+            std::memcpy(edges.outDelays(slot), delays + start[k], degree * sizeof(uint16_t));
+        }
+    }
+
+    // The network now matches the checkpoint; later changes are tracked from here
+    core.clearChanges();
+    return true;
+}
@@ -12,15 +12,71 @@
 #include <random>
 #include <sstream>
 #include "../include/neuron.h"
+#include "../include/simulation_core.h"
 #include "../include/utils.h"
 
+namespace {
+
+// Payload keys used on every signal hop
+const Symbol STRENGTH_KEY = SymbolTable::global().intern("strength");
+const Symbol SOURCE_KEY = SymbolTable::global().intern("source");
+const Symbol FROM_KEY = SymbolTable::global().intern("from");
+const Symbol TO_KEY = SymbolTable::global().intern("to");
+
+// Tag added to every neuron of each type, indexed by NeuronType
+const Symbol TYPE_TAGS[] = {
+    SymbolTable::global().intern("sensory"),
+    SymbolTable::global().intern("processing"),
+    SymbolTable::global().intern("memory"),
+    SymbolTable::global().intern("integration"),
+    SymbolTable::global().intern("association"),
+    SymbolTable::global().intern("output"),
+    SymbolTable::global().intern("regulatory")
+};
+
+// Strength assumed for signals that do not carry one
+const float DEFAULT_STRENGTH = 0.5f;
+
+// Read the strength carried in a signal's payload
+float payloadStrength(const Synapse& signal) {
+    const PayloadValue* value = signal.findData(STRENGTH_KEY);
+    return value ? value->asFloat(DEFAULT_STRENGTH) : DEFAULT_STRENGTH;
+}
+
+/**
+ * @brief Per-thread buffers for running a batch of signals through gates
+ */
+struct GateScratch {
+    std::vector<uint32_t> remaining;  // Signals no gate has taken yet
+    std::vector<float> strengths;     // Gate input per remaining signal
+    std::vector<float> outputs;       // Gate output per remaining signal
+    std::vector<uint8_t> passed;      // Whether the gate took each remaining signal
+    std::vector<SynapsePtr> single;   // Input of gates without a batch kernel
+};
+
+// Marks a gated signal that is used as is
+const float UNGATED = -1.0f;
+
+GateScratch& gateScratch() {
+    static thread_local GateScratch scratch;
+    return scratch;
+}
+
+} // namespace
+
 Neuron::Neuron(const std::string& id, NeuronType type) : 
+    Neuron(id, type, std::make_shared<SimulationCore>()) {
+}
+
+Neuron::Neuron(const std::string& id, NeuronType type, std::shared_ptr<SimulationCore> core) : 
     id(id), 
     type(type),
-    state(NeuronState::RESTING),
-    threshold(0.5f),
-    potential(0.0f),
-    refractoryPeriod(false) {
+    refractoryPeriod(false),
+    core(core),
+    index(SimulationCore::INVALID_INDEX),
+    gateChainStale(true) {
+    
+    float threshold = 0.5f;
         
     // Initialize neuron parameters based on type
     switch (type) {
@@ -41,38 +97,39 @@ Neuron::Neuron(const std::string& id, NeuronType type) :
             break;
     }
     
-    // Add type tag
-    std::string typeTag;
-    switch (type) {
-        case NeuronType::SENSORY: typeTag = "sensory"; break;
-        case NeuronType::PROCESSING: typeTag = "processing"; break;
-        case NeuronType::MEMORY: typeTag = "memory"; break;
-        case NeuronType::INTEGRATION: typeTag = "integration"; break;
-        case NeuronType::ASSOCIATION: typeTag = "association"; break;
-        case NeuronType::OUTPUT: typeTag = "output"; break;
-        case NeuronType::REGULATORY: typeTag = "regulatory"; break;
-    }
+    // Claim a slot for the neuron's hot state
+    index = this->core->allocate(this, type, threshold);
     
-    addTag(typeTag);
+    // Add type tag
+    addTag(TYPE_TAGS[static_cast<size_t>(type)]);
 }
 
 std::shared_ptr<NeuronGate> Neuron::createGate(NeuronGate::GateType gateType) {
-    std::string gateId = id + "_gate_" + std::to_string(gates.size());
+    std::string gateId = getId() + "_gate_" + std::to_string(gates.size());
     auto gate = NeuronGateFactory::createGate(gateType, gateId);
     
     if (gate) {
-        gates.push_back(gate);
+        addGate(gate);
+        core->markAttributesChanged();
     }
     
     return gate;
 }
 
+void Neuron::addGate(std::shared_ptr<NeuronGate> gate) {
+    // The gate's parameters join the other gates of the core
+    gate->owner = this;
+    core->gateParameters().transfer(*gate, index);
+    gates.push_back(std::move(gate));
+    gateChainStale = true;
+}
+
 void Neuron::setState(NeuronState state) {
     // Store old state for callbacks
-    NeuronState oldState = this->state;
+    NeuronState oldState = getState();
     
     // Update state
-    this->state = state;
+    core->setState(index, state);
     
     // Call state change callbacks
     for (const auto& callback : stateChangeCallbacks) {
@@ -91,7 +148,7 @@ void Neuron::setState(NeuronState state) {
 }
 
 Neuron::NeuronState Neuron::getState() const {
-    return state;
+    return core->currentState(index);
 }
 
 const std::string& Neuron::getId() const {
@@ -102,14 +159,22 @@ Neuron::NeuronType Neuron::getType() const {
     return type;
 }
 
+uint32_t Neuron::getIndex() const {
+    return index;
+}
+
+SimulationCore* Neuron::getCore() const {
+    return core.get();
+}
+
 void Neuron::setThreshold(float threshold) {
     if (threshold < 0.0f) threshold = 0.0f;
     if (threshold > 1.0f) threshold = 1.0f;
-    this->threshold = threshold;
+    core->setThreshold(index, threshold);
 }
 
 float Neuron::getThreshold() const {
-    return threshold;
+    return core->threshold(index);
 }
 
 bool Neuron::connectTo(std::shared_ptr<Neuron> target, float weight) {
@@ -117,191 +182,84 @@ bool Neuron::connectTo(std::shared_ptr<Neuron> target, float weight) {
         return false;  // Can't connect to null or self
     }
     
-    // Check if already connected
-    if (connections.find(target) != connections.end()) {
-        // Update weight
-        connections[target] = weight;
-        return true;
+    // Both neurons must share a simulation core
+    if (!SimulationCore::unify(*this, *target)) {
+        return false;
     }
     
-    // Add new connection
-    connections[target] = weight;
-    
-    // Add this neuron as an input to the target
-    target->inputs.push_back(weak_from_this());
-    
-    return true;
+    // Add the connection, or update its weight if it already exists
+    return core->edges().connect(index, target->index, weight);
 }
 
 bool Neuron::disconnectFrom(std::shared_ptr<Neuron> target) {
-    if (!target) {
-        return false;
-    }
-    
-    // Check if connected
-    auto it = connections.find(target);
-    if (it == connections.end()) {
+    if (!target || target->core != core) {
         return false;  // Not connected
     }
     
-    // Remove connection
-    connections.erase(it);
-    
-    // Remove this neuron from target's inputs
-    auto& targetInputs = target->inputs;
-    targetInputs.erase(
-        std::remove_if(targetInputs.begin(), targetInputs.end(),
-                      [this](const std::weak_ptr<Neuron>& weakPtr) {
-                          auto ptr = weakPtr.lock();
-                          return !ptr || ptr.get() == this;
-                      }),
-        targetInputs.end()
-    );
-    
-    return true;
+    return core->edges().disconnect(index, target->index);
 }
 
-void Neuron::receiveSignal(std::shared_ptr<Synapse> signal) {
+void Neuron::receiveSignal(SynapsePtr signal) {
     if (!signal) {
         return;
     }
     
-    // Add to input signals
+    // Add to input signals; they are integrated by the next processSignals()
     inputSignals.push_back(signal);
-    
-    // Note: In a more complex implementation, we might queue signals
-    // based on timing, priority, etc.
-    
-    // Process signals immediately or queue for later processing
-    // depending on the architecture configuration
-    processSignals();
+    core->addPendingSignal(index);
 }
 
 void Neuron::processSignals() {
-    if (state == NeuronState::REFRACTORY || state == NeuronState::INHIBITED) {
-        return;  // Can't process signals in these states
-    }
-    
-    if (inputSignals.empty()) {
-        return;  // No signals to process
-    }
-    
-    // Apply gates to the input signals based on neuron type
-    std::vector<std::shared_ptr<Synapse>> processed;
-    
-    for (const auto& signal : inputSignals) {
-        // Process through appropriate gates based on neuron type and signal tags
-        bool handled = false;
-        
-        // Find a gate that can handle this signal
-        for (const auto& gate : gates) {
-            if (gate && gate->isActive()) {
-                std::vector<std::shared_ptr<Synapse>> gateInput = { signal };
-                auto result = gate->process(gateInput);
-                
-                if (result) {
-                    processed.push_back(result);
-                    handled = true;
-                    break;  // Signal handled by this gate
-                }
-            }
-        }
-        
-        // If no gate handled it, pass through as-is
-        if (!handled && signal) {
-            processed.push_back(signal);
-        }
-    }
-    
-    // Clear input signals
-    inputSignals.clear();
-    
-    // Calculate contribution to potential
-    float potentialDelta = 0.0f;
-    
-    for (const auto& signal : processed) {
-        // Get signal strength
-        float strength = 0.5f;  // Default strength
-        
-        try {
-            if (signal->hasData("strength")) {
-                strength = std::stof(signal->getData<std::string>("strength"));
-            }
-        } catch (...) {
-            // Use default
-        }
-        
-        // Accumulate potential
-        potentialDelta += strength;
-    }
-    
-    // Update potential
-    potential += potentialDelta / (processed.size() > 0 ? processed.size() : 1.0f);
-    
-    // Ensure potential is within bounds
-    if (potential < 0.0f) potential = 0.0f;
-    if (potential > 1.0f) potential = 1.0f;
-    
-    // Check if potential exceeds threshold
-    if (potential >= threshold) {
-        // Fire the neuron
-        fire();
-        
-        // Enter refractory period (for biological realism)
-        setState(NeuronState::REFRACTORY);
-        
-        // Reset potential
-        potential = 0.0f;
-        
-        // Schedule transition back to resting state
-        // (In a real implementation, this would be time-based)
-        setState(NeuronState::RESTING);
-    }
-    
-    // Store processed signals for output or memory
-    for (const auto& signal : processed) {
-        outputSignals.push_back(signal);
-    }
+    commit(integrate());
+}
+
+float Neuron::GatedSignal::getPayloadStrength() const {
+    // A gate result is a new synapse without a strength payload
+    return gateStrength < 0.0f ? payloadStrength(*signal) : DEFAULT_STRENGTH;
+}
+
+SynapsePtr Neuron::GatedSignal::derive() const {
+    return gateStrength < 0.0f ? signal->derive() : signal->derive(gateStrength);
 }
 
 void Neuron::fire() {
     if (outputSignals.empty()) {
         // Create a default output signal if none exists
-        auto signal = std::make_shared<Synapse>(id + "_output");
-        signal->setData("source", id);
-        signal->setData("strength", std::to_string(potential));
-        outputSignals.push_back(signal);
+        auto signal = Synapse::create(getId() + "_output");
+        signal->setData(SOURCE_KEY, getId());
+        signal->setData(STRENGTH_KEY, core->currentPotential(index));
+        outputSignals.push_back({ signal, UNGATED });
     }
     
-    // Send signals to connected neurons
-    for (const auto& [target, weight] : connections) {
+    // Send signals to connected neurons; they are delivered by the
+    // network after the delay of each connection, one tick sooner along
+    // forward connections of a levelized network
+    const EdgeStore& edges = core->edges();
+    const uint32_t* targets = edges.outTargets(index);
+    const float* weights = edges.outWeights(index);
+    const uint16_t* delays = edges.outDelays(index);
+    
+    for (uint32_t edge = 0; edge < edges.outDegree(index); ++edge) {
+        Neuron* target = core->handle(targets[edge]);
+        float weight = weights[edge];
+        
         if (target) {
             for (const auto& signal : outputSignals) {
                 // Create a weighted copy of the signal
-                auto weighted = signal->derive();
-                
-                // Apply weight to strength
-                float strength = 0.5f;
-                try {
-                    if (signal->hasData("strength")) {
-                        strength = std::stof(signal->getData<std::string>("strength"));
-                    }
-                } catch (...) {
-                    // Use default
-                }
+                auto weighted = signal.derive();
                 
-                // Apply connection weight
-                strength *= weight;
+                // Apply connection weight to strength
+                float strength = signal.getPayloadStrength() * weight;
                 
                 // Set new strength
-                weighted->setData("strength", std::to_string(strength));
+                weighted->setData(STRENGTH_KEY, strength);
                 
                 // Add connection metadata
-                weighted->setData("from", id);
-                weighted->setData("to", target->getId());
+                weighted->setData(FROM_KEY, getId());
+                weighted->setData(TO_KEY, target->getId());
                 
-                // Send to target
-                target->receiveSignal(weighted);
+                // Send to the target
+                core->sendSignal(index, targets[edge], weighted, delays[edge]);
             }
         }
     }
@@ -313,47 +271,103 @@ void Neuron::fire() {
 }
 
 void Neuron::addTag(const std::string& tag) {
+    addTag(SymbolTable::global().intern(tag));
+}
+
+void Neuron::addTag(Symbol tag) {
     // Check if tag already exists
     if (std::find(tags.begin(), tags.end(), tag) == tags.end()) {
         tags.push_back(tag);
+        core->indexTag(index, tag);
+        core->markAttributesChanged();
     }
 }
 
 bool Neuron::hasTag(const std::string& tag) const {
+    // A string that was never interned cannot be a tag
+    Symbol symbol = SymbolTable::global().lookup(tag);
+    return symbol != SymbolTable::INVALID_SYMBOL && hasTag(symbol);
+}
+
+bool Neuron::hasTag(Symbol tag) const {
     return std::find(tags.begin(), tags.end(), tag) != tags.end();
 }
 
 std::vector<std::string> Neuron::getTags() const {
+    const SymbolTable& symbols = SymbolTable::global();
+    
+    std::vector<std::string> result;
+    result.reserve(tags.size());
+    for (Symbol tag : tags) {
+        result.push_back(symbols.name(tag));
+    }
+    
+    return result;
+}
+
+const std::vector<Symbol>& Neuron::getTagSymbols() const {
     return tags;
 }
 
 void Neuron::setMetadata(const std::string& key, const std::string& value) {
-    metadata[key] = value;
+    setMetadata(SymbolTable::global().intern(key), value);
 }
 
-std::string Neuron::getMetadata(const std::string& key) const {
-    auto it = metadata.find(key);
-    if (it != metadata.end()) {
-        return it->second;
+void Neuron::setMetadata(Symbol key, const std::string& value) {
+    core->markAttributesChanged();
+    
+    for (auto& entry : metadata) {
+        if (entry.first == key) {
+            entry.second = value;
+            return;
+        }
     }
-    return "";
+    metadata.push_back(std::make_pair(key, value));
+    core->indexMetadataKey(index, key);
+}
+
+std::string Neuron::getMetadata(const std::string& key) const {
+    Symbol symbol = SymbolTable::global().lookup(key);
+    return symbol != SymbolTable::INVALID_SYMBOL ? getMetadata(symbol) : std::string();
+}
+
+std::string Neuron::getMetadata(Symbol key) const {
+    const std::pair<Symbol, std::string>* entry = findMetadata(key);
+    return entry ? entry->second : std::string();
 }
 
 bool Neuron::hasMetadata(const std::string& key) const {
-    return metadata.find(key) != metadata.end();
+    Symbol symbol = SymbolTable::global().lookup(key);
+    return symbol != SymbolTable::INVALID_SYMBOL && hasMetadata(symbol);
+}
+
+bool Neuron::hasMetadata(Symbol key) const {
+    return findMetadata(key) != nullptr;
+}
+
+const std::pair<Symbol, std::string>* Neuron::findMetadata(Symbol key) const {
+    // Neurons carry only a few entries, so a linear scan beats a tree
+    for (const auto& entry : metadata) {
+        if (entry.first == key) {
+            return &entry;
+        }
+    }
+    return nullptr;
 }
 
 float Neuron::getPotential() const {
-    return potential;
+    return core->currentPotential(index);
 }
 
 std::vector<std::shared_ptr<Neuron>> Neuron::getInputs() const {
     std::vector<std::shared_ptr<Neuron>> result;
     
-    for (const auto& weakInput : inputs) {
-        if (auto input = weakInput.lock()) {
-            result.push_back(input);
-        }
+    const EdgeStore& edges = core->edges();
+    const uint32_t* sources = edges.inSources(index);
+    result.reserve(edges.inDegree(index));
+    
+    for (uint32_t i = 0; i < edges.inDegree(index); ++i) {
+        result.push_back(core->handle(sources[i])->shared_from_this());
     }
     
     return result;
@@ -362,8 +376,12 @@ std::vector<std::shared_ptr<Neuron>> Neuron::getInputs() const {
 std::vector<std::shared_ptr<Neuron>> Neuron::getOutputs() const {
     std::vector<std::shared_ptr<Neuron>> result;
     
-    for (const auto& [target, _] : connections) {
-        result.push_back(target);
+    const EdgeStore& edges = core->edges();
+    const uint32_t* targets = edges.outTargets(index);
+    result.reserve(edges.outDegree(index));
+    
+    for (uint32_t i = 0; i < edges.outDegree(index); ++i) {
+        result.push_back(core->handle(targets[i])->shared_from_this());
     }
     
     return result;
@@ -382,51 +400,244 @@ void Neuron::onStateChange(std::function<void(std::shared_ptr<Neuron>, NeuronSta
 }
 
 float Neuron::getConnectionWeight(std::shared_ptr<Neuron> target) const {
-    auto it = connections.find(target);
-    if (it != connections.end()) {
-        return it->second;
+    if (!target || target->core != core) {
+        return 0.0f;
     }
-    return 0.0f;
+    return core->edges().getWeight(index, target->index);
 }
 
 bool Neuron::setConnectionWeight(std::shared_ptr<Neuron> target, float weight) {
-    auto it = connections.find(target);
-    if (it != connections.end()) {
-        it->second = weight;
-        return true;
+    if (!target || target->core != core) {
+        return false;
+    }
+    return core->edges().setWeight(index, target->index, weight);
+}
+
+uint32_t Neuron::getConnectionDelay(std::shared_ptr<Neuron> target) const {
+    if (!target || target->core != core) {
+        return 0;
+    }
+    return core->edges().getDelay(index, target->index);
+}
+
+bool Neuron::setConnectionDelay(std::shared_ptr<Neuron> target, uint32_t ticks) {
+    if (!target || target->core != core) {
+        return false;
     }
-    return false;
+    
+    // The queue never supports more than an edge can store
+    uint32_t maxDelay = std::min(core->signalQueue().getMaxDelay(), DeliveryQueue::DELAY_LIMIT);
+    return core->edges().setDelay(index, target->index, static_cast<uint16_t>(std::min(ticks, maxDelay)));
 }
 
 void Neuron::reset() {
-    potential = 0.0f;
+    core->setPotential(index, 0.0f);
     setState(NeuronState::RESTING);
     inputSignals.clear();
+    core->clearPendingSignals(index);
+    processedSignals.clear();
     outputSignals.clear();
 }
 
 bool Neuron::integrate() {
-    // Example integration function (simplified)
-    // In a real implementation, this would involve more complex
-    // calculations based on signal timing, weights, etc.
+    if (!stageInput()) {
+        return false;
+    }
     
-    if (inputSignals.empty()) {
+    uint64_t fired = 0;
+    core->integrate(index, 1, &fired);
+    return fired != 0;
+}
+
+bool Neuron::stageInput() {
+    NeuronState state = core->currentState(index);
+    if (state == NeuronState::REFRACTORY) {
+        // Input arriving during the refractory period is lost
+        inputSignals.clear();
+        core->clearPendingSignals(index);
         return false;
     }
     
-    // Create a default integration gate if none exists
+    if (state == NeuronState::INHIBITED) {
+        return false;  // Input waits until the neuron is released
+    }
+    
+    if (inputSignals.empty()) {
+        return false;  // No signals to process
+    }
+    
+    // Apply gates to the input signals
+    applyGates();
+    
+    // Clear input signals
+    inputSignals.clear();
+    core->clearPendingSignals(index);
+    
+    // Calculate contribution to potential
+    float potentialDelta = 0.0f;
+    
+    for (const auto& signal : processedSignals) {
+        // Accumulate signal strength
+        potentialDelta += signal.getPayloadStrength();
+    }
+    
+    // The mean strength is added to the potential, clamped and compared
+    // to the threshold by the core's integration kernel
+    core->stageInput(index, potentialDelta / (processedSignals.size() > 0 ? processedSignals.size() : 1.0f));
+    return true;
+}
+
+void Neuron::applyGates() {
+    size_t first = processedSignals.size();
     if (gates.empty()) {
-        auto gate = createGate(NeuronGate::GateType::THRESHOLD);
-        gate->setThreshold(threshold);
+        for (const auto& signal : inputSignals) {
+            if (signal) {
+                processedSignals.push_back({ signal, UNGATED });
+            }
+        }
+        return;
+    }
+    
+    // Each signal is taken by the first active gate that lets it through.
+    // Only tracing gates derive a synapse for it; otherwise the gate's
+    // output strength is kept next to the input.
+    bool tracing = NeuronGate::isTracing();
+    auto gated = [tracing](const NeuronGate& gate, const SynapsePtr& signal, float strength) -> GatedSignal {
+        if (tracing) {
+            return { gate.createResult(signal, strength), UNGATED };
+        }
+        return { signal, strength };
+    };
+    
+    GateScratch& scratch = gateScratch();
+    scratch.remaining.clear();
+    for (uint32_t i = 0; i < inputSignals.size(); ++i) {
+        if (inputSignals[i]) {
+            scratch.remaining.push_back(i);
+        }
+    }
+    
+    if (gateChainStale) {
+        gateChain.compile(gates);
+        gateChainStale = false;
     }
     
-    return potential >= threshold;
+    // A compiled chain routes every signal in one call
+    if (gateChain.isCompiled()) {
+        size_t count = scratch.remaining.size();
+        scratch.strengths.resize(count);
+        scratch.outputs.resize(count);
+        scratch.passed.resize(count);
+        for (size_t k = 0; k < count; ++k) {
+            scratch.strengths[k] = inputSignals[scratch.remaining[k]]->getStrength();
+        }
+        
+        gateChain.run(scratch.strengths.data(), count, scratch.outputs.data(), scratch.passed.data());
+        
+        for (size_t k = 0; k < count; ++k) {
+            const SynapsePtr& signal = inputSignals[scratch.remaining[k]];
+            uint8_t stage = scratch.passed[k];
+            processedSignals.push_back(stage ? gated(gateChain.getGate(stage - 1), signal, scratch.outputs[k])
+                                             : GatedSignal{ signal, UNGATED });
+        }
+        return;
+    }
+    
+    // Otherwise the gates go over all signals still untaken one gate at a
+    // time; results are placed at the position of their input to keep the
+    // input order
+    processedSignals.resize(first + inputSignals.size(), GatedSignal{ nullptr, UNGATED });
+    
+    for (const auto& gate : gates) {
+        if (scratch.remaining.empty()) {
+            break;
+        }
+        if (!gate || !gate->isActive()) {
+            continue;
+        }
+        
+        size_t count = scratch.remaining.size();
+        scratch.strengths.resize(count);
+        scratch.outputs.resize(count);
+        scratch.passed.resize(count);
+        for (size_t k = 0; k < count; ++k) {
+            scratch.strengths[k] = inputSignals[scratch.remaining[k]]->getStrength();
+        }
+        
+        size_t kept = 0;
+        if (gate->evaluate(scratch.strengths.data(), count, scratch.outputs.data(), scratch.passed.data())) {
+            for (size_t k = 0; k < count; ++k) {
+                uint32_t i = scratch.remaining[k];
+                if (scratch.passed[k]) {
+                    processedSignals[first + i] = gated(*gate, inputSignals[i], scratch.outputs[k]);
+                } else {
+                    scratch.remaining[kept++] = i;
+                }
+            }
+        } else {
+            // Gates without a batch kernel see one signal at a time
+            scratch.single.resize(1);
+            for (size_t k = 0; k < count; ++k) {
+                uint32_t i = scratch.remaining[k];
+                scratch.single[0] = inputSignals[i];
+                SynapsePtr result = gate->process(scratch.single);
+                if (result) {
+                    processedSignals[first + i] = { result, UNGATED };
+                } else {
+                    scratch.remaining[kept++] = i;
+                }
+            }
+            scratch.single[0].reset();
+        }
+        scratch.remaining.resize(kept);
+    }
+    
+    // Signals no gate took pass through as-is
+    for (uint32_t i : scratch.remaining) {
+        processedSignals[first + i] = { inputSignals[i], UNGATED };
+    }
+    processedSignals.erase(std::remove_if(processedSignals.begin() + first, processedSignals.end(),
+                                          [](const GatedSignal& entry) { return !entry.signal; }),
+                           processedSignals.end());
+}
+
+void Neuron::commit(bool thresholdReached) {
+    // A refractory period that ran out is ended here rather than in
+    // integrate(), so state callbacks only ever run in the serial phase
+    if (core->state(index) == NeuronState::REFRACTORY && core->isRefractoryOver(index)) {
+        setState(NeuronState::RESTING);
+    }
+    
+    if (thresholdReached) {
+        // Fire the neuron
+        fire();
+        
+        // Enter the refractory period; this resets the potential and
+        // times the period according to the network's neuron model
+        setState(NeuronState::REFRACTORY);
+        core->startRefractory(index);
+        
+        if (core->neuronModel().getRefractoryTicks() == 0) {
+            setState(NeuronState::RESTING);
+        }
+    }
+    
+    // Store processed signals for output or memory
+    for (const auto& signal : processedSignals) {
+        outputSignals.push_back(signal);
+    }
+    processedSignals.clear();
 }
 
 Neuron::~Neuron() {
-    // Clean up connections
-    connections.clear();
-    inputs.clear();
+    // Clean up gates; callers may still hold on to them
+    for (const auto& gate : gates) {
+        gate->owner = nullptr;
+        if (gate.use_count() > 1) {
+            // A surviving gate leaves the core's table for a private one
+            std::make_shared<GateTable>()->transfer(*gate);
+        }
+    }
     gates.clear();
     
     // Clear signals
@@ -436,5 +647,8 @@ Neuron::~Neuron() {
     // Clear callbacks
     fireCallbacks.clear();
     stateChangeCallbacks.clear();
+    
+    // Give the slot and its connections back to the simulation core
+    core->release(index);
 }
 
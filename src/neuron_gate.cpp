@@ -4,17 +4,60 @@
  */
 
 #include "../include/neuron_gate.h"
+#include "../include/neuron.h"
 #include "../include/utils.h"
 #include <algorithm>
+#include <atomic>
 #include <numeric>
 
+namespace {
+
+// Payload keys written on every gate result
+const Symbol GATE_ID_KEY = SymbolTable::global().intern("gate_id");
+const Symbol GATE_TYPE_KEY = SymbolTable::global().intern("gate_type");
+const Symbol MODULATION_FACTOR_KEY = SymbolTable::global().intern("modulation_factor");
+
+// Tag added to every gate result
+const std::string GATE_PROCESSED_TAG = "gate_processed";
+
+// Whether gate results record provenance
+std::atomic<bool> tracing(false);
+
+/**
+ * @brief Get the name written as gate_type
+ */
+const char* typeName(NeuronGate::GateType type) {
+    switch (type) {
+        case NeuronGate::GateType::AND: return "AND";
+        case NeuronGate::GateType::OR: return "OR";
+        case NeuronGate::GateType::NOT: return "NOT";
+        case NeuronGate::GateType::XOR: return "XOR";
+        case NeuronGate::GateType::THRESHOLD: return "THRESHOLD";
+        case NeuronGate::GateType::MODULATOR: return "MODULATOR";
+        case NeuronGate::GateType::CUSTOM:
+        default: return "CUSTOM";
+    }
+}
+
+} // namespace
+
 // ============== Base NeuronGate Implementation ==============
 
+void NeuronGate::setTracing(bool enabled) {
+    tracing.store(enabled, std::memory_order_relaxed);
+}
+
+bool NeuronGate::isTracing() {
+    return tracing.load(std::memory_order_relaxed);
+}
+
 NeuronGate::NeuronGate(const std::string& id, GateType type)
-    : id(id), type(type), threshold(0.5f), active(true), adaptationRate(0.1f) {
+    : id(id), type(type), table(std::make_shared<GateTable>()), owner(nullptr) {
+    slot = table->allocate(this, 0.5f, 0.1f, 1.0f, true, GateTable::NO_NEURON);
 }
 
 NeuronGate::~NeuronGate() {
+    table->release(slot);
 }
 
 NeuronGate::GateType NeuronGate::getType() const {
@@ -26,30 +69,77 @@ const std::string& NeuronGate::getId() const {
 }
 
 void NeuronGate::setThreshold(float threshold) {
-    this->threshold = std::min(1.0f, std::max(0.0f, threshold));
+    table->setThreshold(slot, std::min(1.0f, std::max(0.0f, threshold)));
 }
 
 float NeuronGate::getThreshold() const {
-    return threshold;
+    return table->getThreshold(slot);
+}
+
+void NeuronGate::setAdaptationRate(float rate) {
+    table->setAdaptationRate(slot, rate);
+}
+
+float NeuronGate::getAdaptationRate() const {
+    return table->getAdaptationRate(slot);
 }
 
 void NeuronGate::adapt(bool success) {
-    // Basic adaptation: adjust threshold based on success/failure
-    if (success) {
-        // If successful, slightly lower the threshold to make the gate more permissive
-        threshold = std::max(0.1f, threshold - adaptationRate);
-    } else {
-        // If failed, slightly raise the threshold to make the gate more restrictive
-        threshold = std::min(0.9f, threshold + adaptationRate);
-    }
+    // Success makes the gate more permissive, failure more restrictive
+    table->setThreshold(slot, GateTable::adaptThreshold(getThreshold(), getAdaptationRate(), success));
+}
+
+GateTable& NeuronGate::getTable() const {
+    return *table;
+}
+
+uint32_t NeuronGate::getSlot() const {
+    return slot;
 }
 
 bool NeuronGate::isActive() const {
-    return active;
+    return table->isActive(slot);
 }
 
 void NeuronGate::setActive(bool active) {
-    this->active = active;
+    table->setActive(slot, active);
+}
+
+bool NeuronGate::evaluate(const float* strengths, size_t count, float* outputs, uint8_t* passed) const {
+    if (!isActive()) {
+        std::copy(strengths, strengths + count, outputs);
+        std::fill(passed, passed + count, 0);
+        return true;
+    }
+    return evaluateBatch(strengths, count, outputs, passed);
+}
+
+bool NeuronGate::evaluateBatch(const float*, size_t, float*, uint8_t*) const {
+    return false;
+}
+
+SynapsePtr NeuronGate::processSingle(const SynapsePtr& input) const {
+    // Like process() of every gate, this ignores the active flag
+    float strength = input->getStrength();
+    float output = 0.0f;
+    uint8_t passed = 0;
+    evaluateBatch(&strength, 1, &output, &passed);
+    return passed ? createResult(input, output) : nullptr;
+}
+
+SynapsePtr NeuronGate::createResult(const SynapsePtr& input, float strength) const {
+    auto result = input->derive();
+    result->setStrength(strength);
+    if (isTracing()) {
+        annotate(*result);
+    }
+    return result;
+}
+
+void NeuronGate::annotate(Synapse& result) const {
+    result.setData(GATE_ID_KEY, id);
+    result.setData(GATE_TYPE_KEY, typeName(type));
+    result.addTag(GATE_PROCESSED_TAG);
 }
 
 // ============== AndGate Implementation ==============
@@ -58,13 +148,14 @@ AndGate::AndGate(const std::string& id)
     : NeuronGate(id, GateType::AND) {
 }
 
-std::shared_ptr<Synapse> AndGate::process(const std::vector<std::shared_ptr<Synapse>>& inputs) {
+SynapsePtr AndGate::process(const std::vector<SynapsePtr>& inputs) {
     // If no inputs, return nullptr
     if (inputs.empty()) {
         return nullptr;
     }
 
     // Check if all inputs are above threshold
+    float threshold = getThreshold();
     bool allAboveThreshold = true;
     for (const auto& input : inputs) {
         if (!input || input->getStrength() < threshold) {
@@ -75,9 +166,6 @@ std::shared_ptr<Synapse> AndGate::process(const std::vector<std::shared_ptr<Syna
 
     // If all inputs are above threshold, combine them
     if (allAboveThreshold) {
-        // Start with the first input
-        auto result = inputs[0]->derive();
-
         // Calculate average strength
         float totalStrength = 0.0f;
         for (const auto& input : inputs) {
@@ -85,35 +173,39 @@ std::shared_ptr<Synapse> AndGate::process(const std::vector<std::shared_ptr<Syna
         }
         float avgStrength = totalStrength / inputs.size();
 
-        // Set the result strength
-        result->setStrength(avgStrength);
-
-        // Add gate information
-        result->setData("gate_id", id);
-        result->setData("gate_type", "AND");
-        result->addTag("gate_processed");
-
-        return result;
+        // Start with the first input
+        return createResult(inputs[0], avgStrength);
     } else {
         // If any input is below threshold, return nullptr (gate does not activate)
         return nullptr;
     }
 }
 
+bool AndGate::evaluateBatch(const float* strengths, size_t count, float* outputs, uint8_t* passed) const {
+    // A lone input is its own average
+    float threshold = getThreshold();
+    for (size_t i = 0; i < count; ++i) {
+        outputs[i] = strengths[i];
+        passed[i] = strengths[i] >= threshold;
+    }
+    return true;
+}
+
 // ============== OrGate Implementation ==============
 
 OrGate::OrGate(const std::string& id)
     : NeuronGate(id, GateType::OR) {
 }
 
-std::shared_ptr<Synapse> OrGate::process(const std::vector<std::shared_ptr<Synapse>>& inputs) {
+SynapsePtr OrGate::process(const std::vector<SynapsePtr>& inputs) {
     // If no inputs, return nullptr
     if (inputs.empty()) {
         return nullptr;
     }
 
     // Check if any input is above threshold
-    std::shared_ptr<Synapse> strongestInput = nullptr;
+    float threshold = getThreshold();
+    SynapsePtr strongestInput = nullptr;
     float maxStrength = 0.0f;
 
     for (const auto& input : inputs) {
@@ -127,44 +219,45 @@ std::shared_ptr<Synapse> OrGate::process(const std::vector<std::shared_ptr<Synap
 
     // If at least one input is above threshold, return derived synapse from strongest
     if (strongestInput) {
-        auto result = strongestInput->derive();
-
-        // Add gate information
-        result->setData("gate_id", id);
-        result->setData("gate_type", "OR");
-        result->addTag("gate_processed");
-
-        return result;
+        return createResult(strongestInput, maxStrength);
     } else {
         // If no input is above threshold, return nullptr (gate does not activate)
         return nullptr;
     }
 }
 
+bool OrGate::evaluateBatch(const float* strengths, size_t count, float* outputs, uint8_t* passed) const {
+    // The strongest input must also be stronger than 0
+    float threshold = getThreshold();
+    for (size_t i = 0; i < count; ++i) {
+        outputs[i] = strengths[i];
+        passed[i] = strengths[i] >= threshold && strengths[i] > 0.0f;
+    }
+    return true;
+}
+
 // ============== NotGate Implementation ==============
 
 NotGate::NotGate(const std::string& id)
     : NeuronGate(id, GateType::NOT) {
 }
 
-std::shared_ptr<Synapse> NotGate::process(const std::vector<std::shared_ptr<Synapse>>& inputs) {
+SynapsePtr NotGate::process(const std::vector<SynapsePtr>& inputs) {
     // Not gate only operates on the first input
     if (inputs.empty() || !inputs[0]) {
         return nullptr;
     }
 
-    auto input = inputs[0];
-    auto result = input->derive();
-
-    // Invert the strength
-    result->setStrength(1.0f - input->getStrength());
-
-    // Add gate information
-    result->setData("gate_id", id);
-    result->setData("gate_type", "NOT");
-    result->addTag("gate_processed");
+    return processSingle(inputs[0]);
+}
 
-    return result;
+bool NotGate::evaluateBatch(const float* strengths, size_t count, float* outputs, uint8_t* passed) const {
+    // Every input passes, inverted
+    for (size_t i = 0; i < count; ++i) {
+        outputs[i] = 1.0f - strengths[i];
+        passed[i] = 1;
+    }
+    return true;
 }
 
 // ============== XorGate Implementation ==============
@@ -173,7 +266,7 @@ XorGate::XorGate(const std::string& id)
     : NeuronGate(id, GateType::XOR) {
 }
 
-std::shared_ptr<Synapse> XorGate::process(const std::vector<std::shared_ptr<Synapse>>& inputs) {
+SynapsePtr XorGate::process(const std::vector<SynapsePtr>& inputs) {
     // XOR gate requires exactly two inputs
     if (inputs.size() != 2 || !inputs[0] || !inputs[1]) {
         return nullptr;
@@ -183,29 +276,28 @@ std::shared_ptr<Synapse> XorGate::process(const std::vector<std::shared_ptr<Syna
     float strength2 = inputs[1]->getStrength();
 
     // XOR: One input must be above threshold, the other must be below
+    float threshold = getThreshold();
     bool input1Above = strength1 >= threshold;
     bool input2Above = strength2 >= threshold;
 
     if ((input1Above && !input2Above) || (!input1Above && input2Above)) {
-        // XOR condition satisfied
-        auto result = (input1Above ? inputs[0] : inputs[1])->derive();
-
-        // Set strength proportional to the difference between inputs
+        // XOR condition satisfied; the strength is proportional to the
+        // difference between inputs
         float strengthDiff = std::abs(strength1 - strength2);
-        result->setStrength(strengthDiff);
-
-        // Add gate information
-        result->setData("gate_id", id);
-        result->setData("gate_type", "XOR");
-        result->addTag("gate_processed");
-
-        return result;
+        return createResult(input1Above ? inputs[0] : inputs[1], strengthDiff);
     } else {
         // XOR condition not satisfied
         return nullptr;
     }
 }
 
+bool XorGate::evaluateBatch(const float* strengths, size_t count, float* outputs, uint8_t* passed) const {
+    // XOR needs two inputs, so a lone signal never passes
+    std::copy(strengths, strengths + count, outputs);
+    std::fill(passed, passed + count, 0);
+    return true;
+}
+
 // ============== ThresholdGate Implementation ==============
 
 ThresholdGate::ThresholdGate(const std::string& id, float threshold)
@@ -213,90 +305,84 @@ ThresholdGate::ThresholdGate(const std::string& id, float threshold)
     setThreshold(threshold);
 }
 
-std::shared_ptr<Synapse> ThresholdGate::process(const std::vector<std::shared_ptr<Synapse>>& inputs) {
+SynapsePtr ThresholdGate::process(const std::vector<SynapsePtr>& inputs) {
     // Operate on the first input only
     if (inputs.empty() || !inputs[0]) {
         return nullptr;
     }
 
-    auto input = inputs[0];
-
-    // Check if input is above threshold
-    if (input->getStrength() >= threshold) {
-        auto result = input->derive();
-
-        // Keep the same strength
-        result->setStrength(input->getStrength());
-
-        // Add gate information
-        result->setData("gate_id", id);
-        result->setData("gate_type", "THRESHOLD");
-        result->addTag("gate_processed");
+    return processSingle(inputs[0]);
+}
 
-        return result;
-    } else {
-        // Input is below threshold, gate does not activate
-        return nullptr;
+bool ThresholdGate::evaluateBatch(const float* strengths, size_t count, float* outputs, uint8_t* passed) const {
+    // Inputs at or above the threshold pass with the same strength
+    float threshold = getThreshold();
+    for (size_t i = 0; i < count; ++i) {
+        outputs[i] = strengths[i];
+        passed[i] = strengths[i] >= threshold;
     }
+    return true;
 }
 
 // ============== ModulatorGate Implementation ==============
 
 ModulatorGate::ModulatorGate(const std::string& id, float factor)
-    : NeuronGate(id, GateType::MODULATOR), factor(factor) {
+    : NeuronGate(id, GateType::MODULATOR) {
+    setFactor(factor);
 }
 
-std::shared_ptr<Synapse> ModulatorGate::process(const std::vector<std::shared_ptr<Synapse>>& inputs) {
+SynapsePtr ModulatorGate::process(const std::vector<SynapsePtr>& inputs) {
     // If no inputs, return nullptr
     if (inputs.empty() || !inputs[0]) {
         return nullptr;
     }
 
-    auto input = inputs[0];
-    auto result = input->derive();
-
-    // Modulate the strength by the factor
-    result->setStrength(std::min(1.0f, std::max(0.0f, input->getStrength() * factor)));
+    return processSingle(inputs[0]);
+}
 
-    // Add gate information
-    result->setData("gate_id", id);
-    result->setData("gate_type", "MODULATOR");
-    result->setData("modulation_factor", std::to_string(factor));
-    result->addTag("gate_processed");
+bool ModulatorGate::evaluateBatch(const float* strengths, size_t count, float* outputs, uint8_t* passed) const {
+    // Every input passes, scaled by the factor
+    float factor = getFactor();
+    for (size_t i = 0; i < count; ++i) {
+        outputs[i] = std::min(1.0f, std::max(0.0f, strengths[i] * factor));
+        passed[i] = 1;
+    }
+    return true;
+}
 
-    return result;
+void ModulatorGate::annotate(Synapse& result) const {
+    NeuronGate::annotate(result);
+    result.setData(MODULATION_FACTOR_KEY, getFactor());
 }
 
 void ModulatorGate::setFactor(float factor) {
-    this->factor = factor;
+    table->setFactor(slot, factor);
 }
 
 float ModulatorGate::getFactor() const {
-    return factor;
+    return table->getFactor(slot);
 }
 
 // ============== CustomGate Implementation ==============
 
 CustomGate::CustomGate(const std::string& id,
-                     std::function<std::shared_ptr<Synapse>(const std::vector<std::shared_ptr<Synapse>>&)> processor)
+                     std::function<SynapsePtr(const std::vector<SynapsePtr>&)> processor)
     : NeuronGate(id, GateType::CUSTOM), processor(processor) {
 }
 
-std::shared_ptr<Synapse> CustomGate::process(const std::vector<std::shared_ptr<Synapse>>& inputs) {
+SynapsePtr CustomGate::process(const std::vector<SynapsePtr>& inputs) {
     // Use the custom processor function
     auto result = processor(inputs);
 
-    if (result) {
+    if (result && isTracing()) {
         // Add gate information
-        result->setData("gate_id", id);
-        result->setData("gate_type", "CUSTOM");
-        result->addTag("gate_processed");
+        annotate(*result);
     }
 
     return result;
 }
 
-void CustomGate::setProcessor(const std::function<std::shared_ptr<Synapse>(const std::vector<std::shared_ptr<Synapse>>&)>& processor) {
+void CustomGate::setProcessor(const std::function<SynapsePtr(const std::vector<SynapsePtr>&)>& processor) {
     this->processor = processor;
 }
 
@@ -325,7 +411,7 @@ std::shared_ptr<NeuronGate> NeuronGateFactory::createGate(NeuronGate::GateType t
         case NeuronGate::GateType::CUSTOM:
             // Default custom gate just passes through the first input
             return std::make_shared<CustomGate>(id,
-                [](const std::vector<std::shared_ptr<Synapse>>& inputs) -> std::shared_ptr<Synapse> {
+                [](const std::vector<SynapsePtr>& inputs) -> SynapsePtr {
                     if (inputs.empty() || !inputs[0]) {
                         return nullptr;
                     }
@@ -339,7 +425,7 @@ std::shared_ptr<NeuronGate> NeuronGateFactory::createGate(NeuronGate::GateType t
 
 std::shared_ptr<CustomGate> NeuronGateFactory::createCustomGate(
     const std::string& id,
-    const std::function<std::shared_ptr<Synapse>(const std::vector<std::shared_ptr<Synapse>>&)> processor) {
+    const std::function<SynapsePtr(const std::vector<SynapsePtr>&)> processor) {
 
     return std::make_shared<CustomGate>(id, processor);
 }
\ No newline at end of file
@@ -0,0 +1,391 @@
+/**
+ * @file neuron_index.cpp
+ * @brief Implementation of the tag and type indexes.
+ */
+
+#include "../include/neuron_index.h"
+#include <algorithm>
+
+namespace {
+
+// Mask with a bit for every NeuronType
+const uint32_t ALL_TYPES = (1u << (static_cast<uint32_t>(Neuron::NeuronType::REGULATORY) + 1)) - 1;
+
+// Lowest set bit of a word
+inline uint32_t lowestBit(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<uint32_t>(__builtin_ctzll(word));
+#else
+    uint32_t bit = 0;
+    while (!(word & 1)) {
+        word >>= 1;
+        ++bit;
+    }
+    return bit;
+#endif
+}
+
+} // namespace
+
+// ============== NeuronQuery ==============
+
+NeuronQuery::NeuronQuery() : allowedTypes(0), excludedTypes(0) {
+}
+
+NeuronQuery& NeuronQuery::withTag(const std::string& tag) {
+    // A tag that was never interned is on no neuron; INVALID_SYMBOL keeps it that way
+    return withTag(SymbolTable::global().lookup(tag));
+}
+
+NeuronQuery& NeuronQuery::withTag(Symbol tag) {
+    requiredTags.push_back(tag);
+    return *this;
+}
+
+NeuronQuery& NeuronQuery::withoutTag(const std::string& tag) {
+    Symbol symbol = SymbolTable::global().lookup(tag);
+    return symbol == SymbolTable::INVALID_SYMBOL ? *this : withoutTag(symbol);
+}
+
+NeuronQuery& NeuronQuery::withoutTag(Symbol tag) {
+    excludedTags.push_back(tag);
+    return *this;
+}
+
+NeuronQuery& NeuronQuery::ofType(Neuron::NeuronType type) {
+    allowedTypes |= 1u << static_cast<uint32_t>(type);
+    return *this;
+}
+
+NeuronQuery& NeuronQuery::notOfType(Neuron::NeuronType type) {
+    excludedTypes |= 1u << static_cast<uint32_t>(type);
+    return *this;
+}
+
+uint32_t NeuronQuery::getTypeMask() const {
+    return (allowedTypes ? allowedTypes : ALL_TYPES) & ~excludedTypes;
+}
+
+// ============== Posting ==============
+
+NeuronIndex::Posting::Posting() : count(0), dense(false) {
+}
+
+void NeuronIndex::Posting::insert(uint32_t slot, uint32_t capacity) {
+    if (dense) {
+        size_t position = slot >> 6;
+        if (position >= bits.size()) {
+            bits.resize(position + 1, 0);
+        }
+        uint64_t mask = uint64_t(1) << (slot & 63);
+        count += (bits[position] & mask) == 0;
+        bits[position] |= mask;
+        return;
+    }
+
+    // Slots are mostly allocated in increasing order, so this is usually an append
+    std::vector<uint32_t>::iterator it = std::lower_bound(slots.begin(), slots.end(), slot);
+    if (it != slots.end() && *it == slot) {
+        return;
+    }
+    slots.insert(it, slot);
+    ++count;
+
+    // Switch to a bitset once it takes less memory than the list
+    if (count > capacity / 32) {
+        bits.assign((static_cast<size_t>(capacity) + 63) >> 6, 0);
+        for (uint32_t entry : slots) {
+            if ((entry >> 6) >= bits.size()) {
+                bits.resize((entry >> 6) + 1, 0);
+            }
+            bits[entry >> 6] |= uint64_t(1) << (entry & 63);
+        }
+        std::vector<uint32_t>().swap(slots);
+        dense = true;
+    }
+}
+
+void NeuronIndex::Posting::erase(uint32_t slot) {
+    if (dense) {
+        size_t position = slot >> 6;
+        uint64_t mask = uint64_t(1) << (slot & 63);
+        if (position < bits.size() && (bits[position] & mask)) {
+            bits[position] &= ~mask;
+            --count;
+        }
+        return;
+    }
+
+    std::vector<uint32_t>::iterator it = std::lower_bound(slots.begin(), slots.end(), slot);
+    if (it != slots.end() && *it == slot) {
+        slots.erase(it);
+        --count;
+    }
+}
+
+bool NeuronIndex::Posting::contains(uint32_t slot) const {
+    if (dense) {
+        return (word(slot >> 6) >> (slot & 63)) & 1;
+    }
+    return std::binary_search(slots.begin(), slots.end(), slot);
+}
+
+// ============== NeuronIndex ==============
+
+const size_t NeuronIndex::TYPE_COUNT;
+
+NeuronIndex::NeuronIndex() : types(TYPE_COUNT), capacity(0), tracking(false) {
+}
+
+void NeuronIndex::resize(uint32_t capacity) {
+    this->capacity = capacity;
+}
+
+void NeuronIndex::insert(uint32_t slot, Neuron::NeuronType type) {
+    types[static_cast<size_t>(type)].insert(slot, capacity);
+}
+
+void NeuronIndex::addMember(uint32_t slot, const std::vector<Symbol>& slotTags, const std::vector<Symbol>& slotKeys) {
+    if (members.contains(slot)) {
+        return;
+    }
+    members.insert(slot, capacity);
+
+    // The slot's tags and keys are indexed already; they count from now on
+    for (Symbol tag : slotTags) {
+        countMember(tag);
+    }
+    for (Symbol key : slotKeys) {
+        countMember(key);
+    }
+}
+
+void NeuronIndex::erase(uint32_t slot, Neuron::NeuronType type, const std::vector<Symbol>& slotTags) {
+    types[static_cast<size_t>(type)].erase(slot);
+
+    for (Symbol tag : slotTags) {
+        erasePosting(tags, slot, tag);
+    }
+    members.erase(slot);
+}
+
+void NeuronIndex::addTag(uint32_t slot, Symbol tag) {
+    insertPosting(tags, slot, tag);
+}
+
+void NeuronIndex::addMetadataKey(uint32_t slot, Symbol key) {
+    insertPosting(keys, slot, key);
+}
+
+void NeuronIndex::eraseMetadataKey(uint32_t slot, Symbol key) {
+    erasePosting(keys, slot, key);
+}
+
+void NeuronIndex::insertPosting(PostingMap& postings, uint32_t slot, Symbol symbol) {
+    Posting& posting = postings[symbol];
+    size_t before = posting.size();
+    posting.insert(slot, capacity);
+    if (posting.size() != before && members.contains(slot)) {
+        countMember(symbol);
+    }
+}
+
+void NeuronIndex::erasePosting(PostingMap& postings, uint32_t slot, Symbol symbol) {
+    PostingMap::iterator it = postings.find(symbol);
+    if (it == postings.end()) {
+        return;
+    }
+
+    size_t before = it->second.size();
+    it->second.erase(slot);
+    if (it->second.size() != before && members.contains(slot)) {
+        uncountMember(symbol);
+    }
+    if (it->second.size() == 0) {
+        postings.erase(it);  // Keep one-off tags and keys from accumulating
+    }
+}
+
+void NeuronIndex::countMember(Symbol symbol) {
+    uint32_t& count = memberCounts[symbol];
+    if (++count == 1 && tracking) {
+        presenceChanges.push_back(symbol);
+    }
+}
+
+void NeuronIndex::uncountMember(Symbol symbol) {
+    std::unordered_map<Symbol, uint32_t>::iterator it = memberCounts.find(symbol);
+    if (it == memberCounts.end()) {
+        return;
+    }
+
+    if (--it->second == 0) {
+        memberCounts.erase(it);
+        if (tracking) {
+            presenceChanges.push_back(symbol);
+        }
+    }
+}
+
+void NeuronIndex::clear() {
+    if (tracking) {
+        for (const auto& entry : memberCounts) {
+            presenceChanges.push_back(entry.first);
+        }
+    }
+
+    types.assign(TYPE_COUNT, Posting());
+    members = Posting();
+    tags.clear();
+    keys.clear();
+    memberCounts.clear();
+}
+
+void NeuronIndex::setPresenceTracking(bool enabled) {
+    tracking = enabled;
+    presenceChanges.clear();
+}
+
+void NeuronIndex::takePresenceChanges(std::vector<Symbol>& symbols) {
+    symbols.clear();
+    symbols.swap(presenceChanges);
+}
+
+size_t NeuronIndex::countType(Neuron::NeuronType type) const {
+    return types[static_cast<size_t>(type)].size();
+}
+
+size_t NeuronIndex::countTag(Symbol tag) const {
+    PostingMap::const_iterator it = tags.find(tag);
+    return it == tags.end() ? 0 : it->second.size();
+}
+
+size_t NeuronIndex::countMetadataKey(Symbol key) const {
+    PostingMap::const_iterator it = keys.find(key);
+    return it == keys.end() ? 0 : it->second.size();
+}
+
+void NeuronIndex::select(const NeuronQuery& query, std::vector<uint32_t>& slots) const {
+    slots.clear();
+
+    uint32_t typeMask = query.getTypeMask();
+    if (typeMask == 0) {
+        return;
+    }
+
+    // Only members match; every required tag must be known, otherwise nothing matches
+    std::vector<const Posting*> required(1, &members);
+    for (Symbol tag : query.getRequiredTags()) {
+        std::unordered_map<Symbol, Posting>::const_iterator it = tags.find(tag);
+        if (it == tags.end()) {
+            return;
+        }
+        required.push_back(&it->second);
+    }
+
+    std::vector<const Posting*> excluded;
+    for (Symbol tag : query.getExcludedTags()) {
+        std::unordered_map<Symbol, Posting>::const_iterator it = tags.find(tag);
+        if (it != tags.end()) {
+            excluded.push_back(&it->second);
+        }
+    }
+
+    std::vector<const Posting*> allowed;
+    for (size_t type = 0; type < TYPE_COUNT; ++type) {
+        if (typeMask & (1u << type)) {
+            allowed.push_back(&types[type]);
+        }
+    }
+    bool anyType = typeMask == ALL_TYPES;
+
+    // Drive the evaluation from the smallest posting
+    const Posting* driver = nullptr;
+    for (const Posting* posting : required) {
+        if (!driver || posting->size() < driver->size()) {
+            driver = posting;
+        }
+    }
+    if (allowed.size() == 1 && allowed[0]->size() < driver->size()) {
+        driver = allowed[0];
+    }
+
+    auto accepts = [&](uint32_t slot) {
+        for (const Posting* posting : required) {
+            if (posting != driver && !posting->contains(slot)) {
+                return false;
+            }
+        }
+        for (const Posting* posting : excluded) {
+            if (posting->contains(slot)) {
+                return false;
+            }
+        }
+        if (anyType || driver == allowed[0]) {
+            return true;  // Every indexed slot has some type
+        }
+        for (const Posting* posting : allowed) {
+            if (posting->contains(slot)) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    if (driver && !driver->isDense()) {
+        for (uint32_t slot : driver->list()) {
+            if (accepts(slot)) {
+                slots.push_back(slot);
+            }
+        }
+        return;
+    }
+
+    // Combine the bitsets a word at a time; allowed types still in list
+    // form are merged in through a cursor each, since every slot of them
+    // is a candidate
+    std::vector<size_t> cursors(allowed.size(), 0);
+    size_t words = (static_cast<size_t>(capacity) + 63) >> 6;
+    for (size_t position = 0; position < words; ++position) {
+        uint64_t word = 0;
+        for (size_t i = 0; i < allowed.size(); ++i) {
+            const Posting* posting = allowed[i];
+            if (posting->isDense()) {
+                word |= posting->word(position);
+                continue;
+            }
+            const std::vector<uint32_t>& list = posting->list();
+            size_t& cursor = cursors[i];
+            for (; cursor < list.size() && (list[cursor] >> 6) == position; ++cursor) {
+                word |= uint64_t(1) << (list[cursor] & 63);
+            }
+        }
+        for (const Posting* posting : required) {
+            if (posting->isDense()) {
+                word &= posting->word(position);
+            }
+        }
+        for (const Posting* posting : excluded) {
+            if (posting->isDense()) {
+                word &= ~posting->word(position);
+            }
+        }
+
+        // Postings still in list form are probed per remaining slot
+        while (word) {
+            uint32_t slot = static_cast<uint32_t>(position << 6) + lowestBit(word);
+            word &= word - 1;
+
+            bool kept = true;
+            for (const Posting* posting : required) {
+                kept = kept && (posting->isDense() || posting->contains(slot));
+            }
+            for (const Posting* posting : excluded) {
+                kept = kept && (posting->isDense() || !posting->contains(slot));
+            }
+            if (kept) {
+                slots.push_back(slot);
+            }
+        }
+    }
+}
@@ -0,0 +1,44 @@
+/**
+ * @file neuron_model.cpp
+ * @brief Implementation of the membrane dynamics models.
+ */
+
+#include "../include/neuron_model.h"
+#include <cmath>
+
+namespace {
+
+// Gaps up to this many ticks are looked up instead of computed
+const size_t DECAY_TABLE_SIZE = 64;
+
+} // namespace
+
+NeuronModel::NeuronModel()
+    : kind(Kind::ACCUMULATE), membraneTimeConstant(0.0f), refractoryTicks(0),
+      resetPotential(0.0f), tickDuration(1.0f), decayTable(1, 1.0f) {
+}
+
+NeuronModel NeuronModel::leakyIntegrateAndFire(float membraneTimeConstant, uint32_t refractoryTicks,
+                                               float resetPotential, float tickDuration) {
+    NeuronModel model;
+    model.kind = Kind::LEAKY_INTEGRATE_AND_FIRE;
+    model.membraneTimeConstant = membraneTimeConstant > 0.0f ? membraneTimeConstant : 0.0f;
+    model.refractoryTicks = refractoryTicks;
+    model.resetPotential = resetPotential < 0.0f ? 0.0f : (resetPotential > 1.0f ? 1.0f : resetPotential);
+    model.tickDuration = tickDuration > 0.0f ? tickDuration : 1.0f;
+
+    model.decayTable.resize(DECAY_TABLE_SIZE);
+    for (size_t ticks = 0; ticks < DECAY_TABLE_SIZE; ++ticks) {
+        model.decayTable[ticks] = model.computeDecay(ticks);
+    }
+
+    return model;
+}
+
+float NeuronModel::computeDecay(uint64_t ticks) const {
+    if (membraneTimeConstant <= 0.0f) {
+        return 1.0f;
+    }
+    double elapsed = static_cast<double>(ticks) * tickDuration;
+    return static_cast<float>(std::exp(-elapsed / membraneTimeConstant));
+}
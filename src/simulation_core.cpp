@@ -0,0 +1,352 @@
+/**
+ * @file simulation_core.cpp
+ * @brief Implementation of the structure-of-arrays simulation core.
+ */
+
+#include "../include/simulation_core.h"
+#include "../include/integration_kernel.h"
+#include <algorithm>
+
+const uint32_t SimulationCore::INVALID_INDEX;
+
+SimulationCore::SimulationCore()
+    : gateTable(std::make_shared<GateTable>()), pinned(false), tracking(false), structureRevision(0), attributeRevision(0) {
+}
+
+void SimulationCore::reserve(size_t count) {
+    potentials.reserve(count);
+    thresholds.reserve(count);
+    states.reserve(count);
+    types.reserve(count);
+    roleFlags.reserve(count);
+    pending.reserve(count);
+    generations.reserve(count);
+    changed.reserve(count);
+    currents.reserve(count);
+    staged.reserve(count);
+    decays.reserve(count);
+    updatedAt.reserve(count);
+    refractoryEnds.reserve(count);
+    listed.reserve(count);
+    handles.reserve(count);
+}
+
+uint32_t SimulationCore::allocate(Neuron* handle, Neuron::NeuronType type, float threshold) {
+    // Reuse a released slot if one is available
+    if (!freeSlots.empty()) {
+        uint32_t index = freeSlots.back();
+        freeSlots.pop_back();
+
+        potentials[index] = 0.0f;
+        thresholds[index] = threshold;
+        states[index] = Neuron::NeuronState::RESTING;
+        types[index] = type;
+        roleFlags[index] = 0;
+        pending[index] = 0;
+        changed[index] = 1;
+        staged[index] = 0;
+        updatedAt[index] = getTick();
+        refractoryEnds[index] = 0;
+        handles[index] = handle;
+        ++structureRevision;
+
+        indexSlot(index);
+        return index;
+    }
+
+    // Otherwise append a new slot at the end of every column
+    uint32_t index = static_cast<uint32_t>(handles.size());
+
+    potentials.push_back(0.0f);
+    thresholds.push_back(threshold);
+    states.push_back(Neuron::NeuronState::RESTING);
+    types.push_back(type);
+    roleFlags.push_back(0);
+    pending.push_back(0);
+    generations.push_back(0);
+    changed.push_back(1);
+    currents.push_back(0.0f);
+    staged.push_back(0);
+    decays.push_back(1.0f);
+    updatedAt.push_back(getTick());
+    refractoryEnds.push_back(0);
+    listed.push_back(0);
+    handles.push_back(handle);
+    ++structureRevision;
+
+    edgeStore.resize(index + 1);
+    indexes.resize(index + 1);
+
+    indexSlot(index);
+    return index;
+}
+
+void SimulationCore::release(uint32_t index) {
+    if (index >= handles.size() || !handles[index]) {
+        return;  // Already free
+    }
+
+    // A released slot must not keep any connections
+    edgeStore.removeNeuron(index);
+    for (const auto& entry : handles[index]->metadata) {
+        indexes.eraseMetadataKey(index, entry.first);
+    }
+    indexes.erase(index, types[index], handles[index]->tags);
+
+    handles[index] = nullptr;
+    roleFlags[index] = 0;
+    pending[index] = 0;
+    staged[index] = 0;
+    ++generations[index];  // Signals still in flight to this slot are stale
+    freeSlots.push_back(index);
+    ++structureRevision;
+}
+
+void SimulationCore::indexSlot(uint32_t slot) {
+    // Neurons moved in from another core bring their tags and metadata along
+    indexes.insert(slot, types[slot]);
+    for (Symbol tag : handles[slot]->tags) {
+        indexes.addTag(slot, tag);
+    }
+    for (const auto& entry : handles[slot]->metadata) {
+        indexes.addMetadataKey(slot, entry.first);
+    }
+}
+
+void SimulationCore::indexMember(uint32_t slot) {
+    std::vector<Symbol> keys;
+    for (const auto& entry : handles[slot]->metadata) {
+        keys.push_back(entry.first);
+    }
+    indexes.addMember(slot, handles[slot]->tags, keys);
+}
+
+void SimulationCore::clearChanges() {
+    std::fill(changed.begin(), changed.end(), 0);
+    edgeStore.clearChanges();
+}
+
+void SimulationCore::integrate(uint32_t begin, uint32_t count, uint64_t* fired) {
+    IntegrationKernel::integrate(potentials.data() + begin, thresholds.data() + begin, currents.data() + begin,
+                                 staged.data() + begin, decays.data() + begin, count, fired);
+    std::fill(staged.begin() + begin, staged.begin() + begin + count, 0);
+}
+
+void SimulationCore::setActivityTracking(bool enabled) {
+    tracking = enabled;
+    activeSlots.clear();
+    std::fill(listed.begin(), listed.end(), 0);
+
+    // Start from the input queued so far
+    if (enabled) {
+        for (uint32_t index = 0; index < capacity(); ++index) {
+            if (handles[index] && pending[index]) {
+                listed[index] = 1;
+                activeSlots.push_back(index);
+            }
+        }
+    }
+}
+
+void SimulationCore::takeActiveSlots(std::vector<uint32_t>& slots) {
+    slots.clear();
+    slots.swap(activeSlots);
+
+    // Released slots and slots whose input was consumed outside a tick drop out
+    size_t kept = 0;
+    for (uint32_t slot : slots) {
+        listed[slot] = 0;
+        if (handles[slot] && pending[slot]) {
+            slots[kept++] = slot;
+        }
+    }
+    slots.resize(kept);
+    std::sort(slots.begin(), slots.end());
+}
+
+void SimulationCore::relistActiveSlots(const std::vector<uint32_t>& slots) {
+    if (!tracking) {
+        return;
+    }
+    for (uint32_t slot : slots) {
+        if (slot < capacity() && handles[slot] && pending[slot] && !listed[slot]) {
+            listed[slot] = 1;
+            activeSlots.push_back(slot);
+        }
+    }
+}
+
+void SimulationCore::setNeuronModel(const NeuronModel& model) {
+    // Settle the decay accrued under the previous model
+    for (uint32_t index = 0; index < capacity(); ++index) {
+        if (handles[index]) {
+            setPotential(index, currentPotential(index));
+        }
+    }
+    this->model = model;
+}
+
+void SimulationCore::copyState(uint32_t slot, const SimulationCore& other, uint32_t otherSlot) {
+    uint64_t otherTick = other.getTick();
+    uint64_t remaining = other.refractoryEnds[otherSlot] > otherTick ? other.refractoryEnds[otherSlot] - otherTick : 0;
+
+    potentials[slot] = other.currentPotential(otherSlot);
+    states[slot] = other.states[otherSlot];
+    pending[slot] = other.pending[otherSlot];
+    if (pending[slot] && tracking && !listed[slot]) {
+        listed[slot] = 1;
+        activeSlots.push_back(slot);
+    }
+    updatedAt[slot] = getTick();
+    refractoryEnds[slot] = remaining ? getTick() + remaining : 0;
+}
+
+void SimulationCore::transfer(Neuron& neuron) {
+    SimulationCore* previous = neuron.core.get();
+    uint32_t oldIndex = neuron.index;
+    uint32_t newIndex = allocate(&neuron, previous->types[oldIndex], previous->thresholds[oldIndex]);
+
+    // Carry the hot state over to the new slot
+    copyState(newIndex, *previous, oldIndex);
+
+    previous->release(oldIndex);
+
+    // Rebind the handle; this may destroy the previous core if it was private
+    neuron.index = newIndex;
+    neuron.core = shared_from_this();
+    transferGates(neuron);
+}
+
+void SimulationCore::transferGates(Neuron& neuron) {
+    for (const auto& gate : neuron.gates) {
+        gateTable->transfer(*gate, neuron.index);
+    }
+}
+
+bool SimulationCore::adopt(Neuron& neuron) {
+    SimulationCore* previous = neuron.core.get();
+    if (previous == this) {
+        return true;  // Already stored here
+    }
+
+    if (previous->pinned) {
+        return false;  // Owned by another network
+    }
+
+    merge(*previous);
+    return true;
+}
+
+void SimulationCore::merge(SimulationCore& other) {
+    if (&other == this) {
+        return;
+    }
+
+    // The other core is usually owned only by its neurons, which are
+    // rebound below; keep it alive until the merge is complete
+    auto keepAlive = other.shared_from_this();
+
+    std::vector<uint32_t> remap(other.handles.size(), INVALID_INDEX);
+    reserve(size() + other.size());
+    edgeStore.reserve(edgeStore.edgeCount() + other.edgeStore.edgeCount());
+
+    for (uint32_t index = 0; index < other.handles.size(); ++index) {
+        Neuron* neuron = other.handles[index];
+        if (!neuron) {
+            continue;
+        }
+
+        uint32_t newIndex = allocate(neuron, other.types[index], other.thresholds[index]);
+        copyState(newIndex, other, index);
+
+        remap[index] = newIndex;
+    }
+
+    // Re-create the edges with remapped indices; adopted neurons bring
+    // their connections along even if this core's topology is frozen
+    bool frozen = edgeStore.isFrozen();
+    edgeStore.thaw();
+
+    const EdgeStore& otherEdges = other.edgeStore;
+    for (uint32_t index = 0; index < remap.size(); ++index) {
+        if (remap[index] == INVALID_INDEX) {
+            continue;
+        }
+
+        const uint32_t* targets = otherEdges.outTargets(index);
+        const float* weights = otherEdges.outWeights(index);
+        const uint16_t* delays = otherEdges.outDelays(index);
+        for (uint32_t i = 0; i < otherEdges.outDegree(index); ++i) {
+            edgeStore.connect(remap[index], remap[targets[i]], weights[i]);
+            edgeStore.setDelay(remap[index], remap[targets[i]], delays[i]);
+        }
+    }
+
+    if (frozen) {
+        edgeStore.freeze();
+    }
+
+    // Carry over the signals still in flight, keeping their remaining delay
+    other.queue.forEachPending([&](const DeliveryQueue::Event& event, uint32_t due) {
+        if (event.target < remap.size() && remap[event.target] != INVALID_INDEX &&
+            event.generation == other.generations[event.target]) {
+            scheduleSignal(remap[event.target], event.signal, due);
+        }
+    });
+    other.queue.clear();
+
+    // Rebind the handles and leave the other core empty
+    auto self = shared_from_this();
+    for (uint32_t index = 0; index < remap.size(); ++index) {
+        Neuron* neuron = other.handles[index];
+        if (!neuron) {
+            continue;
+        }
+
+        neuron->index = remap[index];
+        neuron->core = self;
+        transferGates(*neuron);
+        other.handles[index] = nullptr;
+        other.freeSlots.push_back(index);
+    }
+
+    other.edgeStore.clear();
+    other.indexes.clear();
+}
+
+bool SimulationCore::unify(Neuron& a, Neuron& b) {
+    SimulationCore* coreA = a.core.get();
+    SimulationCore* coreB = b.core.get();
+
+    if (coreA == coreB) {
+        return true;
+    }
+
+    if (coreA->pinned && coreB->pinned) {
+        return false;  // Neurons belong to different networks
+    }
+
+    // Merge into the pinned core, otherwise the smaller core into the larger
+    if (coreA->pinned || (!coreB->pinned && coreA->size() >= coreB->size())) {
+        coreA->merge(*coreB);
+    } else {
+        coreB->merge(*coreA);
+    }
+
+    return true;
+}
+
+void SimulationCore::deliverDueSignals() {
+    queue.drain([this](DeliveryQueue::Event& event) {
+        // Drop signals addressed to a slot that was released in the meantime
+        Neuron* target = handles[event.target];
+        if (target && generations[event.target] == event.generation) {
+            target->receiveSignal(std::move(event.signal));
+        }
+    });
+}
+
+void SimulationCore::detach(Neuron& neuron) {
+    auto privateCore = std::make_shared<SimulationCore>();
+    privateCore->transfer(neuron);
+}
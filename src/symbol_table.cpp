@@ -0,0 +1,64 @@
+/**
+ * @file symbol_table.cpp
+ * @brief Implementation of the string interner.
+ */
+
+#include "../include/symbol_table.h"
+#include <stdexcept>
+
+const Symbol SymbolTable::INVALID_SYMBOL;
+
+SymbolTable& SymbolTable::global() {
+    static SymbolTable instance;
+    return instance;
+}
+
+SymbolTable::SymbolTable()
+    : chunks(new std::atomic<std::string*>[MAX_CHUNKS]), count(0) {
+    for (uint32_t i = 0; i < MAX_CHUNKS; ++i) {
+        chunks[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+SymbolTable::~SymbolTable() {
+    for (uint32_t i = 0; i < MAX_CHUNKS; ++i) {
+        delete[] chunks[i].load(std::memory_order_relaxed);
+    }
+}
+
+Symbol SymbolTable::intern(const std::string& text) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    SymbolMap::const_iterator it = symbols.find(&text);
+    if (it != symbols.end()) {
+        return it->second;
+    }
+
+    size_t next = count.load(std::memory_order_relaxed);
+    if (next >= static_cast<size_t>(MAX_CHUNKS) * CHUNK_SIZE) {
+        throw std::length_error("SymbolTable is full");
+    }
+
+    Symbol symbol = static_cast<Symbol>(next);
+    uint32_t chunk = symbol >> CHUNK_BITS;
+
+    std::string* strings = chunks[chunk].load(std::memory_order_relaxed);
+    if (!strings) {
+        strings = new std::string[CHUNK_SIZE];
+        chunks[chunk].store(strings, std::memory_order_release);
+    }
+
+    std::string& stored = strings[symbol & CHUNK_MASK];
+    stored = text;
+    symbols.emplace(&stored, symbol);
+    count.store(next + 1, std::memory_order_release);
+
+    return symbol;
+}
+
+Symbol SymbolTable::lookup(const std::string& text) const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    SymbolMap::const_iterator it = symbols.find(&text);
+    return it != symbols.end() ? it->second : INVALID_SYMBOL;
+}
@@ -9,13 +9,77 @@
 #include <iomanip>
 #include <functional>
 #include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace {
+
+// Payload keys linking derived and combined synapses to their origin
+const Symbol DERIVED_FROM_KEY = SymbolTable::global().intern("derived_from");
+const Symbol COMBINED_FROM_1_KEY = SymbolTable::global().intern("combined_from_1");
+const Symbol COMBINED_FROM_2_KEY = SymbolTable::global().intern("combined_from_2");
+
+// States of the lazily formatted text ID
+const uint8_t ID_UNFORMATTED = 0;
+const uint8_t ID_FORMATTING = 1;
+const uint8_t ID_READY = 2;
+
+// Counter IDs handed to a thread at a time, so the shared counter is
+// touched once per block instead of once per synapse
+const uint64_t ID_BLOCK_SIZE = 1024;
+
+std::atomic<uint64_t> nextIdBlock(1);
+std::atomic<int> idPolicy(static_cast<int>(Synapse::IdPolicy::COUNTER));
+
+// Draw the next counter ID from the calling thread's block
+uint64_t nextCounterId() {
+    static thread_local uint64_t next = 0;
+    static thread_local uint64_t end = 0;
+    
+    if (next == end) {
+        next = nextIdBlock.fetch_add(ID_BLOCK_SIZE, std::memory_order_relaxed);
+        end = next + ID_BLOCK_SIZE;
+    }
+    
+    return next++;
+}
+
+} // namespace
 
 Synapse::Synapse(SynapseType type, float strength)
-    : id(Utils::generateUUID()), type(type), strength(std::min(1.0f, std::max(0.0f, strength))) {
+    : refCount(0), serial(0), idState(ID_READY), type(type), strength(std::min(1.0f, std::max(0.0f, strength))) {
+    if (getIdPolicy() == IdPolicy::UUID) {
+        id = Utils::generateUUID();
+    } else {
+        serial = nextCounterId();
+        idState.store(ID_UNFORMATTED, std::memory_order_relaxed);
+    }
 }
 
 Synapse::Synapse(const std::string& id, SynapseType type, float strength)
-    : id(id), type(type), strength(std::min(1.0f, std::max(0.0f, strength))) {
+    : refCount(0), serial(0), id(id), idState(ID_READY), type(type), strength(std::min(1.0f, std::max(0.0f, strength))) {
+}
+
+void* Synapse::operator new(size_t size) {
+    MemoryManager& memory = MemoryManager::getInstance();
+    return size <= memory.getSynapseBlockSize() ? memory.allocateSynapse() : ::operator new(size);
+}
+
+void Synapse::operator delete(void* ptr, size_t size) {
+    MemoryManager& memory = MemoryManager::getInstance();
+    if (size <= memory.getSynapseBlockSize()) {
+        memory.deallocateSynapse(ptr);
+    } else {
+        ::operator delete(ptr);
+    }
+}
+
+void Synapse::setIdPolicy(IdPolicy policy) {
+    idPolicy.store(static_cast<int>(policy), std::memory_order_relaxed);
+}
+
+Synapse::IdPolicy Synapse::getIdPolicy() {
+    return static_cast<IdPolicy>(idPolicy.load(std::memory_order_relaxed));
 }
 
 void Synapse::setSourceId(const std::string& sourceId) {
@@ -35,9 +99,28 @@ const std::string& Synapse::getTargetId() const {
 }
 
 const std::string& Synapse::getId() const {
+    if (idState.load(std::memory_order_acquire) == ID_READY) {
+        return id;
+    }
+    
+    // Format the counter on first use; concurrent readers wait for the winner
+    uint8_t expected = ID_UNFORMATTED;
+    if (idState.compare_exchange_strong(expected, ID_FORMATTING, std::memory_order_acquire)) {
+        id = std::to_string(static_cast<unsigned long long>(serial));
+        idState.store(ID_READY, std::memory_order_release);
+    } else {
+        while (idState.load(std::memory_order_acquire) != ID_READY) {
+            std::this_thread::yield();
+        }
+    }
+    
     return id;
 }
 
+uint64_t Synapse::getSerial() const {
+    return serial;
+}
+
 Synapse::SynapseType Synapse::getType() const {
     return type;
 }
@@ -51,15 +134,16 @@ void Synapse::setStrength(float value) {
 }
 
 bool Synapse::hasData(const std::string& key) const {
-    return stringPayload.find(key) != stringPayload.end();
+    return hasData(SymbolTable::global().lookup(key));
 }
 
 std::vector<std::string> Synapse::getKeys() const {
     std::vector<std::string> keys;
-    keys.reserve(stringPayload.size());
+    keys.reserve(payload.size());
     
-    for (const auto& pair : stringPayload) {
-        keys.push_back(pair.first);
+    const SymbolTable& symbols = SymbolTable::global();
+    for (size_t i = 0; i < payload.size(); ++i) {
+        keys.push_back(symbols.name(payload.keyAt(i)));
     }
     
     return keys;
@@ -80,10 +164,10 @@ const std::vector<std::string>& Synapse::getTags() const {
     return tags;
 }
 
-std::shared_ptr<Synapse> Synapse::derive(float derivedStrength) const {
+SynapsePtr Synapse::derive(float derivedStrength) const {
     // Create a new synapse with the same type but potentially different strength
     float newStrength = (derivedStrength >= 0.0f) ? derivedStrength : strength;
-    auto derived = std::make_shared<Synapse>(Utils::generateUUID(), type, newStrength);
+    auto derived = create(type, newStrength);
     
     // Copy source and target
     derived->setSourceId(sourceId);
@@ -95,19 +179,19 @@ std::shared_ptr<Synapse> Synapse::derive(float derivedStrength) const {
     }
     
     // Add derivation metadata
-    derived->setData("derived_from", id);
+    derived->recordOrigin(DERIVED_FROM_KEY, *this);
     
     return derived;
 }
 
-std::shared_ptr<Synapse> Synapse::combine(const std::shared_ptr<Synapse>& other) const {
+SynapsePtr Synapse::combine(const SynapsePtr& other) const {
     if (!other) {
         return derive();  // Just derive from this if other is null
     }
     
     // Create a new synapse with combined properties
     float combinedStrength = (strength + other->getStrength()) / 2.0f;  // Average strength
-    auto combined = std::make_shared<Synapse>(Utils::generateUUID(), type, combinedStrength);
+    auto combined = create(type, combinedStrength);
     
     // Set source as this synapse's source
     combined->setSourceId(sourceId);
@@ -125,8 +209,8 @@ std::shared_ptr<Synapse> Synapse::combine(const std::shared_ptr<Synapse>& other)
     }
     
     // Add combination metadata
-    combined->setData("combined_from_1", id);
-    combined->setData("combined_from_2", other->getId());
+    combined->recordOrigin(COMBINED_FROM_1_KEY, *this);
+    combined->recordOrigin(COMBINED_FROM_2_KEY, *other);
     
     // Combine selected data (implementation-specific)
     // This is a simplistic approach; a real implementation would be more sophisticated
@@ -165,7 +249,7 @@ std::string Synapse::createDigitalSignature() const {
     std::stringstream ss;
     
     // Add basic properties
-    ss << id << sourceId << targetId << static_cast<int>(type) << strength;
+    ss << getId() << sourceId << targetId << static_cast<int>(type) << strength;
     
     // Add tags
     for (const auto& tag : tags) {
@@ -173,8 +257,9 @@ std::string Synapse::createDigitalSignature() const {
     }
     
     // Add payload keys and values
-    for (const auto& pair : stringPayload) {
-        ss << pair.first << pair.second;
+    const SymbolTable& symbols = SymbolTable::global();
+    for (size_t i = 0; i < payload.size(); ++i) {
+        ss << symbols.name(payload.keyAt(i)) << payload.valueAt(i).asString();
     }
     
     // Create a simple hash of the concatenated data
@@ -182,3 +267,13 @@ std::string Synapse::createDigitalSignature() const {
     return Utils::simpleHash(ss.str());
 }
 
+
+void Synapse::recordOrigin(Symbol key, const Synapse& origin) {
+    // Counter IDs are stored as numbers, which read back as the same text
+    // getId() would produce, without formatting the origin's ID now
+    if (origin.serial != 0) {
+        setData(key, origin.serial);
+    } else {
+        setData(key, origin.getId());
+    }
+}
@@ -0,0 +1,84 @@
+/**
+ * @file synapse_payload.cpp
+ * @brief Implementation of the typed synapse payload.
+ */
+
+#include "../include/synapse_payload.h"
+#include <cerrno>
+#include <cstdlib>
+
+// ============== PayloadValue Implementation ==============
+
+double PayloadValue::asDouble(double fallback) const {
+    switch (type) {
+        case Type::INT: return static_cast<double>(number.i);
+        case Type::FLOAT: return number.f;
+        case Type::DOUBLE: return number.d;
+        case Type::BOOL: return number.b ? 1.0 : 0.0;
+        case Type::STRING: {
+            // Values set as text are parsed the way std::stod would
+            const char* begin = text.c_str();
+            char* end = nullptr;
+            errno = 0;
+            double value = std::strtod(begin, &end);
+            return (end != begin && errno != ERANGE) ? value : fallback;
+        }
+        case Type::NONE: break;
+    }
+    return fallback;
+}
+
+int64_t PayloadValue::asInt(int64_t fallback) const {
+    switch (type) {
+        case Type::INT: return number.i;
+        case Type::FLOAT: return static_cast<int64_t>(number.f);
+        case Type::DOUBLE: return static_cast<int64_t>(number.d);
+        case Type::BOOL: return number.b ? 1 : 0;
+        case Type::STRING: {
+            const char* begin = text.c_str();
+            char* end = nullptr;
+            errno = 0;
+            long long value = std::strtoll(begin, &end, 10);
+            return (end != begin && errno != ERANGE) ? static_cast<int64_t>(value) : fallback;
+        }
+        case Type::NONE: break;
+    }
+    return fallback;
+}
+
+bool PayloadValue::asBool() const {
+    switch (type) {
+        case Type::INT: return number.i != 0;
+        case Type::FLOAT: return number.f != 0.0f;
+        case Type::DOUBLE: return number.d != 0.0;
+        case Type::BOOL: return number.b;
+        case Type::STRING: return text == "true" || text == "1";
+        case Type::NONE: break;
+    }
+    return false;
+}
+
+std::string PayloadValue::asString() const {
+    switch (type) {
+        case Type::INT: return std::to_string(static_cast<long long>(number.i));
+        case Type::FLOAT: return std::to_string(number.f);
+        case Type::DOUBLE: return std::to_string(number.d);
+        case Type::BOOL: return number.b ? "1" : "0";
+        case Type::STRING: return text;
+        case Type::NONE: break;
+    }
+    return std::string();
+}
+
+// ============== SynapsePayload Implementation ==============
+
+const size_t SynapsePayload::INLINE_CAPACITY;
+
+const PayloadValue* SynapsePayload::findOverflow(Symbol key) const {
+    for (const Entry& entry : overflow) {
+        if (entry.key == key) {
+            return &entry.value;
+        }
+    }
+    return nullptr;
+}
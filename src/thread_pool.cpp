@@ -0,0 +1,302 @@
+/**
+ * @file thread_pool.cpp
+ * @brief Implementation of the work-stealing thread pool.
+ */
+
+#include "../include/thread_pool.h"
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+// Failed attempts to find work before an idle worker goes to sleep
+const int IDLE_SPINS = 64;
+
+// Longest a waiting thread blocks before looking for work again
+const std::chrono::microseconds WAIT_SLICE(200);
+
+// Pool and worker index of the calling thread, if it is a worker
+struct WorkerIdentity {
+    const ThreadPool* pool;
+    size_t index;
+};
+
+thread_local WorkerIdentity currentIdentity = { nullptr, 0 };
+
+} // namespace
+
+ThreadPool::ThreadPool(size_t numThreads, bool pinThreads)
+    : injected(0), queued(0), sleeping(0), stop(false) {
+    // Create all deques before any thread can try to steal from them
+    for (size_t i = 0; i < numThreads; ++i) {
+        workers.emplace_back(new Worker());
+    }
+
+    for (size_t i = 0; i < numThreads; ++i) {
+        workers[i]->thread = std::thread(&ThreadPool::workerLoop, this, i);
+
+#ifdef __linux__
+        if (pinThreads) {
+            unsigned cpus = std::max(1u, std::thread::hardware_concurrency());
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(i % cpus, &set);
+            pthread_setaffinity_np(workers[i]->thread.native_handle(), sizeof(set), &set);
+        }
+#else
+        (void)pinThreads;
+#endif
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stop = true;
+    }
+
+    wake.notify_all();
+
+    for (auto& worker : workers) {
+        worker->thread.join();
+    }
+
+    // Without workers, run whatever is left on this thread
+    while (Task* task = take(workers.size())) {
+        run(task);
+    }
+}
+
+void ThreadPool::enqueue(std::function<void()> task) {
+    if (stop) {
+        throw std::runtime_error("ThreadPool is stopped");
+    }
+
+    submit(defaultGroup, std::move(task));
+}
+
+void ThreadPool::submit(TaskGroup& group, std::function<void()> task) {
+    group.pending.fetch_add(1, std::memory_order_relaxed);
+    queued.fetch_add(1);
+
+    push(new Task{ std::move(task), &group });
+}
+
+void ThreadPool::submitBatch(TaskGroup& group, std::vector<std::function<void()>>& tasks) {
+    if (tasks.empty()) {
+        return;
+    }
+
+    group.pending.fetch_add(tasks.size(), std::memory_order_relaxed);
+    queued.fetch_add(tasks.size());
+
+    size_t self = currentWorker();
+    if (self < workers.size()) {
+        for (auto& task : tasks) {
+            workers[self]->deque.push(new Task{ std::move(task), &group });
+        }
+    } else {
+        // One lock for the whole batch
+        std::lock_guard<std::mutex> lock(injectionMutex);
+        for (auto& task : tasks) {
+            injection.push_back(new Task{ std::move(task), &group });
+        }
+        injected.fetch_add(tasks.size(), std::memory_order_relaxed);
+    }
+
+    size_t count = tasks.size();
+    tasks.clear();
+    notify(count);
+}
+
+void ThreadPool::wait(TaskGroup& group) {
+    size_t self = currentWorker();
+
+    while (!group.done()) {
+        // Help out instead of blocking
+        Task* task = take(self);
+        if (task) {
+            run(task);
+            continue;
+        }
+
+        // Nothing to run: the remaining tasks are executing elsewhere
+        std::unique_lock<std::mutex> lock(group.mutex);
+        group.finished.wait_for(lock, WAIT_SLICE, [&group] { return group.done(); });
+    }
+
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(group.mutex);
+        std::swap(error, group.error);
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void ThreadPool::parallelFor(size_t begin, size_t end, size_t grain,
+                             const std::function<void(size_t, size_t)>& body) {
+    if (begin >= end) {
+        return;
+    }
+
+    grain = std::max<size_t>(1, grain);
+
+    // Not worth splitting
+    if (workers.empty() || end - begin <= grain) {
+        body(begin, end);
+        return;
+    }
+
+    TaskGroup group;
+    std::vector<std::function<void()>> chunks;
+    chunks.reserve((end - begin + grain - 1) / grain);
+
+    for (size_t first = begin; first < end; first += grain) {
+        size_t last = std::min(end, first + grain);
+        chunks.push_back([&body, first, last] { body(first, last); });
+    }
+
+    submitBatch(group, chunks);
+    wait(group);
+}
+
+void ThreadPool::waitForCompletion() {
+    wait(defaultGroup);
+}
+
+size_t ThreadPool::currentWorker() const {
+    return currentIdentity.pool == this ? currentIdentity.index : workers.size();
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    currentIdentity.pool = this;
+    currentIdentity.index = index;
+
+    int idle = 0;
+    while (true) {
+        Task* task = take(index);
+        if (task) {
+            run(task);
+            idle = 0;
+            continue;
+        }
+
+        if (++idle < IDLE_SPINS) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // Sleep until work is queued; queued is re-checked under the lock so
+        // a submission between the last attempt and the wait is not missed
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        if (stop && queued.load() == 0) {
+            return;
+        }
+
+        sleeping.fetch_add(1);
+        wake.wait(lock, [this] { return stop || queued.load() > 0; });
+        sleeping.fetch_sub(1);
+        idle = 0;
+    }
+}
+
+void ThreadPool::push(Task* task) {
+    size_t self = currentWorker();
+    if (self < workers.size()) {
+        workers[self]->deque.push(task);
+    } else {
+        std::lock_guard<std::mutex> lock(injectionMutex);
+        injection.push_back(task);
+        injected.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    notify(1);
+}
+
+void ThreadPool::notify(size_t count) {
+    if (sleeping.load() == 0) {
+        return;  // Everyone is awake and will find the work
+    }
+
+    std::lock_guard<std::mutex> lock(sleepMutex);
+    if (count > 1) {
+        wake.notify_all();
+    } else {
+        wake.notify_one();
+    }
+}
+
+ThreadPool::Task* ThreadPool::take(size_t self) {
+    if (queued.load(std::memory_order_relaxed) == 0) {
+        return nullptr;
+    }
+
+    Task* task = nullptr;
+
+    // Own deque first, newest task for cache locality
+    if (self < workers.size()) {
+        task = workers[self]->deque.pop();
+    }
+
+    // Then work submitted from outside the pool
+    if (!task && injected.load(std::memory_order_relaxed) > 0) {
+        std::lock_guard<std::mutex> lock(injectionMutex);
+        if (!injection.empty()) {
+            task = injection.front();
+            injection.pop_front();
+            injected.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Then steal the oldest task of another worker
+    for (size_t i = 1; !task && i <= workers.size(); ++i) {
+        size_t victim = (self + i) % workers.size();
+        if (victim != self) {
+            task = workers[victim]->deque.steal();
+        }
+    }
+
+    if (task) {
+        queued.fetch_sub(1);
+    }
+
+    return task;
+}
+
+void ThreadPool::run(Task* task) {
+    TaskGroup* group = task->group;
+
+    try {
+        task->function();
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(group->mutex);
+        if (!group->error) {
+            group->error = std::current_exception();
+        }
+    }
+
+    delete task;
+
+    // Most completions just count down
+    size_t pending = group->pending.load(std::memory_order_relaxed);
+    while (pending > 1) {
+        if (group->pending.compare_exchange_weak(pending, pending - 1, std::memory_order_acq_rel)) {
+            return;
+        }
+    }
+
+    // The last one counts down under the lock: a waiter cannot miss the
+    // notification, and it cannot destroy the group before we let go
+    std::lock_guard<std::mutex> lock(group->mutex);
+    group->pending.fetch_sub(1, std::memory_order_acq_rel);
+    group->finished.notify_all();
+}
@@ -4,6 +4,7 @@
  */
 
 #include "../include/utils.h"
+#include "../include/synapse.h"
 #include <random>
 #include <sstream>
 #include <iomanip>
@@ -12,6 +13,8 @@
 #include <iostream>
 #include <chrono>
 #include <ctime>
+#include <cstdio>
+#include <cstddef>
 
 // ============== Utility Functions ==============
 
@@ -37,8 +40,8 @@ std::string Utils::generateUniqueId(const std::string& prefix) {
 }
 
 std::string Utils::generateUUID() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    // Seed one generator per thread instead of opening the random device per call
+    static thread_local std::mt19937 gen(std::random_device{}());
     std::uniform_int_distribution<uint32_t> dist(0, UINT32_MAX);
     
     uint32_t a = dist(gen);
@@ -47,16 +50,11 @@ std::string Utils::generateUUID() {
     uint32_t d = dist(gen);
     
     // Format as standard UUID (8-4-4-4-12 hexadecimal digits)
-    std::stringstream ss;
-    ss << std::hex << std::setfill('0');
-    ss << std::setw(8) << (a) << "-";
-    ss << std::setw(4) << ((b >> 16) & 0xFFFF) << "-";
-    ss << std::setw(4) << (b & 0xFFFF) << "-";
-    ss << std::setw(4) << ((c >> 16) & 0xFFFF) << "-";
-    ss << std::setw(4) << (c & 0xFFFF);
-    ss << std::setw(8) << d;
+    char buffer[40];
+    std::snprintf(buffer, sizeof(buffer), "%08x-%04x-%04x-%04x-%04x%08x",
+                  a, (b >> 16) & 0xFFFF, b & 0xFFFF, (c >> 16) & 0xFFFF, c & 0xFFFF, d);
     
-    return ss.str();
+    return std::string(buffer);
 }
 
 float Utils::sigmoid(float x) {
@@ -138,131 +136,248 @@ std::string Utils::simpleHash(const std::string& str) {
     return ss.str();
 }
 
-// ============== ThreadPool Implementation ==============
-
-ThreadPool::ThreadPool(size_t numThreads) : stop(false), pendingTasks(0) {
-    for (size_t i = 0; i < numThreads; ++i) {
-        workers.emplace_back([this] {
-            while (true) {
-                std::function<void()> task;
-                
-                {
-                    std::unique_lock<std::mutex> lock(this->queueMutex);
-                    this->condition.wait(lock, [this] {
-                        return this->stop || !this->tasks.empty();
-                    });
-                    
-                    if (this->stop && this->tasks.empty()) {
-                        return;
-                    }
-                    
-                    task = std::move(this->tasks.front());
-                    this->tasks.pop();
-                }
-                
-                // Execute the task
-                task();
-                
-                // Decrement pending tasks counter
-                {
-                    std::lock_guard<std::mutex> lock(this->counterMutex);
-                    --this->pendingTasks;
-                }
-                
-                // Notify waitForCompletion
-                this->counterCondition.notify_all();
-            }
-        });
-    }
-}
+// ============== MemoryManager Implementation ==============
 
-ThreadPool::~ThreadPool() {
-    {
-        std::unique_lock<std::mutex> lock(queueMutex);
-        stop = true;
-    }
-    
-    condition.notify_all();
-    
-    for (std::thread& worker : workers) {
-        worker.join();
-    }
+namespace {
+
+// Block size for one synapse, rounded so that every block stays aligned
+const size_t SYNAPSE_BLOCK_SIZE =
+    (sizeof(Synapse) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+const size_t SLAB_BLOCKS = 256;   // Blocks obtained from the system at once
+const size_t CACHE_BATCH = 64;    // Blocks moved between a thread cache and the shared list
+const size_t CACHE_LIMIT = 256;   // Free blocks a thread cache may hold before draining
+
+// Set once the calling thread's cache has been destroyed at thread exit
+thread_local bool cacheDestroyed = false;
+
+inline void* nextBlock(void* block) {
+    return *static_cast<void**>(block);
 }
 
-void ThreadPool::enqueue(std::function<void()> task) {
-    {
-        std::unique_lock<std::mutex> lock(queueMutex);
-        if (stop) {
-            throw std::runtime_error("ThreadPool is stopped");
-        }
-        
-        tasks.emplace(std::move(task));
-        
-        // Increment pending tasks counter
-        {
-            std::lock_guard<std::mutex> counterLock(counterMutex);
-            ++pendingTasks;
-        }
-    }
-    
-    condition.notify_one();
+inline void linkBlock(void* block, void* next) {
+    *static_cast<void**>(block) = next;
 }
 
-void ThreadPool::waitForCompletion() {
-    std::unique_lock<std::mutex> lock(counterMutex);
-    counterCondition.wait(lock, [this] {
-        return pendingTasks == 0;
-    });
+// Counters are written by a single thread, so no read-modify-write is needed
+inline void bump(std::atomic<uint64_t>& counter) {
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
 }
 
-// ============== MemoryManager Implementation ==============
+} // namespace
+
+/**
+ * @brief Free blocks and statistics owned by one thread
+ */
+struct MemoryManager::ThreadCache {
+    void* head;                           // Free blocks, linked through their first word
+    size_t count;                         // Blocks on the list
+    std::atomic<uint64_t> allocations;    // Blocks handed out by this thread
+    std::atomic<uint64_t> deallocations;  // Blocks returned by this thread
+
+    ThreadCache() : head(nullptr), count(0), allocations(0), deallocations(0) {
+        MemoryManager::getInstance().registerCache(this);
+    }
+
+    ~ThreadCache() {
+        cacheDestroyed = true;
+        MemoryManager::getInstance().retireCache(this);
+    }
+};
 
 MemoryManager& MemoryManager::getInstance() {
     static MemoryManager instance;
     return instance;
 }
 
-MemoryManager::MemoryManager() : activeSynapses(0), totalSynapses(0) {
+MemoryManager::MemoryManager()
+    : freeList(nullptr), freeCount(0),
+      retiredAllocations(0), retiredDeallocations(0), totalBaseline(0) {
 }
 
-void* MemoryManager::allocateSynapse() {
+MemoryManager::~MemoryManager() {
     std::lock_guard<std::mutex> lock(mutex);
     
-    // In a more sophisticated implementation, this would use
-    // a memory pool or slab allocator for efficiency
-    void* ptr = ::operator new(sizeof(void*) * 16);  // Approximate Synapse size
+    // Slabs are only released when no block can still be reached
+    if (!caches.empty() || retiredAllocations != retiredDeallocations) {
+        return;
+    }
+    
+    for (void* slab : slabs) {
+        ::operator delete(slab);
+    }
+    slabs.clear();
+    freeList = nullptr;
+    freeCount = 0;
+}
+
+MemoryManager::ThreadCache* MemoryManager::localCache() {
+    if (cacheDestroyed) {
+        return nullptr;
+    }
+    static thread_local ThreadCache cache;
+    return &cache;
+}
+
+void* MemoryManager::allocateSynapse() {
+    ThreadCache* cache = localCache();
+    
+    if (!cache) {
+        // The thread is exiting: take a block straight from the shared list
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!freeList) {
+            addSlab();
+        }
+        void* block = freeList;
+        freeList = nextBlock(block);
+        --freeCount;
+        ++retiredAllocations;
+        return block;
+    }
+    
+    if (!cache->head) {
+        refill(*cache);
+    }
     
-    ++activeSynapses;
-    ++totalSynapses;
+    void* block = cache->head;
+    cache->head = nextBlock(block);
+    --cache->count;
+    bump(cache->allocations);
     
-    return ptr;
+    return block;
 }
 
 void MemoryManager::deallocateSynapse(void* ptr) {
     if (!ptr) return;
     
-    std::lock_guard<std::mutex> lock(mutex);
+    ThreadCache* cache = localCache();
+    
+    if (!cache) {
+        std::lock_guard<std::mutex> lock(mutex);
+        linkBlock(ptr, freeList);
+        freeList = ptr;
+        ++freeCount;
+        ++retiredDeallocations;
+        return;
+    }
     
-    ::operator delete(ptr);
+    linkBlock(ptr, cache->head);
+    cache->head = ptr;
+    ++cache->count;
+    bump(cache->deallocations);
     
-    if (activeSynapses > 0) {
-        --activeSynapses;
+    if (cache->count > CACHE_LIMIT) {
+        drain(*cache, CACHE_LIMIT / 2);
     }
 }
 
+size_t MemoryManager::getSynapseBlockSize() const {
+    return SYNAPSE_BLOCK_SIZE;
+}
+
 size_t MemoryManager::getActiveSynapseCount() const {
     std::lock_guard<std::mutex> lock(mutex);
-    return activeSynapses;
+    
+    uint64_t allocations = 0;
+    uint64_t deallocations = 0;
+    collectStats(allocations, deallocations);
+    
+    // A block freed on another thread may be counted before its allocation
+    return allocations > deallocations ? static_cast<size_t>(allocations - deallocations) : 0;
 }
 
 size_t MemoryManager::getTotalSynapseCount() const {
     std::lock_guard<std::mutex> lock(mutex);
-    return totalSynapses;
+    
+    uint64_t allocations = 0;
+    uint64_t deallocations = 0;
+    collectStats(allocations, deallocations);
+    
+    return static_cast<size_t>(allocations - totalBaseline);
+}
+
+size_t MemoryManager::getReservedSynapseCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return slabs.size() * SLAB_BLOCKS;
 }
 
 void MemoryManager::resetStats() {
     std::lock_guard<std::mutex> lock(mutex);
-    activeSynapses = 0;
-    totalSynapses = 0;
+    
+    uint64_t allocations = 0;
+    uint64_t deallocations = 0;
+    collectStats(allocations, deallocations);
+    
+    totalBaseline = allocations;
 }
 
+void MemoryManager::refill(ThreadCache& cache) {
+    std::lock_guard<std::mutex> lock(mutex);
+    
+    // Reserve more memory only once every shared block is in use
+    if (freeCount == 0) {
+        addSlab();
+    }
+    
+    size_t batch = std::min(freeCount, CACHE_BATCH);
+    for (size_t i = 0; i < batch; ++i) {
+        void* block = freeList;
+        freeList = nextBlock(block);
+        linkBlock(block, cache.head);
+        cache.head = block;
+    }
+    
+    freeCount -= batch;
+    cache.count += batch;
+}
+
+void MemoryManager::drain(ThreadCache& cache, size_t keep) {
+    std::lock_guard<std::mutex> lock(mutex);
+    
+    while (cache.count > keep) {
+        void* block = cache.head;
+        cache.head = nextBlock(block);
+        linkBlock(block, freeList);
+        freeList = block;
+        --cache.count;
+        ++freeCount;
+    }
+}
+
+void MemoryManager::addSlab() {
+    slabs.reserve(slabs.size() + 1);
+    char* slab = static_cast<char*>(::operator new(SLAB_BLOCKS * SYNAPSE_BLOCK_SIZE));
+    slabs.push_back(slab);
+    
+    // Link in reverse so blocks are handed out in address order
+    for (size_t i = SLAB_BLOCKS; i-- > 0;) {
+        void* block = slab + i * SYNAPSE_BLOCK_SIZE;
+        linkBlock(block, freeList);
+        freeList = block;
+    }
+    freeCount += SLAB_BLOCKS;
+}
+
+void MemoryManager::registerCache(ThreadCache* cache) {
+    std::lock_guard<std::mutex> lock(mutex);
+    caches.push_back(cache);
+}
+
+void MemoryManager::retireCache(ThreadCache* cache) {
+    drain(*cache, 0);
+    
+    std::lock_guard<std::mutex> lock(mutex);
+    retiredAllocations += cache->allocations.load(std::memory_order_relaxed);
+    retiredDeallocations += cache->deallocations.load(std::memory_order_relaxed);
+    caches.erase(std::remove(caches.begin(), caches.end(), cache), caches.end());
+}
+
+void MemoryManager::collectStats(uint64_t& allocations, uint64_t& deallocations) const {
+    allocations = retiredAllocations;
+    deallocations = retiredDeallocations;
+    
+    for (const ThreadCache* cache : caches) {
+        allocations += cache->allocations.load(std::memory_order_relaxed);
+        deallocations += cache->deallocations.load(std::memory_order_relaxed);
+    }
+}
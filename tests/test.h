@@ -0,0 +1,90 @@
+/**
+ * @file test.h
+ * @brief Minimal unit test harness for the Ozone (O3) tests.
+ *
+ * Each test file defines cases with TEST(name) and checks with CHECK,
+ * CHECK_EQ and CHECK_NEAR. A failed check reports its location and
+ * fails the case without stopping the remaining cases. Every test file is
+ * linked with test_main.cpp into its own executable and registered with
+ * CTest; the executable runs all its cases, or those named on the
+ * command line.
+ */
+
+#ifndef O3_TEST_H
+#define O3_TEST_H
+
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace o3test {
+
+/**
+ * @brief A registered test case
+ */
+struct Case {
+    const char* name;   // Name given to TEST
+    void (*function)(); // Body of the case
+};
+
+/**
+ * @brief Get every case registered in this executable
+ * @return Cases in registration order
+ */
+std::vector<Case>& registry();
+
+/**
+ * @brief Record a failed check of the running case
+ * @param file Source file of the check
+ * @param line Source line of the check
+ * @param message What failed
+ */
+void fail(const char* file, int line, const std::string& message);
+
+/**
+ * @brief Adds a case to the registry at static initialization
+ */
+struct Registrar {
+    Registrar(const char* name, void (*function)()) {
+        Case entry = { name, function };
+        registry().push_back(entry);
+    }
+};
+
+} // namespace o3test
+
+#define TEST(name)                                                          \
+    static void test_##name();                                              \
+    static o3test::Registrar registrar_##name(#name, &test_##name);         \
+    static void test_##name()
+
+#define CHECK(condition)                                                    \
+    do {                                                                    \
+        if (!(condition)) {                                                 \
+            o3test::fail(__FILE__, __LINE__, "CHECK(" #condition ")");      \
+        }                                                                   \
+    } while (0)
+
+#define CHECK_EQ(actual, expected)                                          \
+    do {                                                                    \
+        if (!((actual) == (expected))) {                                    \
+            std::ostringstream message;                                     \
+            message << "CHECK_EQ(" #actual ", " #expected "): got "         \
+                    << (actual) << ", expected " << (expected);             \
+            o3test::fail(__FILE__, __LINE__, message.str());                \
+        }                                                                   \
+    } while (0)
+
+#define CHECK_NEAR(actual, expected, tolerance)                             \
+    do {                                                                    \
+        if (!(std::fabs((actual) - (expected)) <= (tolerance))) {           \
+            std::ostringstream message;                                     \
+            message << "CHECK_NEAR(" #actual ", " #expected "): got "       \
+                    << (actual) << ", expected " << (expected);             \
+            o3test::fail(__FILE__, __LINE__, message.str());                \
+        }                                                                   \
+    } while (0)
+
+#endif // O3_TEST_H
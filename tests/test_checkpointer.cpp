@@ -0,0 +1,181 @@
+/**
+ * @file test_checkpointer.cpp
+ * @brief Tests for incremental checkpoints of a running network.
+ */
+
+#include "test.h"
+#include "../include/checkpointer.h"
+#include <cstdio>
+#include <dirent.h>
+#include <fstream>
+#include <stdlib.h>
+#include <string>
+#include <unistd.h>
+
+namespace {
+
+/**
+ * @brief A checkpoint directory removed with its files at scope exit
+ */
+class ScratchDirectory {
+public:
+    ScratchDirectory() {
+        char pattern[] = "test_checkpoints_XXXXXX";
+        const char* created = mkdtemp(pattern);
+        path = created ? created : "";
+    }
+
+    ~ScratchDirectory() {
+        DIR* directory = opendir(path.c_str());
+        if (!directory) {
+            return;
+        }
+        while (dirent* entry = readdir(directory)) {
+            std::string name = entry->d_name;
+            if (name != "." && name != "..") {
+                std::remove((path + "/" + name).c_str());
+            }
+        }
+        closedir(directory);
+        rmdir(path.c_str());
+    }
+
+    bool contains(const std::string& name) const {
+        return std::ifstream((path + "/" + name).c_str()).good();
+    }
+
+    std::string path;
+};
+
+/**
+ * @brief Build a chain of neurons fed by one input
+ */
+void populate(Network& network) {
+    auto input = network.createNeuron("input", Neuron::NeuronType::SENSORY);
+    auto relay = network.createNeuron("relay", Neuron::NeuronType::PROCESSING);
+    auto sink = network.createNeuron("sink", Neuron::NeuronType::MEMORY);
+    input->connectTo(relay, 0.9f);
+    relay->connectTo(sink, 0.2f);
+    network.addInputNeuron(input);
+}
+
+void run(Network& network, int ticks) {
+    for (int tick = 0; tick < ticks; ++tick) {
+        network.injectSignal(Synapse::create("input", Synapse::SynapseType::EXCITATORY, 1.0f), "input");
+        network.processSignals();
+    }
+}
+
+} // namespace
+
+TEST(base_and_delta_round_trip) {
+    ScratchDirectory scratch;
+    CHECK(!scratch.path.empty());
+
+    Network network("checkpointed");
+    populate(network);
+    Checkpointer checkpointer(network, scratch.path);
+
+    CHECK(checkpointer.checkpoint());
+    run(network, 3);
+    network.getNeuron("relay")->setConnectionWeight(network.getNeuron("sink"), 0.4f);
+    CHECK(checkpointer.checkpoint());
+    CHECK(checkpointer.flush());
+    CHECK_EQ(checkpointer.getSequence(), 2u);
+    CHECK(scratch.contains("checkpoint-1.o3s"));
+    CHECK(scratch.contains("checkpoint-2.o3d"));
+
+    std::string error;
+    std::shared_ptr<Network> restored = Checkpointer::restore(scratch.path, &error);
+    CHECK(restored != nullptr);
+    if (!restored) {
+        return;
+    }
+
+    for (const char* id : {"input", "relay", "sink"}) {
+        auto original = network.getNeuron(id);
+        auto copy = restored->getNeuron(id);
+        CHECK(copy != nullptr);
+        if (copy) {
+            CHECK_NEAR(copy->getPotential(), original->getPotential(), 1e-6f);
+            CHECK(copy->getState() == original->getState());
+        }
+    }
+    CHECK_NEAR(restored->getNeuron("relay")->getConnectionWeight(restored->getNeuron("sink")), 0.4f, 1e-6f);
+}
+
+TEST(attribute_change_starts_new_base) {
+    ScratchDirectory scratch;
+    Network network("tagged");
+    populate(network);
+    Checkpointer checkpointer(network, scratch.path);
+
+    CHECK(checkpointer.checkpoint());
+    network.getNeuron("sink")->addTag("remembered");
+    network.getNeuron("sink")->setMetadata("unit", "mV");
+    CHECK(checkpointer.checkpoint());
+    CHECK(checkpointer.flush());
+    CHECK(scratch.contains("checkpoint-2.o3s"));
+
+    std::shared_ptr<Network> restored = Checkpointer::restore(scratch.path);
+    CHECK(restored != nullptr);
+    if (restored) {
+        CHECK(restored->getNeuron("sink")->hasTag("remembered"));
+        CHECK_EQ(restored->getNeuron("sink")->getMetadata("unit"), std::string("mV"));
+    }
+}
+
+TEST(attribute_change_keeps_structure_revision) {
+    Network network("revisions");
+    populate(network);
+    auto sink = network.getNeuron("sink");
+    SimulationCore* core = sink->getCore();
+
+    uint64_t structure = core->getStructureRevision();
+    uint64_t snapshot = core->getSnapshotRevision();
+    sink->addTag("fresh_tag");
+    sink->setMetadata("key", "value");
+    sink->createGate(NeuronGate::GateType::THRESHOLD);
+    CHECK_EQ(core->getStructureRevision(), structure);
+    CHECK(core->getSnapshotRevision() != snapshot);
+
+    network.addOutputNeuron(sink);
+    CHECK(core->getStructureRevision() != structure);
+}
+
+TEST(process_callbacks_can_be_removed) {
+    Network network("callbacks");
+    populate(network);
+
+    int first = 0;
+    int second = 0;
+    size_t firstHandle = network.onProcess([&first](Network&) { ++first; });
+    size_t secondHandle = network.onProcess([&second](Network&) { ++second; });
+    CHECK(firstHandle != 0 && secondHandle != 0 && firstHandle != secondHandle);
+    CHECK_EQ(network.onProcess(std::function<void(Network&)>()), 0u);
+
+    run(network, 2);
+    CHECK(network.removeProcessCallback(firstHandle));
+    CHECK(!network.removeProcessCallback(firstHandle));
+    run(network, 3);
+    CHECK_EQ(first, 2);
+    CHECK_EQ(second, 5);
+}
+
+TEST(destroyed_checkpointer_unregisters_callback) {
+    ScratchDirectory scratch;
+    Network network("detached");
+    populate(network);
+
+    // Handles are assigned in order, so the checkpointer's follows the probe's
+    size_t probe = network.onProcess([](Network&) {});
+    {
+        Checkpointer checkpointer(network, scratch.path, 1);
+        run(network, 2);
+        CHECK(checkpointer.flush());
+        CHECK(checkpointer.getSequence() >= 1u);
+    }
+    CHECK(!network.removeProcessCallback(probe + 1));
+    CHECK(network.removeProcessCallback(probe));
+    run(network, 2);
+}
@@ -0,0 +1,110 @@
+/**
+ * @file test_delivery_queue.cpp
+ * @brief Tests for the deferred delivery of signals between neurons.
+ */
+
+#include "test.h"
+#include "../include/delivery_queue.h"
+#include "../include/network.h"
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Drain the current tick and return the targets in delivery order
+ */
+std::vector<uint32_t> drainTargets(DeliveryQueue& queue) {
+    std::vector<uint32_t> targets;
+    queue.drain([&](DeliveryQueue::Event& event) { targets.push_back(event.target); });
+    return targets;
+}
+
+} // namespace
+
+TEST(events_arrive_after_their_delay_in_scheduling_order) {
+    DeliveryQueue queue(8);
+    SynapsePtr signal = Synapse::create("queued");
+
+    queue.schedule(1, 0, signal, 2);
+    queue.schedule(2, 0, signal, 1);
+    queue.schedule(3, 0, signal, 2);
+    queue.schedule(4, 0, signal, 0);  // Clamped to one tick
+    CHECK_EQ(queue.pendingCount(), 4u);
+
+    CHECK(drainTargets(queue).empty());
+    queue.advance();
+
+    std::vector<uint32_t> first = drainTargets(queue);
+    CHECK_EQ(first.size(), 2u);
+    CHECK(first == std::vector<uint32_t>({ 2, 4 }));
+    queue.advance();
+
+    std::vector<uint32_t> second = drainTargets(queue);
+    CHECK(second == std::vector<uint32_t>({ 1, 3 }));
+    CHECK_EQ(queue.pendingCount(), 0u);
+}
+
+TEST(full_slot_drops_signals) {
+    DeliveryQueue queue(4, 2);
+    SynapsePtr signal = Synapse::create("queued");
+
+    CHECK(queue.schedule(1, 0, signal, 1));
+    CHECK(queue.schedule(2, 0, signal, 1));
+    CHECK(!queue.schedule(3, 0, signal, 1));
+    CHECK_EQ(queue.droppedCount(), 1u);
+}
+
+TEST(resizing_keeps_pending_events) {
+    DeliveryQueue queue(4);
+    queue.schedule(7, 0, Synapse::create("queued"), 3);
+    queue.setMaxDelay(32);
+
+    for (int tick = 0; tick < 3; ++tick) {
+        CHECK(drainTargets(queue).empty());
+        queue.advance();
+    }
+    CHECK(drainTargets(queue) == std::vector<uint32_t>({ 7 }));
+}
+
+TEST(max_delay_is_limited_to_what_an_edge_stores) {
+    DeliveryQueue queue(70000);
+    CHECK_EQ(queue.getMaxDelay(), DeliveryQueue::DELAY_LIMIT);
+    queue.setMaxDelay(1u << 20);
+    CHECK_EQ(queue.getMaxDelay(), DeliveryQueue::DELAY_LIMIT);
+}
+
+TEST(long_connection_delay_does_not_wrap) {
+    Network network("delay_network");
+    auto source = network.createNeuron("delay_source", Neuron::NeuronType::PROCESSING);
+    auto target = network.createNeuron("delay_target", Neuron::NeuronType::PROCESSING);
+    source->connectTo(target);
+
+    network.setMaxSignalDelay(70000);
+    CHECK(source->setConnectionDelay(target, 65536));
+    CHECK_EQ(source->getConnectionDelay(target), 65535u);
+
+    CHECK(source->setConnectionDelay(target, 300));
+    CHECK_EQ(source->getConnectionDelay(target), 300u);
+}
+
+TEST(network_delivers_after_connection_delay) {
+    Network network("delivery_network");
+    auto source = network.createNeuron("delivery_source", Neuron::NeuronType::SENSORY);
+    auto target = network.createNeuron("delivery_target", Neuron::NeuronType::SENSORY);
+    source->connectTo(target);
+    source->setConnectionDelay(target, 3);
+    network.addInputNeuron(source);
+
+    std::vector<uint64_t> fired;
+    target->onFire([&](std::shared_ptr<Neuron>) { fired.push_back(network.getCurrentTick()); });
+
+    network.injectSignal(Synapse::create("input", Synapse::SynapseType::EXCITATORY, 1.0f), "delivery_source");
+    for (int tick = 0; tick < 6; ++tick) {
+        network.processSignals();
+    }
+
+    CHECK_EQ(fired.size(), 1u);
+    if (!fired.empty()) {
+        CHECK_EQ(fired[0], 3u);
+    }
+}
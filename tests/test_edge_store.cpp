@@ -0,0 +1,101 @@
+/**
+ * @file test_edge_store.cpp
+ * @brief Tests for the CSR connection storage and the Neuron connection API on top of it.
+ */
+
+#include "test.h"
+#include "../include/edge_store.h"
+#include "../include/neuron.h"
+#include <memory>
+
+TEST(connect_and_disconnect) {
+    EdgeStore store;
+    store.resize(4);
+
+    CHECK(store.connect(0, 1, 0.5f));
+    CHECK(store.connect(0, 2, 0.25f));
+    CHECK(store.connect(3, 1, 1.0f));
+    CHECK_EQ(store.edgeCount(), 3u);
+    CHECK_EQ(store.outDegree(0), 2u);
+    CHECK_EQ(store.inDegree(1), 2u);
+
+    // Reconnecting updates the weight instead of adding an edge
+    CHECK(store.connect(0, 1, 0.75f));
+    CHECK_EQ(store.edgeCount(), 3u);
+    CHECK_EQ(store.getWeight(0, 1), 0.75f);
+
+    CHECK(store.disconnect(0, 1));
+    CHECK(!store.disconnect(0, 1));
+    CHECK_EQ(store.edgeCount(), 2u);
+    CHECK_EQ(store.inDegree(1), 1u);
+    CHECK_EQ(store.find(0, 1), EdgeStore::NOT_FOUND);
+}
+
+TEST(rows_keep_insertion_order) {
+    EdgeStore store;
+    store.resize(5);
+    store.connect(0, 4, 0.1f);
+    store.connect(0, 2, 0.2f);
+    store.connect(0, 3, 0.3f);
+
+    const uint32_t* targets = store.outTargets(0);
+    CHECK_EQ(targets[0], 4u);
+    CHECK_EQ(targets[1], 2u);
+    CHECK_EQ(targets[2], 3u);
+}
+
+TEST(remove_neuron_drops_both_directions) {
+    EdgeStore store;
+    store.resize(3);
+    store.connect(0, 1, 1.0f);
+    store.connect(1, 2, 1.0f);
+    store.connect(2, 1, 1.0f);
+
+    store.removeNeuron(1);
+    CHECK_EQ(store.edgeCount(), 0u);
+    CHECK_EQ(store.outDegree(0), 0u);
+    CHECK_EQ(store.inDegree(2), 0u);
+}
+
+TEST(batch_matches_single_connects) {
+    EdgeStore single;
+    EdgeStore batched;
+    single.resize(4);
+    batched.resize(4);
+
+    std::vector<EdgeStore::BatchEdge> batch;
+    EdgeStore::BatchEdge edges[] = { { 0, 1, 0.5f, 1 }, { 2, 3, 0.1f, 4 }, { 0, 1, 0.9f, 2 }, { 0, 3, 0.2f, 1 } };
+    for (const EdgeStore::BatchEdge& edge : edges) {
+        single.connect(edge.source, edge.target, edge.weight);
+        single.setDelay(edge.source, edge.target, edge.delay);
+        batch.push_back(edge);
+    }
+    CHECK_EQ(batched.connectBatch(batch), 3u);
+
+    for (uint32_t source = 0; source < 4; ++source) {
+        CHECK_EQ(batched.outDegree(source), single.outDegree(source));
+        for (uint32_t i = 0; i < single.outDegree(source); ++i) {
+            CHECK_EQ(batched.outTargets(source)[i], single.outTargets(source)[i]);
+            CHECK_EQ(batched.outWeights(source)[i], single.outWeights(source)[i]);
+            CHECK_EQ(batched.outDelays(source)[i], single.outDelays(source)[i]);
+        }
+    }
+}
+
+TEST(neuron_connections) {
+    auto a = std::make_shared<Neuron>("edge_a", Neuron::NeuronType::PROCESSING);
+    auto b = std::make_shared<Neuron>("edge_b", Neuron::NeuronType::PROCESSING);
+
+    CHECK(a->connectTo(b, 0.4f));
+    CHECK_EQ(a->getOutputs().size(), 1u);
+    CHECK(a->getOutputs()[0] == b);
+    CHECK(b->getInputs()[0] == a);
+    CHECK_EQ(a->getConnectionWeight(b), 0.4f);
+
+    CHECK(a->setConnectionWeight(b, 0.6f));
+    CHECK_EQ(a->getConnectionWeight(b), 0.6f);
+
+    CHECK(a->disconnectFrom(b));
+    CHECK(a->getOutputs().empty());
+    CHECK(b->getInputs().empty());
+}
@@ -0,0 +1,110 @@
+/**
+ * @file test_gate_batch.cpp
+ * @brief Tests for batch gate evaluation against per-signal processing.
+ */
+
+#include "test.h"
+#include "../include/neuron_gate.h"
+#include <vector>
+
+namespace {
+
+const NeuronGate::GateType BUILT_IN[] = {
+    NeuronGate::GateType::AND,
+    NeuronGate::GateType::OR,
+    NeuronGate::GateType::NOT,
+    NeuronGate::GateType::XOR,
+    NeuronGate::GateType::THRESHOLD,
+    NeuronGate::GateType::MODULATOR
+};
+
+std::vector<float> sampleStrengths() {
+    std::vector<float> strengths;
+    for (int i = 0; i <= 40; ++i) {
+        strengths.push_back(static_cast<float>(i) / 40.0f);
+    }
+    return strengths;
+}
+
+} // namespace
+
+TEST(batch_matches_process_per_signal) {
+    std::vector<float> strengths = sampleStrengths();
+    const float thresholds[] = {0.1f, 0.5f, 0.75f};
+
+    for (NeuronGate::GateType type : BUILT_IN) {
+        for (float threshold : thresholds) {
+            auto gate = NeuronGateFactory::createGate(type, "batch_gate");
+            gate->setThreshold(threshold);
+            if (type == NeuronGate::GateType::MODULATOR) {
+                std::static_pointer_cast<ModulatorGate>(gate)->setFactor(1.5f);
+            }
+
+            std::vector<float> outputs(strengths.size(), -1.0f);
+            std::vector<uint8_t> passed(strengths.size(), 2);
+            CHECK(gate->evaluate(strengths.data(), strengths.size(), outputs.data(), passed.data()));
+
+            for (size_t i = 0; i < strengths.size(); ++i) {
+                std::vector<SynapsePtr> single(1, Synapse::create("in", Synapse::SynapseType::EXCITATORY, strengths[i]));
+                SynapsePtr result = gate->process(single);
+                CHECK_EQ(passed[i] != 0, static_cast<bool>(result));
+                if (result && passed[i]) {
+                    CHECK_NEAR(outputs[i], result->getStrength(), 1e-6f);
+                }
+            }
+        }
+    }
+}
+
+TEST(inactive_gate_passes_nothing) {
+    std::vector<float> strengths = sampleStrengths();
+    for (NeuronGate::GateType type : BUILT_IN) {
+        auto gate = NeuronGateFactory::createGate(type, "inactive_gate");
+        gate->setActive(false);
+
+        std::vector<float> outputs(strengths.size(), 0.0f);
+        std::vector<uint8_t> passed(strengths.size(), 1);
+        CHECK(gate->evaluate(strengths.data(), strengths.size(), outputs.data(), passed.data()));
+        for (uint8_t flag : passed) {
+            CHECK_EQ(flag, 0);
+        }
+    }
+}
+
+TEST(custom_gate_has_no_batch_kernel) {
+    auto gate = NeuronGateFactory::createCustomGate("custom_gate", [](const std::vector<SynapsePtr>& inputs) {
+        return inputs.empty() ? SynapsePtr() : inputs[0]->derive();
+    });
+    float strength = 0.5f;
+    float output = 0.0f;
+    uint8_t passed = 0;
+    CHECK(!gate->evaluate(&strength, 1, &output, &passed));
+}
+
+TEST(empty_batch) {
+    auto gate = NeuronGateFactory::createGate(NeuronGate::GateType::THRESHOLD, "empty_gate");
+    CHECK(gate->evaluate(nullptr, 0, nullptr, nullptr));
+}
+
+TEST(process_ignores_active_flag) {
+    // Neurons skip inactive gates themselves; process() behaves the same for every type
+    for (NeuronGate::GateType type : BUILT_IN) {
+        auto active = NeuronGateFactory::createGate(type, "active_gate");
+        auto inactive = NeuronGateFactory::createGate(type, "inactive_gate");
+        inactive->setActive(false);
+
+        std::vector<SynapsePtr> inputs;
+        inputs.push_back(Synapse::create("first", Synapse::SynapseType::EXCITATORY, 0.8f));
+        if (type == NeuronGate::GateType::XOR) {
+            inputs.push_back(Synapse::create("second", Synapse::SynapseType::EXCITATORY, 0.1f));
+        }
+
+        SynapsePtr expected = active->process(inputs);
+        SynapsePtr result = inactive->process(inputs);
+        CHECK_EQ(static_cast<bool>(result), static_cast<bool>(expected));
+        CHECK(result);  // Every gate lets this input through when active
+        if (result && expected) {
+            CHECK_NEAR(result->getStrength(), expected->getStrength(), 1e-6f);
+        }
+    }
+}
@@ -0,0 +1,136 @@
+/**
+ * @file test_gate_chain.cpp
+ * @brief Tests for compiled gate chains against sequential gate processing.
+ */
+
+#include "test.h"
+#include "../include/gate_chain.h"
+#include <random>
+#include <vector>
+
+namespace {
+
+typedef std::vector<std::shared_ptr<NeuronGate>> Gates;
+
+const NeuronGate::GateType BUILT_IN[] = {
+    NeuronGate::GateType::AND,
+    NeuronGate::GateType::OR,
+    NeuronGate::GateType::NOT,
+    NeuronGate::GateType::XOR,
+    NeuronGate::GateType::THRESHOLD,
+    NeuronGate::GateType::MODULATOR
+};
+
+Gates randomGates(std::mt19937& rng, size_t count) {
+    std::uniform_int_distribution<int> pick(0, 5);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    Gates gates;
+    for (size_t i = 0; i < count; ++i) {
+        NeuronGate::GateType type = BUILT_IN[pick(rng)];
+        auto gate = NeuronGateFactory::createGate(type, "gate_" + std::to_string(i));
+        gate->setThreshold(unit(rng));
+        if (type == NeuronGate::GateType::MODULATOR) {
+            std::static_pointer_cast<ModulatorGate>(gate)->setFactor(0.5f + unit(rng));
+        }
+        if (unit(rng) < 0.2f) {
+            gate->setActive(false);
+        }
+        gates.push_back(gate);
+    }
+    return gates;
+}
+
+/**
+ * @brief Route the signals through the gates one by one, as an uncompiled neuron does
+ */
+void checkAgainstProcess(const Gates& gates, GateChain& chain, const std::vector<float>& strengths) {
+    std::vector<float> outputs(strengths.size(), -1.0f);
+    std::vector<uint8_t> taken(strengths.size(), 255);
+    chain.run(strengths.data(), strengths.size(), outputs.data(), taken.data());
+
+    Gates active;
+    for (const auto& gate : gates) {
+        if (gate->isActive()) {
+            active.push_back(gate);
+        }
+    }
+    CHECK_EQ(chain.getStageCount(), active.size());
+
+    for (size_t i = 0; i < strengths.size(); ++i) {
+        std::vector<SynapsePtr> single(1, Synapse::create("in", Synapse::SynapseType::EXCITATORY, strengths[i]));
+        size_t expected = 0;
+        float strength = 0.0f;
+        for (size_t stage = 0; stage < active.size(); ++stage) {
+            SynapsePtr result = active[stage]->process(single);
+            if (result) {
+                expected = stage + 1;
+                strength = result->getStrength();
+                break;
+            }
+        }
+        CHECK_EQ(static_cast<size_t>(taken[i]), expected);
+        if (expected != 0) {
+            CHECK_NEAR(outputs[i], strength, 1e-6f);
+            CHECK(&chain.getGate(expected - 1) == active[expected - 1].get());
+        }
+    }
+}
+
+} // namespace
+
+TEST(compiled_chain_matches_sequential_process) {
+    std::mt19937 rng(2024);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<float> strengths;
+    for (int i = 0; i < 64; ++i) {
+        strengths.push_back(unit(rng));
+    }
+
+    // Lengths one and two use the inlined kernels, longer chains the interpreted loop
+    for (size_t length = 0; length <= 5; ++length) {
+        for (int trial = 0; trial < 20; ++trial) {
+            Gates gates = randomGates(rng, length);
+            GateChain chain;
+            CHECK(chain.compile(gates));
+            CHECK(chain.isCompiled());
+            checkAgainstProcess(gates, chain, strengths);
+        }
+    }
+}
+
+TEST(parameter_changes_need_no_recompile) {
+    Gates gates;
+    gates.push_back(NeuronGateFactory::createGate(NeuronGate::GateType::THRESHOLD, "threshold"));
+    gates.push_back(NeuronGateFactory::createGate(NeuronGate::GateType::MODULATOR, "modulator"));
+
+    GateChain chain;
+    CHECK(chain.compile(gates));
+
+    std::vector<float> strengths;
+    for (int i = 0; i <= 20; ++i) {
+        strengths.push_back(static_cast<float>(i) / 20.0f);
+    }
+    checkAgainstProcess(gates, chain, strengths);
+
+    gates[0]->setThreshold(0.8f);
+    std::static_pointer_cast<ModulatorGate>(gates[1])->setFactor(0.25f);
+    checkAgainstProcess(gates, chain, strengths);
+}
+
+TEST(custom_gate_prevents_compilation) {
+    Gates gates;
+    gates.push_back(NeuronGateFactory::createGate(NeuronGate::GateType::THRESHOLD, "threshold"));
+    gates.push_back(NeuronGateFactory::createCustomGate("custom", [](const std::vector<SynapsePtr>& inputs) {
+        return inputs.empty() ? SynapsePtr() : inputs[0]->derive();
+    }));
+
+    GateChain chain;
+    CHECK(!chain.compile(gates));
+    CHECK(!chain.isCompiled());
+
+    // An inactive custom gate is not part of the chain
+    gates[1]->setActive(false);
+    CHECK(chain.compile(gates));
+    CHECK_EQ(chain.getStageCount(), static_cast<size_t>(1));
+}
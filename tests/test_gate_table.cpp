@@ -0,0 +1,205 @@
+/**
+ * @file test_gate_table.cpp
+ * @brief Tests for the columnar gate table and its bulk adaptation.
+ */
+
+#include "test.h"
+#include "../include/integration_kernel.h"
+#include "../include/network.h"
+#include "../include/thread_pool.h"
+#include <random>
+#include <vector>
+
+namespace {
+
+const IntegrationKernel::Isa ALL_ISAS[] = {
+    IntegrationKernel::Isa::SCALAR,
+    IntegrationKernel::Isa::NEON,
+    IntegrationKernel::Isa::AVX2,
+    IntegrationKernel::Isa::AVX512
+};
+
+/**
+ * @brief A table of gates with random parameters, plus a twin table adapted gate by gate
+ */
+struct TablePair {
+    explicit TablePair(size_t count) : bulk(std::make_shared<GateTable>()), reference(std::make_shared<GateTable>()) {
+        std::mt19937 rng(static_cast<unsigned>(count));
+        std::uniform_real_distribution<float> threshold(0.0f, 1.0f);
+        std::uniform_real_distribution<float> rate(0.0f, 0.3f);
+        for (size_t i = 0; i < count; ++i) {
+            auto bulkGate = NeuronGateFactory::createGate(NeuronGate::GateType::THRESHOLD, "bulk");
+            auto referenceGate = NeuronGateFactory::createGate(NeuronGate::GateType::THRESHOLD, "reference");
+            float t = threshold(rng);
+            float r = rate(rng);
+            bulkGate->setThreshold(t);
+            bulkGate->setAdaptationRate(r);
+            referenceGate->setThreshold(t);
+            referenceGate->setAdaptationRate(r);
+            bulk->transfer(*bulkGate);
+            reference->transfer(*referenceGate);
+            bulkGates.push_back(bulkGate);
+            referenceGates.push_back(referenceGate);
+            success.push_back(static_cast<uint8_t>(rng() % 3 == 0 ? 0 : rng() % 255 + 1));
+        }
+    }
+
+    void adaptReference() {
+        for (size_t i = 0; i < referenceGates.size(); ++i) {
+            referenceGates[i]->adapt(success[referenceGates[i]->getSlot()] != 0);
+        }
+    }
+
+    void checkEqual() const {
+        CHECK_EQ(bulk->capacity(), reference->capacity());
+        for (size_t i = 0; i < bulkGates.size(); ++i) {
+            CHECK_EQ(bulkGates[i]->getThreshold(), referenceGates[i]->getThreshold());
+        }
+    }
+
+    std::shared_ptr<GateTable> bulk;
+    std::shared_ptr<GateTable> reference;
+    std::vector<std::shared_ptr<NeuronGate>> bulkGates;
+    std::vector<std::shared_ptr<NeuronGate>> referenceGates;
+    std::vector<uint8_t> success;
+};
+
+} // namespace
+
+TEST(adapt_threshold_clamps) {
+    CHECK_NEAR(GateTable::adaptThreshold(0.5f, 0.1f, true), 0.4f, 1e-6f);
+    CHECK_NEAR(GateTable::adaptThreshold(0.5f, 0.1f, false), 0.6f, 1e-6f);
+    CHECK_EQ(GateTable::adaptThreshold(0.15f, 0.1f, true), 0.1f);
+    CHECK_EQ(GateTable::adaptThreshold(0.85f, 0.1f, false), 0.9f);
+}
+
+TEST(every_isa_matches_per_gate_adapt) {
+    IntegrationKernel::Isa previous = IntegrationKernel::getIsa();
+    const size_t counts[] = {0, 1, 7, 15, 16, 17, 1037};
+
+    for (IntegrationKernel::Isa isa : ALL_ISAS) {
+        if (!IntegrationKernel::setIsa(isa)) {
+            continue;  // Not supported on this CPU
+        }
+        for (size_t count : counts) {
+            TablePair tables(count);
+            for (int round = 0; round < 12; ++round) {
+                tables.bulk->adaptAll(tables.success.data());
+                tables.adaptReference();
+                tables.checkEqual();
+            }
+        }
+    }
+
+    IntegrationKernel::setIsa(previous);
+}
+
+TEST(parallel_adapt_matches_serial) {
+    ThreadPool pool(4);
+    TablePair tables(5000);
+    for (int round = 0; round < 6; ++round) {
+        tables.bulk->adaptAll(tables.success.data(), &pool, 256);
+        tables.adaptReference();
+        tables.checkEqual();
+    }
+}
+
+TEST(released_slots_are_reused) {
+    auto table = std::make_shared<GateTable>();
+    auto first = NeuronGateFactory::createGate(NeuronGate::GateType::THRESHOLD, "first");
+    auto second = NeuronGateFactory::createGate(NeuronGate::GateType::THRESHOLD, "second");
+    table->transfer(*first);
+    table->transfer(*second);
+    CHECK_EQ(table->size(), static_cast<size_t>(2));
+
+    uint32_t slot = first->getSlot();
+    first.reset();
+    CHECK_EQ(table->size(), static_cast<size_t>(1));
+    CHECK(table->getGate(slot) == nullptr);
+
+    auto third = NeuronGateFactory::createGate(NeuronGate::GateType::MODULATOR, "third");
+    third->setThreshold(0.3f);
+    table->transfer(*third);
+    CHECK_EQ(third->getSlot(), slot);
+    CHECK_EQ(table->capacity(), 2u);
+    CHECK_EQ(third->getThreshold(), 0.3f);
+    CHECK(&third->getTable() == table.get());
+}
+
+TEST(network_adapts_gates_by_neuron_outcome) {
+    Network network("adaptive");
+    network.setParallelism(2, 1);
+
+    std::vector<std::shared_ptr<Neuron>> neurons;
+    std::vector<std::shared_ptr<NeuronGate>> gates;
+    for (int i = 0; i < 40; ++i) {
+        auto neuron = network.createNeuron("n" + std::to_string(i), Neuron::NeuronType::PROCESSING);
+        for (int g = 0; g <= i % 3; ++g) {
+            auto gate = neuron->createGate(NeuronGate::GateType::THRESHOLD);
+            gate->setThreshold(0.2f + 0.015f * static_cast<float>(i));
+            gates.push_back(gate);
+        }
+        neurons.push_back(neuron);
+    }
+
+    std::vector<uint8_t> success(network.getNeuronSlotCount(), 0);
+    for (const auto& neuron : neurons) {
+        success[neuron->getIndex()] = neuron->getIndex() % 2;
+    }
+
+    std::vector<float> expected;
+    for (size_t i = 0; i < neurons.size(); ++i) {
+        bool passed = success[neurons[i]->getIndex()] != 0;
+        for (int g = 0; g <= static_cast<int>(i % 3); ++g) {
+            float threshold = 0.2f + 0.015f * static_cast<float>(i);
+            expected.push_back(GateTable::adaptThreshold(threshold, 0.1f, passed));
+        }
+    }
+
+    CHECK(network.adaptGates(success));
+    for (size_t i = 0; i < gates.size(); ++i) {
+        CHECK_EQ(gates[i]->getThreshold(), expected[i]);
+    }
+
+    std::vector<uint8_t> tooShort(network.getNeuronSlotCount() - 1, 1);
+    CHECK(!network.adaptGates(tooShort));
+    for (size_t i = 0; i < gates.size(); ++i) {
+        CHECK_EQ(gates[i]->getThreshold(), expected[i]);
+    }
+}
+
+TEST(table_activity_changes_recompile_chain) {
+    Network network("toggled");
+    auto input = network.createNeuron("input", Neuron::NeuronType::SENSORY);
+    auto relay = network.createNeuron("relay", Neuron::NeuronType::PROCESSING);
+    input->connectTo(relay, 0.1f);
+    network.addInputNeuron(input);
+    relay->setThreshold(0.45f);
+
+    // A signal taken by the gate counts at the default strength of 0.5
+    // instead of its weakened payload, so the relay fires only through it
+    auto gate = relay->createGate(NeuronGate::GateType::THRESHOLD);
+    gate->setThreshold(0.0f);
+    GateTable& table = gate->getTable();
+
+    int fired = 0;
+    relay->onFire([&fired](std::shared_ptr<Neuron>) { ++fired; });
+    auto run = [&network, &fired]() {
+        int before = fired;
+        for (int tick = 0; tick < 3; ++tick) {
+            network.injectSignal(Synapse::create("input", Synapse::SynapseType::EXCITATORY, 1.0f), "input");
+            network.processSignals();
+        }
+        return fired - before;
+    };
+
+    CHECK(run() > 0);  // Compiles the chain with the gate in it
+
+    table.setActive(gate->getSlot(), false);
+    CHECK(!gate->isActive());
+    CHECK_EQ(run(), 0);
+
+    table.setActive(gate->getSlot(), true);
+    CHECK(gate->isActive());
+    CHECK(run() > 0);
+}
@@ -0,0 +1,93 @@
+/**
+ * @file test_gate_tracing.cpp
+ * @brief Tests that gate tracing records provenance without changing firing.
+ */
+
+#include "test.h"
+#include "../include/network.h"
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Sets gate tracing for the lifetime of the object
+ */
+struct TracingScope {
+    explicit TracingScope(bool enabled) : previous(NeuronGate::isTracing()) { NeuronGate::setTracing(enabled); }
+    ~TracingScope() { NeuronGate::setTracing(previous); }
+    bool previous;
+};
+
+struct Trace {
+    std::vector<std::string> fired;  // Neuron id per firing, in order
+    std::vector<float> potentials;   // Potential of every neuron after every tick
+};
+
+Trace runGated(bool tracing) {
+    TracingScope scope(tracing);
+
+    Network network("gated");
+    auto input = network.createNeuron("input", Neuron::NeuronType::SENSORY);
+    auto relay = network.createNeuron("relay", Neuron::NeuronType::PROCESSING);
+    auto sink = network.createNeuron("sink", Neuron::NeuronType::MEMORY);
+    input->connectTo(relay, 0.9f);
+    relay->connectTo(sink, 0.6f);
+    network.addInputNeuron(input);
+
+    relay->createGate(NeuronGate::GateType::THRESHOLD)->setThreshold(0.3f);
+    auto modulator = std::static_pointer_cast<ModulatorGate>(sink->createGate(NeuronGate::GateType::MODULATOR));
+    modulator->setFactor(1.4f);
+
+    Trace trace;
+    std::vector<std::shared_ptr<Neuron>> neurons = {input, relay, sink};
+    for (const auto& neuron : neurons) {
+        neuron->onFire([&trace](std::shared_ptr<Neuron> fired) { trace.fired.push_back(fired->getId()); });
+    }
+
+    const float strengths[] = {0.2f, 1.0f, 0.4f, 0.9f, 0.1f, 0.7f};
+    for (int tick = 0; tick < 24; ++tick) {
+        float strength = strengths[tick % 6];
+        network.injectSignal(Synapse::create("input", Synapse::SynapseType::EXCITATORY, strength), "input");
+        network.processSignals();
+        for (const auto& neuron : neurons) {
+            trace.potentials.push_back(neuron->getPotential());
+        }
+    }
+    return trace;
+}
+
+} // namespace
+
+TEST(firing_is_the_same_with_and_without_tracing) {
+    Trace plain = runGated(false);
+    Trace traced = runGated(true);
+
+    CHECK(!plain.fired.empty());
+    CHECK(plain.fired == traced.fired);
+    CHECK_EQ(plain.potentials.size(), traced.potentials.size());
+    for (size_t i = 0; i < plain.potentials.size(); ++i) {
+        CHECK_NEAR(plain.potentials[i], traced.potentials[i], 1e-6f);
+    }
+}
+
+TEST(tracing_records_provenance) {
+    auto gate = NeuronGateFactory::createGate(NeuronGate::GateType::THRESHOLD, "traced_gate");
+    std::vector<SynapsePtr> single(1, Synapse::create("in", Synapse::SynapseType::EXCITATORY, 0.8f));
+
+    {
+        TracingScope scope(false);
+        SynapsePtr result = gate->process(single);
+        CHECK(result);
+        CHECK(!result->hasTag("gate_processed"));
+        CHECK(!result->hasData("gate_id"));
+    }
+    {
+        TracingScope scope(true);
+        SynapsePtr result = gate->process(single);
+        CHECK(result);
+        CHECK(result->hasTag("gate_processed"));
+        CHECK(result->getData<std::string>("gate_id") == "traced_gate");
+        CHECK(result->getData<std::string>("gate_type") == "THRESHOLD");
+        CHECK_NEAR(result->getStrength(), 0.8f, 1e-6f);
+    }
+}
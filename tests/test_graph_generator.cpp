@@ -0,0 +1,138 @@
+/**
+ * @file test_graph_generator.cpp
+ * @brief Tests for the synthetic graph generator.
+ */
+
+#include "test.h"
+#include "../include/graph_generator.h"
+#include "../include/network.h"
+#include <set>
+#include <utility>
+
+namespace {
+
+/**
+ * @brief Check two graphs for identical types, edges and layers
+ */
+bool sameGraph(const GraphGenerator::Graph& a, const GraphGenerator::Graph& b) {
+    if (a.types != b.types || a.inputs != b.inputs || a.outputs != b.outputs ||
+        a.edges.size() != b.edges.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.edges.size(); ++i) {
+        if (a.edges[i].source != b.edges[i].source || a.edges[i].target != b.edges[i].target ||
+            a.edges[i].weight != b.edges[i].weight) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Check that a graph has no self-loops, no duplicates and valid ends
+ */
+bool wellFormed(const GraphGenerator::Graph& graph) {
+    std::set<std::pair<uint32_t, uint32_t>> seen;
+    for (const auto& edge : graph.edges) {
+        if (edge.source == edge.target || edge.source >= graph.types.size() ||
+            edge.target >= graph.types.size() || !seen.insert(std::make_pair(edge.source, edge.target)).second) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const GraphGenerator::Topology TOPOLOGIES[] = {
+    GraphGenerator::Topology::ERDOS_RENYI,
+    GraphGenerator::Topology::WATTS_STROGATZ,
+    GraphGenerator::Topology::BARABASI_ALBERT,
+    GraphGenerator::Topology::LAYERED
+};
+
+} // namespace
+
+TEST(same_seed_same_graph) {
+    for (GraphGenerator::Topology topology : TOPOLOGIES) {
+        GraphGenerator::Config config;
+        config.topology = topology;
+        config.neuronCount = 500;
+        config.seed = 42;
+
+        GraphGenerator::Graph first = GraphGenerator::generate(config);
+        GraphGenerator::Graph second = GraphGenerator::generate(config);
+        CHECK(!first.edges.empty());
+        CHECK(sameGraph(first, second));
+        CHECK(wellFormed(first));
+
+        config.seed = 43;
+        CHECK(!sameGraph(first, GraphGenerator::generate(config)));
+    }
+}
+
+TEST(layered_graph_has_sensory_inputs_and_output_outputs) {
+    GraphGenerator::Config config;
+    config.topology = GraphGenerator::Topology::LAYERED;
+    config.neuronCount = 400;
+    config.layerCount = 4;
+    config.layerFanOut = 5;
+    GraphGenerator::Graph graph = GraphGenerator::generate(config);
+
+    CHECK_EQ(graph.types.size(), 400u);
+    CHECK(!graph.inputs.empty());
+    CHECK(!graph.outputs.empty());
+    for (uint32_t input : graph.inputs) {
+        CHECK(graph.types[input] == Neuron::NeuronType::SENSORY);
+    }
+    for (uint32_t output : graph.outputs) {
+        CHECK(graph.types[output] == Neuron::NeuronType::OUTPUT);
+    }
+    for (const auto& edge : graph.edges) {
+        CHECK(edge.source < edge.target);
+    }
+}
+
+TEST(constant_weights) {
+    GraphGenerator::Config config;
+    config.weights = GraphGenerator::WeightDistribution::CONSTANT;
+    config.weightA = 0.3f;
+    GraphGenerator::Graph graph = GraphGenerator::generate(config);
+    for (const auto& edge : graph.edges) {
+        CHECK_EQ(edge.weight, 0.3f);
+    }
+}
+
+TEST(build_matches_graph) {
+    GraphGenerator::Config config;
+    config.neuronCount = 200;
+    config.inputCount = 4;
+    config.outputCount = 3;
+    GraphGenerator::Graph graph = GraphGenerator::generate(config);
+
+    Network network("generated");
+    std::vector<std::shared_ptr<Neuron>> neurons = GraphGenerator::build(graph, network, "g");
+    CHECK_EQ(network.getNeuronCount(), 200u);
+    CHECK_EQ(neurons.size(), 200u);
+    CHECK(network.getNeuron("g17") == neurons[17]);
+    CHECK_EQ(network.getInputNeurons().size(), 4u);
+    CHECK_EQ(network.getOutputNeurons().size(), 3u);
+
+    size_t connections = 0;
+    for (const auto& neuron : neurons) {
+        connections += neuron->getOutputs().size();
+    }
+    CHECK_EQ(connections, graph.edges.size());
+    for (const auto& edge : graph.edges) {
+        CHECK_NEAR(neurons[edge.source]->getConnectionWeight(neurons[edge.target]), edge.weight, 1e-6f);
+    }
+}
+
+TEST(parse_names) {
+    GraphGenerator::Topology topology;
+    CHECK(GraphGenerator::parseTopology("layered", topology));
+    CHECK(topology == GraphGenerator::Topology::LAYERED);
+    CHECK(!GraphGenerator::parseTopology("no_such_topology", topology));
+
+    Neuron::NeuronType type;
+    CHECK(GraphGenerator::parseNeuronType("sensory", type));
+    CHECK(type == Neuron::NeuronType::SENSORY);
+}
@@ -0,0 +1,119 @@
+/**
+ * @file test_integration_kernel.cpp
+ * @brief Tests for the vectorized integration kernel variants.
+ */
+
+#include "test.h"
+#include "../include/integration_kernel.h"
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+const IntegrationKernel::Isa ISAS[] = {
+    IntegrationKernel::Isa::SCALAR,
+    IntegrationKernel::Isa::NEON,
+    IntegrationKernel::Isa::AVX2,
+    IntegrationKernel::Isa::AVX512
+};
+
+/**
+ * @brief Kernel inputs for a range of slots
+ */
+struct Inputs {
+    std::vector<float> potentials;
+    std::vector<float> thresholds;
+    std::vector<float> currents;
+    std::vector<uint8_t> active;
+    std::vector<float> decays;
+
+    Inputs(size_t count, uint32_t seed) {
+        std::mt19937 random(seed);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::uniform_real_distribution<float> current(-0.6f, 1.2f);
+        for (size_t i = 0; i < count; ++i) {
+            potentials.push_back(unit(random));
+            thresholds.push_back(unit(random));
+            currents.push_back(current(random));
+            active.push_back(random() % 4 != 0);
+            decays.push_back(i % 3 == 0 ? 1.0f : unit(random));
+        }
+    }
+};
+
+/**
+ * @brief Run the selected variant over a copy of the inputs
+ */
+void run(const Inputs& inputs, std::vector<float>& potentials, std::vector<uint64_t>& fired) {
+    size_t count = inputs.potentials.size();
+    potentials = inputs.potentials;
+    fired.assign((count + 63) / 64 + 1, ~uint64_t(0));
+    IntegrationKernel::integrate(potentials.data(), inputs.thresholds.data(), inputs.currents.data(),
+                                 inputs.active.data(), inputs.decays.data(), count, fired.data());
+}
+
+} // namespace
+
+TEST(scalar_variant_follows_definition) {
+    IntegrationKernel::Isa previous = IntegrationKernel::getIsa();
+    CHECK(IntegrationKernel::setIsa(IntegrationKernel::Isa::SCALAR));
+
+    Inputs inputs(130, 3);
+    std::vector<float> potentials;
+    std::vector<uint64_t> fired;
+    run(inputs, potentials, fired);
+
+    for (size_t i = 0; i < inputs.potentials.size(); ++i) {
+        bool bit = (fired[i >> 6] >> (i & 63)) & 1;
+        if (!inputs.active[i]) {
+            CHECK_EQ(potentials[i], inputs.potentials[i]);
+            CHECK(!bit);
+            continue;
+        }
+        float expected = inputs.potentials[i] * inputs.decays[i] + inputs.currents[i];
+        expected = expected < 0.0f ? 0.0f : (expected > 1.0f ? 1.0f : expected);
+        CHECK_NEAR(potentials[i], expected, 1e-6f);
+        CHECK_EQ(bit, potentials[i] >= inputs.thresholds[i]);
+    }
+    // Words past the range are left alone
+    CHECK_EQ(fired.back(), ~uint64_t(0));
+
+    IntegrationKernel::setIsa(previous);
+}
+
+TEST(every_variant_matches_scalar) {
+    IntegrationKernel::Isa previous = IntegrationKernel::getIsa();
+    const size_t counts[] = {0, 1, 3, 4, 7, 8, 15, 16, 17, 63, 64, 65, 1000};
+
+    for (size_t count : counts) {
+        Inputs inputs(count, static_cast<uint32_t>(count) + 11);
+        std::vector<float> expectedPotentials;
+        std::vector<uint64_t> expectedFired;
+        IntegrationKernel::setIsa(IntegrationKernel::Isa::SCALAR);
+        run(inputs, expectedPotentials, expectedFired);
+
+        for (IntegrationKernel::Isa isa : ISAS) {
+            if (!IntegrationKernel::setIsa(isa)) {
+                continue;  // Not supported on this CPU
+            }
+            std::vector<float> potentials;
+            std::vector<uint64_t> fired;
+            run(inputs, potentials, fired);
+            CHECK(std::memcmp(potentials.data(), expectedPotentials.data(), count * sizeof(float)) == 0);
+            CHECK(fired == expectedFired);
+        }
+    }
+
+    IntegrationKernel::setIsa(previous);
+}
+
+TEST(detected_variant_is_supported) {
+    IntegrationKernel::Isa previous = IntegrationKernel::getIsa();
+    IntegrationKernel::Isa best = IntegrationKernel::detect();
+    CHECK(IntegrationKernel::setIsa(best));
+    CHECK(IntegrationKernel::getIsa() == best);
+    CHECK(IntegrationKernel::setIsa(IntegrationKernel::Isa::SCALAR));
+    CHECK(IntegrationKernel::getIsaName(IntegrationKernel::Isa::SCALAR) != nullptr);
+    IntegrationKernel::setIsa(previous);
+}
@@ -0,0 +1,115 @@
+/**
+ * @file test_levelized.cpp
+ * @brief Tests for levelized execution of feed-forward regions.
+ */
+
+#include "test.h"
+#include "../include/network.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Build a chain of neurons and record the tick each one fires at
+ */
+std::vector<std::shared_ptr<Neuron>> buildChain(Network& network, int length,
+                                                std::vector<std::vector<uint64_t>>& fires) {
+    std::vector<std::shared_ptr<Neuron>> chain;
+    fires.assign(length, std::vector<uint64_t>());
+    for (int i = 0; i < length; ++i) {
+        chain.push_back(network.createNeuron("c" + std::to_string(i), Neuron::NeuronType::SENSORY));
+        std::vector<uint64_t>* record = &fires[i];
+        Network* raw = &network;
+        chain.back()->onFire([record, raw](std::shared_ptr<Neuron>) { record->push_back(raw->getCurrentTick()); });
+        if (i > 0) {
+            chain[i - 1]->connectTo(chain[i]);
+        }
+    }
+    network.addInputNeuron(chain[0]);
+    return chain;
+}
+
+void run(Network& network, int ticks) {
+    for (int tick = 0; tick < ticks; ++tick) {
+        network.processSignals();
+    }
+}
+
+} // namespace
+
+TEST(feed_forward_chain_crosses_in_one_tick) {
+    Network network("levelized_chain");
+    network.setSchedulingMode(Network::SchedulingMode::LEVELIZED);
+    std::vector<std::vector<uint64_t>> fires;
+    buildChain(network, 6, fires);
+
+    network.injectSignal(Synapse::create("input", Synapse::SynapseType::EXCITATORY, 1.0f), "c0");
+    run(network, 1);
+    for (const auto& record : fires) {
+        CHECK_EQ(record.size(), 1u);
+    }
+
+    // Later ticks do not repeat the wave
+    run(network, 4);
+    for (const auto& record : fires) {
+        CHECK_EQ(record.size(), 1u);
+    }
+}
+
+TEST(dense_chain_takes_one_tick_per_hop) {
+    Network network("dense_chain");
+    std::vector<std::vector<uint64_t>> fires;
+    buildChain(network, 4, fires);
+
+    network.injectSignal(Synapse::create("input", Synapse::SynapseType::EXCITATORY, 1.0f), "c0");
+    run(network, 6);
+    for (size_t i = 0; i < fires.size(); ++i) {
+        CHECK_EQ(fires[i].size(), 1u);
+        if (!fires[i].empty()) {
+            CHECK_EQ(fires[i][0], fires[0][0] + i);
+        }
+    }
+}
+
+TEST(cycle_keeps_its_delay) {
+    Network network("levelized_cycle");
+    network.setSchedulingMode(Network::SchedulingMode::LEVELIZED);
+    auto a = network.createNeuron("a", Neuron::NeuronType::SENSORY);
+    auto b = network.createNeuron("b", Neuron::NeuronType::SENSORY);
+    a->connectTo(b);
+    b->connectTo(a);
+    network.addInputNeuron(a);
+
+    std::vector<uint64_t> fired;
+    b->onFire([&](std::shared_ptr<Neuron>) { fired.push_back(network.getCurrentTick()); });
+    network.injectSignal(Synapse::create("input", Synapse::SynapseType::EXCITATORY, 1.0f), "a");
+    uint64_t start = network.getCurrentTick();
+    run(network, 1);
+    CHECK(fired.empty());
+    run(network, 1);
+    CHECK_EQ(fired.size(), 1u);
+    if (!fired.empty()) {
+        CHECK_EQ(fired[0], start + 1);
+    }
+}
+
+TEST(levels_follow_topology_changes) {
+    Network network("levelized_growth");
+    network.setSchedulingMode(Network::SchedulingMode::LEVELIZED);
+    std::vector<std::vector<uint64_t>> fires;
+    std::vector<std::shared_ptr<Neuron>> chain = buildChain(network, 3, fires);
+    network.injectSignal(Synapse::create("input", Synapse::SynapseType::EXCITATORY, 1.0f), "c0");
+    run(network, 1);
+
+    // Extend the chain; the new neuron joins the same single-tick wave
+    auto tail = network.createNeuron("tail", Neuron::NeuronType::SENSORY);
+    chain.back()->connectTo(tail);
+    int tailFires = 0;
+    tail->onFire([&](std::shared_ptr<Neuron>) { ++tailFires; });
+
+    network.injectSignal(Synapse::create("input", Synapse::SynapseType::EXCITATORY, 1.0f), "c0");
+    run(network, 1);
+    CHECK_EQ(tailFires, 1);
+    CHECK_EQ(fires[2].size(), 2u);
+}
@@ -0,0 +1,59 @@
+/**
+ * @file test_main.cpp
+ * @brief Runner for the cases of one test executable.
+ */
+
+#include "test.h"
+#include <cstring>
+#include <exception>
+
+namespace {
+
+// Failed checks of the running case
+int failures = 0;
+
+} // namespace
+
+std::vector<o3test::Case>& o3test::registry() {
+    static std::vector<Case> cases;
+    return cases;
+}
+
+void o3test::fail(const char* file, int line, const std::string& message) {
+    std::cerr << file << ":" << line << ": " << message << std::endl;
+    ++failures;
+}
+
+int main(int argc, char** argv) {
+    int failed = 0;
+    int run = 0;
+
+    for (const o3test::Case& entry : o3test::registry()) {
+        // Run only the named cases if any are given
+        bool selected = argc < 2;
+        for (int i = 1; i < argc && !selected; ++i) {
+            selected = std::strcmp(argv[i], entry.name) == 0;
+        }
+        if (!selected) {
+            continue;
+        }
+
+        failures = 0;
+        try {
+            entry.function();
+        } catch (const std::exception& error) {
+            o3test::fail(__FILE__, __LINE__, std::string("uncaught exception: ") + error.what());
+        }
+        ++run;
+
+        if (failures) {
+            ++failed;
+            std::cerr << "[FAILED] " << entry.name << std::endl;
+        } else {
+            std::cout << "[ OK ] " << entry.name << std::endl;
+        }
+    }
+
+    std::cout << run - failed << "/" << run << " cases passed" << std::endl;
+    return failed || run == 0 ? 1 : 0;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file test_memory_manager.cpp
+ * @brief Tests for pooled synapse allocation and SynapsePtr ownership.
+ */
+
+#include "test.h"
+#include "../include/synapse.h"
+#include "../include/utils.h"
+#include <thread>
+#include <vector>
+
+TEST(active_count_follows_handles) {
+    MemoryManager& memory = MemoryManager::getInstance();
+    size_t before = memory.getActiveSynapseCount();
+
+    {
+        SynapsePtr first = Synapse::create(Synapse::SynapseType::EXCITATORY, 1.0f);
+        CHECK_EQ(memory.getActiveSynapseCount(), before + 1);
+
+        SynapsePtr copy = first;
+        SynapsePtr moved = std::move(copy);
+        CHECK(!copy);
+        CHECK(moved.get() == first.get());
+        CHECK_EQ(memory.getActiveSynapseCount(), before + 1);
+
+        first.reset();
+        CHECK(!first);
+        CHECK_EQ(memory.getActiveSynapseCount(), before + 1);
+    }
+
+    CHECK_EQ(memory.getActiveSynapseCount(), before);
+}
+
+TEST(total_count_and_reset) {
+    MemoryManager& memory = MemoryManager::getInstance();
+    memory.resetStats();
+    CHECK_EQ(memory.getTotalSynapseCount(), 0u);
+
+    std::vector<SynapsePtr> synapses;
+    for (int i = 0; i < 100; ++i) {
+        synapses.push_back(Synapse::create(Synapse::SynapseType::EXCITATORY, 1.0f));
+    }
+    CHECK_EQ(memory.getTotalSynapseCount(), 100u);
+    CHECK(memory.getReservedSynapseCount() >= memory.getActiveSynapseCount());
+
+    synapses.clear();
+    CHECK_EQ(memory.getTotalSynapseCount(), 100u);
+}
+
+TEST(blocks_are_reused) {
+    MemoryManager& memory = MemoryManager::getInstance();
+    auto churn = []() {
+        std::vector<SynapsePtr> batch;
+        for (int i = 0; i < 1000; ++i) {
+            batch.push_back(Synapse::create(Synapse::SynapseType::EXCITATORY, 1.0f));
+        }
+    };
+
+    // After one round the freed blocks cover every later round
+    churn();
+    size_t reserved = memory.getReservedSynapseCount();
+    for (int round = 0; round < 10; ++round) {
+        churn();
+    }
+    CHECK_EQ(memory.getReservedSynapseCount(), reserved);
+}
+
+TEST(blocks_freed_on_another_thread) {
+    MemoryManager& memory = MemoryManager::getInstance();
+    size_t before = memory.getActiveSynapseCount();
+
+    std::vector<SynapsePtr> synapses;
+    for (int i = 0; i < 500; ++i) {
+        synapses.push_back(Synapse::create(Synapse::SynapseType::EXCITATORY, 1.0f));
+    }
+    CHECK_EQ(memory.getActiveSynapseCount(), before + 500);
+
+    std::thread releaser([&synapses]() { synapses.clear(); });
+    releaser.join();
+    CHECK_EQ(memory.getActiveSynapseCount(), before);
+}
@@ -0,0 +1,139 @@
+/**
+ * @file test_network_builder.cpp
+ * @brief Tests for bulk network construction.
+ */
+
+#include "test.h"
+#include "../include/network.h"
+#include "../include/network_builder.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Compare neurons, connections and layers of two networks
+ */
+bool sameNetwork(const Network& a, const Network& b) {
+    if (a.getNeuronCount() != b.getNeuronCount()) {
+        return false;
+    }
+    for (const auto& neuron : a.getAllNeurons()) {
+        auto other = b.getNeuron(neuron->getId());
+        if (!other || other->getType() != neuron->getType()) {
+            return false;
+        }
+        auto outputs = neuron->getOutputs();
+        auto otherOutputs = other->getOutputs();
+        if (outputs.size() != otherOutputs.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < outputs.size(); ++i) {
+            if (outputs[i]->getId() != otherOutputs[i]->getId() ||
+                neuron->getConnectionWeight(outputs[i]) != other->getConnectionWeight(otherOutputs[i]) ||
+                neuron->getConnectionDelay(outputs[i]) != other->getConnectionDelay(otherOutputs[i])) {
+                return false;
+            }
+        }
+    }
+
+    auto ids = [](const std::vector<std::shared_ptr<Neuron>>& neurons) {
+        std::vector<std::string> result;
+        for (const auto& neuron : neurons) {
+            result.push_back(neuron->getId());
+        }
+        return result;
+    };
+    return ids(a.getInputNeurons()) == ids(b.getInputNeurons()) &&
+           ids(a.getOutputNeurons()) == ids(b.getOutputNeurons());
+}
+
+} // namespace
+
+TEST(builder_matches_incremental_construction) {
+    const uint32_t count = 50;
+    std::vector<NetworkBuilder::EdgeSpec> edges;
+    for (uint32_t i = 0; i < count; ++i) {
+        edges.push_back(NetworkBuilder::EdgeSpec(i, (i * 7 + 3) % count, 0.1f + 0.01f * i, 1 + i % 4));
+        edges.push_back(NetworkBuilder::EdgeSpec(i, (i * 11 + 5) % count, 0.5f, 2));
+    }
+    // Self-loop, repeated connection and out-of-range position
+    edges.push_back(NetworkBuilder::EdgeSpec(4, 4, 0.9f, 1));
+    edges.push_back(NetworkBuilder::EdgeSpec(0, 3, 0.7f, 3));
+    edges.push_back(NetworkBuilder::EdgeSpec(1, count + 10, 0.7f, 1));
+
+    Network incremental("incremental");
+    std::vector<std::shared_ptr<Neuron>> neurons;
+    for (uint32_t i = 0; i < count; ++i) {
+        neurons.push_back(incremental.createNeuron("b" + std::to_string(i),
+                                                   i % 5 == 0 ? Neuron::NeuronType::SENSORY
+                                                              : Neuron::NeuronType::PROCESSING));
+    }
+    for (const auto& edge : edges) {
+        if (edge.source >= count || edge.target >= count) {
+            continue;
+        }
+        incremental.connectNeurons(neurons[edge.source]->getId(), neurons[edge.target]->getId(), edge.weight);
+        neurons[edge.source]->setConnectionDelay(neurons[edge.target], edge.delay);
+    }
+    incremental.addInputNeuron(neurons[0]);
+    incremental.addOutputNeuron(neurons[count - 1]);
+
+    Network bulk("bulk");
+    NetworkBuilder builder(bulk);
+    builder.reserve(count, edges.size());
+    std::vector<NetworkBuilder::NeuronSpec> specs;
+    for (uint32_t i = 0; i < count; ++i) {
+        specs.push_back(NetworkBuilder::NeuronSpec("b" + std::to_string(i),
+                                                   i % 5 == 0 ? Neuron::NeuronType::SENSORY
+                                                              : Neuron::NeuronType::PROCESSING));
+    }
+    CHECK_EQ(builder.addNeurons(specs), 0u);
+    builder.addEdges(edges);
+    builder.addInput(0);
+    builder.addOutput(count - 1);
+    CHECK_EQ(builder.getNeuronCount(), static_cast<size_t>(count));
+    CHECK_EQ(builder.getEdgeCount(), edges.size());
+
+    std::vector<std::shared_ptr<Neuron>> built = builder.finalize();
+    CHECK_EQ(built.size(), static_cast<size_t>(count));
+    CHECK_EQ(builder.getNeuronCount(), 0u);
+    CHECK(sameNetwork(incremental, bulk));
+    CHECK(sameNetwork(bulk, incremental));
+    CHECK_NEAR(built[0]->getConnectionWeight(built[3]), 0.7f, 1e-6f);
+}
+
+TEST(builder_reuses_existing_neurons) {
+    Network network("reuse");
+    auto existing = network.createNeuron("existing", Neuron::NeuronType::MEMORY);
+
+    NetworkBuilder builder(network);
+    uint32_t first = builder.addNeuron("existing", Neuron::NeuronType::PROCESSING);
+    uint32_t second = builder.addNeuron("fresh", Neuron::NeuronType::PROCESSING);
+    builder.addEdge(first, second, 0.4f);
+    std::vector<std::shared_ptr<Neuron>> built = builder.finalize();
+
+    CHECK_EQ(network.getNeuronCount(), 2u);
+    CHECK(built[first] == existing);
+    CHECK(existing->getType() == Neuron::NeuronType::MEMORY);
+    CHECK_NEAR(existing->getConnectionWeight(built[second]), 0.4f, 1e-6f);
+}
+
+TEST(built_network_processes_signals) {
+    Network network("signals");
+    NetworkBuilder builder(network);
+    uint32_t input = builder.addNeuron("in", Neuron::NeuronType::SENSORY);
+    uint32_t output = builder.addNeuron("out", Neuron::NeuronType::SENSORY);
+    builder.addEdge(input, output, 1.0f);
+    builder.addInput(input);
+    builder.addOutput(output);
+    std::vector<std::shared_ptr<Neuron>> built = builder.finalize();
+
+    int fires = 0;
+    built[output]->onFire([&](std::shared_ptr<Neuron>) { ++fires; });
+    network.injectSignal(Synapse::create("input", Synapse::SynapseType::EXCITATORY, 1.0f), "in");
+    for (int tick = 0; tick < 4; ++tick) {
+        network.processSignals();
+    }
+    CHECK_EQ(fires, 1);
+}
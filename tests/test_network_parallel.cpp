@@ -0,0 +1,97 @@
+/**
+ * @file test_network_parallel.cpp
+ * @brief Tests for ticks split over worker threads.
+ */
+
+#include "test.h"
+#include "../include/network.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Run a layered network and count how often each neuron fires
+ * @param workers Worker threads, 0 for a serial tick
+ * @return Fire count per neuron, in creation order
+ */
+std::vector<int> runLayers(size_t workers) {
+    Network network("layers");
+    if (workers > 0) {
+        network.setParallelism(workers, 1);
+    }
+
+    const int width = 16;
+    const int depth = 4;
+    std::vector<std::shared_ptr<Neuron>> neurons;
+    for (int layer = 0; layer < depth; ++layer) {
+        for (int i = 0; i < width; ++i) {
+            neurons.push_back(network.createNeuron("n" + std::to_string(layer) + "_" + std::to_string(i),
+                                                   Neuron::NeuronType::PROCESSING));
+        }
+    }
+    for (int layer = 1; layer < depth; ++layer) {
+        for (int i = 0; i < width; ++i) {
+            for (int j = 0; j < width; j += 3) {
+                neurons[(layer - 1) * width + (i + j) % width]->connectTo(neurons[layer * width + i], 0.4f);
+            }
+        }
+    }
+    for (int i = 0; i < width; ++i) {
+        network.addInputNeuron(neurons[i]);
+        network.addOutputNeuron(neurons[(depth - 1) * width + i]);
+    }
+    // One neuron in both roles
+    network.addOutputNeuron(neurons[0]);
+
+    std::vector<int> fires(neurons.size(), 0);
+    for (size_t i = 0; i < neurons.size(); ++i) {
+        neurons[i]->onFire([&fires, i](std::shared_ptr<Neuron>) { ++fires[i]; });
+    }
+
+    for (int tick = 0; tick < 12; ++tick) {
+        if (tick % 3 == 0) {
+            network.injectSignal(Synapse::create("input", Synapse::SynapseType::EXCITATORY, 1.0f));
+        }
+        network.processSignals();
+    }
+    return fires;
+}
+
+} // namespace
+
+TEST(input_and_output_neuron_fires_once_per_signal) {
+    Network network("roles");
+    network.setParallelism(4, 1);
+    auto both = network.createNeuron("both", Neuron::NeuronType::SENSORY);
+    network.addInputNeuron(both);
+    network.addOutputNeuron(both);
+    for (int i = 0; i < 8; ++i) {
+        auto other = network.createNeuron("other" + std::to_string(i), Neuron::NeuronType::SENSORY);
+        network.addInputNeuron(other);
+        network.addOutputNeuron(other);
+    }
+
+    int fires = 0;
+    both->onFire([&](std::shared_ptr<Neuron>) { ++fires; });
+
+    for (int round = 0; round < 50; ++round) {
+        network.injectSignal(Synapse::create("input", Synapse::SynapseType::EXCITATORY, 1.0f), "both");
+        network.processSignals();
+        network.processSignals();
+    }
+    CHECK_EQ(fires, 50);
+}
+
+TEST(parallel_tick_matches_serial_tick) {
+    std::vector<int> serial = runLayers(0);
+    int total = 0;
+    for (int count : serial) {
+        total += count;
+    }
+    CHECK(total > 0);
+
+    for (int run = 0; run < 5; ++run) {
+        CHECK(runLayers(4) == serial);
+    }
+}
@@ -0,0 +1,104 @@
+/**
+ * @file test_network_roles.cpp
+ * @brief Tests for input and output layer roles and the tick order.
+ */
+
+#include "test.h"
+#include "../include/network.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+void inject(Network& network, const std::string& target) {
+    network.injectSignal(Synapse::create("input", Synapse::SynapseType::EXCITATORY, 1.0f), target);
+}
+
+} // namespace
+
+TEST(inputs_hidden_outputs_fire_in_order) {
+    const Network::SchedulingMode modes[] = {Network::SchedulingMode::DENSE,
+                                             Network::SchedulingMode::EVENT_DRIVEN};
+    for (Network::SchedulingMode mode : modes) {
+        Network network("ordered");
+        network.setSchedulingMode(mode);
+
+        // Created in reverse of the expected order
+        auto output = network.createNeuron("out", Neuron::NeuronType::SENSORY);
+        auto hidden = network.createNeuron("mid", Neuron::NeuronType::SENSORY);
+        auto input = network.createNeuron("in", Neuron::NeuronType::SENSORY);
+        network.addOutputNeuron(output);
+        network.addInputNeuron(input);
+
+        std::vector<std::string> order;
+        for (const auto& neuron : network.getAllNeurons()) {
+            std::string id = neuron->getId();
+            neuron->onFire([&order, id](std::shared_ptr<Neuron>) { order.push_back(id); });
+        }
+
+        inject(network, "out");
+        inject(network, "mid");
+        inject(network, "in");
+        network.processSignals();
+
+        std::vector<std::string> expected;
+        expected.push_back("in");
+        expected.push_back("mid");
+        expected.push_back("out");
+        CHECK(order == expected);
+    }
+}
+
+TEST(layers_have_no_duplicates) {
+    Network network("layers");
+    auto neuron = network.createNeuron("both", Neuron::NeuronType::SENSORY);
+    network.addInputNeuron(neuron);
+    network.addInputNeuron(neuron);
+    network.addOutputNeuron(neuron);
+    network.addOutputNeuron(neuron);
+
+    CHECK_EQ(network.getInputNeurons().size(), 1u);
+    CHECK_EQ(network.getOutputNeurons().size(), 1u);
+
+    int fires = 0;
+    neuron->onFire([&](std::shared_ptr<Neuron>) { ++fires; });
+    inject(network, "both");
+    network.processSignals();
+    CHECK_EQ(fires, 1);
+}
+
+TEST(adding_to_a_layer_adopts_the_neuron) {
+    Network network("adopting");
+    auto outside = std::make_shared<Neuron>("outsider", Neuron::NeuronType::SENSORY);
+    network.addInputNeuron(outside);
+
+    CHECK(network.getNeuron("outsider") == outside);
+    CHECK_EQ(network.getInputNeurons().size(), 1u);
+
+    // A different neuron with a taken ID is refused
+    auto impostor = std::make_shared<Neuron>("outsider", Neuron::NeuronType::SENSORY);
+    network.addOutputNeuron(impostor);
+    CHECK(network.getOutputNeurons().empty());
+}
+
+TEST(removed_neuron_leaves_its_layers) {
+    Network network("removing");
+    auto input = network.createNeuron("in", Neuron::NeuronType::SENSORY);
+    auto output = network.createNeuron("out", Neuron::NeuronType::SENSORY);
+    input->connectTo(output);
+    network.addInputNeuron(input);
+    network.addOutputNeuron(output);
+    network.processSignals();
+
+    CHECK(network.removeNeuron("out"));
+    CHECK(network.getOutputNeurons().empty());
+    CHECK_EQ(network.getInputNeurons().size(), 1u);
+
+    // The next ticks no longer run the removed neuron
+    int fires = 0;
+    output->onFire([&](std::shared_ptr<Neuron>) { ++fires; });
+    inject(network, "in");
+    network.processSignals();
+    network.processSignals();
+    CHECK_EQ(fires, 0);
+}
@@ -0,0 +1,148 @@
+/**
+ * @file test_network_snapshot.cpp
+ * @brief Tests for saving and loading binary network snapshots.
+ */
+
+#include "test.h"
+#include "../include/network_snapshot.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+namespace {
+
+const char* SNAPSHOT_PATH = "test_network_snapshot.o3snap";
+
+/**
+ * @brief Build a small network with every kind of per-neuron state
+ */
+void populate(Network& network) {
+    auto sensor = network.createNeuron("sensor", Neuron::NeuronType::SENSORY);
+    auto hidden = network.createNeuron("hidden", Neuron::NeuronType::PROCESSING);
+    auto memory = network.createNeuron("memory", Neuron::NeuronType::MEMORY);
+    auto output = network.createNeuron("output", Neuron::NeuronType::OUTPUT);
+
+    sensor->connectTo(hidden, 0.8f);
+    hidden->connectTo(memory, 0.3f);
+    hidden->connectTo(output, 0.6f);
+    hidden->setConnectionDelay(output, 4);
+    memory->connectTo(output, 0.2f);
+
+    hidden->addTag("visual");
+    hidden->addTag("edge");
+    memory->setMetadata("unit", "cm");
+    memory->setThreshold(0.9f);
+    hidden->createGate(NeuronGate::GateType::THRESHOLD);
+
+    network.addInputNeuron(sensor);
+    network.addOutputNeuron(output);
+}
+
+} // namespace
+
+TEST(save_and_load_round_trip) {
+    Network network("snapshot_source");
+    populate(network);
+    network.injectSignal(Synapse::create("weak", Synapse::SynapseType::EXCITATORY, 0.2f), "memory");
+    network.processSignals();
+    float potential = network.getNeuron("memory")->getPotential();
+    CHECK(potential > 0.0f);
+
+    std::string error;
+    CHECK(NetworkSnapshot::save(network, SNAPSHOT_PATH, &error));
+    std::shared_ptr<Network> loaded = NetworkSnapshot::load(SNAPSHOT_PATH, &error);
+    std::remove(SNAPSHOT_PATH);
+    CHECK(loaded != nullptr);
+    if (!loaded) {
+        return;
+    }
+
+    CHECK_EQ(loaded->getId(), std::string("snapshot_source"));
+    CHECK_EQ(loaded->getNeuronCount(), 4u);
+    auto hidden = loaded->getNeuron("hidden");
+    auto memory = loaded->getNeuron("memory");
+    auto output = loaded->getNeuron("output");
+    CHECK(hidden && memory && output);
+    if (!hidden || !memory || !output) {
+        return;
+    }
+
+    CHECK(memory->getType() == Neuron::NeuronType::MEMORY);
+    CHECK(hidden->hasTag("visual"));
+    CHECK(hidden->hasTag("edge"));
+    CHECK_EQ(memory->getMetadata("unit"), std::string("cm"));
+    CHECK_NEAR(memory->getThreshold(), 0.9f, 1e-6f);
+    CHECK_NEAR(memory->getPotential(), potential, 1e-6f);
+
+    CHECK_NEAR(loaded->getNeuron("sensor")->getConnectionWeight(hidden), 0.8f, 1e-6f);
+    CHECK_NEAR(hidden->getConnectionWeight(output), 0.6f, 1e-6f);
+    CHECK_EQ(hidden->getConnectionDelay(output), 4u);
+    CHECK_EQ(hidden->getOutputs().size(), 2u);
+
+    CHECK_EQ(loaded->getInputNeurons().size(), 1u);
+    CHECK_EQ(loaded->getOutputNeurons().size(), 1u);
+    CHECK_EQ(loaded->getNeuronsByTag("visual").size(), 1u);
+}
+
+TEST(tier_extras_round_trip) {
+    auto conscious = NetworkFactory::createNetwork(NetworkFactory::NetworkType::CONSCIOUS, "aware");
+    conscious->createNeuron("focus", Neuron::NeuronType::PROCESSING);
+    std::static_pointer_cast<ConsciousNetwork>(conscious)->setAttentionFocus("focus");
+
+    CHECK(NetworkSnapshot::save(*conscious, SNAPSHOT_PATH));
+    NetworkSnapshot snapshot;
+    CHECK(snapshot.open(SNAPSHOT_PATH));
+    CHECK(snapshot.getNetworkType() == NetworkFactory::NetworkType::CONSCIOUS);
+    CHECK_EQ(snapshot.getNeuronCount(), 1u);
+    snapshot.close();
+
+    std::shared_ptr<Network> loaded = NetworkSnapshot::load(SNAPSHOT_PATH);
+    std::remove(SNAPSHOT_PATH);
+    auto restored = std::dynamic_pointer_cast<ConsciousNetwork>(loaded);
+    CHECK(restored != nullptr);
+    if (restored) {
+        CHECK_EQ(restored->getAttentionFocus(), std::string("focus"));
+    }
+}
+
+TEST(restored_network_keeps_behaviour) {
+    Network original("behaviour");
+    populate(original);
+    CHECK(NetworkSnapshot::save(original, SNAPSHOT_PATH));
+    std::shared_ptr<Network> loaded = NetworkSnapshot::load(SNAPSHOT_PATH);
+    std::remove(SNAPSHOT_PATH);
+    CHECK(loaded != nullptr);
+    if (!loaded) {
+        return;
+    }
+
+    int originalFires = 0;
+    int loadedFires = 0;
+    original.getNeuron("output")->onFire([&](std::shared_ptr<Neuron>) { ++originalFires; });
+    loaded->getNeuron("output")->onFire([&](std::shared_ptr<Neuron>) { ++loadedFires; });
+    for (int tick = 0; tick < 12; ++tick) {
+        if (tick % 4 == 0) {
+            original.injectSignal(Synapse::create("input", Synapse::SynapseType::EXCITATORY, 1.0f), "sensor");
+            loaded->injectSignal(Synapse::create("input", Synapse::SynapseType::EXCITATORY, 1.0f), "sensor");
+        }
+        original.processSignals();
+        loaded->processSignals();
+    }
+    CHECK(originalFires > 0);
+    CHECK_EQ(loadedFires, originalFires);
+}
+
+TEST(invalid_files_are_rejected) {
+    std::string error;
+    CHECK(NetworkSnapshot::load("no_such_snapshot.o3snap", &error) == nullptr);
+    CHECK(!error.empty());
+
+    {
+        std::ofstream garbage(SNAPSHOT_PATH, std::ios::binary);
+        garbage << "not a snapshot at all, just some text";
+    }
+    error.clear();
+    CHECK(NetworkSnapshot::load(SNAPSHOT_PATH, &error) == nullptr);
+    CHECK(!error.empty());
+    std::remove(SNAPSHOT_PATH);
+}
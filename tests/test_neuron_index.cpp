@@ -0,0 +1,167 @@
+/**
+ * @file test_neuron_index.cpp
+ * @brief Tests for type and tag queries over the neuron index.
+ */
+
+#include "test.h"
+#include "../include/network.h"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+const Neuron::NeuronType TYPES[] = {
+    Neuron::NeuronType::SENSORY,
+    Neuron::NeuronType::PROCESSING,
+    Neuron::NeuronType::MEMORY,
+    Neuron::NeuronType::OUTPUT,
+    Neuron::NeuronType::REGULATORY
+};
+
+std::vector<std::string> ids(const std::vector<std::shared_ptr<Neuron>>& neurons) {
+    std::vector<std::string> result;
+    for (const auto& neuron : neurons) {
+        result.push_back(neuron->getId());
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+} // namespace
+
+TEST(list_and_bitset_type_postings_combine) {
+    // PROCESSING turns into a bitset, MEMORY stays a one-slot list
+    Network network("mixed_postings");
+    for (int i = 0; i < 100; ++i) {
+        network.createNeuron("p" + std::to_string(i), Neuron::NeuronType::PROCESSING)->addTag("x");
+    }
+    network.createNeuron("m", Neuron::NeuronType::MEMORY)->addTag("x");
+
+    CHECK_EQ(network.getNeuronsByTag("x").size(), 101u);
+    CHECK_EQ(network.findNeurons(NeuronQuery()).size(), 101u);
+    CHECK_EQ(network.getNeuronsByType(Neuron::NeuronType::MEMORY).size(), 1u);
+
+    auto memory = network.findNeurons(NeuronQuery().withTag("x").notOfType(Neuron::NeuronType::PROCESSING));
+    CHECK_EQ(memory.size(), 1u);
+    if (!memory.empty()) {
+        CHECK_EQ(memory[0]->getId(), std::string("m"));
+    }
+    CHECK_EQ(network.findNeurons(NeuronQuery()
+                                     .ofType(Neuron::NeuronType::MEMORY)
+                                     .ofType(Neuron::NeuronType::PROCESSING))
+                 .size(),
+             101u);
+}
+
+TEST(queries_match_brute_force) {
+    Network network("random_postings");
+    std::mt19937 random(7);
+    const char* tagNames[] = {"common", "half", "rare", "single"};
+
+    std::vector<std::shared_ptr<Neuron>> neurons;
+    for (int i = 0; i < 600; ++i) {
+        // Skewed type shares give both list and bitset postings
+        uint32_t pick = random() % 100;
+        Neuron::NeuronType type = pick < 80 ? Neuron::NeuronType::PROCESSING
+                                : pick < 95 ? Neuron::NeuronType::MEMORY
+                                : pick < 99 ? Neuron::NeuronType::SENSORY
+                                            : Neuron::NeuronType::OUTPUT;
+        auto neuron = network.createNeuron("r" + std::to_string(i), type);
+        if (random() % 10 < 9) neuron->addTag("common");
+        if (random() % 2) neuron->addTag("half");
+        if (random() % 100 < 2) neuron->addTag("rare");
+        if (i == 321) neuron->addTag("single");
+        neurons.push_back(neuron);
+    }
+    for (int i = 0; i < 600; i += 7) {
+        network.removeNeuron("r" + std::to_string(i));
+    }
+    std::vector<std::shared_ptr<Neuron>> members = network.getAllNeurons();
+
+    for (int round = 0; round < 300; ++round) {
+        NeuronQuery query;
+        std::vector<std::string> required;
+        std::vector<std::string> excluded;
+        uint32_t allowedMask = 0;
+        uint32_t excludedMask = 0;
+        for (const char* tag : tagNames) {
+            uint32_t pick = random() % 6;
+            if (pick == 0) {
+                query.withTag(tag);
+                required.push_back(tag);
+            } else if (pick == 1) {
+                query.withoutTag(tag);
+                excluded.push_back(tag);
+            }
+        }
+        for (Neuron::NeuronType type : TYPES) {
+            uint32_t pick = random() % 5;
+            uint32_t bit = 1u << static_cast<uint32_t>(type);
+            if (pick == 0) {
+                query.ofType(type);
+                allowedMask |= bit;
+            } else if (pick == 1) {
+                query.notOfType(type);
+                excludedMask |= bit;
+            }
+        }
+
+        std::vector<std::shared_ptr<Neuron>> expected;
+        for (const auto& neuron : members) {
+            uint32_t bit = 1u << static_cast<uint32_t>(neuron->getType());
+            bool keep = (allowedMask == 0 || (allowedMask & bit)) && !(excludedMask & bit);
+            for (const auto& tag : required) {
+                keep = keep && neuron->hasTag(tag);
+            }
+            for (const auto& tag : excluded) {
+                keep = keep && !neuron->hasTag(tag);
+            }
+            if (keep) {
+                expected.push_back(neuron);
+            }
+        }
+
+        CHECK(ids(network.findNeurons(query)) == ids(expected));
+    }
+}
+
+TEST(merged_outside_neurons_are_not_returned) {
+    Network network("members");
+    auto member = network.createNeuron("member", Neuron::NeuronType::PROCESSING);
+    member->addTag("shared_tag");
+
+    // Connecting merges these neurons into the network's core without
+    // making them members; one of them is not owned by a shared_ptr
+    auto outside = std::make_shared<Neuron>("outside", Neuron::NeuronType::PROCESSING);
+    outside->addTag("shared_tag");
+    CHECK(member->connectTo(outside));
+    Neuron local("local", Neuron::NeuronType::MEMORY);
+    local.addTag("shared_tag");
+    CHECK(local.connectTo(member));
+    CHECK(local.getCore() == member->getCore());
+
+    CHECK_EQ(network.getNeuronCount(), 1u);
+    auto tagged = network.getNeuronsByTag("shared_tag");
+    CHECK_EQ(tagged.size(), 1u);
+    CHECK(tagged.size() == 1 && tagged[0] == member);
+    CHECK_EQ(network.findNeurons(NeuronQuery()).size(), 1u);
+    CHECK(network.getNeuronsByType(Neuron::NeuronType::MEMORY).empty());
+
+    // Adding the outside neuron makes it a member
+    CHECK(network.addNeuron(outside));
+    CHECK_EQ(network.getNeuronsByTag("shared_tag").size(), 2u);
+}
+
+TEST(removed_neurons_leave_queries) {
+    Network network("removal");
+    network.createNeuron("keep", Neuron::NeuronType::SENSORY)->addTag("t");
+    auto removed = network.createNeuron("drop", Neuron::NeuronType::SENSORY);
+    removed->addTag("t");
+
+    CHECK(network.removeNeuron("drop"));
+    CHECK_EQ(network.getNeuronsByTag("t").size(), 1u);
+    CHECK_EQ(network.getNeuronsByType(Neuron::NeuronType::SENSORY).size(), 1u);
+    CHECK(removed->hasTag("t"));
+}
@@ -0,0 +1,95 @@
+/**
+ * @file test_neuron_model.cpp
+ * @brief Tests for the accumulate and leaky integrate-and-fire models.
+ */
+
+#include "test.h"
+#include "../include/network.h"
+#include <cmath>
+
+namespace {
+
+void inject(Network& network, const std::string& target, float strength) {
+    network.injectSignal(Synapse::create("input", Synapse::SynapseType::EXCITATORY, strength), target);
+}
+
+} // namespace
+
+TEST(decay_follows_time_constant) {
+    NeuronModel model = NeuronModel::leakyIntegrateAndFire(10.0f, 2, 0.1f, 0.5f);
+    CHECK(model.getKind() == NeuronModel::Kind::LEAKY_INTEGRATE_AND_FIRE);
+    CHECK_EQ(model.getDecay(0), 1.0f);
+    CHECK_NEAR(model.getDecay(4), std::exp(-0.2f), 1e-6f);
+    CHECK_NEAR(model.getDecay(100000), std::exp(-5000.0f), 1e-6f);
+    CHECK_EQ(model.getRefractoryTicks(), 2u);
+    CHECK_NEAR(model.getResetPotential(), 0.1f, 0.0f);
+
+    NeuronModel accumulate;
+    CHECK(accumulate.getKind() == NeuronModel::Kind::ACCUMULATE);
+    CHECK_EQ(accumulate.getDecay(1000), 1.0f);
+}
+
+TEST(silent_neuron_decays_lazily) {
+    Network network("leaky");
+    network.setNeuronModel(NeuronModel::leakyIntegrateAndFire(10.0f, 0));
+    auto cell = network.createNeuron("cell", Neuron::NeuronType::SENSORY);
+    cell->setThreshold(0.95f);
+    network.addInputNeuron(cell);
+
+    inject(network, "cell", 0.5f);
+    network.processSignals();
+    float charged = cell->getPotential();
+    CHECK(charged > 0.0f);
+
+    for (int tick = 0; tick < 5; ++tick) {
+        network.processSignals();
+    }
+    CHECK_NEAR(cell->getPotential(), charged * std::exp(-0.5f), 1e-5f);
+    CHECK(cell->getState() != Neuron::NeuronState::REFRACTORY);
+}
+
+TEST(accumulate_model_keeps_potential) {
+    Network network("accumulating");
+    auto cell = network.createNeuron("cell", Neuron::NeuronType::SENSORY);
+    cell->setThreshold(0.95f);
+    network.addInputNeuron(cell);
+
+    inject(network, "cell", 0.5f);
+    network.processSignals();
+    float charged = cell->getPotential();
+    for (int tick = 0; tick < 5; ++tick) {
+        network.processSignals();
+    }
+    CHECK_EQ(cell->getPotential(), charged);
+}
+
+TEST(refractory_period_blocks_input) {
+    const uint32_t refractory = 3;
+    Network network("refractory");
+    network.setNeuronModel(NeuronModel::leakyIntegrateAndFire(20.0f, refractory, 0.0f));
+    auto cell = network.createNeuron("cell", Neuron::NeuronType::SENSORY);
+    network.addInputNeuron(cell);
+
+    int fires = 0;
+    cell->onFire([&](std::shared_ptr<Neuron>) { ++fires; });
+
+    inject(network, "cell", 1.0f);
+    network.processSignals();
+    CHECK_EQ(fires, 1);
+    CHECK(cell->getState() == Neuron::NeuronState::REFRACTORY);
+    CHECK_EQ(cell->getPotential(), 0.0f);
+
+    // Input arriving during the refractory period is dropped
+    for (uint32_t tick = 1; tick < refractory; ++tick) {
+        inject(network, "cell", 1.0f);
+        network.processSignals();
+    }
+    CHECK_EQ(fires, 1);
+
+    // Once it is over the neuron fires again
+    for (int tick = 0; tick < 3; ++tick) {
+        inject(network, "cell", 1.0f);
+        network.processSignals();
+    }
+    CHECK_EQ(fires, 2);
+}
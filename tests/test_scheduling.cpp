@@ -0,0 +1,92 @@
+/**
+ * @file test_scheduling.cpp
+ * @brief Tests for dense and event-driven tick scheduling.
+ */
+
+#include "test.h"
+#include "../include/graph_generator.h"
+#include "../include/network.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+typedef std::vector<std::pair<uint64_t, std::string>> Trace;
+
+/**
+ * @brief Run a random recurrent network and record every firing
+ * @param mode Scheduling mode for the whole run
+ * @param switchAt Tick at which to switch to the other sparse mode, or -1
+ */
+Trace runTrace(Network::SchedulingMode mode, int switchAt = -1) {
+    GraphGenerator::Config config;
+    config.neuronCount = 300;
+    config.meanDegree = 4;
+    config.weightA = 0.2f;
+    config.weightB = 0.7f;
+    config.inputCount = 10;
+    config.outputCount = 10;
+    config.seed = 5;
+    std::shared_ptr<Network> network = GraphGenerator::createNetwork(config, "scheduled");
+    network->setNeuronModel(NeuronModel::leakyIntegrateAndFire(8.0f, 2));
+    network->setSchedulingMode(mode);
+
+    Trace trace;
+    Network* raw = network.get();
+    for (const auto& neuron : network->getAllNeurons()) {
+        std::string id = neuron->getId();
+        neuron->onFire([&trace, raw, id](std::shared_ptr<Neuron>) {
+            trace.push_back(std::make_pair(raw->getCurrentTick(), id));
+        });
+    }
+
+    std::vector<std::shared_ptr<Neuron>> inputs = network->getInputNeurons();
+    for (int tick = 0; tick < 40; ++tick) {
+        if (tick == switchAt) {
+            network->setSchedulingMode(Network::SchedulingMode::EVENT_DRIVEN);
+        }
+        if (tick % 5 == 0) {
+            for (size_t i = 0; i < inputs.size(); i += 2) {
+                network->injectSignal(Synapse::create("input", Synapse::SynapseType::EXCITATORY, 1.0f),
+                                      inputs[i]->getId());
+            }
+        }
+        network->processSignals();
+    }
+    return trace;
+}
+
+} // namespace
+
+TEST(event_driven_matches_dense) {
+    Trace dense = runTrace(Network::SchedulingMode::DENSE);
+    CHECK(dense.size() > 20);
+    CHECK(runTrace(Network::SchedulingMode::EVENT_DRIVEN) == dense);
+}
+
+TEST(switching_mode_mid_run_matches_dense) {
+    Trace dense = runTrace(Network::SchedulingMode::DENSE);
+    CHECK(runTrace(Network::SchedulingMode::DENSE, 17) == dense);
+}
+
+TEST(event_driven_tracks_new_neurons) {
+    Network network("growing");
+    network.setSchedulingMode(Network::SchedulingMode::EVENT_DRIVEN);
+    auto input = network.createNeuron("in", Neuron::NeuronType::SENSORY);
+    network.addInputNeuron(input);
+    network.processSignals();
+
+    // A neuron connected after the first tick still runs once it has input
+    auto late = network.createNeuron("late", Neuron::NeuronType::SENSORY);
+    input->connectTo(late);
+    int fires = 0;
+    late->onFire([&](std::shared_ptr<Neuron>) { ++fires; });
+
+    network.injectSignal(Synapse::create("input", Synapse::SynapseType::EXCITATORY, 1.0f), "in");
+    for (int tick = 0; tick < 3; ++tick) {
+        network.processSignals();
+    }
+    CHECK_EQ(fires, 1);
+    CHECK(network.getSchedulingMode() == Network::SchedulingMode::EVENT_DRIVEN);
+}
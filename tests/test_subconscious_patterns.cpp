@@ -0,0 +1,145 @@
+/**
+ * @file test_subconscious_patterns.cpp
+ * @brief Tests for incremental pattern matching over network members.
+ */
+
+#include "test.h"
+#include "../include/network.h"
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief A subconscious network whose output neuron fires once per responding tick
+ */
+struct Responder {
+    Responder() : network("patterns"), responses(0) {
+        member = network.createNeuron("member", Neuron::NeuronType::PROCESSING);
+        auto output = network.createNeuron("output", Neuron::NeuronType::OUTPUT);
+        output->setThreshold(0.5f);
+        output->onFire([this](std::shared_ptr<Neuron>) { ++responses; });
+        network.addOutputNeuron(output);
+    }
+
+    int tick() {
+        int before = responses;
+        network.processSignals();
+        network.processSignals();
+        return responses - before;
+    }
+
+    SubconsciousNetwork network;
+    std::shared_ptr<Neuron> member;
+    int responses;
+};
+
+} // namespace
+
+TEST(member_tags_satisfy_patterns) {
+    Responder responder;
+    responder.network.addPattern({"member_tag", "member_key"}, {"seen"});
+    CHECK_EQ(responder.tick(), 0);
+
+    responder.member->addTag("member_tag");
+    CHECK_EQ(responder.tick(), 0);
+    responder.member->setMetadata("member_key", "value");
+    CHECK(responder.tick() > 0);
+}
+
+TEST(outside_neurons_do_not_satisfy_patterns) {
+    Responder responder;
+    responder.network.addPattern({"only_outside"}, {"seen"});
+    responder.network.addPattern({"outside_key"}, {"seen"});
+
+    // Connecting merges the outside neuron into the network's core without making it a member
+    auto outside = std::make_shared<Neuron>("outside", Neuron::NeuronType::PROCESSING);
+    outside->addTag("only_outside");
+    CHECK(responder.member->connectTo(outside));
+    CHECK(outside->getCore() == responder.member->getCore());
+    outside->setMetadata("outside_key", "value");
+    CHECK_EQ(responder.tick(), 0);
+
+    // A pattern added afterwards starts from member presence too
+    responder.network.addPattern({"only_outside", "outside_key"}, {"seen"});
+    CHECK_EQ(responder.tick(), 0);
+
+    // Adopting the neuron makes its tags and keys count
+    CHECK(responder.network.addNeuron(outside));
+    CHECK(responder.tick() > 0);
+
+    // Removing it again withdraws them
+    CHECK(responder.network.removeNeuron("outside"));
+    responder.tick();
+    CHECK_EQ(responder.tick(), 0);
+}
+
+TEST(tracked_presence_matches_brute_force) {
+    Network network("presence");
+    NeuronIndex& index = network.createNeuron("anchor", Neuron::NeuronType::PROCESSING)->getCore()->neuronIndex();
+    index.setPresenceTracking(true);
+
+    std::mt19937 random(11);
+    std::vector<std::string> names;
+    std::vector<Symbol> symbols;
+    for (int i = 0; i < 12; ++i) {
+        names.push_back("presence_" + std::to_string(i));
+        symbols.push_back(SymbolTable::global().intern(names.back()));
+    }
+
+    std::vector<std::shared_ptr<Neuron>> outsiders;
+    std::set<Symbol> tracked;
+    std::vector<Symbol> changes;
+    for (int step = 0; step < 400; ++step) {
+        std::vector<std::shared_ptr<Neuron>> members = network.getAllNeurons();
+        const std::string& name = names[random() % names.size()];
+        uint32_t pick = random() % 8;
+        if (pick == 0) {
+            members[random() % members.size()]->addTag(name);
+        } else if (pick == 1) {
+            members[random() % members.size()]->setMetadata(name, "value");
+        } else if (pick == 2) {
+            network.createNeuron("m" + std::to_string(step), Neuron::NeuronType::MEMORY)->addTag(name);
+        } else if (pick == 3 || pick == 4) {
+            auto outside = std::make_shared<Neuron>("o" + std::to_string(step), Neuron::NeuronType::SENSORY);
+            if (pick == 3) {
+                outside->addTag(name);
+            } else {
+                outside->setMetadata(name, "value");
+            }
+            members[random() % members.size()]->connectTo(outside);
+            outsiders.push_back(outside);
+        } else if (pick == 5 && !outsiders.empty()) {
+            outsiders[random() % outsiders.size()]->addTag(name);
+        } else if (pick == 6 && !outsiders.empty()) {
+            network.addNeuron(outsiders[random() % outsiders.size()]);
+        } else if (pick == 7 && members.size() > 1) {
+            std::string id = members[random() % members.size()]->getId();
+            if (id != "anchor") {
+                network.removeNeuron(id);
+            }
+        }
+
+        // Follow the recorded changes the way a pattern matcher does
+        index.takePresenceChanges(changes);
+        for (Symbol symbol : changes) {
+            if (index.isPresent(symbol)) {
+                tracked.insert(symbol);
+            } else {
+                tracked.erase(symbol);
+            }
+        }
+
+        members = network.getAllNeurons();
+        for (size_t i = 0; i < symbols.size(); ++i) {
+            bool expected = false;
+            for (const auto& neuron : members) {
+                expected = expected || neuron->hasTag(names[i]) || neuron->hasMetadata(names[i]);
+            }
+            CHECK_EQ(index.isPresent(symbols[i]), expected);
+            CHECK_EQ(tracked.count(symbols[i]) != 0, expected);
+        }
+    }
+}
@@ -0,0 +1,114 @@
+/**
+ * @file test_symbol_table.cpp
+ * @brief Tests for string interning of IDs, tags and keys.
+ */
+
+#include "test.h"
+#include "../include/network.h"
+#include "../include/symbol_table.h"
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(intern_is_stable) {
+    SymbolTable table;
+    Symbol alpha = table.intern("alpha");
+    Symbol beta = table.intern("beta");
+    CHECK(alpha != beta);
+    CHECK_EQ(table.intern("alpha"), alpha);
+    CHECK_EQ(table.lookup("beta"), beta);
+    CHECK_EQ(table.lookup("gamma"), SymbolTable::INVALID_SYMBOL);
+    CHECK_EQ(table.name(alpha), std::string("alpha"));
+    CHECK_EQ(table.size(), 2u);
+}
+
+TEST(names_survive_growth) {
+    SymbolTable table;
+    Symbol first = table.intern("first");
+    const std::string& name = table.name(first);
+    for (int i = 0; i < 10000; ++i) {
+        table.intern("symbol_" + std::to_string(i));
+    }
+    CHECK_EQ(name, std::string("first"));
+    CHECK_EQ(table.name(table.lookup("symbol_9999")), std::string("symbol_9999"));
+}
+
+TEST(concurrent_interning_agrees) {
+    SymbolTable table;
+    std::vector<std::vector<Symbol>> results(4);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < results.size(); ++t) {
+        threads.emplace_back([&table, &results, t]() {
+            for (int i = 0; i < 2000; ++i) {
+                results[t].push_back(table.intern("shared_" + std::to_string(i)));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    CHECK_EQ(table.size(), 2000u);
+    for (size_t t = 1; t < results.size(); ++t) {
+        CHECK(results[t] == results[0]);
+    }
+}
+
+TEST(neuron_string_api_matches_symbols) {
+    Network network("symbols");
+    auto neuron = network.createNeuron("symbol_api_neuron", Neuron::NeuronType::PROCESSING);
+    SymbolTable& symbols = SymbolTable::global();
+    CHECK(network.getNeuron("symbol_api_neuron") == neuron);
+
+    size_t typeTags = neuron->getTagSymbols().size();
+    neuron->addTag("string_tag");
+    neuron->addTag(symbols.intern("symbol_tag"));
+    neuron->addTag("string_tag");
+    CHECK_EQ(neuron->getTagSymbols().size(), typeTags + 2);
+    CHECK(neuron->hasTag(symbols.lookup("string_tag")));
+    CHECK(neuron->hasTag("symbol_tag"));
+    CHECK(!neuron->hasTag("missing_tag"));
+
+    neuron->setMetadata("colour", "red");
+    CHECK(neuron->hasMetadata(symbols.lookup("colour")));
+    CHECK_EQ(neuron->getMetadata(symbols.lookup("colour")), std::string("red"));
+    neuron->setMetadata(symbols.intern("colour"), "blue");
+    CHECK_EQ(neuron->getMetadata("colour"), std::string("blue"));
+
+    CHECK_EQ(network.getNeuronsByTag(symbols.lookup("symbol_tag")).size(), 1u);
+    CHECK_EQ(network.getNeuronsByTag("string_tag").size(), 1u);
+}
+
+TEST(neuron_ids_are_not_interned) {
+    SymbolTable& symbols = SymbolTable::global();
+    Network network("uninterned");
+    network.createNeuron("warm_up", Neuron::NeuronType::PROCESSING);  // Interns the type tags once
+
+    size_t before = symbols.size();
+    std::vector<std::string> ids;
+    for (int i = 0; i < 500; ++i) {
+        ids.push_back("uninterned_" + std::to_string(i));
+    }
+    network.createNeurons(ids, std::vector<Neuron::NeuronType>(ids.size(), Neuron::NeuronType::MEMORY));
+    network.createNeuron("uninterned_single", Neuron::NeuronType::SENSORY);
+
+    CHECK_EQ(symbols.size(), before);
+    CHECK_EQ(symbols.lookup("uninterned_7"), SymbolTable::INVALID_SYMBOL);
+    CHECK(network.getNeuron("uninterned_7") != nullptr);
+    CHECK_EQ(network.getNeuron("uninterned_7")->getId(), std::string("uninterned_7"));
+    CHECK(network.removeNeuron("uninterned_single"));
+    CHECK(network.getNeuron("uninterned_single") == nullptr);
+}
+
+TEST(lookup_finds_interned_strings_only) {
+    SymbolTable table;
+    std::string text = "stored_once";
+    Symbol symbol = table.intern(text);
+    text[0] = 'S';  // The table keeps its own copy
+
+    CHECK_EQ(table.lookup("stored_once"), symbol);
+    CHECK_EQ(table.lookup(text), SymbolTable::INVALID_SYMBOL);
+    CHECK_EQ(table.name(symbol), std::string("stored_once"));
+    CHECK_EQ(table.intern("stored_once"), symbol);
+    CHECK_EQ(table.size(), 1u);
+}
@@ -0,0 +1,71 @@
+/**
+ * @file test_synapse_ids.cpp
+ * @brief Tests for synapse ID policies.
+ */
+
+#include "test.h"
+#include "../include/synapse.h"
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(counter_ids_are_unique_and_lazy) {
+    Synapse::setIdPolicy(Synapse::IdPolicy::COUNTER);
+    SynapsePtr first = Synapse::create(Synapse::SynapseType::EXCITATORY, 1.0f);
+    SynapsePtr second = first->derive();
+
+    CHECK(first->getSerial() != 0);
+    CHECK(second->getSerial() != 0);
+    CHECK(first->getSerial() != second->getSerial());
+    CHECK_EQ(first->getId(), std::to_string(static_cast<unsigned long long>(first->getSerial())));
+    CHECK(&first->getId() == &first->getId());
+}
+
+TEST(counter_ids_unique_across_threads) {
+    Synapse::setIdPolicy(Synapse::IdPolicy::COUNTER);
+    const int threads = 4;
+    const int perThread = 5000;
+    std::vector<std::vector<uint64_t>> serials(threads);
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&serials, t, perThread]() {
+            SynapsePtr origin = Synapse::create(Synapse::SynapseType::EXCITATORY, 1.0f);
+            for (int i = 0; i < perThread; ++i) {
+                serials[t].push_back(origin->derive()->getSerial());
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    std::set<uint64_t> unique;
+    for (const auto& list : serials) {
+        unique.insert(list.begin(), list.end());
+    }
+    CHECK_EQ(unique.size(), static_cast<size_t>(threads * perThread));
+}
+
+TEST(uuid_policy_is_opt_in) {
+    Synapse::setIdPolicy(Synapse::IdPolicy::UUID);
+    SynapsePtr first = Synapse::create(Synapse::SynapseType::EXCITATORY, 1.0f);
+    SynapsePtr second = Synapse::create(Synapse::SynapseType::EXCITATORY, 1.0f);
+    Synapse::setIdPolicy(Synapse::IdPolicy::COUNTER);
+
+    CHECK(Synapse::getIdPolicy() == Synapse::IdPolicy::COUNTER);
+    CHECK_EQ(first->getSerial(), 0u);
+    CHECK_EQ(first->getId().size(), 36u);
+    CHECK(first->getId() != second->getId());
+}
+
+TEST(explicit_id_is_kept) {
+    SynapsePtr named = Synapse::create("named_synapse", Synapse::SynapseType::INHIBITORY, 0.5f);
+    CHECK_EQ(named->getId(), std::string("named_synapse"));
+    CHECK_EQ(named->getSerial(), 0u);
+
+    SynapsePtr derived = named->derive();
+    CHECK(derived->getId() != named->getId());
+    CHECK_EQ(derived->getData<std::string>("derived_from"), std::string("named_synapse"));
+}
@@ -0,0 +1,75 @@
+/**
+ * @file test_synapse_payload.cpp
+ * @brief Tests for the typed synapse payload.
+ */
+
+#include "test.h"
+#include "../include/synapse.h"
+#include <string>
+
+TEST(values_keep_native_type) {
+    SynapsePtr synapse = Synapse::create("payload", Synapse::SynapseType::EXCITATORY, 1.0f);
+    synapse->setData("count", 42);
+    synapse->setData("ratio", 0.25f);
+    synapse->setData("precise", 0.125);
+    synapse->setData("flag", true);
+    synapse->setData("label", std::string("alpha"));
+
+    Symbol count = SymbolTable::global().lookup("count");
+    CHECK(synapse->findData(count) != nullptr);
+    CHECK(synapse->findData(count)->getType() == PayloadValue::Type::INT);
+    CHECK(synapse->findData(SymbolTable::global().lookup("ratio"))->getType() == PayloadValue::Type::FLOAT);
+    CHECK(synapse->findData(SymbolTable::global().lookup("precise"))->getType() == PayloadValue::Type::DOUBLE);
+    CHECK(synapse->findData(SymbolTable::global().lookup("flag"))->getType() == PayloadValue::Type::BOOL);
+    CHECK(synapse->findData(SymbolTable::global().lookup("label"))->getType() == PayloadValue::Type::STRING);
+
+    CHECK_EQ(synapse->getData<int>("count"), 42);
+    CHECK_EQ(synapse->getData<float>("ratio"), 0.25f);
+    CHECK_EQ(synapse->getData<double>("precise"), 0.125);
+    CHECK(synapse->getData<bool>("flag"));
+    CHECK_EQ(synapse->getData<std::string>("label"), std::string("alpha"));
+}
+
+TEST(values_convert_between_types) {
+    SynapsePtr synapse = Synapse::create("convert", Synapse::SynapseType::EXCITATORY, 1.0f);
+    synapse->setData("count", 7);
+    CHECK_NEAR(synapse->getData<float>("count"), 7.0f, 0.0f);
+    CHECK_EQ(synapse->getData<std::string>("count"), std::to_string(7));
+
+    // Overwriting replaces the type as well as the value
+    synapse->setData("count", std::string("seven"));
+    CHECK(synapse->findData(SymbolTable::global().lookup("count"))->getType() == PayloadValue::Type::STRING);
+    CHECK_EQ(synapse->getData<std::string>("count"), std::string("seven"));
+}
+
+TEST(missing_key_reads_default) {
+    SynapsePtr synapse = Synapse::create("missing", Synapse::SynapseType::EXCITATORY, 1.0f);
+    CHECK(!synapse->hasData("never_set_key"));
+    CHECK_EQ(synapse->getData<int>("never_set_key"), 0);
+    CHECK_EQ(synapse->getData<std::string>("never_set_key"), std::string());
+}
+
+TEST(entries_beyond_inline_capacity) {
+    SynapsePtr synapse = Synapse::create("overflow", Synapse::SynapseType::EXCITATORY, 1.0f);
+    const int entries = static_cast<int>(SynapsePayload::INLINE_CAPACITY) + 3;
+    for (int i = 0; i < entries; ++i) {
+        synapse->setData("key" + std::to_string(i), i * 10);
+    }
+
+    std::vector<std::string> keys = synapse->getKeys();
+    CHECK_EQ(keys.size(), static_cast<size_t>(entries));
+    for (int i = 0; i < entries; ++i) {
+        CHECK(synapse->hasData("key" + std::to_string(i)));
+        CHECK_EQ(synapse->getData<int>("key" + std::to_string(i)), i * 10);
+    }
+}
+
+TEST(strength_is_stored_natively) {
+    SynapsePtr synapse = Synapse::create("strength", Synapse::SynapseType::EXCITATORY, 0.5f);
+    CHECK_EQ(synapse->getStrength(), 0.5f);
+    synapse->setStrength(0.75f);
+    CHECK_EQ(synapse->getStrength(), 0.75f);
+
+    SynapsePtr derived = synapse->derive(0.3f);
+    CHECK_EQ(derived->getStrength(), 0.3f);
+}
@@ -0,0 +1,107 @@
+/**
+ * @file test_thread_pool.cpp
+ * @brief Tests for the work-stealing thread pool.
+ */
+
+#include "test.h"
+#include "../include/thread_pool.h"
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+TEST(parallel_for_covers_range_once) {
+    ThreadPool pool(4);
+    std::vector<std::atomic<int>> hits(10007);
+    for (auto& hit : hits) {
+        hit.store(0);
+    }
+
+    std::atomic<bool> oversized(false);
+    pool.parallelFor(3, hits.size(), 64, [&](size_t first, size_t last) {
+        if (last - first > 64) {
+            oversized.store(true);
+        }
+        for (size_t i = first; i < last; ++i) {
+            hits[i].fetch_add(1);
+        }
+    });
+
+    CHECK(!oversized.load());
+    for (size_t i = 0; i < hits.size(); ++i) {
+        CHECK_EQ(hits[i].load(), i < 3 ? 0 : 1);
+    }
+}
+
+TEST(parallel_for_empty_range) {
+    ThreadPool pool(2);
+    int calls = 0;
+    pool.parallelFor(5, 5, 16, [&](size_t, size_t) { ++calls; });
+    CHECK_EQ(calls, 0);
+}
+
+TEST(wait_runs_every_task_of_group) {
+    ThreadPool pool(3);
+    TaskGroup group;
+    std::atomic<int> count(0);
+
+    std::vector<std::function<void()>> tasks;
+    for (int i = 0; i < 500; ++i) {
+        tasks.push_back([&count]() { count.fetch_add(1); });
+    }
+    pool.submitBatch(group, tasks);
+    CHECK(tasks.empty());
+    for (int i = 0; i < 500; ++i) {
+        pool.submit(group, [&count]() { count.fetch_add(1); });
+    }
+
+    pool.wait(group);
+    CHECK(group.done());
+    CHECK_EQ(count.load(), 1000);
+}
+
+TEST(nested_wait_inside_task) {
+    ThreadPool pool(2);
+    TaskGroup outer;
+    std::atomic<int> count(0);
+
+    for (int i = 0; i < 8; ++i) {
+        pool.submit(outer, [&pool, &count]() {
+            TaskGroup inner;
+            for (int j = 0; j < 8; ++j) {
+                pool.submit(inner, [&count]() { count.fetch_add(1); });
+            }
+            pool.wait(inner);
+        });
+    }
+
+    pool.wait(outer);
+    CHECK_EQ(count.load(), 64);
+}
+
+TEST(wait_rethrows_task_exception) {
+    ThreadPool pool(2);
+    TaskGroup group;
+    pool.submit(group, []() { throw std::runtime_error("task failed"); });
+    pool.submit(group, []() {});
+
+    bool thrown = false;
+    try {
+        pool.wait(group);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    CHECK(thrown);
+    CHECK(group.done());
+}
+
+TEST(enqueue_and_wait_for_completion) {
+    ThreadPool pool(4);
+    std::atomic<int> count(0);
+    for (int i = 0; i < 200; ++i) {
+        pool.enqueue([&count]() { count.fetch_add(1); });
+    }
+    pool.waitForCompletion();
+    CHECK_EQ(count.load(), 200);
+    CHECK_EQ(pool.size(), 4u);
+    CHECK_EQ(pool.currentWorker(), pool.size());
+}
@@ -0,0 +1,206 @@
+/**
+ * @file graphgen.cpp
+ * @brief Command line front end of the synthetic graph generator.
+ *
+ * Generates a network, builds it and optionally runs a few ticks, printing
+ * the size of the graph and the time spent in each step:
+ *
+ *     o3_graphgen --topology=ba --neurons=1000000 --attach=4 --seed=7 --ticks=10
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../include/graph_generator.h"
+#include "../include/network.h"
+#include "../include/synapse.h"
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+std::vector<std::string> split(const std::string& text, char separator) {
+    std::vector<std::string> parts;
+    std::stringstream stream(text);
+    std::string part;
+    while (std::getline(stream, part, separator)) {
+        parts.push_back(part);
+    }
+    return parts;
+}
+
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [options]\n"
+              << "  --topology=er|ws|ba|layered  Graph model (default er)\n"
+              << "  --neurons=N                  Number of neurons (default 1000)\n"
+              << "  --degree=K                   Mean degree for er, lattice degree for ws (default 8)\n"
+              << "  --rewire=P                   Rewiring probability for ws (default 0.1)\n"
+              << "  --attach=M                   Edges per new neuron for ba (default 4)\n"
+              << "  --layers=L                   Layer count for layered (default 4)\n"
+              << "  --fanout=F                   Targets per neuron in the next layer, 0 for all (default 8)\n"
+              << "  --types=type:share,...       Neuron type mix (default processing:1)\n"
+              << "  --weights=dist:a[:b]         constant, uniform, normal or lognormal (default uniform:0.1:0.5)\n"
+              << "  --inputs=N --outputs=N       Input and output neuron counts (default 16)\n"
+              << "  --seed=S                     Random seed (default 1)\n"
+              << "  --ticks=T                    Ticks to run after building, stimulating the inputs (default 0)\n"
+              << "  --workers=W                  Worker threads for the ticks (default 1)\n"
+              << "  --scheduling=dense|event|levelized\n"
+              << "                               How ticks find active neurons (default dense)\n";
+}
+
+bool parseOptions(int argc, char** argv, GraphGenerator::Config& config, size_t& ticks, size_t& workers,
+                  Network::SchedulingMode& scheduling) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        size_t equals = arg.find('=');
+        if (arg.compare(0, 2, "--") != 0 || equals == std::string::npos) {
+            std::cerr << "Malformed option: " << arg << std::endl;
+            return false;
+        }
+
+        std::string key = arg.substr(2, equals - 2);
+        std::string value = arg.substr(equals + 1);
+
+        if (key == "topology") {
+            if (!GraphGenerator::parseTopology(value, config.topology)) {
+                std::cerr << "Unknown topology: " << value << std::endl;
+                return false;
+            }
+        } else if (key == "neurons") {
+            config.neuronCount = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (key == "degree") {
+            config.meanDegree = std::atof(value.c_str());
+        } else if (key == "rewire") {
+            config.rewireProbability = std::atof(value.c_str());
+        } else if (key == "attach") {
+            config.attachEdges = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (key == "layers") {
+            config.layerCount = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (key == "fanout") {
+            config.layerFanOut = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (key == "types") {
+            config.typeMix.clear();
+            for (const auto& entry : split(value, ',')) {
+                std::vector<std::string> parts = split(entry, ':');
+                Neuron::NeuronType type;
+                if (parts.empty() || !GraphGenerator::parseNeuronType(parts[0], type)) {
+                    std::cerr << "Unknown neuron type in: " << entry << std::endl;
+                    return false;
+                }
+                double share = parts.size() > 1 ? std::atof(parts[1].c_str()) : 1.0;
+                config.typeMix.push_back(std::make_pair(type, share));
+            }
+        } else if (key == "weights") {
+            std::vector<std::string> parts = split(value, ':');
+            if (parts.empty() || !GraphGenerator::parseWeightDistribution(parts[0], config.weights)) {
+                std::cerr << "Unknown weight distribution: " << value << std::endl;
+                return false;
+            }
+            if (parts.size() > 1) config.weightA = static_cast<float>(std::atof(parts[1].c_str()));
+            if (parts.size() > 2) config.weightB = static_cast<float>(std::atof(parts[2].c_str()));
+        } else if (key == "inputs") {
+            config.inputCount = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (key == "outputs") {
+            config.outputCount = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (key == "seed") {
+            config.seed = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (key == "ticks") {
+            ticks = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (key == "workers") {
+            workers = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (key == "scheduling") {
+            if (value == "dense") {
+                scheduling = Network::SchedulingMode::DENSE;
+            } else if (value == "event") {
+                scheduling = Network::SchedulingMode::EVENT_DRIVEN;
+            } else if (value == "levelized") {
+                scheduling = Network::SchedulingMode::LEVELIZED;
+            } else {
+                std::cerr << "Unknown scheduling mode: " << value << std::endl;
+                return false;
+            }
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    GraphGenerator::Config config;
+    size_t ticks = 0;
+    size_t workers = 1;
+    Network::SchedulingMode scheduling = Network::SchedulingMode::DENSE;
+
+    if (!parseOptions(argc, argv, config, ticks, workers, scheduling)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    Clock::time_point start = Clock::now();
+    GraphGenerator::Graph graph = GraphGenerator::generate(config);
+    double generateSeconds = secondsSince(start);
+
+    // Degree statistics
+    std::vector<uint32_t> outDegrees(graph.types.size(), 0);
+    std::vector<uint32_t> inDegrees(graph.types.size(), 0);
+    for (const auto& edge : graph.edges) {
+        ++outDegrees[edge.source];
+        ++inDegrees[edge.target];
+    }
+    uint32_t maxOut = 0;
+    uint32_t maxIn = 0;
+    for (size_t i = 0; i < graph.types.size(); ++i) {
+        maxOut = std::max(maxOut, outDegrees[i]);
+        maxIn = std::max(maxIn, inDegrees[i]);
+    }
+
+    start = Clock::now();
+    Network network("generated");
+    std::vector<std::shared_ptr<Neuron>> neurons = GraphGenerator::build(graph, network);
+    double buildSeconds = secondsSince(start);
+
+    std::cout << "neurons:        " << network.getNeuronCount() << "\n"
+              << "connections:    " << network.getConnectionCount() << "\n"
+              << "mean degree:    " << (graph.types.empty() ? 0.0
+                                        : static_cast<double>(graph.edges.size()) / graph.types.size()) << "\n"
+              << "max out-degree: " << maxOut << "\n"
+              << "max in-degree:  " << maxIn << "\n"
+              << "inputs:         " << graph.inputs.size() << "\n"
+              << "outputs:        " << graph.outputs.size() << "\n"
+              << "generate:       " << generateSeconds << " s\n"
+              << "build:          " << buildSeconds << " s\n";
+
+    if (ticks > 0) {
+        network.setParallelism(workers);
+        network.setSchedulingMode(scheduling);
+
+        start = Clock::now();
+        for (size_t tick = 0; tick < ticks; ++tick) {
+            for (uint32_t input : graph.inputs) {
+                SynapsePtr signal = Synapse::create("stimulus");
+                signal->setData("strength", 1.0f);
+                neurons[input]->receiveSignal(signal);
+            }
+            network.processSignals();
+        }
+        double tickSeconds = secondsSince(start);
+
+        std::cout << "ticks:          " << ticks << "\n"
+                  << "per tick:       " << tickSeconds * 1e3 / ticks << " ms\n"
+                  << "pending:        " << network.getPendingSignalCount() << "\n";
+    }
+
+    return 0;
+}